@@ -8,6 +8,10 @@
 #include "limits.h"
 #include "ripes_types.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 /// Most of the code in this file originates from LLVM MathExtras.h
 
 namespace Ripes {
@@ -81,6 +85,17 @@ inline unsigned log2Ceil(double v) {
     return static_cast<unsigned>(std::ceil(std::log2(v)));
 }
 
+/// Returns the number of trailing zero bits of @p val, which must be non-zero.
+inline unsigned countTrailingZeros(uint64_t val) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, val);
+    return idx;
+#else
+    return __builtin_ctzll(val);
+#endif
+}
+
 template <typename T>
 unsigned firstSetBitIdx(const T& val) {
     for (unsigned i = 0; i < CHAR_BIT * sizeof(T); ++i) {
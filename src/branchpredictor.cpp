@@ -0,0 +1,369 @@
+#include "branchpredictor.h"
+
+#include <algorithm>
+
+#include "binutils.h"
+#include "processorhandler.h"
+#include "ripessettings.h"
+
+#include "../external/VSRTL/core/vsrtl_register.h"
+
+namespace Ripes {
+
+namespace {
+
+class NotTakenPredictor : public DirectionPredictor {
+public:
+    bool predict(AInt, AInt) const override { return false; }
+    void train(AInt, bool) override {}
+    void undo() override {}
+};
+
+/**
+ * @brief The BTFNPredictor class
+ * Backward taken, forward not taken; predicts that loops keep iterating.
+ */
+class BTFNPredictor : public DirectionPredictor {
+public:
+    bool predict(AInt pc, AInt target) const override { return target <= pc; }
+    void train(AInt, bool) override {}
+    void undo() override {}
+};
+
+/**
+ * @brief The CounterPredictor class
+ * A pattern history table of 2-bit saturating counters, initially weakly not taken. The table is indexed by the
+ * address of the branch, XOR'ed with the global history of the outcomes of the most recent conditional branches. This
+ * is a bimodal predictor without any history bits, and a gshare predictor otherwise.
+ */
+class CounterPredictor : public DirectionPredictor {
+public:
+    CounterPredictor(unsigned entries, unsigned historyBits, unsigned pcShift, unsigned undoCapacity)
+        : m_counters(std::max(1u, entries), 1),
+          m_historyMask(historyBits >= 32 ? UINT32_MAX : (1u << historyBits) - 1),
+          m_pcShift(pcShift),
+          m_undo(std::max(1u, undoCapacity)) {}
+
+    bool predict(AInt pc, AInt) const override { return m_counters[index(pc)] >= 2; }
+
+    void train(AInt pc, bool taken) override {
+        const unsigned idx = index(pc);
+        m_undo[m_undoHead] = {idx, m_counters[idx], m_history};
+        m_undoHead = (m_undoHead + 1) % m_undo.size();
+
+        uint8_t& counter = m_counters[idx];
+        counter = taken ? std::min(counter + 1, 3) : std::max(counter - 1, 0);
+        m_history = ((m_history << 1) | (taken ? 1 : 0)) & m_historyMask;
+    }
+
+    void undo() override {
+        m_undoHead = (m_undoHead + m_undo.size() - 1) % m_undo.size();
+        const Undo& undo = m_undo[m_undoHead];
+        m_counters[undo.idx] = undo.counter;
+        m_history = undo.history;
+    }
+
+private:
+    struct Undo {
+        unsigned idx = 0;
+        uint8_t counter = 0;
+        uint32_t history = 0;
+    };
+
+    unsigned index(AInt pc) const { return ((pc >> m_pcShift) ^ m_history) % m_counters.size(); }
+
+    std::vector<uint8_t> m_counters;
+    uint32_t m_history = 0;
+    uint32_t m_historyMask;
+    unsigned m_pcShift;
+
+    std::vector<Undo> m_undo;
+    unsigned m_undoHead = 0;
+};
+
+}  // namespace
+
+std::unique_ptr<DirectionPredictor> DirectionPredictor::create(const BranchPredictorConfig& config, unsigned pcShift,
+                                                               unsigned undoCapacity) {
+    switch (config.type) {
+        case DirectionPredictorType::NotTaken:
+            return std::make_unique<NotTakenPredictor>();
+        case DirectionPredictorType::StaticBTFN:
+            return std::make_unique<BTFNPredictor>();
+        case DirectionPredictorType::Bimodal:
+            return std::make_unique<CounterPredictor>(config.tableEntries, 0, pcShift, undoCapacity);
+        case DirectionPredictorType::GShare:
+            return std::make_unique<CounterPredictor>(config.tableEntries, config.historyBits, pcShift, undoCapacity);
+    }
+    Q_UNREACHABLE();
+}
+
+BranchPredictor::BranchPredictor(QObject* parent) : QObject(parent) {
+    // The processor is clocked in the simulator thread while running, wherein the predictor is trained directly.
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this, &BranchPredictor::processorWasClocked,
+            Qt::DirectConnection);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReversed, this,
+            &BranchPredictor::processorWasReversed);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this, &BranchPredictor::reset);
+    reset();
+}
+
+QString BranchPredictor::typeName(DirectionPredictorType type) {
+    switch (type) {
+        case DirectionPredictorType::NotTaken:
+            return "Static not taken";
+        case DirectionPredictorType::StaticBTFN:
+            return "Static BTFN";
+        case DirectionPredictorType::Bimodal:
+            return "Bimodal";
+        case DirectionPredictorType::GShare:
+            return "Gshare";
+    }
+    Q_UNREACHABLE();
+}
+
+QString BranchPredictor::kindName(ControlFlow::Kind kind) {
+    switch (kind) {
+        case ControlFlow::None:
+            return "";
+        case ControlFlow::Branch:
+            return "Branch";
+        case ControlFlow::Jump:
+            return "Jump";
+        case ControlFlow::IndirectJump:
+            return "Indirect jump";
+        case ControlFlow::Call:
+            return "Call";
+        case ControlFlow::Return:
+            return "Return";
+    }
+    Q_UNREACHABLE();
+}
+
+void BranchPredictor::setConfig(const BranchPredictorConfig& config) {
+    m_config = config;
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+}
+
+void BranchPredictor::reset() {
+    m_penalty = ProcessorHandler::getProcessor()->controlFlowPenalty();
+    m_pcShift = log2Ceil(std::max(1u, ProcessorHandler::currentISA()->instrByteAlignment()));
+    m_instrBytes = std::max(1u, ProcessorHandler::currentISA()->instrBytes());
+
+    const unsigned undoCapacity = std::max(1u, vsrtl::core::ClockedComponent::reverseStackSize());
+    m_direction = DirectionPredictor::create(m_config, m_pcShift, undoCapacity);
+    m_btb.assign(m_config.btbEntries, BTBEntry());
+    m_ras.assign(m_config.rasEntries, 0);
+    m_rasTop = 0;
+    m_rasSize = 0;
+    m_predictions.assign(s_maxInFlight, Prediction());
+    m_fetchSeq = 0;
+    m_predictionCount = 0;
+    m_hasLastFetch = false;
+    m_cycle = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        m_stats = Stats();
+        m_pcStats.clear();
+    }
+    m_undo.assign(undoCapacity, Undo());
+    m_undoHead = 0;
+    m_undoSize = 0;
+
+    // Resolve the control flow of the initial (cycle 0) state of the processor
+    processorWasClocked();
+    emit predictorReset();
+}
+
+BranchPredictor::Prediction BranchPredictor::predict(AInt pc) const {
+    Prediction prediction;
+    prediction.pc = pc;
+    const BTBEntry* entry = m_btb.empty() ? nullptr : &m_btb[btbIndex(pc)];
+    if (entry && entry->valid && entry->pc == pc) {
+        prediction.target = entry->target;
+        switch (entry->kind) {
+            case ControlFlow::Branch:
+                prediction.taken = m_direction->predict(pc, entry->target);
+                break;
+            case ControlFlow::Return:
+                prediction.taken = true;
+                if (m_rasSize > 0) {
+                    prediction.target = m_ras[(m_rasTop + m_ras.size() - 1) % m_ras.size()];
+                }
+                break;
+            default:
+                prediction.taken = true;
+                break;
+        }
+    }
+    return prediction;
+}
+
+void BranchPredictor::fetch(const MemoryAccess& access, Undo& undo) {
+    undo.hadLastFetch = m_hasLastFetch;
+    undo.lastFetch = m_lastFetch;
+    if (access.type == MemoryAccess::None || (m_hasLastFetch && access.address == m_lastFetch)) {
+        return;
+    }
+    m_hasLastFetch = true;
+    m_lastFetch = access.address;
+
+    undo.fetched = std::max(1u, access.bytes / m_instrBytes);
+    for (unsigned i = 0; i < undo.fetched; ++i) {
+        prediction(m_fetchSeq++) = predict(access.address + i * m_instrBytes);
+        m_predictionCount = std::min<unsigned>(m_predictionCount + 1, m_predictions.size());
+    }
+}
+
+void BranchPredictor::resolve(const ControlFlow& cf, Undo& undo) {
+    // Prediction, as made when the oldest in-flight instance of the instruction was fetched
+    uint64_t seq = oldestPrediction();
+    while (seq < m_fetchSeq && !(prediction(seq).status == Prediction::InFlight && prediction(seq).pc == cf.pc)) {
+        seq++;
+    }
+    undo.resolvedFetched = seq < m_fetchSeq;
+    undo.resolvedSeq = seq;
+    const Prediction predicted = undo.resolvedFetched ? prediction(seq) : predict(cf.pc);
+    undo.targetMispredicted = predicted.taken && cf.taken && predicted.target != cf.target;
+    undo.mispredicted = predicted.taken != cf.taken || undo.targetMispredicted;
+
+    // A taken control flow instruction flushes the younger instructions. If the instruction was not predicted as it
+    // was fetched, it is older than all predicted instructions.
+    if (undo.resolvedFetched) {
+        prediction(seq).status = Prediction::Resolved;
+    }
+    if (cf.taken) {
+        undo.squashed = true;
+        undo.squashFrom = undo.resolvedFetched ? seq + 1 : oldestPrediction();
+        for (uint64_t younger = undo.squashFrom; younger < m_fetchSeq; ++younger) {
+            Prediction& squashed = prediction(younger);
+            if (squashed.status == Prediction::InFlight) {
+                squashed.status = Prediction::Squashed;
+                squashed.squashCycle = m_cycle;
+            }
+        }
+        // The target may be fetched from the address fetched in this cycle
+        m_hasLastFetch = false;
+    }
+
+    // Training
+    const BTBEntry* entry = m_btb.empty() ? nullptr : &m_btb[btbIndex(cf.pc)];
+    if (entry) {
+        undo.btbIdx = btbIndex(cf.pc);
+        undo.btbEntry = *entry;
+        if (cf.taken) {
+            m_btb[undo.btbIdx] = {true, cf.pc, cf.target, cf.kind};
+        }
+    }
+
+    if (cf.kind == ControlFlow::Branch) {
+        m_direction->train(cf.pc, cf.taken);
+        undo.trained = true;
+    }
+
+    undo.rasTop = m_rasTop;
+    undo.rasSize = m_rasSize;
+    if (!m_ras.empty()) {
+        if (cf.kind == ControlFlow::Call) {
+            undo.rasEntry = m_ras[m_rasTop];
+            m_ras[m_rasTop] = cf.fallthrough;
+            m_rasTop = (m_rasTop + 1) % m_ras.size();
+            m_rasSize = std::min<unsigned>(m_rasSize + 1, m_ras.size());
+        } else if (cf.kind == ControlFlow::Return && m_rasSize > 0) {
+            m_rasTop = (m_rasTop + m_ras.size() - 1) % m_ras.size();
+            m_rasSize--;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_statsLock);
+    m_stats.resolved++;
+    m_stats.taken += cf.taken ? 1 : 0;
+    m_stats.mispredicted += undo.mispredicted ? 1 : 0;
+    m_stats.targetMispredicted += undo.targetMispredicted ? 1 : 0;
+
+    PCStats& pcStats = m_pcStats[cf.pc];
+    pcStats.kind = cf.kind;
+    pcStats.executed++;
+    pcStats.taken += cf.taken ? 1 : 0;
+    pcStats.mispredicted += undo.mispredicted ? 1 : 0;
+}
+
+void BranchPredictor::processorWasClocked() {
+    Undo& undo = m_undo[m_undoHead];
+    undo = Undo();
+    m_cycle++;
+    // The instructions fetched in the cycle are younger than the instruction resolved in the cycle
+    fetch(ProcessorHandler::getProcessor()->instrMemAccess(), undo);
+    undo.cf = ProcessorHandler::getProcessor()->controlFlow();
+    if (undo.cf.kind != ControlFlow::None) {
+        resolve(undo.cf, undo);
+    }
+    m_undoHead = (m_undoHead + 1) % m_undo.size();
+    m_undoSize = std::min<unsigned>(m_undoSize + 1, m_undo.size());
+}
+
+void BranchPredictor::processorWasReversed() {
+    if (m_undoSize == 0) {
+        // The cycle precedes the recorded cycles; its resolution cannot be undone.
+        return;
+    }
+    m_undoHead = (m_undoHead + m_undo.size() - 1) % m_undo.size();
+    m_undoSize--;
+
+    const Undo& undo = m_undo[m_undoHead];
+    const ControlFlow& cf = undo.cf;
+    if (cf.kind != ControlFlow::None) {
+        unresolve(undo);
+    }
+
+    m_fetchSeq -= undo.fetched;
+    m_predictionCount -= std::min(m_predictionCount, undo.fetched);
+    m_hasLastFetch = undo.hadLastFetch;
+    m_lastFetch = undo.lastFetch;
+    m_cycle--;
+}
+
+void BranchPredictor::unresolve(const Undo& undo) {
+    const ControlFlow& cf = undo.cf;
+    if (undo.squashed) {
+        for (uint64_t younger = std::max(undo.squashFrom, oldestPrediction()); younger < m_fetchSeq; ++younger) {
+            Prediction& squashed = prediction(younger);
+            if (squashed.status == Prediction::Squashed && squashed.squashCycle == m_cycle) {
+                squashed.status = Prediction::InFlight;
+            }
+        }
+    }
+    if (undo.resolvedFetched && undo.resolvedSeq >= oldestPrediction()) {
+        prediction(undo.resolvedSeq).status = Prediction::InFlight;
+    }
+
+    if (undo.trained) {
+        m_direction->undo();
+    }
+    if (!m_btb.empty()) {
+        m_btb[undo.btbIdx] = undo.btbEntry;
+    }
+    if (cf.kind == ControlFlow::Call && !m_ras.empty()) {
+        m_ras[undo.rasTop] = undo.rasEntry;
+    }
+    m_rasTop = undo.rasTop;
+    m_rasSize = undo.rasSize;
+
+    std::lock_guard<std::mutex> lock(m_statsLock);
+    m_stats.resolved--;
+    m_stats.taken -= cf.taken ? 1 : 0;
+    m_stats.mispredicted -= undo.mispredicted ? 1 : 0;
+    m_stats.targetMispredicted -= undo.targetMispredicted ? 1 : 0;
+
+    auto it = m_pcStats.find(cf.pc);
+    PCStats& pcStats = it->second;
+    pcStats.executed--;
+    pcStats.taken -= cf.taken ? 1 : 0;
+    pcStats.mispredicted -= undo.mispredicted ? 1 : 0;
+    if (pcStats.executed == 0) {
+        m_pcStats.erase(it);
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "processors/interface/ripesprocessor.h"
+#include "ripes_types.h"
+
+namespace Ripes {
+
+enum class DirectionPredictorType { NotTaken, StaticBTFN, Bimodal, GShare };
+
+/**
+ * @brief The BranchPredictorConfig struct
+ * Organization of a branch predictor: the predictor of the direction of conditional branches, the branch target buffer
+ * (BTB) and the return address stack (RAS). A BTB or RAS of 0 entries is disabled.
+ */
+struct BranchPredictorConfig {
+    DirectionPredictorType type = DirectionPredictorType::Bimodal;
+    unsigned tableEntries = 256;  // Pattern history table entries of the bimodal and gshare predictors
+    unsigned historyBits = 8;     // Global history bits of the gshare predictor
+    unsigned btbEntries = 64;
+    unsigned rasEntries = 8;
+};
+
+/**
+ * @brief The DirectionPredictor class
+ * Interface of the predictors of the direction of conditional branches. Trainings may be undone in reverse order.
+ */
+class DirectionPredictor {
+public:
+    virtual ~DirectionPredictor() {}
+    static std::unique_ptr<DirectionPredictor> create(const BranchPredictorConfig& config, unsigned pcShift,
+                                                      unsigned undoCapacity);
+
+    /**
+     * @brief predict
+     * @returns true if the conditional branch at @p pc, branching to @p target, is predicted taken.
+     */
+    virtual bool predict(AInt pc, AInt target) const = 0;
+
+    /**
+     * @brief train/undo
+     * Trains the predictor on the outcome of the conditional branch at @p pc, or reverts the most recent training.
+     */
+    virtual void train(AInt pc, bool taken) = 0;
+    virtual void undo() = 0;
+};
+
+/**
+ * @brief The BranchPredictor class
+ * A model of a dynamic branch predictor in the fetch stage of the current processor, evaluated on the control flow
+ * instructions which the processor resolves (see RipesProcessor::controlFlow()).
+ *
+ * The fetch stage looks up the address of each fetched instruction in the BTB. On a miss, the instruction is predicted
+ * to not be a taken control flow instruction. On a hit, the target of the BTB entry is predicted; returns are
+ * predicted to return to the top of the RAS, and conditional branches are predicted taken by the direction predictor.
+ * The BTB is allocated by taken control flow instructions, the RAS is pushed by calls and popped by returns, and the
+ * direction predictor is trained by conditional branches.
+ *
+ * Each fetched instruction (see RipesProcessor::instrMemAccess()) is predicted with the state of the predictor as it is
+ * fetched, and the predictor is trained when the instruction is resolved. Hence, the predictions of instructions which
+ * are fetched while older control flow instructions are in flight do not reflect the outcome of these.
+ *
+ * The predictor does not alter the execution of the processor, which does not predict control flow; i.e., each taken
+ * control flow instruction flushes the pipeline. Had the processor predicted control flow, only mispredicted control
+ * flow instructions would flush the pipeline, from which the cycles saved by the predictor are estimated. The cycle
+ * count of the processor is unaffected by the predictor.
+ *
+ * Cycles may be undone in reverse order, alongside the cycles of the processor.
+ */
+class BranchPredictor : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief The Stats struct
+     * Prediction counters of the control flow instructions resolved since the processor was reset. An instruction is
+     * mispredicted if either its direction or target was mispredicted.
+     */
+    struct Stats {
+        uint64_t resolved = 0;
+        uint64_t taken = 0;
+        uint64_t mispredicted = 0;
+        uint64_t targetMispredicted = 0;  // Taken, and predicted taken, but to another target
+
+        double accuracy() const { return resolved == 0 ? 0 : static_cast<double>(resolved - mispredicted) / resolved; }
+    };
+
+    /**
+     * @brief The PCStats struct
+     * The prediction counters of a single control flow instruction.
+     */
+    struct PCStats {
+        ControlFlow::Kind kind = ControlFlow::None;
+        uint64_t executed = 0;
+        uint64_t taken = 0;
+        uint64_t mispredicted = 0;
+
+        double accuracy() const { return executed == 0 ? 0 : static_cast<double>(executed - mispredicted) / executed; }
+    };
+
+    BranchPredictor(QObject* parent = nullptr);
+
+    /**
+     * @brief setConfig
+     * Sets the organization of the predictor. Since the predictor has not been trained on the execution of the
+     * processor so far, the processor is reset.
+     */
+    void setConfig(const BranchPredictorConfig& config);
+    const BranchPredictorConfig& getConfig() const { return m_config; }
+
+    /**
+     * @brief getStats, getPCStats
+     * The statistics are updated from the simulator thread, so copies are returned rather than references.
+     */
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        return m_stats;
+    }
+    std::map<AInt, PCStats> getPCStats() const {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        return m_pcStats;
+    }
+
+    /**
+     * @brief penalty
+     * @returns the cycles lost by the processor to each taken, or mispredicted, control flow instruction.
+     */
+    unsigned penalty() const { return m_penalty; }
+
+    /**
+     * @brief savedCycles
+     * @returns the estimated number of cycles which the processor would have saved, had it predicted control flow
+     * through this predictor. Negative if the predictor would have lost cycles.
+     */
+    long long savedCycles() const {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        return (static_cast<long long>(m_stats.taken) - static_cast<long long>(m_stats.mispredicted)) * m_penalty;
+    }
+
+    static QString typeName(DirectionPredictorType type);
+    static QString kindName(ControlFlow::Kind kind);
+
+public slots:
+    void reset();
+
+signals:
+    /**
+     * @brief predictorReset
+     * Emitted when the predictor has been reset, e.g., following a change of its configuration.
+     */
+    void predictorReset();
+
+private slots:
+    void processorWasClocked();
+    void processorWasReversed();
+
+private:
+    struct BTBEntry {
+        bool valid = false;
+        AInt pc = 0;
+        AInt target = 0;
+        ControlFlow::Kind kind = ControlFlow::None;
+    };
+
+    /**
+     * @brief The Prediction struct
+     * The prediction of a fetched instruction. A prediction is in flight until its instruction is resolved, or until
+     * it is squashed by an older taken control flow instruction, which flushes the younger instructions.
+     */
+    struct Prediction {
+        enum Status : uint8_t { InFlight, Resolved, Squashed };
+        AInt pc = 0;
+        AInt target = 0;
+        bool taken = false;
+        Status status = InFlight;
+        uint64_t squashCycle = 0;  // m_cycle of the resolution which squashed the prediction
+    };
+
+    /**
+     * @brief s_maxInFlight
+     * Number of most recently fetched instructions whose predictions are retained; exceeds the number of instructions
+     * in flight in any of the processor models. The resolution of an older instruction is predicted with the state of
+     * the predictor as it is resolved.
+     */
+    static constexpr unsigned s_maxInFlight = 512;
+
+    /**
+     * @brief The Undo struct
+     * Undo record of a cycle: the instructions fetched in the cycle, the control flow instruction resolved in the
+     * cycle, its prediction, and the state of the BTB and RAS prior to the resolution.
+     */
+    struct Undo {
+        unsigned fetched = 0;
+        bool hadLastFetch = false;
+        AInt lastFetch = 0;
+        bool resolvedFetched = false;  // The resolved instruction was predicted as it was fetched
+        uint64_t resolvedSeq = 0;
+        bool squashed = false;
+        uint64_t squashFrom = 0;
+
+        ControlFlow cf;
+        bool mispredicted = false;
+        bool targetMispredicted = false;
+        bool trained = false;  // The direction predictor was trained
+        unsigned btbIdx = 0;
+        BTBEntry btbEntry;
+        unsigned rasTop = 0;
+        unsigned rasSize = 0;
+        AInt rasEntry = 0;  // The RAS entry overwritten by a push
+    };
+
+    /**
+     * @brief predict
+     * @returns the prediction of the instruction at @p pc with the current state of the predictor.
+     */
+    Prediction predict(AInt pc) const;
+
+    /**
+     * @brief fetch
+     * Predicts the instructions fetched by @p access. A stalled fetch stage, which refetches the instructions of the
+     * previous cycle, does not fetch new instructions.
+     */
+    void fetch(const MemoryAccess& access, Undo& undo);
+    /**
+     * @brief resolve/unresolve
+     * Evaluates the prediction of the resolved control flow instruction @p cf and trains the predictor on its outcome,
+     * or undoes the resolution recorded in @p undo.
+     */
+    void resolve(const ControlFlow& cf, Undo& undo);
+    void unresolve(const Undo& undo);
+    Prediction& prediction(uint64_t seq) { return m_predictions[seq % m_predictions.size()]; }
+    uint64_t oldestPrediction() const { return m_fetchSeq - m_predictionCount; }
+    unsigned btbIndex(AInt pc) const { return (pc >> m_pcShift) % m_btb.size(); }
+
+    BranchPredictorConfig m_config;
+    std::unique_ptr<DirectionPredictor> m_direction;
+    unsigned m_pcShift = 0;
+    unsigned m_penalty = 0;
+    unsigned m_instrBytes = 4;
+
+    std::vector<BTBEntry> m_btb;
+
+    /**
+     * @brief m_ras
+     * Circular return address stack; when full, a push overwrites the oldest entry.
+     */
+    std::vector<AInt> m_ras;
+    unsigned m_rasTop = 0;  // Index of the next entry to push
+    unsigned m_rasSize = 0;
+
+    /**
+     * @brief m_predictions
+     * Ring buffer of the predictions of the most recently fetched instructions, indexed by fetch sequence number. The
+     * m_predictionCount predictions preceding m_fetchSeq are valid.
+     */
+    std::vector<Prediction> m_predictions;
+    uint64_t m_fetchSeq = 0;
+    unsigned m_predictionCount = 0;
+    bool m_hasLastFetch = false;
+    AInt m_lastFetch = 0;
+    uint64_t m_cycle = 0;
+
+    /**
+     * @brief m_statsLock
+     * Guards m_stats and m_pcStats, which are written by the simulator thread and read by the GUI thread.
+     */
+    mutable std::mutex m_statsLock;
+    Stats m_stats;
+    std::map<AInt, PCStats> m_pcStats;
+
+    /**
+     * @brief m_undo
+     * Ring buffer of the undo records of the most recent cycles.
+     */
+    std::vector<Undo> m_undo;
+    unsigned m_undoHead = 0;
+    unsigned m_undoSize = 0;
+};
+
+}  // namespace Ripes
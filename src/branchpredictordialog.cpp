@@ -0,0 +1,199 @@
+#include "branchpredictordialog.h"
+
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+#include "branchpredictor.h"
+#include "processorhandler.h"
+#include "radix.h"
+
+namespace Ripes {
+
+BranchPredictorDialog::BranchPredictorDialog(BranchPredictor& predictor, QWidget* parent)
+    : QDialog(parent), m_predictor(predictor) {
+    setWindowTitle("Branch predictor");
+
+    auto* configGroup = new QGroupBox("Predictor", this);
+    auto* configLayout = new QFormLayout(configGroup);
+    m_type = new QComboBox(this);
+    for (auto type : {DirectionPredictorType::NotTaken, DirectionPredictorType::StaticBTFN,
+                      DirectionPredictorType::Bimodal, DirectionPredictorType::GShare}) {
+        m_type->addItem(BranchPredictor::typeName(type), QVariant::fromValue(static_cast<int>(type)));
+    }
+    m_type->setToolTip("Predictor of the direction of conditional branches");
+    m_tableEntries = new QSpinBox(this);
+    m_tableEntries->setRange(1, 1 << 16);
+    m_historyBits = new QSpinBox(this);
+    m_historyBits->setRange(1, 16);
+    m_btbEntries = new QSpinBox(this);
+    m_btbEntries->setRange(0, 1 << 16);
+    m_btbEntries->setToolTip("Control flow instructions which are not held in the BTB are predicted not taken.");
+    m_rasEntries = new QSpinBox(this);
+    m_rasEntries->setRange(0, 64);
+    configLayout->addRow("Direction predictor:", m_type);
+    configLayout->addRow("Pattern history table entries:", m_tableEntries);
+    configLayout->addRow("Global history bits:", m_historyBits);
+    configLayout->addRow("BTB entries:", m_btbEntries);
+    configLayout->addRow("Return address stack entries:", m_rasEntries);
+    auto* applyButton = new QPushButton("Apply", this);
+    applyButton->setToolTip("Apply the configuration. The processor is reset.");
+    configLayout->addRow(applyButton);
+    connect(applyButton, &QPushButton::clicked, this, &BranchPredictorDialog::applyConfig);
+    connect(m_type, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &BranchPredictorDialog::updateConfigWidgets);
+
+    m_info = new QLabel(this);
+    m_info->setWordWrap(true);
+
+    m_table = new QTableWidget(this);
+    m_table->setColumnCount(7);
+    m_table->setHorizontalHeaderLabels(
+        {"Address", "Instruction", "Kind", "Executed", "Taken", "Mispredicted", "Accuracy (%)"});
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    auto* exportButton = buttons->addButton("Export...", QDialogButtonBox::ActionRole);
+    exportButton->setToolTip("Export the predictions of each control flow instruction as comma-separated values.");
+    connect(exportButton, &QPushButton::clicked, this, &BranchPredictorDialog::exportCSV);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(configGroup);
+    layout->addWidget(m_info);
+    layout->addWidget(m_table);
+    layout->addWidget(buttons);
+    resize(800, 650);
+
+    setupConfigWidgets();
+    updateStats();
+    connect(&m_predictor, &BranchPredictor::predictorReset, this, &BranchPredictorDialog::updateStats);
+}
+
+void BranchPredictorDialog::setupConfigWidgets() {
+    const auto& config = m_predictor.getConfig();
+    m_type->setCurrentIndex(m_type->findData(static_cast<int>(config.type)));
+    m_tableEntries->setValue(config.tableEntries);
+    m_historyBits->setValue(config.historyBits);
+    m_btbEntries->setValue(config.btbEntries);
+    m_rasEntries->setValue(config.rasEntries);
+    updateConfigWidgets();
+}
+
+void BranchPredictorDialog::updateConfigWidgets() {
+    const auto type = static_cast<DirectionPredictorType>(m_type->currentData().toInt());
+    m_tableEntries->setEnabled(type == DirectionPredictorType::Bimodal || type == DirectionPredictorType::GShare);
+    m_historyBits->setEnabled(type == DirectionPredictorType::GShare);
+}
+
+void BranchPredictorDialog::applyConfig() {
+    BranchPredictorConfig config;
+    config.type = static_cast<DirectionPredictorType>(m_type->currentData().toInt());
+    config.tableEntries = m_tableEntries->value();
+    config.historyBits = m_historyBits->value();
+    config.btbEntries = m_btbEntries->value();
+    config.rasEntries = m_rasEntries->value();
+    m_predictor.setConfig(config);
+}
+
+void BranchPredictorDialog::updateStats() {
+    const auto totals = m_predictor.getStats();
+    const auto* processor = ProcessorHandler::getProcessor();
+    if (m_predictor.penalty() == 0) {
+        m_info->setText("The current processor does not flush its pipeline on control flow; select a pipelined "
+                        "processor to evaluate the predictor.");
+    } else {
+        // Cycles are accounted for as in the processor tab
+        const bool hasMemoryStalls = processor->features() & RipesProcessor::Features::hasMemoryStalls;
+        const long long cycles = processor->getCycleCount() + (hasMemoryStalls ? 0 : processor->getMemoryStallCycles());
+        const long long instructions = processor->getInstructionsRetired();
+        const long long predictedCycles = std::max(0LL, cycles - m_predictor.savedCycles());
+        QString info =
+            QString("%1 control flow instructions resolved, %2 taken. %3 mispredicted (%4% accuracy), of which %5 "
+                    "to the wrong target.\n")
+                .arg(totals.resolved)
+                .arg(totals.taken)
+                .arg(totals.mispredicted)
+                .arg(100.0 * totals.accuracy(), 0, 'f', 1)
+                .arg(totals.targetMispredicted);
+        info += QString("The simulated processor does not predict control flow, and each taken control flow "
+                        "instruction costs it %1 cycles. Had it only lost these cycles to mispredicted instructions, "
+                        "it would have spent an estimated %2 cycles rather than the simulated %3")
+                    .arg(m_predictor.penalty())
+                    .arg(predictedCycles)
+                    .arg(cycles);
+        if (instructions != 0) {
+            info += QString(" (estimated CPI %1 rather than the simulated CPI %2)")
+                        .arg(static_cast<double>(predictedCycles) / instructions, 0, 'f', 3)
+                        .arg(static_cast<double>(cycles) / instructions, 0, 'f', 3);
+        }
+        m_info->setText(info + ".");
+    }
+
+    // Numeric items are stored as display role values such that the table sorts them numerically.
+    const auto numberItem = [](const QVariant& value) {
+        auto* item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+
+    const unsigned addrWidth = ProcessorHandler::currentISA()->bytes();
+    const auto pcStats = m_predictor.getPCStats();
+    m_table->setSortingEnabled(false);
+    m_table->clearContents();
+    m_table->setRowCount(pcStats.size());
+    int row = 0;
+    for (const auto& [pc, stats] : pcStats) {
+        m_table->setItem(row, 0, new QTableWidgetItem(encodeRadixValue(pc, Radix::Hex, addrWidth)));
+        m_table->setItem(row, 1, new QTableWidgetItem(ProcessorHandler::disassembleInstr(pc)));
+        m_table->setItem(row, 2, new QTableWidgetItem(BranchPredictor::kindName(stats.kind)));
+        m_table->setItem(row, 3, numberItem(static_cast<qulonglong>(stats.executed)));
+        m_table->setItem(row, 4, numberItem(static_cast<qulonglong>(stats.taken)));
+        m_table->setItem(row, 5, numberItem(static_cast<qulonglong>(stats.mispredicted)));
+        m_table->setItem(row, 6, numberItem(std::round(stats.accuracy() * 10000) / 100));
+        row++;
+    }
+    m_table->setSortingEnabled(true);
+    m_table->sortByColumn(5, Qt::DescendingOrder);
+}
+
+void BranchPredictorDialog::exportCSV() {
+    const QString filename =
+        QFileDialog::getSaveFileName(this, "Export branch predictions", "", "CSV files (*.csv);;All files (*)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Error", "Could not write branch predictions to '" + filename + "'");
+        return;
+    }
+
+    QTextStream out(&file);
+    out << "# Predictor: " << BranchPredictor::typeName(m_predictor.getConfig().type) << "\n";
+    out << "address,kind,executed,taken,mispredicted\n";
+    const auto pcStats = m_predictor.getPCStats();
+    for (const auto& [pc, stats] : pcStats) {
+        out << "0x" << QString::number(pc, 16) << "," << BranchPredictor::kindName(stats.kind) << "," << stats.executed
+            << "," << stats.taken << "," << stats.mispredicted << "\n";
+    }
+}
+
+}  // namespace Ripes
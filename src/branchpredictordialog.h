@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QDialog>
+
+QT_FORWARD_DECLARE_CLASS(QComboBox)
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QSpinBox)
+QT_FORWARD_DECLARE_CLASS(QTableWidget)
+
+namespace Ripes {
+
+class BranchPredictor;
+
+/**
+ * @brief The BranchPredictorDialog class
+ * Configures the branch predictor model of the processor tab, and shows its prediction accuracy per control flow
+ * instruction alongside the estimated cycles which the processor would have saved through the predictor.
+ */
+class BranchPredictorDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    BranchPredictorDialog(BranchPredictor& predictor, QWidget* parent = nullptr);
+
+private:
+    void setupConfigWidgets();
+    void updateConfigWidgets();
+    void applyConfig();
+    void updateStats();
+    void exportCSV();
+
+    BranchPredictor& m_predictor;
+
+    QComboBox* m_type = nullptr;
+    QSpinBox* m_tableEntries = nullptr;
+    QSpinBox* m_historyBits = nullptr;
+    QSpinBox* m_btbEntries = nullptr;
+    QSpinBox* m_rasEntries = nullptr;
+
+    QLabel* m_info = nullptr;
+    QTableWidget* m_table = nullptr;
+};
+
+}  // namespace Ripes
@@ -0,0 +1,161 @@
+#include "cachebatchsim.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace Ripes {
+
+bool CacheBatchSim::canBatch(const CachePreset& preset) {
+    return preset.replPolicy == ReplPolicy::LRU;
+}
+
+bool CacheBatchSim::isCompatible(const CachePreset& a, const CachePreset& b) {
+    return a.lines == b.lines && a.blocks == b.blocks;
+}
+
+CacheBatchSim::CacheBatchSim(const std::vector<CachePreset>& presets, unsigned wordBytes) {
+    Q_ASSERT(!presets.empty() && presets.size() <= s_lanes);
+    m_geometry.setWordSize(wordBytes);
+    m_geometry.setPreset(presets.front());
+    m_lanes = presets.size();
+
+    for (unsigned lane = 0; lane < m_lanes; ++lane) {
+        const auto& preset = presets.at(lane);
+        Q_ASSERT(canBatch(preset) && isCompatible(preset, presets.front()));
+        m_ways[lane] = 1 << preset.ways;
+        m_writeBack[lane] = preset.wrPolicy == WritePolicy::WriteBack;
+        m_writeAllocate[lane] = preset.wrAllocPolicy == WriteAllocPolicy::WriteAllocate;
+        m_maxWaysBits = std::max<unsigned>(m_maxWaysBits, preset.ways);
+    }
+
+    const unsigned entries = m_geometry.getLines() << m_maxWaysBits;
+    m_tags.resize(entries);
+    m_stamps.resize(entries);
+    m_dirty.resize(entries);
+}
+
+void CacheBatchSim::renumberStamps() {
+    // Replace the stamps of the valid ways of each line by their recency order within the line, which is all that is
+    // required for selecting the least recently used way.
+    const unsigned ways = 1 << m_maxWaysBits;
+    std::vector<std::pair<int32_t, unsigned>> order;
+    for (unsigned base = 0; base < m_stamps.size(); base += ways) {
+        for (unsigned lane = 0; lane < s_lanes; ++lane) {
+            order.clear();
+            for (unsigned wayIdx = 0; wayIdx < ways; ++wayIdx) {
+                if (m_stamps[base + wayIdx][lane] != 0) {
+                    order.push_back({m_stamps[base + wayIdx][lane], wayIdx});
+                }
+            }
+            std::sort(order.begin(), order.end());
+            for (unsigned i = 0; i < order.size(); ++i) {
+                m_stamps[base + order[i].second][lane] = i + 1;
+            }
+        }
+    }
+    m_stamp = ways;
+}
+
+void CacheBatchSim::findWaysScalar(unsigned base, uint32_t tag, Lanes<int32_t>& hitWay,
+                                   Lanes<int32_t>& evictWay) const {
+    Lanes<int32_t> evictStamp;
+    hitWay.fill(0);
+    evictWay.fill(0);
+    evictStamp.fill(INT32_MAX);
+    for (int32_t wayIdx = 0; wayIdx < (1 << m_maxWaysBits); ++wayIdx) {
+        const auto& tags = m_tags[base + wayIdx];
+        const auto& stamps = m_stamps[base + wayIdx];
+        for (unsigned lane = 0; lane < s_lanes; ++lane) {
+            hitWay[lane] += (tags[lane] == tag && stamps[lane] != 0) ? wayIdx + 1 : 0;
+            const int32_t stamp = wayIdx < m_ways[lane] ? stamps[lane] : INT32_MAX;
+            if (stamp < evictStamp[lane]) {
+                evictStamp[lane] = stamp;
+                evictWay[lane] = wayIdx;
+            }
+        }
+    }
+}
+
+#ifdef RIPES_CACHEBATCH_SSE2
+void CacheBatchSim::findWaysSSE2(unsigned base, uint32_t tag, Lanes<int32_t>& hitWay, Lanes<int32_t>& evictWay) const {
+    // Each way is compared across 2x4 lanes. Only a single way may hit, such that the hitting way is or'ed together.
+    const __m128i tagv = _mm_set1_epi32(static_cast<int32_t>(tag));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maxStamp = _mm_set1_epi32(INT32_MAX);
+    __m128i hits[2] = {zero, zero};
+    __m128i evicts[2] = {zero, zero};
+    __m128i evictStamps[2] = {maxStamp, maxStamp};
+    for (int32_t wayIdx = 0; wayIdx < (1 << m_maxWaysBits); ++wayIdx) {
+        const __m128i way = _mm_set1_epi32(wayIdx);
+        const __m128i wayPlusOne = _mm_set1_epi32(wayIdx + 1);
+        for (unsigned half = 0; half < 2; ++half) {
+            const unsigned lane = 4 * half;
+            const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_tags[base + wayIdx][lane]));
+            const __m128i stamps = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_stamps[base + wayIdx][lane]));
+            const __m128i ways = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_ways[lane]));
+
+            const __m128i match = _mm_andnot_si128(_mm_cmpeq_epi32(stamps, zero), _mm_cmpeq_epi32(tags, tagv));
+            hits[half] = _mm_or_si128(hits[half], _mm_and_si128(match, wayPlusOne));
+
+            const __m128i inRange = _mm_cmplt_epi32(way, ways);
+            const __m128i stamp = _mm_or_si128(_mm_and_si128(inRange, stamps), _mm_andnot_si128(inRange, maxStamp));
+            const __m128i older = _mm_cmplt_epi32(stamp, evictStamps[half]);
+            evictStamps[half] = _mm_or_si128(_mm_and_si128(older, stamp), _mm_andnot_si128(older, evictStamps[half]));
+            evicts[half] = _mm_or_si128(_mm_and_si128(older, way), _mm_andnot_si128(older, evicts[half]));
+        }
+    }
+    for (unsigned half = 0; half < 2; ++half) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&hitWay[4 * half]), hits[half]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&evictWay[4 * half]), evicts[half]);
+    }
+}
+#endif
+
+void CacheBatchSim::access(AInt address, MemoryAccess::Type type) {
+    address = address & ~0b11;  // Disregard unaligned accesses, as CacheCore
+    const unsigned lineIdx = m_geometry.getLineIdx(address);
+    const uint32_t tag = m_geometry.getTag(address);
+    const bool isWrite = type == MemoryAccess::Write;
+    const unsigned base = entryIdx(lineIdx, 0);
+    if (m_stamp == INT32_MAX - 1) {
+        renumberStamps();
+    }
+    m_stamp++;
+
+    Lanes<int32_t> hitWay;
+    Lanes<int32_t> evictWay;
+#ifdef RIPES_CACHEBATCH_SSE2
+    if (m_vectorized) {
+        findWaysSSE2(base, tag, hitWay, evictWay);
+    } else {
+        findWaysScalar(base, tag, hitWay, evictWay);
+    }
+#else
+    findWaysScalar(base, tag, hitWay, evictWay);
+#endif
+
+    // Update the accessed way of each lane, following the semantics of CacheCore::access.
+    for (unsigned lane = 0; lane < m_lanes; ++lane) {
+        const bool hit = hitWay[lane] != 0;
+        const bool allocate = !isWrite || m_writeAllocate[lane];
+
+        // Writes which are not retained in the cache are written through to memory.
+        bool writeback = isWrite && (!m_writeBack[lane] || (!hit && !allocate));
+        if (hit || allocate) {
+            const unsigned entry = base + (hit ? hitWay[lane] - 1 : evictWay[lane]);
+            if (!hit) {
+                writeback |= m_stamps[entry][lane] != 0 && m_dirty[entry][lane];
+                m_tags[entry][lane] = tag;
+                m_dirty[entry][lane] = false;
+            }
+            m_dirty[entry][lane] |= isWrite && m_writeBack[lane];
+            m_stamps[entry][lane] = m_stamp;
+        }
+
+        m_hits[lane] += hit ? 1 : 0;
+        m_misses[lane] += hit ? 0 : 1;
+        m_writebacks[lane] += writeback ? 1 : 0;
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "cachecore.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIPES_CACHEBATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Ripes {
+
+/**
+ * @brief The CacheBatchSim class
+ * Simulates up to s_lanes cache configurations in lockstep over a single access stream, producing the same access
+ * statistics as simulating each configuration through a separate CacheCore. Used for design-space exploration, wherein
+ * the access stream is otherwise decoded and traversed once per configuration.
+ *
+ * The configurations of a batch must be LRU replaced and share their line and block geometry, but may differ in
+ * associativity and write policies. Given the shared geometry, the line index and tag of an access are identical for
+ * all configurations. The cache state is stored with the configurations (lanes) as the innermost dimension, such that
+ * the tag comparison and victim selection for a way of the accessed line are performed across all lanes at once using
+ * SSE2 instructions, where available. Otherwise, a scalar implementation with identical results is used. Ways beyond
+ * the associativity of a lane are never valid nor selected for eviction.
+ */
+class CacheBatchSim {
+public:
+    static constexpr unsigned s_lanes = 8;
+
+    /**
+     * @brief canBatch
+     * @returns true if @p preset may be simulated by a batch simulator.
+     */
+    static bool canBatch(const CachePreset& preset);
+
+    /**
+     * @brief isCompatible
+     * @returns true if the batchable presets @p a and @p b may be simulated within the same batch.
+     */
+    static bool isCompatible(const CachePreset& a, const CachePreset& b);
+
+    /**
+     * @param presets: at most s_lanes batchable and mutually compatible presets.
+     * @param wordBytes: the number of bytes in a word of the simulated processor.
+     */
+    CacheBatchSim(const std::vector<CachePreset>& presets, unsigned wordBytes);
+
+    void access(AInt address, MemoryAccess::Type type);
+
+    /**
+     * @brief setVectorized
+     * Selects the SSE2 (@p vectorized) or the scalar implementation of the way search, if SSE2 is available. Both
+     * implementations produce identical results; the scalar implementation may be selected for verifying the SSE2
+     * implementation.
+     */
+    void setVectorized(bool vectorized) { m_vectorized = vectorized; }
+
+    unsigned lanes() const { return m_lanes; }
+    unsigned getHits(unsigned lane) const { return m_hits[lane]; }
+    unsigned getMisses(unsigned lane) const { return m_misses[lane]; }
+    unsigned getWritebacks(unsigned lane) const { return m_writebacks[lane]; }
+
+private:
+    template <typename T>
+    using Lanes = std::array<T, s_lanes>;
+
+    unsigned entryIdx(unsigned lineIdx, unsigned wayIdx) const { return (lineIdx << m_maxWaysBits) + wayIdx; }
+
+    /**
+     * @brief findWaysScalar, findWaysSSE2
+     * Locates the way hitting @p tag (1-indexed; 0 indicates a miss) and the way to evict in each lane, among the ways
+     * of the line starting at entry @p base. The way to evict is the first invalid way of the lane or else the least
+     * recently used way; invalid ways have a stamp of 0, and ways beyond the associativity of the lane are never
+     * selected.
+     */
+    void findWaysScalar(unsigned base, uint32_t tag, Lanes<int32_t>& hitWay, Lanes<int32_t>& evictWay) const;
+#ifdef RIPES_CACHEBATCH_SSE2
+    void findWaysSSE2(unsigned base, uint32_t tag, Lanes<int32_t>& hitWay, Lanes<int32_t>& evictWay) const;
+#endif
+
+    /**
+     * @brief renumberStamps
+     * Renumbers the stamps of all entries, retaining their order, once m_stamp is about to overflow.
+     */
+    void renumberStamps();
+
+    /**
+     * @brief m_geometry
+     * Cache configured with the shared geometry of the batch; provides the line index and tag of an address, as
+     * determined by CacheCore.
+     */
+    CacheCore m_geometry;
+    unsigned m_lanes = 0;
+    unsigned m_maxWaysBits = 0;
+    bool m_vectorized = true;
+
+    // Per-lane configuration. Unused lanes have no ways.
+    Lanes<int32_t> m_ways{};
+    Lanes<uint8_t> m_writeBack{};
+    Lanes<uint8_t> m_writeAllocate{};
+
+    /**
+     * @brief Cache state
+     * Per-entry state of each lane, with entries stored line-major (see entryIdx()). An entry is valid if its stamp is
+     * non-zero, in which case the stamp is the value of m_stamp at the most recent access to the entry.
+     */
+    std::vector<Lanes<uint32_t>> m_tags;
+    std::vector<Lanes<int32_t>> m_stamps;
+    std::vector<Lanes<uint8_t>> m_dirty;
+    int32_t m_stamp = 0;
+
+    Lanes<unsigned> m_hits{};
+    Lanes<unsigned> m_misses{};
+    Lanes<unsigned> m_writebacks{};
+};
+
+}  // namespace Ripes
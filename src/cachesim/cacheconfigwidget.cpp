@@ -9,6 +9,7 @@
 #include <QtCharts/QChartView>
 
 #include "cacheplotwidget.h"
+#include "cachereplaydialog.h"
 #include "enumcombobox.h"
 #include "ripessettings.h"
 
@@ -18,8 +19,8 @@ CacheConfigWidget::CacheConfigWidget(QWidget* parent) : QWidget(parent), m_ui(ne
     m_ui->setupUi(this);
 
     // Gather a list of all items in this widget which will trigger a modification to the current configuration
-    m_configItems = {m_ui->presets,           m_ui->ways,   m_ui->lines, m_ui->blocks,
-                     m_ui->replacementPolicy, m_ui->wrMiss, m_ui->wrHit};
+    m_configItems = {m_ui->presets, m_ui->ways,  m_ui->lines,      m_ui->blocks,     m_ui->replacementPolicy,
+                     m_ui->wrMiss,  m_ui->wrHit, m_ui->prefetcher, m_ui->writeBuffer};
 }
 
 void CacheConfigWidget::setCache(const std::shared_ptr<CacheSim>& cache) {
@@ -28,6 +29,7 @@ void CacheConfigWidget::setCache(const std::shared_ptr<CacheSim>& cache) {
     setupEnumCombobox(m_ui->replacementPolicy, s_cacheReplPolicyStrings);
     setupEnumCombobox(m_ui->wrHit, s_cacheWritePolicyStrings);
     setupEnumCombobox(m_ui->wrMiss, s_cacheWriteAllocateStrings);
+    setupEnumCombobox(m_ui->prefetcher, s_cachePrefetcherStrings);
 
     m_ui->ways->setValue(m_cache->getWaysBits());
     m_ui->lines->setValue(m_cache->getLineBits());
@@ -37,6 +39,13 @@ void CacheConfigWidget::setCache(const std::shared_ptr<CacheSim>& cache) {
     connect(m_ui->blocks, QOverload<int>::of(&QSpinBox::valueChanged), m_cache.get(), &CacheSim::setBlocks);
     connect(m_ui->lines, QOverload<int>::of(&QSpinBox::valueChanged), m_cache.get(), &CacheSim::setLines);
 
+    // Latencies do not affect the cache configuration, and are thus not part of cache presets.
+    m_ui->hitLatency->setValue(m_cache->getHitLatency());
+    m_ui->missLatency->setValue(m_cache->getMissLatency());
+    const auto setLatencies = [=] { m_cache->setLatencies(m_ui->hitLatency->value(), m_ui->missLatency->value()); };
+    connect(m_ui->hitLatency, QOverload<int>::of(&QSpinBox::valueChanged), m_cache.get(), setLatencies);
+    connect(m_ui->missLatency, QOverload<int>::of(&QSpinBox::valueChanged), m_cache.get(), setLatencies);
+
     connect(m_ui->replacementPolicy, QOverload<int>::of(&QComboBox::currentIndexChanged), cache.get(), [=](int index) {
         m_cache->setReplacementPolicy(qvariant_cast<ReplPolicy>(m_ui->replacementPolicy->itemData(index)));
     });
@@ -45,12 +54,24 @@ void CacheConfigWidget::setCache(const std::shared_ptr<CacheSim>& cache) {
     connect(m_ui->wrMiss, QOverload<int>::of(&QComboBox::currentIndexChanged), cache.get(), [=](int index) {
         m_cache->setWriteAllocatePolicy(qvariant_cast<WriteAllocPolicy>(m_ui->wrMiss->itemData(index)));
     });
+    // Prefetchers and write buffers are attached to the cache rather than being part of its configuration, and are thus
+    // not part of cache presets.
+    connect(m_ui->prefetcher, QOverload<int>::of(&QComboBox::currentIndexChanged), cache.get(), [=](int index) {
+        m_cache->setPrefetcher(qvariant_cast<PrefetcherType>(m_ui->prefetcher->itemData(index)));
+    });
+    m_ui->writeBuffer->setMaximum(CacheSim::s_maxWriteBufferSize);
+    connect(m_ui->writeBuffer, QOverload<int>::of(&QSpinBox::valueChanged), m_cache.get(),
+            &CacheSim::setWriteBufferSize);
     connect(m_ui->savePresetButton, &QPushButton::clicked, this, &CacheConfigWidget::storePreset);
     m_ui->savePresetButton->setIcon(QIcon(":/icons/save.svg"));
     m_ui->savePresetButton->setToolTip("Store cache preset");
     connect(m_ui->removePresetButton, &QPushButton::clicked, this, &CacheConfigWidget::removePreset);
     m_ui->removePresetButton->setIcon(QIcon(":/icons/delete.svg"));
     m_ui->removePresetButton->setToolTip("Delete cache preset");
+    connect(m_ui->comparePresetsButton, &QPushButton::clicked, this, &CacheConfigWidget::comparePresets);
+    m_ui->comparePresetsButton->setIcon(QIcon(":/icons/spreadsheet.svg"));
+    m_ui->comparePresetsButton->setToolTip("Compare cache presets on the current memory trace");
+    m_ui->comparePresetsButton->setEnabled(m_memoryTrace != nullptr);
 
     connect(m_cache.get(), &CacheSim::configurationChanged, this, &CacheConfigWidget::handleConfigurationChanged);
     connect(m_cache.get(), &CacheSim::configurationChanged, this, [=] { emit configurationChanged(); });
@@ -81,6 +102,19 @@ void CacheConfigWidget::storePreset() {
     }
 }
 
+void CacheConfigWidget::setMemoryTrace(const MemoryTrace* trace) {
+    m_memoryTrace = trace;
+    m_ui->comparePresetsButton->setEnabled(m_memoryTrace != nullptr);
+}
+
+void CacheConfigWidget::comparePresets() {
+    if (!m_memoryTrace) {
+        return;
+    }
+    CacheReplayDialog dialog(*m_memoryTrace, this);
+    dialog.exec();
+}
+
 void CacheConfigWidget::removePreset() {
     auto presetData = m_ui->presets->currentData();
     if (presetData.isNull()) {
@@ -127,6 +161,8 @@ void CacheConfigWidget::handleConfigurationChanged() {
     setEnumIndex(m_ui->wrHit, m_cache->getWritePolicy());
     setEnumIndex(m_ui->wrMiss, m_cache->getWriteAllocPolicy());
     setEnumIndex(m_ui->replacementPolicy, m_cache->getReplacementPolicy());
+    setEnumIndex(m_ui->prefetcher, m_cache->getPrefetcherType());
+    m_ui->writeBuffer->setValue(m_cache->getWriteBufferSize());
 
     if (!m_justSetPreset) {
         m_ui->presets->setCurrentIndex(-1);
@@ -2,6 +2,7 @@
 
 #include <QWidget>
 #include "cachesim.h"
+#include "memorytrace.h"
 
 namespace Ripes {
 
@@ -18,6 +19,12 @@ public:
 
     void setCache(const std::shared_ptr<CacheSim>& cache);
 
+    /**
+     * @brief setMemoryTrace
+     * Sets the memory trace of the accesses into the cache, enabling comparison of the cache presets on the trace.
+     */
+    void setMemoryTrace(const MemoryTrace* trace);
+
 signals:
     void configurationChanged();
 
@@ -28,10 +35,12 @@ private:
     void setupPresets();
     void showSizeBreakdown();
     std::shared_ptr<CacheSim> m_cache;
+    const MemoryTrace* m_memoryTrace = nullptr;
     Ui::CacheConfigWidget* m_ui = nullptr;
     std::vector<QObject*> m_configItems;
     void storePreset();
     void removePreset();
+    void comparePresets();
 
     /**
      * @brief m_justSetPreset
@@ -48,4 +57,6 @@ private:
 Q_DECLARE_METATYPE(Ripes::WritePolicy);
 Q_DECLARE_METATYPE(Ripes::WriteAllocPolicy);
 Q_DECLARE_METATYPE(Ripes::ReplPolicy);
+Q_DECLARE_METATYPE(Ripes::InclusionPolicy);
+Q_DECLARE_METATYPE(Ripes::PrefetcherType);
 Q_DECLARE_METATYPE(Ripes::CachePreset);
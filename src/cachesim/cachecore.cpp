@@ -0,0 +1,1205 @@
+#include "cachecore.h"
+#include "binutils.h"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <random>
+#include <utility>
+
+namespace Ripes {
+
+CacheCore::CacheCore() {
+    recalculateMasks();
+    reinitializeState();
+}
+
+CacheCore::~CacheCore() {
+    setNextLevel(nullptr);
+    for (auto* prevLevel : m_prevLevels) {
+        prevLevel->m_nextLevel = nullptr;
+    }
+}
+
+void CacheCore::setNextLevel(CacheCore* cache) {
+    if (m_nextLevel) {
+        auto& prevLevels = m_nextLevel->m_prevLevels;
+        prevLevels.erase(std::remove(prevLevels.begin(), prevLevels.end(), this), prevLevels.end());
+    }
+    m_nextLevel = cache;
+    if (m_nextLevel) {
+        m_nextLevel->m_prevLevels.push_back(this);
+    }
+}
+
+void CacheCore::setWordSize(unsigned bytes) {
+    m_byteOffset = log2Ceil(bytes);
+    m_wordBits = bytes * CHAR_BIT;
+}
+
+void CacheCore::setTextSection(AInt start, AInt bytes, unsigned instrAlignment) {
+    m_pcBase = start;
+    m_textBytes = bytes;
+    m_pcShift = log2Ceil(std::max(1u, instrAlignment));
+}
+
+void CacheCore::unlinkWay(unsigned lineIdx, unsigned wayIdx) {
+    const ReplLink link = m_replLinks[entryIdx(lineIdx, wayIdx)];
+    ReplList& list = m_replLists[lineIdx];
+    (link.prev == s_noWay ? list.head : m_replLinks[entryIdx(lineIdx, link.prev)].next) = link.next;
+    (link.next == s_noWay ? list.tail : m_replLinks[entryIdx(lineIdx, link.next)].prev) = link.prev;
+}
+
+void CacheCore::linkWay(unsigned lineIdx, unsigned wayIdx, unsigned nextIdx) {
+    ReplList& list = m_replLists[lineIdx];
+    ReplLink& link = m_replLinks[entryIdx(lineIdx, wayIdx)];
+    link.next = nextIdx;
+    link.prev = nextIdx == s_noWay ? list.tail : m_replLinks[entryIdx(lineIdx, nextIdx)].prev;
+    (link.prev == s_noWay ? list.head : m_replLinks[entryIdx(lineIdx, link.prev)].next) = wayIdx;
+    (nextIdx == s_noWay ? list.tail : m_replLinks[entryIdx(lineIdx, nextIdx)].prev) = wayIdx;
+}
+
+namespace {
+
+bool testBit(const uint64_t* bits, unsigned idx) {
+    return (bits[idx / 64] >> (idx % 64)) & 1;
+}
+
+void assignBit(uint64_t* bits, unsigned idx, bool value) {
+    const uint64_t mask = uint64_t(1) << (idx % 64);
+    bits[idx / 64] = value ? bits[idx / 64] | mask : bits[idx / 64] & ~mask;
+}
+
+/**
+ * @brief findBit
+ * @returns the index of the first bit in the @p words words of @p bits which is equal to @p value, or -1 if none.
+ */
+int findBit(const uint64_t* bits, unsigned words, bool value) {
+    for (unsigned i = 0; i < words; ++i) {
+        const uint64_t word = value ? bits[i] : ~bits[i];
+        if (word != 0) {
+            return i * 64 + countTrailingZeros(word);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief shiftBitmasks
+ * Moves the contents of each of the 4 SRRIP bitmasks in @p bits @p shift bitmasks up (positive) or down (negative),
+ * clearing the bitmasks which are vacated.
+ */
+void shiftBitmasks(uint64_t* bits, unsigned words, int shift) {
+    uint64_t shifted[4 * 16];  // Caches have at most 2^10 ways, i.e., 16 words per bitmask.
+    for (int rrpv = 0; rrpv < 4; ++rrpv) {
+        const int from = rrpv - shift;
+        for (unsigned i = 0; i < words; ++i) {
+            shifted[rrpv * words + i] = from >= 0 && from < 4 ? bits[from * words + i] : 0;
+        }
+    }
+    std::copy_n(shifted, 4 * words, bits);
+}
+
+}  // namespace
+
+uint32_t CacheCore::updateReplState(unsigned lineIdx, unsigned wayIdx, ReplUpdate update) {
+    uint32_t undo = 0;
+    switch (m_replPolicy) {
+        case ReplPolicy::Random: {
+            m_randomReplacements += update == ReplUpdate::Replace ? 1 : 0;
+            break;
+        }
+        case ReplPolicy::FIFO:
+        case ReplPolicy::LRU: {
+            // Move the way to the front of the list. FIFO ordering only changes when a way is (re)filled.
+            if (m_replPolicy == ReplPolicy::FIFO && update == ReplUpdate::Hit) {
+                break;
+            }
+            undo = m_replLinks[entryIdx(lineIdx, wayIdx)].next;
+            unlinkWay(lineIdx, wayIdx);
+            linkWay(lineIdx, wayIdx, m_replLists[lineIdx].head);
+            break;
+        }
+        case ReplPolicy::TreePLRU: {
+            // Point all nodes on the path from the root to the way away from the way. The previous node values are
+            // recorded from the leaf and upwards.
+            uint64_t* bits = replBits(lineIdx);
+            unsigned level = 0;
+            for (unsigned node = getWays() + wayIdx; node > 1; node >>= 1, ++level) {
+                undo |= static_cast<uint32_t>(testBit(bits, node >> 1)) << level;
+                assignBit(bits, node >> 1, !(node & 1));
+            }
+            break;
+        }
+        case ReplPolicy::BitPLRU: {
+            uint64_t* bits = replBits(lineIdx);
+            undo = testBit(bits, wayIdx);
+            assignBit(bits, wayIdx, true);
+            const int unaccessed = findBit(bits, m_replWords, false);
+            if (unaccessed == -1 || unaccessed >= getWays()) {
+                // All ways have been accessed; start a new epoch.
+                std::fill_n(bits, m_replWords, 0);
+                assignBit(bits, wayIdx, true);
+                undo |= 0b10;
+            }
+            break;
+        }
+        case ReplPolicy::SRRIP: {
+            uint64_t* bits = replBits(lineIdx);
+            unsigned rrpv = 0;
+            while (!testBit(bits + rrpv * m_replWords, wayIdx)) {
+                rrpv++;
+            }
+            // A replaced way holds the largest prediction value of the line. All ways are aged such that this value
+            // becomes the maximum (distant re-reference) value.
+            const unsigned aging = update == ReplUpdate::Replace ? 3 - rrpv : 0;
+            shiftBitmasks(bits, m_replWords, aging);
+            rrpv += aging;
+
+            // Hits are predicted to be re-referenced in the near future; new blocks in the long-term future.
+            assignBit(bits + rrpv * m_replWords, wayIdx, false);
+            assignBit(bits + (update == ReplUpdate::Hit ? 0 : 2) * m_replWords, wayIdx, true);
+            undo = rrpv | aging << 2;
+            break;
+        }
+    }
+    return undo;
+}
+
+void CacheCore::revertReplState(unsigned lineIdx, unsigned wayIdx, ReplUpdate update, uint32_t undo) {
+    switch (m_replPolicy) {
+        case ReplPolicy::Random: {
+            m_randomReplacements -= update == ReplUpdate::Replace ? 1 : 0;
+            break;
+        }
+        case ReplPolicy::FIFO:
+        case ReplPolicy::LRU: {
+            if (m_replPolicy == ReplPolicy::FIFO && update == ReplUpdate::Hit) {
+                break;
+            }
+            unlinkWay(lineIdx, wayIdx);
+            linkWay(lineIdx, wayIdx, undo);
+            break;
+        }
+        case ReplPolicy::TreePLRU: {
+            uint64_t* bits = replBits(lineIdx);
+            unsigned level = 0;
+            for (unsigned node = getWays() + wayIdx; node > 1; node >>= 1, ++level) {
+                assignBit(bits, node >> 1, (undo >> level) & 1);
+            }
+            break;
+        }
+        case ReplPolicy::BitPLRU: {
+            uint64_t* bits = replBits(lineIdx);
+            if (undo & 0b10) {
+                // All ways but the accessed way had been accessed prior to the new epoch.
+                std::fill_n(bits, m_replWords, ~uint64_t(0));
+                bits[0] &= getWays() < 64 ? vsrtl::generateBitmask(getWays()) : ~uint64_t(0);
+            }
+            assignBit(bits, wayIdx, undo & 0b1);
+            break;
+        }
+        case ReplPolicy::SRRIP: {
+            uint64_t* bits = replBits(lineIdx);
+            const unsigned rrpv = undo & 0b11;
+            const unsigned aging = undo >> 2;
+            assignBit(bits + (update == ReplUpdate::Hit ? 0 : 2) * m_replWords, wayIdx, false);
+            assignBit(bits + rrpv * m_replWords, wayIdx, true);
+            shiftBitmasks(bits, m_replWords, -static_cast<int>(aging));
+            break;
+        }
+    }
+}
+
+unsigned CacheCore::randomWay() const {
+    // splitmix64 of the seeded sequence index
+    uint64_t z = s_randomSeed + (m_randomReplacements + 1) * 0x9E3779B97F4A7C15;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return (z ^ (z >> 31)) & (getWays() - 1);
+}
+
+unsigned CacheCore::getWayLRU(unsigned lineIdx, unsigned wayIdx) const {
+    if (m_replPolicy != ReplPolicy::LRU || !isWayValid(lineIdx, wayIdx)) {
+        return CacheWay().lru;
+    }
+    // The rank of the way is the number of valid ways which were more recently used.
+    unsigned rank = 0;
+    for (unsigned way = m_replLists[lineIdx].head; way != wayIdx; way = m_replLinks[entryIdx(lineIdx, way)].next) {
+        rank += isWayValid(lineIdx, way) ? 1 : 0;
+    }
+    return rank;
+}
+
+CacheCore::CacheSize CacheCore::getCacheSize() const {
+    CacheSize size;
+
+    const int entries = getLines() * getWays();
+
+    // Valid bits
+    unsigned componentBits = entries;  // 1 bit per entry
+    size.components.push_back("Valid bits: " + QString::number(componentBits));
+    size.bits += componentBits;
+
+    if (m_wrPolicy == WritePolicy::WriteBack) {
+        // Dirty bits
+        componentBits = entries;  // 1 bit per entry
+        size.components.push_back("Dirty bits: " + QString::number(componentBits));
+        size.bits += componentBits;
+    }
+
+    if (getWays() > 1) {
+        // Replacement bits
+        switch (m_replPolicy) {
+            case ReplPolicy::Random:
+                componentBits = 0;
+                break;
+            case ReplPolicy::LRU:
+                componentBits = getWaysBits() * entries;  // A rank per entry
+                break;
+            case ReplPolicy::FIFO:
+                componentBits = getWaysBits() * getLines();  // An insertion pointer per line
+                break;
+            case ReplPolicy::TreePLRU:
+                componentBits = (getWays() - 1) * getLines();  // A tree node per way pair
+                break;
+            case ReplPolicy::BitPLRU:
+                componentBits = entries;  // An MRU bit per entry
+                break;
+            case ReplPolicy::SRRIP:
+                componentBits = 2 * entries;  // A 2-bit prediction value per entry
+                break;
+        }
+        if (componentBits != 0) {
+            size.components.push_back(s_cacheReplPolicyStrings.at(m_replPolicy) + " bits: " +
+                                      QString::number(componentBits));
+            size.bits += componentBits;
+        }
+    }
+
+    // Tag bits
+    componentBits = vsrtl::bitcount(m_tagMask) * entries;
+    size.components.push_back("Tag bits: " + QString::number(componentBits));
+    size.bits += componentBits;
+
+    // Data bits
+    componentBits = m_wordBits * entries * getBlocks();
+    size.components.push_back("Data bits: " + QString::number(componentBits));
+    size.bits += componentBits;
+
+    if (m_writeBufferSize > 0) {
+        // Write buffer bits; a block address, and the data and a valid bit for each word of the block, per entry
+        componentBits =
+            m_writeBufferSize * (vsrtl::bitcount(m_tagMask) + getLineBits() + getBlocks() * (m_wordBits + 1));
+        size.components.push_back("Write buffer bits: " + QString::number(componentBits));
+        size.bits += componentBits;
+    }
+
+    return size;
+}
+
+unsigned CacheCore::locateEvictionWay(const CacheTransaction& transaction) const {
+    const unsigned lineIdx = transaction.index.line;
+    if (getWays() == 1) {
+        return 0;
+    }
+
+    // If there is an invalid way, select that.
+    if (m_validWays[lineIdx] < getWays()) {
+        const uint8_t* valid = &m_valid[entryIdx(lineIdx, 0)];
+        return std::find(valid, valid + getWays(), 0) - valid;
+    }
+
+    // Else, locate a way based on replacement policy.
+    unsigned wayIdx = s_invalidIndex;
+    switch (m_replPolicy) {
+        case ReplPolicy::Random:
+            wayIdx = randomWay();
+            break;
+        case ReplPolicy::LRU:
+        case ReplPolicy::FIFO:
+            wayIdx = m_replLists[lineIdx].tail;
+            break;
+        case ReplPolicy::TreePLRU: {
+            const uint64_t* bits = replBits(lineIdx);
+            unsigned node = 1;
+            while (node < static_cast<unsigned>(getWays())) {
+                node = 2 * node + testBit(bits, node);
+            }
+            wayIdx = node - getWays();
+            break;
+        }
+        case ReplPolicy::BitPLRU:
+            wayIdx = findBit(replBits(lineIdx), m_replWords, false);
+            break;
+        case ReplPolicy::SRRIP: {
+            // The first way with the largest prediction value
+            const uint64_t* bits = replBits(lineIdx);
+            for (int rrpv = 3; rrpv >= 0 && wayIdx == s_invalidIndex; --rrpv) {
+                const int way = findBit(bits + rrpv * m_replWords, m_replWords, true);
+                wayIdx = way == -1 ? s_invalidIndex : way;
+            }
+            break;
+        }
+    }
+
+    Q_ASSERT(wayIdx < static_cast<unsigned>(getWays()) && "Unable to locate way for eviction");
+    return wayIdx;
+}
+
+CacheCore::Eviction CacheCore::evictAndUpdate(CacheTransaction& transaction, unsigned traceSlot) {
+    const unsigned wayIdx = locateEvictionWay(transaction);
+    const unsigned entry = entryIdx(transaction.index.line, wayIdx);
+
+    // Store the old way info in our eviction trace, in case of rollbacks
+    recordWayState(traceSlot, transaction.index.line, wayIdx);
+
+    Eviction eviction;
+    if (!m_valid[entry]) {
+        // Record that this was an invalid->valid transition
+        transaction.transToValid = true;
+        m_validWays[transaction.index.line]++;
+    } else {
+        eviction.valid = true;
+        eviction.address = buildAddress(m_tags[entry], transaction.index.line, 0);
+        if (isWayDirty(transaction.index.line, wayIdx)) {
+            // The eviction will result in a writeback
+            eviction.dirty = true;
+            transaction.isWriteback = true;
+        }
+    }
+
+    // Set required values in way, reflecting the newly loaded address
+    m_tags[entry] = getTag(transaction.address);
+    m_valid[entry] = true;
+    m_prefetched[entry] = false;
+    std::fill_n(dirtyMask(entry), m_dirtyWords, 0);
+    transaction.tagChanged = true;
+    transaction.index.way = wayIdx;
+    return eviction;
+}
+
+void CacheCore::recordWayState(unsigned traceSlot, unsigned lineIdx, unsigned wayIdx) {
+    const unsigned entry = entryIdx(lineIdx, wayIdx);
+    CacheTrace& trace = m_traces[traceSlot];
+    trace.prevTag = m_tags[entry];
+    trace.prevPrefetchReady = m_prefetchReady[entry];
+    trace.flags |= m_prefetched[entry] ? CacheTrace::WasPrefetched : 0;
+    std::copy_n(dirtyMask(entry), m_dirtyWords, traceDirtyMask(traceSlot));
+}
+
+CacheCore::CacheWay CacheCore::getWay(unsigned lineIdx, unsigned wayIdx) const {
+    const unsigned entry = entryIdx(lineIdx, wayIdx);
+    CacheWay way;
+    way.valid = m_valid[entry];
+    way.lru = getWayLRU(lineIdx, wayIdx);
+    way.prefetched = m_prefetched[entry];
+    if (way.valid) {
+        way.tag = m_tags[entry];
+    }
+
+    const uint64_t* mask = dirtyMask(entry);
+    for (int i = 0; i < getBlocks(); ++i) {
+        if ((mask[i / 64] >> (i % 64)) & 1) {
+            way.dirtyBlocks.insert(i);
+        }
+    }
+    way.dirty = !way.dirtyBlocks.empty();
+    return way;
+}
+
+bool CacheCore::isWayDirty(unsigned lineIdx, unsigned wayIdx) const {
+    const uint64_t* mask = dirtyMask(entryIdx(lineIdx, wayIdx));
+    return std::any_of(mask, mask + m_dirtyWords, [](uint64_t bits) { return bits != 0; });
+}
+
+unsigned CacheCore::getWayDirtyBlocks(unsigned lineIdx, unsigned wayIdx) const {
+    const uint64_t* mask = dirtyMask(entryIdx(lineIdx, wayIdx));
+    unsigned dirtyBlocks = 0;
+    for (unsigned i = 0; i < m_dirtyWords; ++i) {
+        dirtyBlocks += std::bitset<64>(mask[i]).count();
+    }
+    return dirtyBlocks;
+}
+
+
+unsigned CacheCore::getHits() const {
+    return m_accessTrace.empty() ? 0 : m_accessTrace.back().values[CacheTimeSeries::Hits];
+}
+
+unsigned CacheCore::getMisses() const {
+    return m_accessTrace.empty() ? 0 : m_accessTrace.back().values[CacheTimeSeries::Misses];
+}
+
+unsigned CacheCore::getWritebacks() const {
+    return m_accessTrace.empty() ? 0 : m_accessTrace.back().values[CacheTimeSeries::Writebacks];
+}
+
+unsigned CacheCore::getCoalescedWrites() const {
+    return m_accessTrace.empty() ? 0 : m_accessTrace.back().values[CacheTimeSeries::CoalescedWrites];
+}
+
+std::vector<std::pair<AInt, CacheCore::PCStats>> CacheCore::getPCProfile() const {
+    std::vector<std::pair<AInt, PCStats>> profile;
+    for (uint32_t pcIdx = 0; pcIdx < m_pcStats.size(); ++pcIdx) {
+        const PCStats& stats = m_pcStats[pcIdx];
+        if (stats.misses != 0 || stats.writebacks != 0) {
+            profile.push_back({m_pcBase + (static_cast<AInt>(pcIdx) << m_pcShift), stats});
+        }
+    }
+    return profile;
+}
+
+unsigned CacheCore::getMisses(MissClass missClass) const {
+    return m_accessTrace.empty() ? 0 : m_accessTrace.back().values[CacheTimeSeries::CompulsoryMisses + missClass];
+}
+
+double CacheCore::getHitRate() const {
+    if (m_accessTrace.empty()) {
+        return 0;
+    } else {
+        const auto& values = m_accessTrace.back().values;
+        return static_cast<double>(values[CacheTimeSeries::Hits]) /
+               (values[CacheTimeSeries::Hits] + values[CacheTimeSeries::Misses]);
+    }
+}
+
+void CacheCore::analyzeCacheAccess(CacheTransaction& transaction) const {
+    transaction.index.line = getLineIdx(transaction.address);
+    transaction.index.block = getBlockIdx(transaction.address);
+
+    // A tag may only be present in a single valid way of a cache line. Given this, the index of the hitting way can be
+    // determined through a branchless sum-reduction across all ways of the line, which the compiler is free to
+    // vectorize. hitWay is 1-indexed, such that 0 indicates a miss.
+    const unsigned tag = getTag(transaction.address);
+    const unsigned base = entryIdx(transaction.index.line, 0);
+    const unsigned* tags = &m_tags[base];
+    const uint8_t* valid = &m_valid[base];
+    unsigned hitWay = 0;
+    for (int i = 0; i < getWays(); ++i) {
+        hitWay += (tags[i] == tag && valid[i]) ? i + 1 : 0;
+    }
+
+    transaction.isHit = hitWay != 0;
+    if (transaction.isHit) {
+        transaction.index.way = hitWay - 1;
+    }
+}
+
+void CacheCore::pushAccessTrace(const CacheTransaction& transaction, MissClass missClass, bool coalesced,
+                               unsigned cycle) {
+    // Access traces are appended in cycle order to the access trace; each sample contains the cumulative statistics up
+    // until and including the cycle of the access.
+    CacheTimeSeries::Sample sample;
+    if (!m_accessTrace.empty()) {
+        sample = m_accessTrace.back();
+        if (sample.cycle == cycle) {
+            // A trace has already been recorded for this cycle; the new trace replaces it.
+            m_accessTrace.popBack();
+        }
+    }
+
+    sample.cycle = cycle;
+    auto& values = sample.values;
+    values[CacheTimeSeries::Reads] += transaction.type == MemoryAccess::Read ? 1 : 0;
+    values[CacheTimeSeries::Writes] += transaction.type == MemoryAccess::Write ? 1 : 0;
+    values[CacheTimeSeries::Writebacks] += transaction.isWriteback ? 1 : 0;
+    values[CacheTimeSeries::Hits] += transaction.isHit ? 1 : 0;
+    values[CacheTimeSeries::Misses] += transaction.isHit ? 0 : 1;
+    values[CacheTimeSeries::CompulsoryMisses + missClass] += transaction.isHit ? 0 : 1;
+    values[CacheTimeSeries::CoalescedWrites] += coalesced ? 1 : 0;
+    m_accessTrace.append(sample);
+    notifyStatisticsChanged();
+}
+
+void CacheCore::popAccessTrace() {
+    Q_ASSERT(!m_accessTrace.empty());
+    // The access trace should have an entry
+    m_accessTrace.popBack();
+    notifyStatisticsChanged();
+}
+
+unsigned CacheCore::access(AInt address, MemoryAccess::Type type, unsigned cycle, AInt pc) {
+    return request(address, type == MemoryAccess::Write ? Request::Write : Request::Read, cycle, pc);
+}
+
+void CacheCore::setLatencies(unsigned hitLatency, unsigned missLatency) {
+    m_hitLatency = hitLatency;
+    m_missLatency = missLatency;
+}
+
+void CacheCore::setPrefetcher(PrefetcherType type) {
+    m_prefetcher = Prefetcher::create(type);
+    updateConfiguration();
+}
+
+void CacheCore::setWriteBufferSize(unsigned entries) {
+    m_writeBufferSize = std::min(entries, s_maxWriteBufferSize);
+    updateConfiguration();
+}
+
+unsigned CacheCore::findWriteBufferEntry(AInt block) const {
+    for (unsigned pos = 0; pos < m_writeBuffer.size(); ++pos) {
+        if (m_writeBuffer[pos].block == block) {
+            return pos;
+        }
+    }
+    return s_invalidIndex;
+}
+
+CacheCore::WriteBufferEntry CacheCore::drainWriteBuffer(unsigned pos, unsigned traceSlot) {
+    const WriteBufferEntry entry = m_writeBuffer[pos];
+    m_traces[traceSlot].flags |= CacheTrace::WriteDrained;
+    m_drains.push() = {entry, pos};
+    m_writeBuffer.erase(m_writeBuffer.begin() + pos);
+    return entry;
+}
+
+unsigned CacheCore::request(AInt address, Request request, unsigned cycle, AInt pc) {
+    address = address & ~0b11;  // Disregard unaligned accesses
+    CacheTransaction transaction;
+    transaction.address = address;
+    transaction.type = request == Request::Read || request == Request::Prefetch ? MemoryAccess::Read
+                       : request == Request::CleanEviction                      ? MemoryAccess::None
+                                                                                : MemoryAccess::Write;
+    const MemoryAccess::Type type = transaction.type;
+
+    analyzeCacheAccess(transaction);
+
+    // Prefetches of blocks which are already resident, or which are held in the write buffer, are dropped.
+    if (request == Request::Prefetch &&
+        (transaction.isHit || findWriteBufferEntry(blockAddress(address)) != s_invalidIndex)) {
+        return 0;
+    }
+
+    // Determine whether a miss allocates a way in this cache. Fills bypass exclusive caches, whereas blocks evicted
+    // from the levels above are always installed in exclusive caches.
+    bool allocate = false;
+    switch (request) {
+        case Request::Read:
+        case Request::Prefetch:
+            allocate = !isExclusive();
+            break;
+        case Request::Write:
+            allocate = !isExclusive() && getWriteAllocPolicy() == WriteAllocPolicy::WriteAllocate;
+            break;
+        case Request::Writeback:
+            allocate = isExclusive() || getWriteAllocPolicy() == WriteAllocPolicy::WriteAllocate;
+            break;
+        case Request::CleanEviction:
+            allocate = true;
+            break;
+    }
+
+    // Prefetches and the blocks evicted from the levels above are not accounted for in the access statistics. The
+    // prefetcher is trained on the reads and writes of this cache.
+    const bool isAccess = request != Request::CleanEviction && request != Request::Prefetch;
+    const bool isDemand = request == Request::Read || request == Request::Write;
+    const bool trains = m_prefetcher && isDemand && !isExclusive();
+
+    const unsigned hitEntry = transaction.isHit ? entryIdx(transaction.index.line, transaction.index.way) : 0;
+    const bool hitPrefetched = transaction.isHit && m_prefetched[hitEntry];
+
+    // Reserve a trace for this access. The state of the accessed way is recorded in the trace before being modified.
+    const unsigned traceSlot = pushTrace();
+
+    // Classify the access before the cache state is modified. The shadow cache of the classifier follows the
+    // allocation decision of this cache. Prefetches are not referenced by the program and bypass the classifier.
+    MissClassifier::Record missRecord;
+    if (request != Request::Prefetch) {
+        missRecord = m_missClassifier.access(blockAddress(address), transaction.isHit, allocate, hitPrefetched);
+    }
+    const MissClass missClass = MissClassifier::classify(missRecord);
+    if (missRecord.flags != 0) {
+        m_traces[traceSlot].flags |= CacheTrace::Classified;
+        m_missRecords.push() = missRecord;
+    }
+
+    Eviction eviction;
+    if (!transaction.isHit) {
+        if (allocate) {
+            eviction = evictAndUpdate(transaction, traceSlot);
+        }
+    } else {
+        recordWayState(traceSlot, transaction.index.line, transaction.index.way);
+    }
+
+    // The first demand reference to a prefetched block makes the prefetch useful. If the fill of the block has not yet
+    // completed, the prefetch was late.
+    const bool prefetchHit = hitPrefetched && isDemand;
+    const unsigned prefetchReady = prefetchHit ? m_prefetchReady[hitEntry] : 0;
+    if (prefetchHit) {
+        m_prefetched[hitEntry] = false;
+    }
+    if (trains) {
+        PrefetchStats& stats = m_prefetcher->stats();
+        stats.misses += transaction.isHit ? 0 : 1;
+        stats.useful += prefetchHit ? 1 : 0;
+        stats.late += prefetchHit && prefetchReady > cycle ? 1 : 0;
+    } else if (request == Request::Prefetch) {
+        m_prefetched[entryIdx(transaction.index.line, transaction.index.way)] = true;
+        m_prefetcher->stats().issued++;
+    }
+
+    // A read hit in an exclusive cache moves the block to the level above; the way is invalidated rather than updated.
+    const bool exclusiveHit = transaction.isHit && request == Request::Read && isExclusive();
+    const bool exclusiveHitDirty = exclusiveHit && isWayDirty(transaction.index.line, transaction.index.way);
+
+    // === Update dirty and LRU bits ===
+
+    // Initially, we need a check for the case of "write + miss + noWriteAlloc". In this case, we should not update
+    // replacement/dirty fields. In all other cases, this is a valid action.
+    const bool missNoAlloc = !transaction.isHit && !allocate;
+
+    if (!missNoAlloc && !exclusiveHit) {
+        if (type == MemoryAccess::Write && getWritePolicy() == WritePolicy::WriteBack) {
+            uint64_t* mask = dirtyMask(entryIdx(transaction.index.line, transaction.index.way));
+            mask[transaction.index.block / 64] |= uint64_t(1) << (transaction.index.block % 64);
+        }
+
+        const ReplUpdate update = transaction.isHit        ? ReplUpdate::Hit
+                                  : transaction.transToValid ? ReplUpdate::Fill
+                                                             : ReplUpdate::Replace;
+        m_traces[traceSlot].replUndo = updateReplState(transaction.index.line, transaction.index.way, update);
+    }
+
+    // === Write buffer ===
+    // Writes which are not retained in this cache, i.e., all writes of a write-through cache and write misses without
+    // write allocation, are written through to the next level, each resulting in a writeback. With a write buffer, the
+    // writes are instead coalesced in the buffer, and only the entries drained from the buffer result in writebacks.
+    // Blocks evicted from the levels above bypass the buffer.
+    const bool fill = !transaction.isHit && (request == Request::Read || request == Request::Prefetch ||
+                                             (request == Request::Write && allocate));
+    const bool writeThrough =
+        type == MemoryAccess::Write && (getWritePolicy() == WritePolicy::WriteThrough || missNoAlloc);
+    const bool buffered = writeThrough && request == Request::Write && m_writeBufferSize > 0;
+    bool drained = false;
+    bool coalesced = false;
+    WriteBufferEntry drainedEntry{0, 0};
+    if (m_writeBufferSize > 0) {
+        // A fill of a buffered block drains the entry of the block, such that the fill observes the buffered writes.
+        const unsigned conflictPos = fill ? findWriteBufferEntry(blockAddress(address)) : s_invalidIndex;
+        if (conflictPos != s_invalidIndex) {
+            drainedEntry = drainWriteBuffer(conflictPos, traceSlot);
+            drained = true;
+        }
+        if (buffered) {
+            coalesced = findWriteBufferEntry(blockAddress(address)) != s_invalidIndex;
+            if (!coalesced) {
+                // A conflicting entry was drained above, in which case the buffer cannot be full.
+                if (m_writeBuffer.size() == m_writeBufferSize) {
+                    Q_ASSERT(!drained);
+                    drainedEntry = drainWriteBuffer(0, traceSlot);
+                    drained = true;
+                }
+                m_writeBuffer.push_back({blockAddress(address), pc});
+                m_traces[traceSlot].flags |= CacheTrace::WriteBuffered;
+            }
+        }
+    }
+    transaction.isWriteback |= drained || (writeThrough && !buffered);
+
+    // An inclusive cache must invalidate its evicted block in all levels above it. If any of these were dirty, the
+    // eviction results in a writeback.
+    if (eviction.valid && m_inclusionPolicy == InclusionPolicy::Inclusive) {
+        bool upperDirty = false;
+        for (auto* prevLevel : m_prevLevels) {
+            upperDirty |= prevLevel->invalidateBlocks(eviction.address, getBlockBytes(), cycle);
+        }
+        if (upperDirty && !eviction.dirty) {
+            eviction.dirty = true;
+            transaction.isWriteback = true;
+        }
+    }
+
+    if (exclusiveHitDirty) {
+        transaction.isWriteback = true;
+    }
+
+    // ===========================
+
+    // At this point, no further changes shall be made to the transaction.
+    // We record the transaction alongside the previously recorded way state
+    CacheTrace& trace = m_traces[traceSlot];
+    trace.address = transaction.address;
+    trace.cycle = cycle;
+    trace.line = transaction.index.line;
+    trace.way = transaction.index.way == s_invalidIndex || exclusiveHit ? CacheTrace::s_invalidWay
+                                                                          : transaction.index.way;
+    trace.type = transaction.type;
+    trace.flags |= (transaction.isHit ? CacheTrace::IsHit : 0) |
+                   (transaction.isWriteback ? CacheTrace::IsWriteback : 0) |
+                   (transaction.transToValid ? CacheTrace::TransToValid : 0) |
+                   (transaction.tagChanged ? CacheTrace::TagChanged : 0) | (isAccess ? CacheTrace::IsAccess : 0) |
+                   (request == Request::Prefetch ? CacheTrace::Prefetch : 0) | (trains ? CacheTrace::Trained : 0);
+    trace.pcIdx = pcIndex(pc);
+    if (isAccess) {
+        m_lineMisses[transaction.index.line][missClass] += transaction.isHit ? 0 : 1;
+        if (trace.pcIdx != s_noPC) {
+            PCStats& pcStats = m_pcStats[trace.pcIdx];
+            pcStats.misses += transaction.isHit ? 0 : 1;
+            pcStats.writebacks += transaction.isWriteback ? 1 : 0;
+        }
+        pushAccessTrace(transaction, missClass, coalesced, cycle);
+    }
+
+    // === Some sanity checking ===
+    // It should never be possible that an allocating access returns an invalid way index
+    if (!missNoAlloc) {
+        transaction.index.assertValid();
+    }
+
+    // ===========================
+    if (!missNoAlloc) {
+        // There are no graphical changes to perform if nothing was pulled into the cache. Prefetches only update the
+        // prefetched way, leaving the highlighting of the most recent access in place.
+        if (request == Request::Prefetch) {
+            notifyWayChanged(transaction.index.line, transaction.index.way);
+        } else {
+            notifyTransaction(transaction);
+        }
+    }
+
+    if (exclusiveHit) {
+        invalidateWay(transaction.index.line, transaction.index.way, cycle);
+    }
+
+    // === Forward requests to the next level cache ===
+    // All modifications to this cache have been performed (and recorded) at this point. This ensures that any
+    // modifications performed by the levels below (back-invalidations) are recorded after the modifications of this
+    // access, such that the traces may be undone in reverse order.
+    // Only fills contribute to the latency of an access; writes to the next level are assumed to be buffered.
+    unsigned latency = m_hitLatency;
+    if (prefetchHit && prefetchReady > cycle) {
+        latency = std::max(m_hitLatency, prefetchReady - cycle);
+    }
+    if (!m_nextLevel && m_mainMemory) {
+        // Evicted and drained blocks are written to memory in their entirety, whereas writes which are written through
+        // only write the accessed word.
+        const unsigned wordBytes = 1 << m_byteOffset;
+        if (eviction.dirty) {
+            m_mainMemory->access(eviction.address, getBlockBytes(), true, cycle);
+        }
+        if (exclusiveHitDirty) {
+            m_mainMemory->access(blockAddress(address), getBlockBytes(), true, cycle);
+        }
+        if (drained) {
+            m_mainMemory->access(drainedEntry.block, getBlockBytes(), true, cycle);
+        }
+        if (fill) {
+            latency = m_missLatency + m_mainMemory->access(blockAddress(address), getBlockBytes(), false, cycle);
+        }
+        if (writeThrough && !buffered) {
+            m_mainMemory->access(address, request == Request::Writeback ? getBlockBytes() : wordBytes, true, cycle);
+        }
+    } else if (!m_nextLevel) {
+        latency = fill ? m_missLatency + m_memoryLatency : latency;
+    } else {
+        if (eviction.valid) {
+            if (eviction.dirty) {
+                m_nextLevel->request(eviction.address, Request::Writeback, cycle, pc);
+            } else if (m_nextLevel->isExclusive()) {
+                m_nextLevel->request(eviction.address, Request::CleanEviction, cycle, pc);
+            }
+        }
+
+        if (exclusiveHitDirty) {
+            m_nextLevel->request(transaction.address, Request::Writeback, cycle, pc);
+        }
+
+        // Drained writes are issued on behalf of the write which allocated the entry, ahead of any fill of the block.
+        if (drained) {
+            m_nextLevel->request(drainedEntry.block, Request::Write, cycle, drainedEntry.pc);
+        }
+
+        // Fetch the missing block from the next level. Blocks evicted from the levels above are written in their
+        // entirety and do not require a fill.
+        if (fill) {
+            latency = m_missLatency + m_nextLevel->request(transaction.address, Request::Read, cycle, pc);
+        }
+
+        if (writeThrough && !buffered) {
+            m_nextLevel->request(transaction.address, request, cycle, pc);
+        }
+    }
+
+    // === Prefetch ===
+    // Prefetched blocks are available once their fill completes. The prefetches nominated by the prefetcher are issued
+    // after the access itself has been performed, such that their traces are undone before the access.
+    if (request == Request::Prefetch) {
+        m_prefetchReady[entryIdx(transaction.index.line, transaction.index.way)] = cycle + latency;
+    } else if (trains) {
+        Prefetcher::Access access;
+        access.address = address;
+        access.pc = pc;
+        access.isHit = transaction.isHit;
+        access.isPrefetchHit = prefetchHit;
+        m_prefetchCandidates.clear();
+        m_prefetcher->train(access, m_prefetchCandidates);
+        for (const AInt candidate : m_prefetchCandidates) {
+            this->request(candidate, Request::Prefetch, cycle, pc);
+        }
+    }
+
+    return latency;
+}
+
+bool CacheCore::invalidateBlocks(AInt address, unsigned bytes, unsigned cycle) {
+    bool dirty = false;
+    const AInt blockBytes = getBlockBytes();
+    for (AInt blockAddress = address & ~(blockBytes - 1); blockAddress < address + bytes; blockAddress += blockBytes) {
+        CacheTransaction transaction;
+        transaction.address = blockAddress;
+        analyzeCacheAccess(transaction);
+        if (transaction.isHit) {
+            dirty |= isWayDirty(transaction.index.line, transaction.index.way);
+            invalidateWay(transaction.index.line, transaction.index.way, cycle);
+        }
+    }
+
+    // Inclusion of the level below this cache extends to all levels above it.
+    for (auto* prevLevel : m_prevLevels) {
+        dirty |= prevLevel->invalidateBlocks(address, bytes, cycle);
+    }
+    return dirty;
+}
+
+void CacheCore::invalidateWay(unsigned lineIdx, unsigned wayIdx, unsigned cycle) {
+    const unsigned entry = entryIdx(lineIdx, wayIdx);
+    const unsigned traceSlot = pushTrace();
+    recordWayState(traceSlot, lineIdx, wayIdx);
+
+    CacheTrace& trace = m_traces[traceSlot];
+    trace.address = buildAddress(m_tags[entry], lineIdx, 0);
+    trace.cycle = cycle;
+    trace.line = lineIdx;
+    trace.way = wayIdx;
+    trace.type = MemoryAccess::None;
+    trace.flags |= CacheTrace::Invalidation;
+
+    // The replacement state of the line is retained; invalid ways are always replaced first.
+    m_valid[entry] = false;
+    m_validWays[lineIdx]--;
+    m_prefetched[entry] = false;
+    std::fill_n(dirtyMask(entry), m_dirtyWords, 0);
+    notifyWayChanged(lineIdx, wayIdx);
+}
+
+void CacheCore::undo() {
+    if (m_traceCount == 0)
+        return;
+
+    const unsigned traceSlot = popTrace();
+    const CacheTrace& trace = m_traces[traceSlot];
+
+    // All accesses within a cycle share a single access trace sample, which is popped once the first of these are
+    // undone.
+    if ((trace.flags & CacheTrace::IsAccess) && !m_accessTrace.empty() && m_accessTrace.back().cycle == trace.cycle) {
+        popAccessTrace();
+    }
+
+    const MissClassifier::Record missRecord =
+        (trace.flags & CacheTrace::Classified) ? m_missRecords.pop() : MissClassifier::Record();
+    if ((trace.flags & CacheTrace::IsAccess) && !(trace.flags & CacheTrace::IsHit)) {
+        m_lineMisses[trace.line][MissClassifier::classify(missRecord)]--;
+    }
+    if ((trace.flags & CacheTrace::IsAccess) && trace.pcIdx != s_noPC) {
+        PCStats& pcStats = m_pcStats[trace.pcIdx];
+        pcStats.misses -= (trace.flags & CacheTrace::IsHit) ? 0 : 1;
+        pcStats.writebacks -= (trace.flags & CacheTrace::IsWriteback) ? 1 : 0;
+    }
+    if (trace.flags & CacheTrace::Classified) {
+        m_missClassifier.undo(blockAddress(trace.address), missRecord);
+    }
+
+    // An access drains the write buffer before allocating an entry.
+    if (trace.flags & CacheTrace::WriteBuffered) {
+        m_writeBuffer.pop_back();
+    }
+    if (trace.flags & CacheTrace::WriteDrained) {
+        const DrainRecord& drain = m_drains.pop();
+        m_writeBuffer.insert(m_writeBuffer.begin() + drain.pos, drain.entry);
+    }
+
+    if (trace.flags & CacheTrace::Trained) {
+        m_prefetcher->undo();
+        PrefetchStats& stats = m_prefetcher->stats();
+        const bool prefetchHit = (trace.flags & CacheTrace::IsHit) && (trace.flags & CacheTrace::WasPrefetched);
+        stats.misses -= (trace.flags & CacheTrace::IsHit) ? 0 : 1;
+        stats.useful -= prefetchHit ? 1 : 0;
+        stats.late -= prefetchHit && trace.prevPrefetchReady > trace.cycle ? 1 : 0;
+    } else if (trace.flags & CacheTrace::Prefetch) {
+        m_prefetcher->stats().issued--;
+    }
+
+    // A miss without allocation never modified the cache state; nothing to revert.
+    if (trace.way != CacheTrace::s_invalidWay) {
+        const unsigned entry = entryIdx(trace.line, trace.way);
+        m_prefetched[entry] = (trace.flags & CacheTrace::WasPrefetched) != 0;
+        m_prefetchReady[entry] = trace.prevPrefetchReady;
+
+        if (trace.flags & CacheTrace::Invalidation) {
+            // Case 0: A way was invalidated. Restore the way.
+            m_valid[entry] = true;
+            m_validWays[trace.line]++;
+            m_tags[entry] = trace.prevTag;
+            std::copy_n(traceDirtyMask(traceSlot), m_dirtyWords, dirtyMask(entry));
+        } else {
+            // Case 1: A cache way was transitioned to valid. In this case, we simply invalidate the cache way
+            if (trace.flags & CacheTrace::TransToValid) {
+                m_valid[entry] = false;
+                m_validWays[trace.line]--;
+            }
+            // Case 2: A miss occured on a valid entry. In this case, we have to restore the old way, which was evicted
+            // - Restore the old entry which was evicted
+            else if (!(trace.flags & CacheTrace::IsHit)) {
+                m_tags[entry] = trace.prevTag;
+            }
+            // Case 3: Else, it was a cache hit; Revert replacement fields and dirty blocks
+            std::copy_n(traceDirtyMask(traceSlot), m_dirtyWords, dirtyMask(entry));
+            const ReplUpdate update = (trace.flags & CacheTrace::IsHit)          ? ReplUpdate::Hit
+                                      : (trace.flags & CacheTrace::TransToValid) ? ReplUpdate::Fill
+                                                                                 : ReplUpdate::Replace;
+            revertReplState(trace.line, trace.way, update, trace.replUndo);
+        }
+
+        // Notify that changes to the way has been performed
+        notifyWayChanged(trace.line, trace.way);
+    }
+
+    // Finally, re-emit the transaction which occurred in the previous cache access to update the cache
+    // highlighting state
+    if (m_traceCount > 0) {
+        notifyTransaction(decodeTrace(m_traces[(m_traceHead + m_traces.size() - 1) % m_traces.size()]));
+    } else {
+        notifyTransaction(CacheTransaction());
+    }
+}
+
+unsigned CacheCore::popTrace() {
+    Q_ASSERT(m_traceCount > 0);
+    m_traceHead = (m_traceHead + m_traces.size() - 1) % m_traces.size();
+    m_traceCount--;
+    return m_traceHead;
+}
+
+unsigned CacheCore::pushTrace() {
+    const unsigned traceSlot = m_traceHead;
+    m_traceHead = (m_traceHead + 1) % m_traces.size();
+    if (m_traceCount < m_traceCapacity) {
+        m_traceCount++;
+    } else if (m_traceCapacity > 0) {
+        // The oldest trace is overwritten. Within the bound of tracesPerCycle(), its cycle precedes the cycles which
+        // may be undone. If the bound is exceeded, e.g., as the hierarchy changed after this cache was reset, the cycle
+        // may be within the undo window, and is dropped in its entirety rather than being partially undone.
+        const unsigned droppedCycle = m_traces[traceSlot].cycle;
+        while (m_traceCount > 1 &&
+               m_traces[(m_traceHead + m_traces.size() - m_traceCount) % m_traces.size()].cycle == droppedCycle) {
+            m_traceCount--;
+        }
+    }
+    m_traces[traceSlot].flags = 0;
+    return traceSlot;
+}
+
+unsigned CacheCore::requestsPerCycle() const {
+    unsigned requests = m_prevLevels.empty() ? 1 : 0;
+    for (const auto* prevLevel : m_prevLevels) {
+        requests += s_requestsPerRequest * prevLevel->requestsPerCycle();
+    }
+    // Each demand request may additionally issue the prefetches nominated by the prefetcher
+    return requests * (1 + (m_prefetcher ? m_prefetcher->degree() : 0));
+}
+
+unsigned CacheCore::tracesPerCycle() const {
+    // A read hit in an exclusive cache records the invalidation of the way hit, alongside the request itself.
+    unsigned traces = requestsPerCycle() * (isExclusive() ? 2 : 1);
+
+    // Each request to an inclusive cache below this cache may evict a block, which is invalidated in this cache. A
+    // block of the cache below may span multiple blocks of this cache.
+    for (const CacheCore* lower = m_nextLevel; lower; lower = lower->m_nextLevel) {
+        if (lower->m_inclusionPolicy == InclusionPolicy::Inclusive) {
+            traces += lower->requestsPerCycle() * std::max(1u, lower->getBlockBytes() / getBlockBytes());
+        }
+    }
+    return traces;
+}
+
+CacheCore::CacheTransaction CacheCore::decodeTrace(const CacheTrace& trace) const {
+    CacheTransaction transaction;
+    transaction.address = trace.address;
+    transaction.index.line = trace.line;
+    transaction.index.way = trace.way == CacheTrace::s_invalidWay ? s_invalidIndex : trace.way;
+    transaction.index.block = getBlockIdx(trace.address);
+    transaction.type = static_cast<MemoryAccess::Type>(trace.type);
+    transaction.isHit = trace.flags & CacheTrace::IsHit;
+    transaction.isWriteback = trace.flags & CacheTrace::IsWriteback;
+    transaction.transToValid = trace.flags & CacheTrace::TransToValid;
+    transaction.tagChanged = trace.flags & CacheTrace::TagChanged;
+    return transaction;
+}
+
+AInt CacheCore::buildAddress(unsigned tag, unsigned lineIdx, unsigned blockIdx) const {
+    AInt address = 0;
+    address |= static_cast<AInt>(tag) << (m_byteOffset + getBlockBits() + getLineBits());
+    address |= lineIdx << (m_byteOffset + getBlockBits());
+    address |= blockIdx << (m_byteOffset);
+    return address;
+}
+
+unsigned CacheCore::getLineIdx(const AInt address) const {
+    AInt maskedAddress = address & m_lineMask;
+    maskedAddress >>= m_byteOffset + getBlockBits();
+    return maskedAddress;
+}
+
+unsigned CacheCore::getTag(const AInt address) const {
+    AInt maskedAddress = address & m_tagMask;
+    maskedAddress >>= m_byteOffset + getBlockBits() + getLineBits();
+    return maskedAddress;
+}
+
+unsigned CacheCore::getBlockIdx(const AInt address) const {
+    AInt maskedAddress = address & m_blockMask;
+    maskedAddress >>= m_byteOffset;
+    return maskedAddress;
+}
+
+void CacheCore::undoCycle(unsigned cycle) {
+    // Undo all modifications performed in the cycle. This may include multiple accesses, i.e., requests from multiple
+    // caches of the level above, as well as invalidations performed by the level below.
+    while (m_traceCount > 0 && m_traces[(m_traceHead + m_traces.size() - 1) % m_traces.size()].cycle == cycle) {
+        undo();
+    }
+}
+
+void CacheCore::recalculateMasks() {
+    unsigned bitOffset = m_byteOffset;
+    m_blockMask = vsrtl::generateBitmask(getBlockBits()) << bitOffset;
+    bitOffset += getBlockBits();
+    m_lineMask = vsrtl::generateBitmask(getLineBits()) << bitOffset;
+    bitOffset += getLineBits();
+    m_tagMask = vsrtl::generateBitmask(m_wordBits - bitOffset) << bitOffset;
+}
+
+void CacheCore::resetState() {
+    recalculateMasks();
+    reinitializeState();
+    m_accessTrace.clear();
+}
+
+void CacheCore::reinitializeState() {
+    const unsigned entries = getLines() * getWays();
+    m_dirtyWords = (getBlocks() + 63) / 64;
+
+    // assign() retains the current allocations if the cache geometry is unchanged.
+    m_tags.assign(entries, 0);
+    m_valid.assign(entries, false);
+    m_validWays.assign(getLines(), 0);
+    m_dirtyMasks.assign(entries * m_dirtyWords, 0);
+    m_missClassifier.reset(entries);
+    m_lineMisses.assign(getLines(), {});
+    m_prefetched.assign(entries, false);
+    m_prefetchReady.assign(entries, 0);
+    m_writeBuffer.clear();
+    m_writeBuffer.reserve(m_writeBufferSize);
+
+    // Accesses are attributed to the instruction slots of the text section of the current program.
+    m_pcStats.assign(m_textBytes >> m_pcShift, PCStats());
+
+    // Initialize the replacement state of each line
+    m_replWords = (getWays() + 63) / 64;
+    m_replLinks.clear();
+    m_replLists.clear();
+    m_replBits.clear();
+    m_randomReplacements = 0;
+    if (m_replPolicy == ReplPolicy::LRU || m_replPolicy == ReplPolicy::FIFO) {
+        m_replLinks.resize(entries);
+        m_replLists.resize(getLines());
+        for (unsigned lineIdx = 0; lineIdx < static_cast<unsigned>(getLines()); ++lineIdx) {
+            m_replLists[lineIdx] = {s_noWay, s_noWay};
+            for (unsigned wayIdx = 0; wayIdx < static_cast<unsigned>(getWays()); ++wayIdx) {
+                linkWay(lineIdx, wayIdx, s_noWay);
+            }
+        }
+    } else if (m_replPolicy != ReplPolicy::Random) {
+        m_replBits.assign(getLines() * m_replWords * replBitmasks(), 0);
+        if (m_replPolicy == ReplPolicy::SRRIP) {
+            // All ways are initially predicted to be re-referenced in the distant future.
+            for (unsigned lineIdx = 0; lineIdx < static_cast<unsigned>(getLines()); ++lineIdx) {
+                for (unsigned wayIdx = 0; wayIdx < static_cast<unsigned>(getWays()); ++wayIdx) {
+                    assignBit(replBits(lineIdx) + 3 * m_replWords, wayIdx, true);
+                }
+            }
+        }
+    }
+
+    // Clear and preallocate the undo trace ring buffer, such that it holds the traces of m_undoCycles cycles.
+    m_traceCapacity = m_undoCycles * tracesPerCycle();
+    m_traces.resize(std::max(1u, m_traceCapacity));
+    m_traceDirtyMasks.resize(m_traces.size() * m_dirtyWords);
+    m_missRecords.reset(m_traces.size());
+    m_drains.reset(m_writeBufferSize > 0 ? m_traces.size() : 1);
+    m_traceHead = 0;
+    m_traceCount = 0;
+
+    // Each training of the prefetcher is recorded in a trace, such that the trainings of all undoable traces may be
+    // undone.
+    if (m_prefetcher) {
+        m_prefetcher->reset(getBlockBytes(), m_traceCapacity);
+    }
+}
+
+void CacheCore::updateConfiguration() {
+    recalculateMasks();
+    reinitializeState();
+    notifyConfigurationChanged();
+}
+
+void CacheCore::setBlocks(unsigned blocks) {
+    m_blocks = blocks;
+    updateConfiguration();
+}
+
+void CacheCore::setLines(unsigned lines) {
+    m_lines = lines;
+    updateConfiguration();
+}
+
+void CacheCore::setWays(unsigned ways) {
+    m_ways = ways;
+    updateConfiguration();
+}
+
+void CacheCore::setInclusionPolicy(InclusionPolicy policy) {
+    m_inclusionPolicy = policy;
+    updateConfiguration();
+}
+
+void CacheCore::setWritePolicy(WritePolicy policy) {
+    m_wrPolicy = policy;
+    updateConfiguration();
+}
+
+void CacheCore::setWriteAllocatePolicy(WriteAllocPolicy policy) {
+    m_wrAllocPolicy = policy;
+    updateConfiguration();
+}
+
+void CacheCore::setReplacementPolicy(ReplPolicy policy) {
+    m_replPolicy = policy;
+    updateConfiguration();
+}
+
+void CacheCore::setPreset(const CachePreset& preset) {
+    m_blocks = preset.blocks;
+    m_ways = preset.ways;
+    m_lines = preset.lines;
+    m_wrPolicy = preset.wrPolicy;
+    m_wrAllocPolicy = preset.wrAllocPolicy;
+    m_replPolicy = preset.replPolicy;
+
+    updateConfiguration();
+}
+
+}  // namespace Ripes
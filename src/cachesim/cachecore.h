@@ -0,0 +1,711 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QDataStream>
+#include <QString>
+
+#include "cachetimeseries.h"
+#include "dramsim.h"
+#include "missclassifier.h"
+#include "prefetcher.h"
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+enum WriteAllocPolicy { WriteAllocate, NoWriteAllocate };
+enum WritePolicy { WriteThrough, WriteBack };
+enum ReplPolicy { Random, LRU, FIFO, TreePLRU, BitPLRU, SRRIP };
+enum InclusionPolicy { NonInclusive, Inclusive, Exclusive };
+
+struct CachePreset {
+    QString name;
+    int blocks;
+    int lines;
+    int ways;
+
+    WritePolicy wrPolicy;
+    WriteAllocPolicy wrAllocPolicy;
+    ReplPolicy replPolicy;
+
+    friend QDataStream& operator<<(QDataStream& arch, const CachePreset& object) {
+        arch << object.name;
+        arch << object.blocks;
+        arch << object.lines;
+        arch << object.ways;
+        arch << object.wrPolicy;
+        arch << object.wrAllocPolicy;
+        arch << object.replPolicy;
+        return arch;
+    }
+
+    friend QDataStream& operator>>(QDataStream& arch, CachePreset& object) {
+        arch >> object.name;
+        arch >> object.blocks;
+        arch >> object.lines;
+        arch >> object.ways;
+        arch >> object.wrPolicy;
+        arch >> object.wrAllocPolicy;
+        arch >> object.replPolicy;
+        return arch;
+    }
+
+    bool operator==(const CachePreset& other) const { return this->name == other.name; }
+};
+
+/**
+ * @brief The CacheCore class
+ * The state machine of a single cache: its configuration, the state of its ways, its replacement, prefetching and write
+ * buffering, its access statistics and the undo traces of its modifications. The core is independent of the processor
+ * handler and of the settings of Ripes, and performs no notifications by itself, such that it may be simulated outside
+ * of the GUI thread, e.g., when replaying a memory trace. CacheSim extends the core with the signals and bindings which
+ * attach a cache to the current processor and to the views of the cache.
+ *
+ * The environment of the cache (its word size, the text section of the current program and the number of cycles which
+ * may be undone) is set by its owner, and takes effect once the cache is reset or reconfigured.
+ */
+class CacheCore {
+public:
+    static constexpr unsigned s_invalidIndex = static_cast<unsigned>(-1);
+    static constexpr unsigned s_maxWriteBufferSize = 64;
+
+    struct CacheSize {
+        unsigned bits = 0;
+        std::vector<QString> components;
+    };
+
+    /**
+     * @brief The CacheWay struct
+     * A materialized snapshot of a single cache way. The cache simulator itself does not store its state as CacheWay
+     * objects (see m_tags et al.); CacheWay's are constructed on demand through getWay(), e.g., for the graphical view.
+     */
+    struct CacheWay {
+        VInt tag = -1;
+        std::set<unsigned> dirtyBlocks;
+        bool dirty = false;
+        bool valid = false;
+
+        // Recency rank of the way within its cache line for LRU replacement, 0 being the most recently used. Invalid
+        // ways, and ways of caches with other replacement policies, have a rank of -1.
+        unsigned lru = -1;
+
+        // True if the way holds a prefetched block which has not yet been referenced by a demand access.
+        bool prefetched = false;
+    };
+
+    struct CacheIndex {
+        unsigned line = s_invalidIndex;
+        unsigned way = s_invalidIndex;
+        unsigned block = s_invalidIndex;
+        void assertValid() const {
+            Q_ASSERT(line != s_invalidIndex && "Cache line index is invalid");
+            Q_ASSERT(way != s_invalidIndex && "Cache way index is invalid");
+            Q_ASSERT(block != s_invalidIndex && "Cache block index is invalid");
+        }
+
+        bool operator==(const CacheIndex& other) const {
+            return this->line == other.line && this->way == other.way && this->block == other.block;
+        }
+    };
+
+    struct CacheTransaction {
+        AInt address;
+        CacheIndex index;
+
+        bool isHit = false;
+        bool isWriteback = false;  // True if the transaction resulted in an eviction of a dirty cacheline
+        MemoryAccess::Type type = MemoryAccess::None;
+        bool transToValid = false;  // True if the cacheline just transitioned from invalid to valid
+        bool tagChanged = false;    // True if transToValid or the previous entry was evicted
+    };
+
+    CacheCore();
+    virtual ~CacheCore();
+
+    /**
+     * @brief setWordSize
+     * Sets the number of bytes in a word of the simulated processor. Blocks consist of words.
+     */
+    void setWordSize(unsigned bytes);
+
+    /**
+     * @brief setTextSection
+     * Sets the range of the text section of the current program, of @p bytes bytes from @p start, whose instructions
+     * are aligned to @p instrAlignment bytes. Misses and writebacks are attributed to the instructions of the text
+     * section, see getPCStats(). Without a text section, accesses are not attributed to instructions.
+     */
+    void setTextSection(AInt start, AInt bytes, unsigned instrAlignment);
+
+    /**
+     * @brief setUndoCycles
+     * Sets the number of cycles whose modifications of the cache are recorded, such that they may be undone. No
+     * modifications are recorded if @p cycles is 0.
+     */
+    void setUndoCycles(unsigned cycles) { m_undoCycles = cycles; }
+
+    /**
+     * @brief setMemoryLatency
+     * Sets the number of cycles taken by fills from main memory, for last-level caches without a DRAM model.
+     */
+    void setMemoryLatency(unsigned cycles) { m_memoryLatency = cycles; }
+
+    /**
+     * @brief resetState
+     * Invalidates all ways and clears all statistics and undo traces of the cache.
+     */
+    void resetState();
+
+    void setBlocks(unsigned blocks);
+    void setLines(unsigned lines);
+    void setWays(unsigned ways);
+    void setPreset(const CachePreset& preset);
+    void setWritePolicy(WritePolicy policy);
+    void setWriteAllocatePolicy(WriteAllocPolicy policy);
+    void setReplacementPolicy(ReplPolicy policy);
+
+    /**
+     * @brief setInclusionPolicy
+     * Sets the inclusion policy of this cache wrt. the caches in the levels above it. The policy has no effect for
+     * caches which have no caches above them (L1 caches).
+     */
+    void setInclusionPolicy(InclusionPolicy policy);
+
+    /**
+     * @brief setLatencies
+     * Sets the number of cycles required for a hit in this cache, and the number of cycles spent by this cache on a
+     * miss before the block is provided by the next level cache (or main memory, for the last-level cache). Writes and
+     * writebacks to the next level are assumed to be buffered, and do not contribute to the latency of an access.
+     */
+    void setLatencies(unsigned hitLatency, unsigned missLatency);
+
+    /**
+     * @brief setPrefetcher
+     * Attaches a prefetcher of type @p type to this cache, replacing the current prefetcher. The prefetcher is trained
+     * on the reads and writes issued to this cache, and its prefetches are filled into this cache through the next
+     * level cache. Exclusive caches, which are filled by the evictions of the levels above, do not prefetch.
+     */
+    void setPrefetcher(PrefetcherType type);
+
+    /**
+     * @brief setWriteBufferSize
+     * Places a write buffer of @p entries entries between this cache and the next level, or removes the write buffer
+     * if @p entries is 0. The writes which are written through to the next level (see request()) are coalesced by
+     * block in the buffer. A write to a block which is not buffered allocates an entry, draining the oldest entry if
+     * the buffer is full, and a fill of a buffered block drains the entry of the block before the block is fetched.
+     * Only the drained entries are issued as writes to the next level.
+     */
+    void setWriteBufferSize(unsigned entries);
+
+    /**
+     * @brief setNextLevel
+     * Sets @p cache as the next level of this cache. Misses, fills and writebacks of this cache are forwarded to the
+     * next level cache, and this cache is registered as a previous level of @p cache.
+     */
+    void setNextLevel(CacheCore* cache);
+
+    /**
+     * @brief setMainMemory
+     * Sets the DRAM model which this cache accesses when it is a last-level cache, i.e., when it has no next level
+     * cache. The model may be shared by multiple caches, and is reset and reversed by its owner rather than through the
+     * cache hierarchy. Without a DRAM model, fills from main memory take a fixed number of cycles (see
+     * RIPES_SETTING_CACHE_MEMLATENCY).
+     */
+    void setMainMemory(const std::shared_ptr<DRAMSim>& memory) { m_mainMemory = memory; }
+
+    /**
+     * @brief access
+     * Accesses the cache as if the access occurred in @p cycle. Used when the cache is driven by a recorded memory
+     * trace rather than the current processor. @p pc is the program counter of the accessing instruction, if known,
+     * which is used for training PC-indexed prefetchers.
+     * @returns the latency of the access in cycles, see setLatencies(). Demand accesses to prefetched blocks whose fill
+     * has not yet completed wait for the remainder of the fill.
+     */
+    unsigned access(AInt address, MemoryAccess::Type type, unsigned cycle, AInt pc = 0);
+    void undo();
+
+    /**
+     * @brief undoCycle
+     * Undoes all modifications of the cache which were performed in @p cycle, which must be the most recent cycle
+     * wherein the cache was modified.
+     */
+    void undoCycle(unsigned cycle);
+
+    WriteAllocPolicy getWriteAllocPolicy() const { return m_wrAllocPolicy; }
+    ReplPolicy getReplacementPolicy() const { return m_replPolicy; }
+    WritePolicy getWritePolicy() const { return m_wrPolicy; }
+    InclusionPolicy getInclusionPolicy() const { return m_inclusionPolicy; }
+    unsigned getHitLatency() const { return m_hitLatency; }
+    unsigned getMissLatency() const { return m_missLatency; }
+    PrefetcherType getPrefetcherType() const { return m_prefetcher ? m_prefetcher->type() : PrefetcherType::None; }
+    /**
+     * @brief getPrefetcher
+     * @returns the prefetcher attached to this cache, or nullptr if the cache does not prefetch.
+     */
+    const Prefetcher* getPrefetcher() const { return m_prefetcher.get(); }
+    unsigned getWriteBufferSize() const { return m_writeBufferSize; }
+
+    const CacheTimeSeries& getAccessTrace() const { return m_accessTrace; }
+
+    double getHitRate() const;
+    unsigned getHits() const;
+    unsigned getMisses() const;
+    unsigned getWritebacks() const;
+    /**
+     * @brief getCoalescedWrites
+     * @returns the number of writes which were coalesced with a write to the same block in the write buffer. With a
+     * write buffer, getWritebacks() only counts the writes which were issued to the next level.
+     */
+    unsigned getCoalescedWrites() const;
+    unsigned getMisses(MissClass missClass) const;
+    /**
+     * @brief getLineMisses
+     * @returns the number of misses of class @p missClass which occurred in cache line @p lineIdx.
+     */
+    unsigned getLineMisses(unsigned lineIdx, MissClass missClass) const { return m_lineMisses[lineIdx][missClass]; }
+
+    /**
+     * @brief The PCStats struct
+     * The misses and writebacks of the cache which were caused by the accesses of a single instruction.
+     */
+    struct PCStats {
+        unsigned misses = 0;
+        unsigned writebacks = 0;
+    };
+
+    /**
+     * @brief getPCStats
+     * @returns the misses and writebacks of this cache attributed to the instruction at @p pc. Accesses are attributed
+     * to the instruction which issued them to the L1 cache; only instructions within the text section of the current
+     * program are tracked.
+     */
+    PCStats getPCStats(AInt pc) const {
+        const uint32_t pcIdx = pcIndex(pc);
+        return pcIdx == s_noPC ? PCStats() : m_pcStats[pcIdx];
+    }
+    /**
+     * @brief getPCProfile
+     * @returns the instructions which caused misses or writebacks in this cache, in order of their address.
+     */
+    std::vector<std::pair<AInt, PCStats>> getPCProfile() const;
+    CacheSize getCacheSize() const;
+
+    AInt buildAddress(unsigned tag, unsigned lineIdx, unsigned blockIdx) const;
+
+    int getBlockBits() const { return m_blocks; }
+    int getWaysBits() const { return m_ways; }
+    int getLineBits() const { return m_lines; }
+    int getTagBits() const { return 32 - 2 /*byte offset*/ - getBlockBits() - getLineBits(); }
+
+    int getBlocks() const { return 1 << m_blocks; }
+    unsigned getBlockBytes() const { return 1 << (m_byteOffset + m_blocks); }
+    int getWays() const { return 1 << m_ways; }
+    int getLines() const { return 1 << m_lines; }
+    unsigned getBlockMask() const { return m_blockMask; }
+    unsigned getTagMask() const { return m_tagMask; }
+    unsigned getLineMask() const { return m_lineMask; }
+
+    unsigned getLineIdx(const AInt address) const;
+    unsigned getBlockIdx(const AInt address) const;
+    unsigned getTag(const AInt address) const;
+
+    /**
+     * @brief getWay
+     * @returns a snapshot of the way at @p wayIdx in cache line @p lineIdx.
+     */
+    CacheWay getWay(unsigned lineIdx, unsigned wayIdx) const;
+    bool isWayValid(unsigned lineIdx, unsigned wayIdx) const { return m_valid[entryIdx(lineIdx, wayIdx)]; }
+    bool isWayDirty(unsigned lineIdx, unsigned wayIdx) const;
+    unsigned getWayLRU(unsigned lineIdx, unsigned wayIdx) const;
+    bool isWayPrefetched(unsigned lineIdx, unsigned wayIdx) const { return m_prefetched[entryIdx(lineIdx, wayIdx)]; }
+    unsigned getWayDirtyBlocks(unsigned lineIdx, unsigned wayIdx) const;
+    unsigned getLineValidWays(unsigned lineIdx) const { return m_validWays[lineIdx]; }
+
+protected:
+    /**
+     * @brief Notifications
+     * Called when the cache is reconfigured, when @p transaction modified the cache, when way @p wayIdx of cache line
+     * @p lineIdx was modified otherwise, and when the access statistics of the cache changed.
+     */
+    virtual void notifyConfigurationChanged() {}
+    virtual void notifyTransaction(const CacheTransaction& /*transaction*/) {}
+    virtual void notifyWayChanged(unsigned /*lineIdx*/, unsigned /*wayIdx*/) {}
+    virtual void notifyStatisticsChanged() {}
+
+    /**
+     * @brief updateConfiguration
+     * Called whenever one of the cache parameters changes. Notifies that the configuration changed after updating.
+     */
+    void updateConfiguration();
+
+private:
+    /**
+     * @brief The CacheTrace struct
+     * A packed undo record of a single modification of the cache; either an access, a prefetch or the invalidation of
+     * a way. Only the state of the modified way prior to the modification is recorded; the dirty block mask of the way
+     * is stored separately in m_traceDirtyMasks, at the same slot index as the record. The undo records of the miss
+     * classifier and of drained write buffer entries are only recorded by some traces, and are stored in the side rings
+     * m_missRecords and m_drains, as indicated by the flags of the trace.
+     */
+    struct CacheTrace {
+        enum Flags : uint16_t {
+            IsHit = 0b1,
+            IsWriteback = 0b10,
+            TransToValid = 0b100,
+            TagChanged = 0b1000,
+            IsAccess = 0b10000,            // The record is accounted for in the access statistics
+            Invalidation = 0b100000,       // The record is an invalidation of a way, rather than an access
+            Prefetch = 0b1000000,          // The record is a prefetch, rather than an access
+            WasPrefetched = 0b10000000,    // The way held an unreferenced prefetched block prior to the modification
+            Trained = 0b100000000,         // The access trained the prefetcher of the cache
+            WriteBuffered = 0b1000000000,  // The access allocated the newest entry of the write buffer
+            WriteDrained = 0b10000000000,  // The access drained a write buffer entry, recorded in m_drains
+            Classified = 0b100000000000    // The access modified the miss classifier, recorded in m_missRecords
+        };
+        static constexpr uint16_t s_invalidWay = UINT16_MAX;
+
+        AInt address;
+        unsigned cycle;
+        unsigned line;
+        unsigned prevTag;
+        uint32_t replUndo;           // Undo record of the replacement state update, see updateReplState()
+        unsigned prevPrefetchReady;  // Fill completion cycle of the way prior to the modification
+        uint32_t pcIdx;              // Index of the accessing instruction in m_pcStats, or s_noPC
+        uint16_t way;                // Ways are limited to 2^10, so 16 bits are sufficient.
+        uint16_t flags;
+        uint8_t type;
+    };
+
+    /**
+     * @brief The TraceRing struct
+     * A ring buffer of the data which only some of the traces record. Entries are pushed and popped alongside their
+     * traces, such that the newest entry belongs to the newest trace recording one. With the capacity of m_traces, the
+     * entries of all traces which may be undone are retained.
+     */
+    template <typename T>
+    struct TraceRing {
+        std::vector<T> entries;
+        unsigned head = 0;
+
+        void reset(unsigned capacity) {
+            entries.resize(std::max(1u, capacity));
+            head = 0;
+        }
+        T& push() {
+            T& entry = entries[head];
+            head = (head + 1) % entries.size();
+            return entry;
+        }
+        const T& pop() {
+            head = (head + entries.size() - 1) % entries.size();
+            return entries[head];
+        }
+    };
+
+    /**
+     * @brief The Request enum
+     * Requests which may be issued to a cache. Read and Write requests originate from either the processor or from
+     * fills and write-throughs of the cache levels above. Writeback and CleanEviction requests carry blocks evicted
+     * from the cache levels above; clean evictions are only issued to exclusive caches. Prefetch requests are issued by
+     * the prefetcher of the cache itself, and are not accounted for in the access statistics.
+     */
+    enum class Request { Read, Write, Writeback, CleanEviction, Prefetch };
+
+    struct Eviction {
+        bool valid = false;
+        bool dirty = false;
+        AInt address = 0;
+    };
+
+    unsigned request(AInt address, Request request, unsigned cycle, AInt pc);
+    bool isExclusive() const { return m_inclusionPolicy == InclusionPolicy::Exclusive && !m_prevLevels.empty(); }
+
+    /**
+     * @brief invalidateBlocks
+     * Invalidates all blocks in this cache and in the cache levels above it which overlap the @p bytes bytes starting
+     * at @p address. Used for back-invalidation in inclusive caches.
+     * @returns true if any of the invalidated blocks were dirty.
+     */
+    bool invalidateBlocks(AInt address, unsigned bytes, unsigned cycle);
+    void invalidateWay(unsigned lineIdx, unsigned wayIdx, unsigned cycle);
+
+    /**
+     * @brief The ReplUpdate enum
+     * Updates of the replacement state of a cache line: a hit on a way, the fill of an invalid way, or the replacement
+     * of a valid way.
+     */
+    enum class ReplUpdate { Hit, Fill, Replace };
+
+    unsigned locateEvictionWay(const CacheTransaction& transaction) const;
+
+    /**
+     * @brief updateReplState
+     * Updates the replacement state of cache line @p lineIdx following @p update of way @p wayIdx.
+     * @returns a policy-specific undo record, from which revertReplState() restores the replacement state.
+     */
+    uint32_t updateReplState(unsigned lineIdx, unsigned wayIdx, ReplUpdate update);
+    void revertReplState(unsigned lineIdx, unsigned wayIdx, ReplUpdate update, uint32_t undo);
+
+    /**
+     * @brief randomWay
+     * @returns the way to replace for the next random replacement. Ways are drawn from a per-cache pseudo-random
+     * sequence, indexed by the number of random replacements performed since the last reset. Given that undoing a
+     * replacement rewinds the sequence, a simulation replays identically after being reversed.
+     */
+    unsigned randomWay() const;
+    Eviction evictAndUpdate(CacheTransaction& transaction, unsigned traceSlot);
+    void recordWayState(unsigned traceSlot, unsigned lineIdx, unsigned wayIdx);
+    void analyzeCacheAccess(CacheTransaction& transaction) const;
+    void pushAccessTrace(const CacheTransaction& transaction, MissClass missClass, bool coalesced, unsigned cycle);
+    void popAccessTrace();
+
+    void recalculateMasks();
+
+    /**
+     * @brief reinitializeState
+     * (Re)sizes the cache state arrays to the current cache geometry and invalidates all ways.
+     */
+    void reinitializeState();
+
+    /**
+     * @brief entryIdx
+     * @returns the index of way @p wayIdx in cache line @p lineIdx within the flat cache state arrays.
+     */
+    unsigned entryIdx(unsigned lineIdx, unsigned wayIdx) const { return (lineIdx << m_ways) + wayIdx; }
+    uint64_t* dirtyMask(unsigned entry) { return &m_dirtyMasks[entry * m_dirtyWords]; }
+    const uint64_t* dirtyMask(unsigned entry) const { return &m_dirtyMasks[entry * m_dirtyWords]; }
+    uint64_t* traceDirtyMask(unsigned slot) { return &m_traceDirtyMasks[slot * m_dirtyWords]; }
+    AInt blockAddress(AInt address) const { return address & ~static_cast<AInt>(getBlockBytes() - 1); }
+
+    ReplPolicy m_replPolicy = ReplPolicy::LRU;
+    WritePolicy m_wrPolicy = WritePolicy::WriteBack;
+    WriteAllocPolicy m_wrAllocPolicy = WriteAllocPolicy::WriteAllocate;
+    InclusionPolicy m_inclusionPolicy = InclusionPolicy::NonInclusive;
+    unsigned m_hitLatency = 1;
+    unsigned m_missLatency = 1;
+    unsigned m_memoryLatency = 0;
+    std::shared_ptr<DRAMSim> m_mainMemory;
+
+    /**
+     * @brief m_nextLevel, m_prevLevels
+     * The next level cache of this cache, if any, and the caches which have this cache as their next level cache.
+     */
+    CacheCore* m_nextLevel = nullptr;
+    std::vector<CacheCore*> m_prevLevels;
+
+    unsigned m_blockMask = -1;
+    unsigned m_lineMask = -1;
+    unsigned m_tagMask = -1;
+
+    int m_blocks = 2;           // Some power of 2
+    int m_lines = 5;            // Some power of 2
+    int m_ways = 0;             // Some power of 2
+    unsigned m_byteOffset = 2;  // # of bits to represent the # of bytes in a word
+    unsigned m_wordBits = 32;
+
+    /**
+     * @brief Cache state
+     * The state of the cache is stored as a set of flat arrays, each holding getLines() x getWays() entries. Entries
+     * are stored line-major, such that all ways of a cache line are contiguous in memory (see entryIdx()). This keeps
+     * the per-access working set to a few cache-resident loads, and allows for the tag comparison across all ways of a
+     * line to be vectorized.
+     * Dirty blocks are stored as a bitmask of m_dirtyWords 64-bit words per entry.
+     */
+    std::vector<unsigned> m_tags;
+    std::vector<uint8_t> m_valid;
+    std::vector<uint64_t> m_dirtyMasks;
+    unsigned m_dirtyWords = 1;
+
+    /**
+     * @brief m_validWays
+     * The number of valid ways in each cache line. Invalid ways are always replaced first; only lines with invalid
+     * ways must be searched for these.
+     */
+    std::vector<uint16_t> m_validWays;
+
+    /**
+     * @brief Replacement state
+     * The replacement state of each cache line is, depending on the replacement policy:
+     * - LRU, FIFO: a doubly linked list of the ways of the line, ordered from the most to the least recently
+     *   used/inserted way (m_replLinks and m_replLists).
+     * - TreePLRU: a binary tree of getWays() - 1 bits in heap order, each bit pointing towards the subtree to replace
+     *   next.
+     * - BitPLRU: a bit per way, set when the way is accessed. Once all bits are set, all bits but the accessed are
+     *   cleared.
+     * - SRRIP: a bitmask for each of the 4 re-reference prediction values, holding the ways with that prediction
+     *   value.
+     * Bits are stored as m_replWords 64-bit words per line (times 4 for SRRIP) in m_replBits. Updates and the selection
+     * of a way to evict thus require a constant number of operations, regardless of the associativity of the cache
+     * (up to 64 ways; a word per 64 ways beyond that).
+     */
+    struct ReplLink {
+        uint16_t prev;  // Towards the most recently used way
+        uint16_t next;  // Towards the least recently used way
+    };
+    struct ReplList {
+        uint16_t head;  // Most recently used way
+        uint16_t tail;  // Least recently used way
+    };
+    static constexpr uint16_t s_noWay = UINT16_MAX;
+    std::vector<ReplLink> m_replLinks;
+    std::vector<ReplList> m_replLists;
+    std::vector<uint64_t> m_replBits;
+    unsigned m_replWords = 1;
+    uint64_t* replBits(unsigned lineIdx) { return &m_replBits[lineIdx * m_replWords * replBitmasks()]; }
+    const uint64_t* replBits(unsigned lineIdx) const { return &m_replBits[lineIdx * m_replWords * replBitmasks()]; }
+    unsigned replBitmasks() const { return m_replPolicy == ReplPolicy::SRRIP ? 4 : 1; }
+
+    void unlinkWay(unsigned lineIdx, unsigned wayIdx);
+    /**
+     * @brief linkWay
+     * Inserts @p wayIdx in the replacement list of @p lineIdx before way @p nextIdx, or as the least recently used way
+     * if @p nextIdx is s_noWay.
+     */
+    void linkWay(unsigned lineIdx, unsigned wayIdx, unsigned nextIdx);
+
+    static constexpr uint64_t s_randomSeed = 0x5eed5eed5eed5eed;
+    uint64_t m_randomReplacements = 0;
+
+    /**
+     * @brief m_missClassifier
+     * Classifies each miss of the cache as a compulsory, capacity or conflict miss. The classifier is accessed by all
+     * requests to the cache, and its accesses are undone alongside the traces of the cache. m_lineMisses holds the
+     * number of misses of each class per cache line.
+     */
+    MissClassifier m_missClassifier;
+    std::vector<std::array<unsigned, NMissClasses>> m_lineMisses;
+
+    /**
+     * @brief m_prefetcher
+     * The prefetcher attached to this cache, if any. Trainings of the prefetcher are undone alongside the traces of the
+     * accesses which trained it. m_prefetched marks the entries holding a prefetched block which has not yet been
+     * referenced, and m_prefetchReady holds the cycle in which the most recent prefetch fill of each entry completes.
+     */
+    std::unique_ptr<Prefetcher> m_prefetcher;
+    std::vector<AInt> m_prefetchCandidates;
+    std::vector<uint8_t> m_prefetched;
+    std::vector<unsigned> m_prefetchReady;
+
+    /**
+     * @brief m_writeBuffer
+     * The entries of the write buffer, from the oldest to the most recently allocated entry. Each entry holds a block
+     * address and the program counter of the write which allocated the entry. Buffers are small (see
+     * s_maxWriteBufferSize), such that the buffer is searched linearly.
+     */
+    struct WriteBufferEntry {
+        AInt block;
+        AInt pc;
+    };
+    std::vector<WriteBufferEntry> m_writeBuffer;
+    unsigned m_writeBufferSize = 0;
+
+    /**
+     * @brief drainWriteBuffer
+     * Removes the write buffer entry at @p pos, recording the entry for trace @p traceSlot.
+     */
+    WriteBufferEntry drainWriteBuffer(unsigned pos, unsigned traceSlot);
+    unsigned findWriteBufferEntry(AInt block) const;
+
+    /**
+     * @brief m_pcStats
+     * Misses and writebacks of the accesses of this cache, attributed to the instructions which issued them. A flat
+     * array with an entry per instruction slot of the text section of the current program, starting at m_pcBase;
+     * m_pcShift is log2 of the instruction alignment. Reallocated for the current text section (see setTextSection())
+     * when the cache is reset, e.g., when a new program is loaded.
+     */
+    std::vector<PCStats> m_pcStats;
+    AInt m_pcBase = 0;
+    unsigned m_pcShift = 0;
+    AInt m_textBytes = 0;
+    static constexpr uint32_t s_noPC = UINT32_MAX;
+    uint32_t pcIndex(AInt pc) const {
+        const AInt pcIdx = (pc - m_pcBase) >> m_pcShift;
+        return pc >= m_pcBase && pcIdx < m_pcStats.size() ? static_cast<uint32_t>(pcIdx) : s_noPC;
+    }
+
+    /**
+     * @brief m_accessTrace
+     * The access trace contains cumulative cache access statistics for each simulation cycle wherein the cache was
+     * accessed. Contrary to the trace ring buffer (m_traces), the access trace is not bounded by the undo stack size.
+     */
+    CacheTimeSeries m_accessTrace;
+
+    /**
+     * @brief m_traces
+     * The following information is used to track all most-recent modifications made to the cache. The traces are
+     * stored in a ring buffer with a capacity of tracesPerCycle() times the number of cycles which may be undone
+     * (m_undoCycles), which is allocated once per cache configuration. Without undo cycles, the ring buffer holds a
+     * single slot to which the trace of each modification is written, and from which no traces may be undone. Multiple
+     * traces may be recorded in a single cycle when the cache is accessed by multiple caches above it, when ways are
+     * invalidated by the cache levels below it, or when prefetches are issued. Storing all modifications allows us to
+     * rollback any changes performed to the cache, when clock cycles are undone.
+     * m_traceHead is the slot of the next trace to be pushed, and m_traceCount the number of traces which may
+     * currently be undone.
+     */
+    std::vector<CacheTrace> m_traces;
+    std::vector<uint64_t> m_traceDirtyMasks;
+
+    /**
+     * @brief m_missRecords, m_drains
+     * Side rings of the traces flagged as Classified and WriteDrained, respectively. Classifier records which do not
+     * modify the classifier are not recorded. The drain ring is only allocated with a write buffer.
+     */
+    struct DrainRecord {
+        WriteBufferEntry entry;
+        unsigned pos;  // Position of the drained entry in the write buffer
+    };
+    TraceRing<MissClassifier::Record> m_missRecords;
+    TraceRing<DrainRecord> m_drains;
+    unsigned m_traceHead = 0;
+    unsigned m_traceCount = 0;
+    unsigned m_traceCapacity = 0;
+    unsigned m_undoCycles = 0;
+
+    /**
+     * @brief requestsPerCycle
+     * @returns an upper bound of the requests to this cache within a single cycle, including its prefetches. The L1
+     * caches are accessed once per cycle, and each request to a cache issues at most s_requestsPerRequest requests to
+     * the level below it.
+     */
+    unsigned requestsPerCycle() const;
+    static constexpr unsigned s_requestsPerRequest = 3;
+
+    /**
+     * @brief tracesPerCycle
+     * @returns an upper bound of the traces recorded by this cache within a single cycle, for the cache hierarchy and
+     * the configurations of the caches at the time of calling.
+     */
+    unsigned tracesPerCycle() const;
+
+    /**
+     * @brief pushTrace/popTrace
+     * @returns the ring buffer slot of the pushed or popped trace. The flags of a pushed trace are cleared. Once the
+     * ring buffer is full, a pushed trace overwrites the oldest trace, and the remaining traces of the cycle of the
+     * latter are dropped, such that no cycle is partially undone.
+     */
+    unsigned pushTrace();
+    unsigned popTrace();
+    CacheTransaction decodeTrace(const CacheTrace& trace) const;
+};
+
+const static std::map<ReplPolicy, QString> s_cacheReplPolicyStrings{
+    {ReplPolicy::Random, "Random"},       {ReplPolicy::LRU, "LRU"},          {ReplPolicy::FIFO, "FIFO"},
+    {ReplPolicy::TreePLRU, "Tree-PLRU"}, {ReplPolicy::BitPLRU, "Bit-PLRU"}, {ReplPolicy::SRRIP, "SRRIP"}};
+const static std::map<WriteAllocPolicy, QString> s_cacheWriteAllocateStrings{
+    {WriteAllocPolicy::WriteAllocate, "Write allocate"},
+    {WriteAllocPolicy::NoWriteAllocate, "No write allocate"}};
+
+const static std::map<WritePolicy, QString> s_cacheWritePolicyStrings{{WritePolicy::WriteThrough, "Write-through"},
+                                                                      {WritePolicy::WriteBack, "Write-back"}};
+
+const static std::map<InclusionPolicy, QString> s_cacheInclusionPolicyStrings{
+    {InclusionPolicy::NonInclusive, "Non-inclusive"},
+    {InclusionPolicy::Inclusive, "Inclusive"},
+    {InclusionPolicy::Exclusive, "Exclusive"}};
+
+}  // namespace Ripes
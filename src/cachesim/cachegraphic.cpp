@@ -3,22 +3,29 @@
 #include <QGraphicsLineItem>
 #include <QGraphicsRectItem>
 #include <QGraphicsScene>
+#include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSimpleTextItem>
+#include <QPainter>
 #include <QPen>
+#include <QStyleOptionGraphicsItem>
 
+#include <algorithm>
+#include <cmath>
+
+#include "colors.h"
 #include "processorhandler.h"
 #include "radix.h"
+#include "ripessettings.h"
 
 namespace {
 
-// Return a set of all keys in a map
-template <typename TK, typename TV>
-std::set<TK> keys(std::map<TK, TV> const& input_map) {
-    std::set<TK> keyset;
-    for (auto const& element : input_map) {
-        keyset.insert(element.first);
+// Return the number of misses of all classes in a cache line
+unsigned lineMisses(const Ripes::CacheSim& cache, unsigned lineIdx) {
+    unsigned misses = 0;
+    for (const auto& missClass : Ripes::s_cacheMissClassStrings) {
+        misses += cache.getLineMisses(lineIdx, missClass.first);
     }
-    return keyset;
+    return misses;
 }
 }  // namespace
 
@@ -73,172 +80,382 @@ private:
 };
 
 CacheGraphic::CacheGraphic(CacheSim& cache) : QGraphicsObject(nullptr), m_cache(cache), m_fm(m_font) {
+    // The exposed area is required to only paint the visible cache lines, see paint()
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    // Tooltips of the cache lines are determined on hovering, see hoverMoveEvent()
+    setAcceptHoverEvents(true);
+
     // Connect to CacheSim::dataChanged using QueuedConnection, to ensure allow for cross thread signalling (CacheSim is
     // executed in the same thread as the simulator).
     connect(&cache, &CacheSim::dataChanged, this, &CacheGraphic::dataChanged, Qt::QueuedConnection);
     connect(&cache, &CacheSim::wayInvalidated, this, &CacheGraphic::wayInvalidated);
     connect(&cache, &CacheSim::cacheInvalidated, this, &CacheGraphic::cacheInvalidated);
+    connect(&cache, &CacheSim::hitrateChanged, this, &CacheGraphic::updateMissHeatmap);
+
+    m_missHeatmapVisible = RipesSettings::value(RIPES_SETTING_CACHE_MISSHEATMAP).toBool();
+    connect(RipesSettings::getObserver(RIPES_SETTING_CACHE_MISSHEATMAP), &SettingObserver::modified, this,
+            [=](const QVariant& value) { setMissHeatmapVisible(value.toBool()); });
 
     cacheInvalidated();
 }
 
-void CacheGraphic::updateLineReplFields(unsigned lineIdx) {
-    auto* cacheLine = m_cache.getLine(lineIdx);
+void CacheGraphic::setMissHeatmapVisible(bool visible) {
+    m_missHeatmapVisible = visible;
+    update(m_bodyRect);
+}
 
-    if (cacheLine == nullptr) {
-        // Nothing to do
-        return;
+void CacheGraphic::updateMissHeatmap() {
+    // The miss counters of the cache lines have changed; the bounds of the counters are recalculated once required by
+    // the next paint.
+    m_lineMissBoundsValid = false;
+    if (m_missHeatmapVisible || m_summaryPainted) {
+        update(m_bodyRect);
     }
+}
 
-    if (m_cacheTextItems.at(0).at(0).lru == nullptr) {
-        // The current cache configuration does not have any replacement field
+void CacheGraphic::updateLineMissBounds() {
+    if (m_lineMissBoundsValid) {
         return;
     }
 
-    for (const auto& way : m_cacheTextItems[lineIdx]) {
-        // If LRU was just initialized, the actual (software) LRU value may be very large. Mask to the
-        // number of actual LRU bits.
-        unsigned lruVal = cacheLine->at(way.first).lru;
-        lruVal &= vsrtl::generateBitmask(m_cache.getWaysBits());
-        const QString lruText = QString::number(lruVal);
-        way.second.lru->setText(lruText);
-
-        // LRU text might have changed; update LRU field position to center in column
-        const qreal y = lineIdx * m_lineHeight + way.first * m_setHeight;
-        const qreal x = m_widthBeforeLRU + m_lruWidth / 2 - m_fm.width(lruText) / 2;
+    m_maxLineMisses = 0;
+    m_maxLineConflicts = 0;
+    for (int lineIdx = 0; lineIdx < m_cache.getLines(); lineIdx++) {
+        m_maxLineMisses = std::max(m_maxLineMisses, lineMisses(m_cache, lineIdx));
+        m_maxLineConflicts = std::max(m_maxLineConflicts, m_cache.getLineMisses(lineIdx, MissClass::Conflict));
+    }
+    m_lineMissBoundsValid = true;
+}
 
-        way.second.lru->setPos(x, y);
+QString CacheGraphic::lineToolTip(unsigned lineIdx) const {
+    QStringList tooltip;
+    if (m_summaryPainted) {
+        unsigned dirtyBlocks = 0;
+        for (int wayIdx = 0; wayIdx < m_cache.getWays(); wayIdx++) {
+            dirtyBlocks += m_cache.getWayDirtyBlocks(lineIdx, wayIdx);
+        }
+        tooltip << "Line " + QString::number(lineIdx);
+        tooltip << "Valid ways: " + QString::number(m_cache.getLineValidWays(lineIdx)) + "/" +
+                       QString::number(m_cache.getWays());
+        if (m_hasDirtyColumn) {
+            tooltip << "Dirty blocks: " + QString::number(dirtyBlocks) + "/" +
+                           QString::number(m_cache.getWays() * m_cache.getBlocks());
+        }
+    }
+    for (const auto& missClass : s_cacheMissClassStrings) {
+        tooltip << missClass.second + " misses: " + QString::number(m_cache.getLineMisses(lineIdx, missClass.first));
     }
+    return tooltip.join("\n");
 }
 
 QString CacheGraphic::addressString() const {
     return "0x" + QString("0").repeated(ProcessorHandler::currentISA()->bytes() * 2);
 }
 
-void CacheGraphic::updateWay(unsigned lineIdx, unsigned wayIdx) {
-    const auto& it = m_cacheTextItems.find(lineIdx);
-    if (it == m_cacheTextItems.end()) {
+CacheSim::CacheIndex CacheGraphic::indexAt(const QPointF& pos) const {
+    CacheSim::CacheIndex index;
+    if (pos.x() < 0 || pos.x() >= m_cacheWidth || pos.y() < 0 || pos.y() >= m_cacheHeight) {
+        return index;
+    }
+
+    index.line = std::min(static_cast<int>(pos.y() / m_lineHeight), m_cache.getLines() - 1);
+    index.way = std::min(static_cast<int>((pos.y() - index.line * m_lineHeight) / m_setHeight), m_cache.getWays() - 1);
+    if (pos.x() >= m_widthBeforeBlocks) {
+        index.block =
+            std::min(static_cast<int>((pos.x() - m_widthBeforeBlocks) / m_blockWidth), m_cache.getBlocks() - 1);
+    }
+    return index;
+}
+
+std::optional<AInt> CacheGraphic::blockAddressAt(const QPointF& pos) const {
+    const CacheSim::CacheIndex index = indexAt(pos);
+    if (index.block == CacheSim::s_invalidIndex || !m_cache.isWayValid(index.line, index.way)) {
+        return {};
+    }
+    return m_cache.buildAddress(m_cache.getWay(index.line, index.way).tag, index.line, index.block);
+}
+
+QRectF CacheGraphic::lineRect(unsigned lineIdx) const {
+    return QRectF(0, lineIdx * m_lineHeight, m_cacheWidth, m_lineHeight);
+}
+
+QRectF CacheGraphic::wayRect(unsigned lineIdx, unsigned wayIdx) const {
+    return QRectF(0, lineIdx * m_lineHeight + wayIdx * m_setHeight, m_cacheWidth, m_setHeight);
+}
+
+QRectF CacheGraphic::blockRect(unsigned lineIdx, unsigned wayIdx, unsigned blockIdx) const {
+    return QRectF(m_widthBeforeBlocks + blockIdx * m_blockWidth, lineIdx * m_lineHeight + wayIdx * m_setHeight,
+                  m_blockWidth, m_setHeight);
+}
+
+void CacheGraphic::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
+    // Only the cache lines, and block columns, which intersect the exposed area are painted.
+    const QRectF rect = option->exposedRect.intersected(m_bodyRect);
+    if (rect.isEmpty()) {
         return;
     }
-    const auto& wayIt = it->second.find(wayIdx);
-    if (wayIt == it->second.end()) {
+    const auto lineAt = [=](qreal y) {
+        return std::clamp(static_cast<int>(std::floor(y / m_lineHeight)), 0, m_cache.getLines() - 1);
+    };
+    const auto blockAt = [=](qreal x) {
+        return std::clamp(static_cast<int>(std::floor((x - m_widthBeforeBlocks) / m_blockWidth)), 0,
+                          m_cache.getBlocks() - 1);
+    };
+    const int firstLine = lineAt(rect.top());
+    const int lastLine = lineAt(rect.bottom());
+    const int firstBlock = blockAt(rect.left());
+    const int lastBlock = blockAt(rect.right());
+
+    // Determine the level of detail from the scale at which the cache is drawn. Once the text of the cache is too
+    // small to be read, the cache lines are drawn as summary rows, each spanning at least a single device pixel.
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    m_summaryPainted = m_setHeight * lod < s_minTextHeight;
+    const int linesPerRow = m_summaryPainted ? std::max(1, static_cast<int>(1 / (m_lineHeight * lod))) : 1;
+
+    if (m_missHeatmapVisible || m_summaryPainted) {
+        updateLineMissBounds();
+    }
+    if (m_missHeatmapVisible) {
+        paintMissHeatmap(painter, firstLine, lastLine, linesPerRow);
+    }
+    if (m_summaryPainted) {
+        paintLineSummaries(painter, firstLine, lastLine, linesPerRow);
+    }
+    paintHighlighting(painter);
+    if (!m_summaryPainted) {
+        paintWays(painter, firstLine, lastLine, firstBlock, lastBlock);
+    }
+    // Separators between the cache lines are omitted once these would be drawn within a few pixels of each other
+    paintGrid(painter, rect, firstLine, lastLine, !m_summaryPainted, m_lineHeight * lod >= s_minTextHeight);
+}
+
+void CacheGraphic::paintMissHeatmap(QPainter* painter, int firstLine, int lastLine, int linesPerRow) {
+    if (m_maxLineConflicts == 0) {
         return;
     }
-    CacheWay& way = wayIt->second;
 
-    CacheSim::CacheWay simWay = CacheSim::CacheWay();
+    // A summary row is shaded by the cache line with the most conflict misses among its lines
+    for (int rowLine = firstLine - firstLine % linesPerRow; rowLine <= lastLine; rowLine += linesPerRow) {
+        const int rowLines = std::min(linesPerRow, m_cache.getLines() - rowLine);
+        unsigned conflicts = 0;
+        for (int lineIdx = rowLine; lineIdx < rowLine + rowLines; lineIdx++) {
+            conflicts = std::max(conflicts, m_cache.getLineMisses(lineIdx, MissClass::Conflict));
+        }
+        if (conflicts > 0) {
+            painter->setOpacity(0.6 * conflicts / m_maxLineConflicts);
+            painter->fillRect(QRectF(0, rowLine * m_lineHeight, m_cacheWidth, rowLines * m_lineHeight), Qt::red);
+        }
+    }
+    painter->setOpacity(1);
+}
 
-    if (auto* cacheLine = m_cache.getLine(lineIdx)) {
-        simWay = cacheLine->at(wayIdx);
-    };
+void CacheGraphic::paintLineSummaries(QPainter* painter, int firstLine, int lastLine, int linesPerRow) {
+    for (int rowLine = firstLine - firstLine % linesPerRow; rowLine <= lastLine; rowLine += linesPerRow) {
+        const int rowLines = std::min(linesPerRow, m_cache.getLines() - rowLine);
+        unsigned validWays = 0;
+        unsigned dirtyBlocks = 0;
+        unsigned misses = 0;
+        for (int lineIdx = rowLine; lineIdx < rowLine + rowLines; lineIdx++) {
+            validWays += m_cache.getLineValidWays(lineIdx);
+            misses += lineMisses(m_cache, lineIdx);
+            if (m_hasDirtyColumn) {
+                for (int wayIdx = 0; wayIdx < m_cache.getWays(); wayIdx++) {
+                    dirtyBlocks += m_cache.getWayDirtyBlocks(lineIdx, wayIdx);
+                }
+            }
+        }
 
+        const qreal y = rowLine * m_lineHeight;
+        const qreal height = rowLines * m_lineHeight;
+        const unsigned ways = rowLines * m_cache.getWays();
+
+        // Control bit columns: fraction of valid ways
+        if (validWays > 0) {
+            painter->setOpacity(0.6 * validWays / ways);
+            painter->fillRect(QRectF(0, y, m_widthBeforeTag, height), Qt::darkGreen);
+        }
+
+        // Tag column: misses of the lines, i.e., the rate at which new tags are brought into the lines, relative to
+        // the cache line with the most misses
+        if (misses > 0) {
+            painter->setOpacity(0.6 * misses / (static_cast<qreal>(m_maxLineMisses) * rowLines));
+            painter->fillRect(QRectF(m_widthBeforeTag, y, m_tagWidth, height), Qt::darkMagenta);
+        }
+
+        // Block columns: fraction of dirty blocks
+        if (dirtyBlocks > 0) {
+            painter->setOpacity(0.6 * dirtyBlocks / (static_cast<qreal>(ways) * m_cache.getBlocks()));
+            painter->fillRect(QRectF(m_widthBeforeBlocks, y, m_cacheWidth - m_widthBeforeBlocks, height),
+                              Qt::darkCyan);
+        }
+    }
+    painter->setOpacity(1);
+}
+
+void CacheGraphic::paintWays(QPainter* painter, int firstLine, int lastLine, int firstBlock, int lastBlock) {
     const unsigned bytes = ProcessorHandler::currentISA()->bytes();
-    // ======================== Update block text fields ======================
-    if (simWay.valid) {
-        for (int i = 0; i < m_cache.getBlocks(); ++i) {
-            QGraphicsSimpleTextItem* blockTextItem = nullptr;
-            if (way.blocks.count(i) == 0) {
-                // Block text item has not yet been created
-                const qreal x =
-                    m_widthBeforeBlocks + i * m_blockWidth + (m_blockWidth / 2 - m_fm.width(addressString()) / 2);
-                const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
+    const qreal addressWidth = m_fm.width(addressString());
+    const unsigned lruMask = vsrtl::generateBitmask(m_cache.getWaysBits());
+
+    painter->setFont(m_font);
+    painter->setPen(Qt::black);
+    const auto drawCentered = [&](const QString& text, qreal columnX, qreal columnWidth, qreal y) {
+        painter->drawText(QPointF(columnX + columnWidth / 2 - m_fm.width(text) / 2, y + m_fm.ascent()), text);
+    };
+
+    for (int lineIdx = firstLine; lineIdx <= lastLine; lineIdx++) {
+        // Draw line index number
+        const QString indexText = QString::number(lineIdx);
+        painter->drawText(QPointF(-m_fm.width(indexText) * 1.2, lineIdx * m_lineHeight + m_lineHeight / 2 -
+                                                                     m_setHeight / 2 + m_fm.ascent()),
+                          indexText);
+
+        for (int wayIdx = 0; wayIdx < m_cache.getWays(); wayIdx++) {
+            const CacheSim::CacheWay simWay = m_cache.getWay(lineIdx, wayIdx);
+            const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
+
+            // Highlight a way holding a prefetched block which has not yet been referenced
+            if (simWay.valid && simWay.prefetched) {
+                painter->setOpacity(0.3);
+                painter->fillRect(QRectF(m_widthBeforeTag, y, m_cacheWidth - m_widthBeforeTag, m_setHeight),
+                                  Colors::CaliforniaGold);
+            }
+
+            // Highlight dirty blocks
+            painter->setOpacity(0.4);
+            for (const unsigned blockIdx : simWay.dirtyBlocks) {
+                painter->fillRect(blockRect(lineIdx, wayIdx, blockIdx), Qt::darkCyan);
+            }
+            painter->setOpacity(1);
+
+            // Control bits
+            drawCentered(QString::number(simWay.valid), 0, m_bitWidth, y);
+            if (m_hasDirtyColumn) {
+                drawCentered(QString::number(simWay.dirty), m_widthBeforeDirty, m_bitWidth, y);
+            }
+            if (m_hasLRUColumn) {
+                // The software LRU value of invalid ways may be very large. Mask to the number of actual LRU bits.
+                drawCentered(QString::number(simWay.lru & lruMask), m_widthBeforeLRU, m_lruWidth, y);
+            }
 
-                way.blocks[i] = createGraphicsTextItemSP(x, y);
-                blockTextItem = way.blocks[i].get();
-            } else {
-                blockTextItem = way.blocks.at(i).get();
+            // The way is invalid so no tag or block text should be present
+            if (!simWay.valid) {
+                continue;
             }
 
-            // Update block text
-            const AInt addressForBlock = m_cache.buildAddress(simWay.tag, lineIdx, i);
-            const auto data = ProcessorHandler::getMemory().readMemConst(addressForBlock, bytes);
-            const QString text = encodeRadixValue(data, Radix::Hex, ProcessorHandler::currentISA()->bytes());
-            blockTextItem->setText(text);
-            QString tooltip =
-                "Address: " + encodeRadixValue(addressForBlock, Radix::Hex, ProcessorHandler::currentISA()->bytes());
-            if (simWay.dirtyBlocks.count(i)) {
-                tooltip += "\n> Dirty";
+            const QString tagText = encodeRadixValue(simWay.tag, Radix::Hex, bytes);
+            painter->drawText(QPointF(m_widthBeforeTag + m_tagWidth / 2 - addressWidth / 2, y + m_fm.ascent()),
+                              tagText);
+
+            for (int blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx++) {
+                const AInt addressForBlock = m_cache.buildAddress(simWay.tag, lineIdx, blockIdx);
+                const auto data = ProcessorHandler::getMemory().readMemConst(addressForBlock, bytes);
+                const QString text = encodeRadixValue(data, Radix::Hex, bytes);
+                const qreal x = m_widthBeforeBlocks + blockIdx * m_blockWidth + (m_blockWidth / 2 - addressWidth / 2);
+                painter->drawText(QPointF(x, y + m_fm.ascent()), text);
             }
-            blockTextItem->setToolTip(tooltip);
-            // Store the address within the userrole of the block text. Doing this, we are able to easily retrieve the
-            // address for the block if the block is clicked.
-            blockTextItem->setData(Qt::UserRole, QVariant::fromValue(addressForBlock));
         }
-    } else {
-        // The way is invalid so no block text should be present
-        way.blocks.clear();
     }
+}
 
-    // =========================== Update dirty field =========================
-    if (way.dirty) {
-        way.dirty->setText(QString::number(simWay.dirty));
+void CacheGraphic::paintHighlighting(QPainter* painter) {
+    if (!m_highlightingActive) {
+        return;
     }
-
-    // =========================== Update valid field =========================
-    if (way.valid) {
-        way.valid->setText(QString::number(simWay.valid));
+    const auto& index = m_highlightedTransaction.index;
+
+    // Cache line and cache block column of the current indexing
+    painter->setOpacity(0.25);
+    painter->fillRect(lineRect(index.line), Qt::yellow);
+    painter->fillRect(QRectF(m_widthBeforeBlocks + index.block * m_blockWidth, 0, m_blockWidth, m_cacheHeight),
+                      Qt::yellow);
+
+    // Currently accessed block
+    if (m_highlightedTransaction.isHit) {
+        painter->setOpacity(0.4);
+        painter->fillRect(blockRect(index.line, index.way, index.block), Qt::green);
+    } else {
+        painter->setOpacity(0.8);
+        painter->fillRect(blockRect(index.line, index.way, index.block), Qt::red);
     }
+    painter->setOpacity(1);
+}
 
-    // ============================ Update tag field ==========================
-    if (simWay.valid) {
-        QGraphicsSimpleTextItem* tagTextItem = way.tag.get();
-        if (tagTextItem == nullptr) {
-            const qreal x = m_widthBeforeTag + (m_tagWidth / 2 - m_fm.width(addressString()) / 2);
-            const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
-            way.tag = createGraphicsTextItemSP(x, y);
-            tagTextItem = way.tag.get();
+void CacheGraphic::paintGrid(QPainter* painter, const QRectF& rect, int firstLine, int lastLine, bool detailed,
+                             bool separators) {
+    const qreal top = firstLine * m_lineHeight;
+    const qreal bottom = (lastLine + 1) * m_lineHeight;
+    QPen pen;
+    painter->setPen(pen);
+
+    // Column separators
+    std::vector<qreal> columns = {0, m_bitWidth};
+    if (m_hasDirtyColumn) {
+        columns.push_back(m_widthBeforeDirty + m_bitWidth);
+    }
+    if (m_hasLRUColumn) {
+        columns.push_back(m_widthBeforeLRU + m_lruWidth);
+    }
+    columns.push_back(m_widthBeforeBlocks);
+    for (int i = 1; i <= m_cache.getBlocks(); ++i) {
+        const qreal x = m_widthBeforeBlocks + i * m_blockWidth;
+        if (x >= rect.left()) {
+            columns.push_back(x);
         }
-        const QString tagText = encodeRadixValue(simWay.tag, Radix::Hex, ProcessorHandler::currentISA()->bytes());
-        tagTextItem->setText(tagText);
-    } else {
-        // The way is invalid so no tag text should be present
-        if (way.tag) {
-            way.tag.reset();
+        if (x > rect.right()) {
+            break;
         }
     }
+    for (const qreal x : columns) {
+        painter->drawLine(QLineF(x, top, x, bottom));
+    }
 
-    // ==================== Update dirty blocks highlighting ==================
-    const std::set<unsigned> graphicDirtyBlocks = keys(way.dirtyBlocks);
-    std::set<unsigned> newDirtyBlocks;
-    std::set<unsigned> dirtyBlocksToDelete;
-    std::set_difference(graphicDirtyBlocks.begin(), graphicDirtyBlocks.end(), simWay.dirtyBlocks.begin(),
-                        simWay.dirtyBlocks.end(), std::inserter(dirtyBlocksToDelete, dirtyBlocksToDelete.begin()));
-    std::set_difference(simWay.dirtyBlocks.begin(), simWay.dirtyBlocks.end(), graphicDirtyBlocks.begin(),
-                        graphicDirtyBlocks.end(), std::inserter(newDirtyBlocks, newDirtyBlocks.begin()));
-
-    // Delete blocks which are not in sync with the current dirty status of the way
-    for (const unsigned& blockToDelete : dirtyBlocksToDelete) {
-        way.dirtyBlocks.erase(blockToDelete);
-    }
-    // Create all required new blocks
-    for (const auto& blockIdx : newDirtyBlocks) {
-        const auto topLeft =
-            QPointF(blockIdx * m_blockWidth + m_widthBeforeBlocks, lineIdx * m_lineHeight + wayIdx * m_setHeight);
-        const auto bottomRight = QPointF((blockIdx + 1) * m_blockWidth + m_widthBeforeBlocks,
-                                         lineIdx * m_lineHeight + (wayIdx + 1) * m_setHeight);
-        way.dirtyBlocks[blockIdx] = std::make_unique<QGraphicsRectItem>(QRectF(topLeft, bottomRight), this);
-
-        const auto& dirtyRectItem = way.dirtyBlocks[blockIdx];
-        dirtyRectItem->setZValue(-1);
-        dirtyRectItem->setOpacity(0.4);
-        dirtyRectItem->setBrush(Qt::darkCyan);
+    // Cache line separators; zoomed out, only the outline of the cache is drawn
+    for (int lineIdx = firstLine; lineIdx <= lastLine + 1; lineIdx++) {
+        if (separators || lineIdx == 0 || lineIdx == m_cache.getLines()) {
+            painter->drawLine(QLineF(0, lineIdx * m_lineHeight, m_cacheWidth, lineIdx * m_lineHeight));
+        }
     }
-}
 
-QGraphicsSimpleTextItem* CacheGraphic::tryCreateGraphicsTextItem(QGraphicsSimpleTextItem** item, qreal x, qreal y) {
-    if (*item == nullptr) {
-        *item = new QGraphicsSimpleTextItem(this);
-        (*item)->setFont(m_font);
-        (*item)->setPos(x, y);
+    // Cache set separators
+    if (detailed) {
+        pen.setStyle(Qt::DashLine);
+        painter->setPen(pen);
+        for (int lineIdx = firstLine; lineIdx <= lastLine; lineIdx++) {
+            for (int wayIdx = 1; wayIdx < m_cache.getWays(); wayIdx++) {
+                const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
+                painter->drawLine(QLineF(0, y, m_cacheWidth, y));
+            }
+        }
     }
-    return *item;
 }
 
-std::unique_ptr<QGraphicsSimpleTextItem> CacheGraphic::createGraphicsTextItemSP(qreal x, qreal y) {
-    std::unique_ptr<QGraphicsSimpleTextItem> ptr = std::make_unique<QGraphicsSimpleTextItem>(this);
-    ptr->setFont(m_font);
-    ptr->setPos(x, y);
-    return ptr;
+void CacheGraphic::hoverMoveEvent(QGraphicsSceneHoverEvent* event) {
+    QString tooltip;
+    const CacheSim::CacheIndex index = indexAt(event->pos());
+    if (index.line != CacheSim::s_invalidIndex) {
+        if (!m_summaryPainted && m_cache.isWayValid(index.line, index.way)) {
+            const CacheSim::CacheWay simWay = m_cache.getWay(index.line, index.way);
+            if (index.block != CacheSim::s_invalidIndex) {
+                const AInt addressForBlock = m_cache.buildAddress(simWay.tag, index.line, index.block);
+                tooltip = "Address: " +
+                          encodeRadixValue(addressForBlock, Radix::Hex, ProcessorHandler::currentISA()->bytes());
+                if (simWay.dirtyBlocks.count(index.block)) {
+                    tooltip += "\n> Dirty";
+                }
+                if (simWay.prefetched) {
+                    tooltip += "\n> Prefetched";
+                }
+            } else if (simWay.prefetched && event->pos().x() >= m_widthBeforeTag) {
+                tooltip = "Prefetched; not yet referenced";
+            }
+        }
+        if (tooltip.isEmpty() && (m_summaryPainted || m_missHeatmapVisible)) {
+            tooltip = lineToolTip(index.line);
+        }
+    }
+    setToolTip(tooltip);
+    QGraphicsObject::hoverMoveEvent(event);
 }
 
 void CacheGraphic::drawIndexingItems() {
@@ -343,15 +560,17 @@ void CacheGraphic::drawIndexingItems() {
 }
 
 void CacheGraphic::cacheInvalidated() {
+    prepareGeometryChange();
+
     // Remove all items
-    m_highlightingItems.clear();
-    m_cacheTextItems.clear();
     m_addressTextItem = nullptr;
     m_blockIndexingLine = nullptr;
     m_lineIndexingLine = nullptr;
     for (const auto& item : childItems()) {
         delete item;
     }
+    m_highlightingActive = false;
+    m_lineMissBoundsValid = false;
 
     // Determine cell dimensions
     m_setHeight = m_fm.height();
@@ -362,21 +581,16 @@ void CacheGraphic::cacheInvalidated() {
     m_cacheHeight = m_lineHeight * m_cache.getLines();
     m_tagWidth = m_blockWidth;
 
-    // Draw cache:
-    new QGraphicsLineItem(0, 0, 0, m_cacheHeight, this);
+    // Draw the column headers of the cache. The cache lines themselves are drawn in paint().
     qreal width = 0;
-    // Draw valid bit column
-    new QGraphicsLineItem(m_bitWidth, 0, m_bitWidth, m_cacheHeight, this);
     const QString validBitText = "V";
     auto* validItem = drawText(validBitText, 0, -m_fm.height());
     validItem->setToolTip("Valid bit");
     width += m_bitWidth;
 
-    if (m_cache.getWritePolicy() == WritePolicy::WriteBack) {
+    m_hasDirtyColumn = m_cache.getWritePolicy() == WritePolicy::WriteBack;
+    if (m_hasDirtyColumn) {
         m_widthBeforeDirty = width;
-
-        // Draw dirty bit column
-        new QGraphicsLineItem(width + m_bitWidth, 0, width + m_bitWidth, m_cacheHeight, this);
         const QString dirtyBitText = "D";
         auto* dirtyItem = drawText(dirtyBitText, m_widthBeforeDirty, -m_fm.height());
         dirtyItem->setToolTip("Dirty bit");
@@ -385,9 +599,8 @@ void CacheGraphic::cacheInvalidated() {
 
     m_widthBeforeLRU = width;
 
-    if (m_cache.getReplacementPolicy() == ReplPolicy::LRU && m_cache.getWays() > 1) {
-        // Draw LRU bit column
-        new QGraphicsLineItem(width + m_lruWidth, 0, width + m_lruWidth, m_cacheHeight, this);
+    m_hasLRUColumn = m_cache.getReplacementPolicy() == ReplPolicy::LRU && m_cache.getWays() > 1;
+    if (m_hasLRUColumn) {
         const QString LRUBitText = "LRU";
         auto* textItem = drawText(LRUBitText, width + m_lruWidth / 2 - m_fm.width(LRUBitText) / 2, -m_fm.height());
         textItem->setToolTip("Least Recently Used bits");
@@ -396,71 +609,34 @@ void CacheGraphic::cacheInvalidated() {
 
     m_widthBeforeTag = width;
 
-    // Draw tag column
-    new QGraphicsLineItem(m_tagWidth + width, 0, m_tagWidth + width, m_cacheHeight, this);
     const QString tagText = "Tag";
     drawText(tagText, width + m_tagWidth / 2 - m_fm.width(tagText) / 2, -m_fm.height());
 
     width += m_tagWidth;
     m_widthBeforeBlocks = width;
 
-    // Draw horizontal lines between cache blocks
     for (int i = 0; i < m_cache.getBlocks(); ++i) {
         const QString blockText = "Block " + QString::number(i);
         drawText(blockText, width + m_tagWidth / 2 - m_fm.width(blockText) / 2, -m_fm.height());
         width += m_blockWidth;
-        new QGraphicsLineItem(width, 0, width, m_cacheHeight, this);
     }
 
     m_cacheWidth = width;
 
-    // Draw cache line rows
-    for (int i = 0; i <= m_cache.getLines(); ++i) {
-        qreal verticalAdvance = i * m_lineHeight;
-        new QGraphicsLineItem(0, verticalAdvance, m_cacheWidth, verticalAdvance, this);
-
-        if (i < m_cache.getLines()) {
-            // Draw cache set rows
-            for (int j = 1; j < m_cache.getWays(); j++) {
-                verticalAdvance += m_setHeight;
-                auto* setLine = new QGraphicsLineItem(0, verticalAdvance, m_cacheWidth, verticalAdvance, this);
-                auto pen = setLine->pen();
-                pen.setStyle(Qt::DashLine);
-                setLine->setPen(pen);
-            }
-        }
-    }
-
-    // Draw line index numbers
-    for (int i = 0; i < m_cache.getLines(); ++i) {
-        const QString text = QString::number(i);
-
-        const qreal y = i * m_lineHeight + m_lineHeight / 2 - m_setHeight / 2;
-        const qreal x = -m_fm.width(text) * 1.2;
-        drawText(text, x, y);
-    }
-
     // Draw index column text
     const QString indexText = "Index";
     const qreal x = -m_fm.width(indexText) * 1.2;
     drawText(indexText, x, -m_fm.height());
 
+    const qreal indexWidth = m_fm.width(QString::number(m_cache.getLines() - 1)) * 1.2;
+    m_bodyRect = QRectF(-indexWidth, 0, m_cacheWidth + indexWidth, m_cacheHeight);
+
     // Draw indexing - this does not change the 'width' advancement, and is purely based on the tag column positioning.
     if (m_indexingVisible) {
         drawIndexingItems();
     }
 
-    initializeControlBits();
-
-    // Update all entries in the cache
-    for (int lineIdx = 0; lineIdx < m_cache.getLines(); lineIdx++) {
-        if (const auto* line = m_cache.getLine(lineIdx)) {
-            for (const auto& way : *line) {
-                updateWay(lineIdx, way.first);
-            }
-            updateLineReplFields(lineIdx);
-        }
-    }
+    update();
 
     if (auto* _scene = scene()) {
         // Invalidate the scene rect to resize it to the current dimensions of the CacheGraphic
@@ -471,19 +647,14 @@ void CacheGraphic::cacheInvalidated() {
 void CacheGraphic::updateAddressing(bool valid, const CacheSim::CacheTransaction& transaction) {
     if (m_indexingVisible) {
         if (valid) {
-            const auto& it = m_cacheTextItems.find(transaction.index.line);
-            if (it == m_cacheTextItems.end()) {
-                return;
-            }
-            const auto& wayIt = it->second.find(transaction.index.way);
-            if (wayIt == it->second.end()) {
+            if (transaction.index.line >= static_cast<unsigned>(m_cache.getLines()) ||
+                transaction.index.way >= static_cast<unsigned>(m_cache.getWays())) {
                 return;
             }
 
-            const CacheWay& way = wayIt->second;
             m_addressTextItem->setText(QString::number(transaction.address, 2).rightJustified(32, '0'));
 
-            if (way.tag) {
+            if (m_cache.isWayValid(transaction.index.line, transaction.index.way)) {
                 QPolygonF lineIndexingPoly;
                 m_lineIndexingLine->setVisible(true);
                 lineIndexingPoly << m_lineIndexStartPoint;
@@ -514,8 +685,9 @@ void CacheGraphic::updateAddressing(bool valid, const CacheSim::CacheTransaction
 }
 
 void CacheGraphic::wayInvalidated(unsigned lineIdx, unsigned wayIdx) {
-    updateWay(lineIdx, wayIdx);
-    updateLineReplFields(lineIdx);
+    // The replacement fields of all ways of the line may have changed alongside the way
+    update(lineRect(lineIdx));
+    Q_UNUSED(wayIdx);
 }
 
 void CacheGraphic::dataChanged(CacheSim::CacheTransaction transaction) {
@@ -545,72 +717,21 @@ QGraphicsSimpleTextItem* CacheGraphic::drawText(const QString& text, qreal x, qr
 }
 
 void CacheGraphic::updateHighlighting(bool active, const CacheSim::CacheTransaction& transaction) {
-    m_highlightingItems.clear();
-
-    if (active) {
-        // Redraw highlighting rectangles indicating the current indexing
-
-        // Draw cache line highlighting rectangle
-        QPointF topLeft = QPointF(0, transaction.index.line * m_lineHeight);
-        QPointF bottomRight = QPointF(m_cacheWidth, (transaction.index.line + 1) * m_lineHeight);
-        m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(QRectF(topLeft, bottomRight), this));
-        auto* lineRectItem = m_highlightingItems.rbegin()->get();
-        lineRectItem->setZValue(-2);
-        lineRectItem->setOpacity(0.25);
-        lineRectItem->setBrush(Qt::yellow);
-
-        // Draw cache block highlighting rectangle
-        topLeft = QPointF(transaction.index.block * m_blockWidth + m_widthBeforeBlocks, 0);
-        bottomRight = QPointF((transaction.index.block + 1) * m_blockWidth + m_widthBeforeBlocks, m_cacheHeight);
-        m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(QRectF(topLeft, bottomRight), this));
-        auto* blockRectItem = m_highlightingItems.rbegin()->get();
-        blockRectItem->setZValue(-2);
-        blockRectItem->setOpacity(0.25);
-        blockRectItem->setBrush(Qt::yellow);
-
-        // Draw highlighting on the currently accessed block
-        topLeft = QPointF(transaction.index.block * m_blockWidth + m_widthBeforeBlocks,
-                          transaction.index.line * m_lineHeight + transaction.index.way * m_setHeight);
-        bottomRight = QPointF((transaction.index.block + 1) * m_blockWidth + m_widthBeforeBlocks,
-                              transaction.index.line * m_lineHeight + (transaction.index.way + 1) * m_setHeight);
-        m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(QRectF(topLeft, bottomRight), this));
-        auto* hitRectItem = m_highlightingItems.rbegin()->get();
-        hitRectItem->setZValue(-1);
-        if (transaction.isHit) {
-            hitRectItem->setOpacity(0.4);
-            hitRectItem->setBrush(Qt::green);
-        } else {
-            hitRectItem->setOpacity(0.8);
-            hitRectItem->setBrush(Qt::red);
+    // Repaint the previously and the newly highlighted cache line and block column
+    const auto updateHighlightedArea = [=] {
+        if (m_highlightingActive) {
+            const auto& index = m_highlightedTransaction.index;
+            update(lineRect(index.line));
+            update(QRectF(m_widthBeforeBlocks + index.block * m_blockWidth, 0, m_blockWidth, m_cacheHeight));
         }
-    }
-}
-
-void CacheGraphic::initializeControlBits() {
-    for (int lineIdx = 0; lineIdx < m_cache.getLines(); lineIdx++) {
-        auto& line = m_cacheTextItems[lineIdx];
-        for (int setIdx = 0; setIdx < m_cache.getWays(); setIdx++) {
-            const qreal y = lineIdx * m_lineHeight + setIdx * m_setHeight;
-            qreal x;
-
-            // Create valid field
-            x = m_bitWidth / 2 - m_fm.width("0") / 2;
-            line[setIdx].valid = drawText("0", x, y);
-
-            if (m_cache.getWritePolicy() == WritePolicy::WriteBack) {
-                // Create dirty bit field
-                x = m_widthBeforeDirty + m_bitWidth / 2 - m_fm.width("0") / 2;
-                line[setIdx].dirty = drawText("0", x, y);
-            }
+    };
 
-            if (m_cache.getReplacementPolicy() == ReplPolicy::LRU && m_cache.getWays() > 1) {
-                // Create LRU field
-                const QString lruText = QString::number(m_cache.getWays() - 1);
-                x = m_widthBeforeLRU + m_lruWidth / 2 - m_fm.width(lruText) / 2;
-                line[setIdx].lru = drawText(lruText, x, y);
-            }
-        }
-    }
+    updateHighlightedArea();
+    m_highlightingActive = active && transaction.index.line < static_cast<unsigned>(m_cache.getLines()) &&
+                           transaction.index.way < static_cast<unsigned>(m_cache.getWays()) &&
+                           transaction.index.block < static_cast<unsigned>(m_cache.getBlocks());
+    m_highlightedTransaction = transaction;
+    updateHighlightedArea();
 }
 
 }  // namespace Ripes
@@ -5,33 +5,52 @@
 #include <QGraphicsItem>
 #include <QObject>
 #include <memory>
+#include <optional>
 #include "cachesim.h"
 #include "fonts.h"
 
 namespace Ripes {
 class FancyPolyLine;
 
+/**
+ * @brief The CacheGraphic class
+ * Graphical view of the state of a cache. The cache lines are not represented by graphics items; rather, paint()
+ * draws the lines which intersect the exposed area of the view, such that the cost of repainting the view tracks the
+ * visible area rather than the size of the cache.
+ *
+ * The level of detail depends on the scale of the view. When zoomed in far enough to read the text of the cache, each
+ * way is drawn with its control bits, tag and blocks. When zoomed further out, each cache line is instead drawn as a
+ * summary row, shading the valid bit column by the fraction of valid ways, the tag column by the number of misses of
+ * the line (i.e., tag churn) and the blocks by the fraction of dirty blocks of the line.
+ */
 class CacheGraphic : public QGraphicsObject {
 public:
     CacheGraphic(CacheSim& cache);
 
-    QRectF boundingRect() const override { return childrenBoundingRect(); };
+    QRectF boundingRect() const override { return childrenBoundingRect().united(m_bodyRect); };
 
-    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr) override {}
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* = nullptr) override;
     bool indexingVisible() const { return m_indexingVisible; }
 
+    /**
+     * @brief blockAddressAt
+     * @returns the address of the cache block drawn at @p pos, in item coordinates, if @p pos is within a block of a
+     * valid way.
+     */
+    std::optional<AInt> blockAddressAt(const QPointF& pos) const;
+
 public slots:
     /**
      * @brief dataChanged
      * The cache simulator indicates that some entries in the cache has changed. CacheGraphic will, using @p
-     * transaction, lazily initialize and update all required values to reflect the new state of the cache.
+     * transaction, repaint the changed way and update the indexing and highlighting of the access.
      */
     void dataChanged(CacheSim::CacheTransaction transaction);
 
     /**
      * @brief wayInvalidated
-     * The cache simulator has signalled that all graphics in the given cache way shall be reinitialized to reflect a
-     * changed state in the cache simulator.
+     * The cache simulator has signalled that the given cache way shall be repainted to reflect a changed state in the
+     * cache simulator.
      */
     void wayInvalidated(unsigned lineIdx, unsigned wayIdx);
 
@@ -51,47 +70,74 @@ public slots:
 
     void setIndexingVisible(bool visible);
 
-private:
-    // Data structure modelling the cache; keeping graphics text items for each entry
-    // All text items which are not always present are stored as unqiue_ptr's to facilitate easy deletion when undoing
-    // changes to the cache
-    struct CacheWay {
-        std::map<unsigned, std::unique_ptr<QGraphicsSimpleTextItem>> blocks;
-        std::unique_ptr<QGraphicsSimpleTextItem> tag = nullptr;
-        QGraphicsSimpleTextItem* lru = nullptr;
-        QGraphicsSimpleTextItem* valid = nullptr;
-        QGraphicsSimpleTextItem* dirty = nullptr;
-        std::map<unsigned, std::unique_ptr<QGraphicsRectItem>> dirtyBlocks;
-    };
-
-    using CacheLine = std::map<unsigned, CacheWay>;
-
     /**
-     * @brief initializeControlBits
-     * Constructs all of the "Valid" and "LRU" text items within the cache
+     * @brief setMissHeatmapVisible
+     * Toggles an overlay which shades each cache line by its number of conflict misses, relative to the cache line
+     * with the most conflict misses. The tooltip of each line lists the number of misses of each class.
      */
-    void initializeControlBits();
+    void setMissHeatmapVisible(bool visible);
+
+protected:
+    void hoverMoveEvent(QGraphicsSceneHoverEvent* event) override;
+
+private:
+    // Drawing functions of paint(). Each function draws the cache lines in [firstLine; lastLine]; block columns outside
+    // of [firstBlock; lastBlock] are skipped. Zoomed out, each summary row aggregates linesPerRow cache lines.
+    void paintMissHeatmap(QPainter* painter, int firstLine, int lastLine, int linesPerRow);
+    void paintLineSummaries(QPainter* painter, int firstLine, int lastLine, int linesPerRow);
+    void paintWays(QPainter* painter, int firstLine, int lastLine, int firstBlock, int lastBlock);
+    void paintHighlighting(QPainter* painter);
+    void paintGrid(QPainter* painter, const QRectF& rect, int firstLine, int lastLine, bool detailed, bool separators);
+
     void updateHighlighting(bool active, const CacheSim::CacheTransaction& transaction);
     QGraphicsSimpleTextItem* drawText(const QString& text, const QPointF& pos, const QFont* otherFont = nullptr);
     QGraphicsSimpleTextItem* drawText(const QString& text, qreal x, qreal y, const QFont* otherFont = nullptr);
-    QGraphicsSimpleTextItem* tryCreateGraphicsTextItem(QGraphicsSimpleTextItem** item, qreal x, qreal y);
-    std::unique_ptr<QGraphicsSimpleTextItem> createGraphicsTextItemSP(qreal x, qreal y);
 
     // Graphical update functions
-    void updateLineReplFields(unsigned lineIdx);
-    void updateWay(unsigned lineIdx, unsigned wayIdx);
     void updateAddressing(bool valid, const CacheSim::CacheTransaction& transaction);
+    void updateMissHeatmap();
+    void updateLineMissBounds();
     void drawIndexingItems();
     QString addressString() const;
+    QString lineToolTip(unsigned lineIdx) const;
+
+    /**
+     * @brief indexAt
+     * @returns the index of the cache way drawn at @p pos, in item coordinates. The block index is only valid if @p pos
+     * is within the block columns, and all indices are invalid if @p pos is outside of the cache lines.
+     */
+    CacheSim::CacheIndex indexAt(const QPointF& pos) const;
+    QRectF lineRect(unsigned lineIdx) const;
+    QRectF wayRect(unsigned lineIdx, unsigned wayIdx) const;
+    QRectF blockRect(unsigned lineIdx, unsigned wayIdx, unsigned blockIdx) const;
+
+    /**
+     * @brief s_minTextHeight
+     * The minimum height, in device pixels, of the text of the cache for the cache to be drawn in full detail. Below
+     * this, the cache lines are drawn as summary rows.
+     */
+    static constexpr qreal s_minTextHeight = 5;
 
     QFont m_font = QFont(Fonts::monospace, 12);
     CacheSim& m_cache;
 
-    std::vector<std::unique_ptr<QGraphicsRectItem>> m_highlightingItems;
-
     QFontMetricsF m_fm;
 
     bool m_indexingVisible = true;
+    bool m_missHeatmapVisible = false;
+
+    // The most recent access, as highlighted in the cache
+    bool m_highlightingActive = false;
+    CacheSim::CacheTransaction m_highlightedTransaction;
+
+    // The maximum number of misses, and of conflict misses, of any cache line. Recalculated lazily upon painting the
+    // line summaries or the miss heatmap, following a change of the miss counters of the cache.
+    bool m_lineMissBoundsValid = false;
+    unsigned m_maxLineMisses = 0;
+    unsigned m_maxLineConflicts = 0;
+
+    // Whether the cache was last painted as line summaries; determines the tooltips of the cache lines
+    bool m_summaryPainted = false;
 
     // Drawing dimensions
     qreal m_setHeight = 0;
@@ -106,20 +152,13 @@ private:
     qreal m_widthBeforeLRU = 0;
     qreal m_widthBeforeDirty = 0;
     qreal m_lruWidth = 0;
+    bool m_hasDirtyColumn = false;
+    bool m_hasLRUColumn = false;
 
-    static constexpr qreal z_grid = 0;
-    static constexpr qreal z_wires = -1;
+    // Area of the cache lines and their index numbers, in item coordinates
+    QRectF m_bodyRect;
 
-    /**
-     * @brief m_cacheTextItems
-     * All text items in the cache are managed in @var m_cacheTextItems.
-     * This object models the hierarchy of the cache, and stores all currently initialized text items for the cache.
-     * The object is indexed similarly to how the cache simulator is indexed. As such, a cache transaction is used to
-     * traverse the object.
-     * All items are lazily initialized in calls to dataChanged(). This prevents initializing a ton of items if a user
-     * has created a very large cache.
-     */
-    std::map<unsigned, CacheLine> m_cacheTextItems;
+    static constexpr qreal z_wires = -1;
 
     // Addressing related items which are moved around when addressing changes
     QGraphicsSimpleTextItem* m_addressTextItem = nullptr;
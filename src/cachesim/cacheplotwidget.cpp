@@ -26,6 +26,37 @@ static QPointF stepPoint(const QPointF& p1, const QPointF& p2) {
     return QPointF(p2.x(), p1.y());
 }
 
+static unsigned variableValue(const CacheTimeSeries::Sample& sample, CachePlotWidget::Variable variable) {
+    const auto& values = sample.values;
+    switch (variable) {
+        case CachePlotWidget::Writes:
+            return values[CacheTimeSeries::Writes];
+        case CachePlotWidget::Reads:
+            return values[CacheTimeSeries::Reads];
+        case CachePlotWidget::Hits:
+            return values[CacheTimeSeries::Hits];
+        case CachePlotWidget::Misses:
+            return values[CacheTimeSeries::Misses];
+        case CachePlotWidget::Writebacks:
+            return values[CacheTimeSeries::Writebacks];
+        case CachePlotWidget::Accesses:
+            return values[CacheTimeSeries::Hits] + values[CacheTimeSeries::Misses];
+        case CachePlotWidget::CompulsoryMisses:
+            return values[CacheTimeSeries::CompulsoryMisses];
+        case CachePlotWidget::CapacityMisses:
+            return values[CacheTimeSeries::CapacityMisses];
+        case CachePlotWidget::ConflictMisses:
+            return values[CacheTimeSeries::ConflictMisses];
+        case CachePlotWidget::CoalescedWrites:
+            return values[CacheTimeSeries::CoalescedWrites];
+        case CachePlotWidget::Unary:
+            return 1;
+        case CachePlotWidget::N_TraceVars:
+            break;
+    }
+    Q_UNREACHABLE();
+}
+
 CachePlotWidget::CachePlotWidget(QWidget* parent) : QWidget(parent), m_ui(new Ui::CachePlotWidget) {
     m_ui->setupUi(this);
     m_ui->plotView->setScene(new QGraphicsScene(this));
@@ -44,6 +75,8 @@ CachePlotWidget::CachePlotWidget(QWidget* parent) : QWidget(parent), m_ui(new Ui
     connect(m_ui->den, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CachePlotWidget::variablesChanged);
     connect(m_ui->windowed, &QCheckBox::toggled, this, &CachePlotWidget::variablesChanged);
     connect(m_ui->windowCycles, QOverload<int>::of(&QSpinBox::valueChanged), this, &CachePlotWidget::variablesChanged);
+    connect(RipesSettings::getObserver(RIPES_SETTING_CACHE_MAXPOINTS), &SettingObserver::modified, this,
+            &CachePlotWidget::variablesChanged);
 
     m_ui->rangeMin->setValue(0);
     m_ui->rangeMax->setValue(ProcessorHandler::getProcessor()->getCycleCount());
@@ -274,53 +307,27 @@ std::map<CachePlotWidget::Variable, QList<QPoint>> CachePlotWidget::gatherData(u
     std::map<Variable, QList<QPoint>> cacheData;
     const auto& trace = m_cache->getAccessTrace();
 
-    for (int i = 0; i < N_TraceVars; ++i) {
-        cacheData[static_cast<Variable>(i)].reserve(trace.size());
-    }
-
     // Gather data up until the end of the trace or the maximum plotted cycles
     const unsigned maxCycles = RipesSettings::value(RIPES_SETTING_CACHE_MAXCYCLES).toInt();
     if (fromCycle > maxCycles) {
         return {};
     }
 
-    for (auto it = trace.upper_bound(fromCycle); it != trace.lower_bound(maxCycles); it++) {
-        const auto& entry = it->second;
-        Q_ASSERT(it->first <= maxCycles);
-        cacheData[Variable::Writes].append(QPoint(it->first, entry.writes));
-        cacheData[Variable::Reads].append(QPoint(it->first, entry.reads));
-        cacheData[Variable::Hits].append(QPoint(it->first, entry.hits));
-        cacheData[Variable::Misses].append(QPoint(it->first, entry.misses));
-        cacheData[Variable::Writebacks].append(QPoint(it->first, entry.writebacks));
-        cacheData[Variable::Accesses].append(QPoint(it->first, entry.hits + entry.misses));
-    }
-
-    return cacheData;
-}
-
-void resample(QLineSeries* series, unsigned target, double& step) {
-    QVector<QPointF> newPoints;
-    const auto& oldPoints = series->pointsVector();
-    step = (oldPoints.last().x() / static_cast<double>(target)) * 2;  // *2 to account for steps
-    newPoints.reserve(target);
-    for (int i = 0; i < oldPoints.size(); i += step) {
-        newPoints << oldPoints.at(i);
+    const auto samples = trace.samples(fromCycle, maxCycles);
+    for (int i = 0; i < N_TraceVars; ++i) {
+        cacheData[static_cast<Variable>(i)].reserve(samples.size());
     }
 
-#if !defined(QT_NO_DEBUG)
-    // sanity check
-    QPointF plast = QPointF(0, 0);
-    bool first = true;
-    for (const auto& p : qAsConst(newPoints)) {
-        if (!first) {
-            Q_ASSERT(p.x() - plast.x() < step * 1.1);
-            first = false;
+    for (const auto& sample : samples) {
+        const int cycle = sample.cycle;
+        Q_ASSERT(sample.cycle <= maxCycles);
+        for (int i = 0; i < N_TraceVars; ++i) {
+            const auto variable = static_cast<Variable>(i);
+            cacheData[variable].append(QPoint(cycle, variableValue(sample, variable)));
         }
-        plast = p;
     }
-#endif
 
-    series->replace(newPoints);
+    return cacheData;
 }
 
 void CachePlotWidget::updatePlotAxes() {
@@ -351,116 +358,91 @@ void CachePlotWidget::updatePlotAxes() {
     axisX->setRange(m_ui->rangeSlider->minimumPosition(), m_ui->rangeSlider->maximumPosition());
 }
 
-void CachePlotWidget::updateRatioPlot() {
-    const auto newCacheData = gatherData(m_lastCyclePlotted);
-    const int nNewPoints = newCacheData.at(Accesses).size();
-    if (nNewPoints == 0) {
-        return;
+void CachePlotWidget::plotSample(const CacheTimeSeries::Sample& sample) {
+    // Cummulative plot
+    const unsigned num = variableValue(sample, m_numerator);
+    const unsigned den = variableValue(sample, m_denominator);
+    double ratio = 0;
+    if (den != 0) {
+        ratio = static_cast<double>(num) / den;
+        ratio *= 100.0;
     }
+    m_ratioPoints.append(QPointF(sample.cycle, ratio));
+    m_maxY = ratio > m_maxY ? ratio : m_maxY;
+    m_minY = ratio < m_minY ? ratio : m_minY;
 
-    // convenience function to move a series on/off the chart based on the number of points to be added.
-    // We have to remove series due to append(QList(...)) calling redraw _for each_ point in the list.
-    // Not removing the series for low nNewPoints avoids a flicker in plot labels. Everything is a balance...
-    const auto plotMover = [=](QLineSeries* series, bool visible) {
-        if (nNewPoints > 2) {
-            if (visible) {
-                this->m_plot->addSeries(series);
-            } else {
-                this->m_plot->removeSeries(series);
-            }
-        }
-    };
-
-    m_lastCyclePlotted = newCacheData.at(Accesses).last().x();
-
-    QList<QPointF> newPoints;
-    QList<QPointF> newWindowPoints;
-    QPointF lastPoint;
-    if (m_series->pointsVector().size() > 0) {
-        lastPoint = m_series->pointsVector().constLast();
-    } else {
-        lastPoint = QPointF(-1, 0);
-    }
-    for (int i = 0; i < nNewPoints; ++i) {
-        // Cummulative plot. For the unary variable, "Accesses" is just used to index into the cache data for
-        // accessing the x variable.
-        const auto& p1 =
-            m_numerator == Unary ? QPoint(newCacheData.at(Accesses).at(i).x(), 1) : newCacheData.at(m_numerator).at(i);
-        const auto& p2 = m_denominator == Unary ? QPoint(newCacheData.at(Accesses).at(i).x(), 1)
-                                                : newCacheData.at(m_denominator).at(i);
-        Q_ASSERT(p1.x() == p2.x() && "Data inconsistency");
-        double ratio = 0;
-        if (p2.y() != 0) {
-            ratio = static_cast<double>(p1.y()) / p2.y();
-            ratio *= 100.0;
-        }
-        bool skipPoint = false;
-        const QPointF newPoint = QPointF(p1.x(), ratio);
-        if (lastPoint.x() >= 0) {
-            if (newPoint.x() - lastPoint.x() < m_xStep) {
-                // Skip point; irrelevant at the current sampling level
-                skipPoint = true;
-            }
+    // Moving average plot
+    if (m_ui->windowed->isChecked()) {
+        double dNum = num;
+        double dDen = den;
+        if (m_lastDiffValid) {
+            dNum -= m_lastDiffData.first;
+            dDen -= m_lastDiffData.second;
         }
-        if (!skipPoint) {
-            newPoints << stepPoint(lastPoint, newPoint);
-            newPoints << newPoint;
-            m_maxY = ratio > m_maxY ? ratio : m_maxY;
-            m_minY = ratio < m_minY ? ratio : m_minY;
-            lastPoint = newPoint;
+        m_lastDiffValid = true;
+        double wRatio = 0;
+        if (dDen != 0) {
+            wRatio = dNum / dDen;
+            wRatio *= 100.0;
         }
 
-        // Moving average plot
-        if (m_ui->windowed->isChecked()) {
-            QPointF dNum, dDen;
-            if (!m_lastDiffValid) {
-                dNum = p1;
-                dDen = p2;
-                m_lastDiffValid = true;
-            } else {
-                dNum = p1 - m_lastDiffData.first;
-                dDen = p2 - m_lastDiffData.second;
-            }
-            double wRatio = 0;
-            if (dDen.y() != 0) {
-                wRatio = static_cast<double>(dNum.y()) / dDen.y();
-                wRatio *= 100.0;
-            }
-
-            m_maxY = wRatio > m_maxY ? wRatio : m_maxY;
-            m_minY = wRatio < m_minY ? wRatio : m_minY;
-            m_mavgData.push(wRatio);
+        m_maxY = wRatio > m_maxY ? wRatio : m_maxY;
+        m_minY = wRatio < m_minY ? wRatio : m_minY;
 
-            // Plot moving average
-            const double wAvg = std::accumulate(m_mavgData.begin(), m_mavgData.end(), 0.0) / m_mavgData.size();
-            newWindowPoints << QPointF(p1.x(), wAvg);
-            m_lastDiffData.first = p1;
-            m_lastDiffData.second = p2;
+        // The sum of the window is updated incrementally with the values entering and leaving the window
+        if (m_mavgData.full()) {
+            m_mavgSum -= m_mavgData.front();
         }
+        m_mavgData.push(wRatio);
+        m_mavgSum += wRatio;
+        m_mavgPoints.append(QPointF(sample.cycle, m_mavgSum / m_mavgData.size()));
+        m_lastDiffData = {num, den};
     }
+    m_lastCyclePlotted = sample.cycle;
+}
 
-    if (newPoints.size() == 0 && newWindowPoints.size() == 0) {
+void CachePlotWidget::updateRatioPlot() {
+    const auto& trace = m_cache->getAccessTrace();
+    const unsigned maxCycles = RipesSettings::value(RIPES_SETTING_CACHE_MAXCYCLES).toInt();
+    const int64_t lastCycle = trace.empty() ? 0 : std::min(trace.back().cycle, maxCycles);
+    if (m_lastCyclePlotted >= lastCycle) {
         return;
     }
 
-    plotMover(m_series, false);
-    m_series->append(newPoints);
-    if (m_ui->windowed->isChecked()) {
-        plotMover(m_mavgSeries, false);
-        m_mavgSeries->append(newWindowPoints);
+    // Gather the samples which have not yet been plotted. The trace is decoded a window of cycles at a time, such that
+    // replotting a long trace does not require decoding the entire trace at once.
+    while (m_lastCyclePlotted < lastCycle) {
+        const unsigned fromCycle = m_lastCyclePlotted;
+        const unsigned toCycle = static_cast<unsigned>(std::min<int64_t>(fromCycle + s_plotWindowCycles, maxCycles));
+        for (const auto& sample : trace.samples(fromCycle, toCycle)) {
+            plotSample(sample);
+        }
+        if (toCycle >= maxCycles) {
+            break;
+        }
+        // Samples are gathered within ]fromCycle; toCycle[
+        m_lastCyclePlotted = std::max<int64_t>(m_lastCyclePlotted, toCycle - 1);
     }
-
-    // Determine whether to resample;
-    // *2 the allowed points to account for the addition of step points.
-    // *2 to account for the fact that the setting specifies the minimum # of points, and we resample at a 2x ratio
-    const int maxPoints = RipesSettings::value(RIPES_SETTING_CACHE_MAXPOINTS).toInt() * 2 * 2;
-    if (m_series->pointsVector().size() >= maxPoints) {
-        resample(m_series, maxPoints / 2, m_xStep);
+    m_lastCyclePlotted = lastCycle;
+
+    // Replace the plotted series by the downsampled points, adding step points to the cummulative plot
+    QVector<QPointF> ratioPoints;
+    const auto downsampledRatioPoints = m_ratioPoints.points();
+    ratioPoints.reserve(downsampledRatioPoints.size() * 2);
+    QPointF lastPoint = QPointF(-1, 0);
+    for (const auto& point : downsampledRatioPoints) {
+        ratioPoints << stepPoint(lastPoint, point);
+        ratioPoints << point;
+        lastPoint = point;
     }
+    m_series->replace(ratioPoints);
 
-    plotMover(m_series, true);
     if (m_ui->windowed->isChecked()) {
-        plotMover(m_mavgSeries, true);
+        QVector<QPointF> mavgPoints;
+        for (const auto& point : m_mavgPoints.points()) {
+            mavgPoints << point;
+        }
+        m_mavgSeries->replace(mavgPoints);
     }
 
     updatePlotWarningButton();
@@ -477,8 +459,11 @@ void CachePlotWidget::resetRatioPlot() {
     m_series->clear();
     m_mavgSeries->clear();
     m_lastCyclePlotted = 0;
-    m_xStep = 1;
     m_lastDiffValid = false;
+    m_mavgSum = 0;
+    const unsigned maxPoints = RipesSettings::value(RIPES_SETTING_CACHE_MAXPOINTS).toInt();
+    m_ratioPoints.reset(maxPoints);
+    m_mavgPoints.reset(maxPoints);
 
     if (m_ui->windowed->isChecked()) {
         m_mavgData = FixedQueue<double>(m_ui->windowCycles->value());
@@ -497,6 +482,19 @@ void CachePlotWidget::updateHitrate() {
     m_ui->hits->setText(QString::number(m_cache->getHits()));
     m_ui->misses->setText(QString::number(m_cache->getMisses()));
     m_ui->writebacks->setText(QString::number(m_cache->getWritebacks()));
+
+    const Prefetcher* prefetcher = m_cache->getPrefetcher();
+    m_ui->prefetchStats->setVisible(prefetcher != nullptr);
+    if (prefetcher) {
+        const PrefetchStats& stats = prefetcher->getStats();
+        m_ui->prefetches->setText(QString::number(stats.issued));
+        m_ui->prefetchAccuracy->setText(QString::number(stats.accuracy(), 'G', 4));
+        m_ui->prefetchCoverage->setText(QString::number(stats.coverage(), 'G', 4));
+        m_ui->prefetchTimeliness->setText(QString::number(stats.timeliness(), 'G', 4));
+    }
+
+    m_ui->writeBufferStats->setVisible(m_cache->getWriteBufferSize() > 0);
+    m_ui->coalescedWrites->setText(QString::number(m_cache->getCoalescedWrites()));
 }
 
 }  // namespace Ripes
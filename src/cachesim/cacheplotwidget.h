@@ -7,6 +7,7 @@
 #include <queue>
 #include "cachesim.h"
 #include "float.h"
+#include "plotdownsampler.h"
 
 QT_FORWARD_DECLARE_CLASS(QToolBar);
 QT_FORWARD_DECLARE_CLASS(QAction);
@@ -29,6 +30,7 @@ public:
         }
         std::deque<T>::push_back(value);
     }
+    bool full() const { return this->size() == m_n; }
 
 private:
     unsigned m_n;
@@ -46,7 +48,20 @@ class CachePlotWidget : public QWidget {
     enum class RangeChangeSource { Slider, Comboboxes, Cycles };
 
 public:
-    enum Variable { Writes = 0, Reads, Hits, Misses, Writebacks, Accesses, N_TraceVars, Unary };
+    enum Variable {
+        Writes = 0,
+        Reads,
+        Hits,
+        Misses,
+        Writebacks,
+        Accesses,
+        CompulsoryMisses,
+        CapacityMisses,
+        ConflictMisses,
+        CoalescedWrites,
+        N_TraceVars,
+        Unary
+    };
     explicit CachePlotWidget(QWidget* parent = nullptr);
     void setCache(const std::shared_ptr<CacheSim>& cache);
     ~CachePlotWidget();
@@ -65,6 +80,12 @@ private:
      * specified cycle
      */
     std::map<Variable, QList<QPoint>> gatherData(unsigned fromCycle = 0) const;
+
+    /**
+     * @brief plotSample
+     * Appends the ratio, and moving average, of the tracked variables in @p sample to the plotted series.
+     */
+    void plotSample(const CacheTimeSeries::Sample& sample);
     void setupPlotActions();
     void showSizeBreakdown();
     void copyPlotDataToClipboard() const;
@@ -74,27 +95,29 @@ private:
     void updateAllowedRange(const RangeChangeSource src);
     void updatePlotWarningButton();
 
-    /**
-     * @brief resampleToScreen
-     * Resamples @param series to only contain as many points as would be visible on the associated plot view
-     */
-    void resampleToScreen(QLineSeries* series);
-
     void resetRatioPlot();
     QChart* m_plot = nullptr;
     QLineSeries* m_series = nullptr;
     double m_maxY = -DBL_MAX;
     double m_minY = DBL_MAX;
     int64_t m_lastCyclePlotted = 0;
-    double m_xStep = 1.0;
-    static constexpr int s_resamplingRatio = 2;
+
+    // Downsampled points of the ratio and moving average series. The series are bounded by the
+    // RIPES_SETTING_CACHE_MAXPOINTS setting, such that the cost of updating the plot is independent of the number of
+    // cycles plotted.
+    PlotDownsampler m_ratioPoints;
+    PlotDownsampler m_mavgPoints;
+
+    // Cycles of the access trace decoded at a time when gathering new plot points
+    static constexpr unsigned s_plotWindowCycles = 1 << 16;
 
     QLineSeries* m_mavgSeries = nullptr;
-    // N last computations of the change in ratio value
+    // N last computations of the change in ratio value, and their sum
     FixedQueue<double> m_mavgData;
+    double m_mavgSum = 0;
     // Last cycle numerator and denominator values
     bool m_lastDiffValid = false;
-    std::pair<QPoint, QPoint> m_lastDiffData;
+    std::pair<unsigned, unsigned> m_lastDiffData;
 
     Ui::CachePlotWidget* m_ui;
     std::shared_ptr<CacheSim> m_cache;
@@ -117,6 +140,10 @@ const static std::map<CachePlotWidget::Variable, QString> s_cacheVariableStrings
     {CachePlotWidget::Variable::Misses, "Misses"},
     {CachePlotWidget::Variable::Writebacks, "Writebacks"},
     {CachePlotWidget::Variable::Accesses, "Access count"},
+    {CachePlotWidget::Variable::CompulsoryMisses, "Compulsory misses"},
+    {CachePlotWidget::Variable::CapacityMisses, "Capacity misses"},
+    {CachePlotWidget::Variable::ConflictMisses, "Conflict misses"},
+    {CachePlotWidget::Variable::CoalescedWrites, "Coalesced writes"},
     {CachePlotWidget::Variable::Unary, "1"},
 };
 
@@ -0,0 +1,162 @@
+#include "cachereplay.h"
+
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
+
+#include "cachebatchsim.h"
+#include "optimalreplacement.h"
+
+namespace Ripes {
+
+static CacheReplayResult replayPreset(const MemoryTrace& trace, const CachePreset& preset, unsigned wordBytes) {
+    // The cache is local to the worker thread; it is not attached to any views nor to the processor, and records no
+    // undo traces.
+    CacheCore cache;
+    cache.setWordSize(wordBytes);
+    cache.setPreset(preset);
+    trace.forEach([&](const MemoryTrace::Entry& entry) { cache.access(entry.address, entry.type, entry.cycle); });
+
+    CacheReplayResult result;
+    result.preset = preset;
+    result.hits = cache.getHits();
+    result.misses = cache.getMisses();
+    result.writebacks = cache.getWritebacks();
+    result.hitRate = cache.getHitRate();
+    result.sizeBits = cache.getCacheSize().bits;
+    return result;
+}
+
+static std::vector<CacheReplayResult> replayBatch(const MemoryTrace& trace, const std::vector<CachePreset>& presets,
+                                                  unsigned wordBytes) {
+    CacheBatchSim batch(presets, wordBytes);
+    trace.forEach([&](const MemoryTrace::Entry& entry) { batch.access(entry.address, entry.type); });
+
+    std::vector<CacheReplayResult> results;
+    for (unsigned lane = 0; lane < batch.lanes(); ++lane) {
+        CacheReplayResult result;
+        result.preset = presets.at(lane);
+        result.hits = batch.getHits(lane);
+        result.misses = batch.getMisses(lane);
+        result.writebacks = batch.getWritebacks(lane);
+        const unsigned accesses = result.hits + result.misses;
+        result.hitRate = accesses == 0 ? 0 : static_cast<double>(result.hits) / accesses;
+
+        CacheCore cache;
+        cache.setWordSize(wordBytes);
+        cache.setPreset(result.preset);
+        result.sizeBits = cache.getCacheSize().bits;
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<CacheReplayResult> replayMemoryTrace(const MemoryTrace& trace, const QList<CachePreset>& presets,
+                                                 unsigned wordBytes) {
+    // Group the presets which may be simulated in lockstep into batches, each of which traverses the trace once. The
+    // remaining presets are simulated individually.
+    std::vector<std::vector<int>> batches;
+    std::vector<int> individual;
+    for (int i = 0; i < presets.size(); ++i) {
+        const auto& preset = presets.at(i);
+        if (!CacheBatchSim::canBatch(preset)) {
+            individual.push_back(i);
+            continue;
+        }
+        auto batchIt = std::find_if(batches.begin(), batches.end(), [&](const std::vector<int>& batch) {
+            return batch.size() < CacheBatchSim::s_lanes &&
+                   CacheBatchSim::isCompatible(presets.at(batch.front()), preset);
+        });
+        if (batchIt == batches.end()) {
+            batches.push_back({i});
+        } else {
+            batchIt->push_back(i);
+        }
+    }
+
+    std::vector<QFuture<std::vector<CacheReplayResult>>> batchFutures;
+    for (const auto& batch : batches) {
+        std::vector<CachePreset> batchPresets;
+        for (int i : batch) {
+            batchPresets.push_back(presets.at(i));
+        }
+        batchFutures.push_back(QtConcurrent::run([&trace, batchPresets, wordBytes] {
+            return replayBatch(trace, batchPresets, wordBytes);
+        }));
+    }
+    std::vector<QFuture<CacheReplayResult>> futures;
+    for (int i : individual) {
+        const auto preset = presets.at(i);
+        futures.push_back(
+            QtConcurrent::run([&trace, preset, wordBytes] { return replayPreset(trace, preset, wordBytes); }));
+    }
+
+    // Optimal replacement is simulated per block size, given that the next-use indices depend on the block size only.
+    std::map<int, std::vector<int>> blockSizes;
+    for (int i = 0; i < presets.size(); ++i) {
+        blockSizes[presets.at(i).blocks].push_back(i);
+    }
+    std::vector<QFuture<std::vector<OptimalReplacement::Result>>> optimalFutures;
+    for (const auto& blockSize : blockSizes) {
+        std::vector<CachePreset> blockSizePresets;
+        for (int i : blockSize.second) {
+            blockSizePresets.push_back(presets.at(i));
+        }
+        optimalFutures.push_back(QtConcurrent::run([&trace, blockSizePresets, wordBytes] {
+            CacheCore geometry;
+            geometry.setWordSize(wordBytes);
+            geometry.setPreset(blockSizePresets.front());
+            const OptimalReplacement optimal(trace, geometry.getBlockBytes());
+            std::vector<OptimalReplacement::Result> results;
+            for (const auto& preset : blockSizePresets) {
+                results.push_back(optimal.simulate(preset));
+            }
+            return results;
+        }));
+    }
+
+    // Gather the results in the order of the presets
+    std::vector<CacheReplayResult> results(presets.size());
+    for (unsigned b = 0; b < batches.size(); ++b) {
+        const auto batchResults = batchFutures.at(b).result();
+        for (unsigned lane = 0; lane < batchResults.size(); ++lane) {
+            results.at(batches.at(b).at(lane)) = batchResults.at(lane);
+        }
+    }
+    for (unsigned i = 0; i < individual.size(); ++i) {
+        results.at(individual.at(i)) = futures.at(i).result();
+    }
+    unsigned blockSizeIdx = 0;
+    for (const auto& blockSize : blockSizes) {
+        const auto optimalResults = optimalFutures.at(blockSizeIdx++).result();
+        for (unsigned i = 0; i < optimalResults.size(); ++i) {
+            auto& result = results.at(blockSize.second.at(i));
+            const auto& optimal = optimalResults.at(i);
+            const unsigned accesses = optimal.hits + optimal.misses;
+            result.optimalHits = optimal.hits;
+            result.optimalHitRate = accesses == 0 ? 0 : static_cast<double>(optimal.hits) / accesses;
+        }
+    }
+    return results;
+}
+
+StackDistanceAnalyzer analyzeStackDistances(const MemoryTrace& trace, unsigned offsetBits, unsigned maxLineBits,
+                                            unsigned maxWaysBits) {
+    std::vector<QFuture<StackDistanceAnalyzer>> futures;
+    for (unsigned lineBits = 0; lineBits <= maxLineBits; ++lineBits) {
+        futures.push_back(QtConcurrent::run([=, &trace] {
+            StackDistanceAnalyzer analyzer(offsetBits, maxLineBits, maxWaysBits);
+            analyzer.analyzeLineBits(lineBits);
+            trace.forEach([&](const MemoryTrace::Entry& entry) { analyzer.access(entry.address); });
+            return analyzer;
+        }));
+    }
+
+    StackDistanceAnalyzer result = futures.front().result();
+    for (unsigned i = 1; i < futures.size(); ++i) {
+        result.merge(futures.at(i).result());
+    }
+    return result;
+}
+
+}  // namespace Ripes
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QList>
+
+#include <vector>
+
+#include "cachecore.h"
+#include "memorytrace.h"
+#include "stackdistance.h"
+
+namespace Ripes {
+
+struct CacheReplayResult {
+    CachePreset preset;
+    unsigned hits = 0;
+    unsigned misses = 0;
+    unsigned writebacks = 0;
+    double hitRate = 0;
+    unsigned sizeBits = 0;
+
+    // Hits and hit rate of the geometry of the preset under optimal (Belady MIN) replacement
+    unsigned optimalHits = 0;
+    double optimalHitRate = 0;
+};
+
+/**
+ * @brief replayMemoryTrace
+ * Replays @p trace through an independent cache simulator for each of the provided @p presets. Presets which share
+ * their geometry and are LRU replaced are simulated in batches of up to CacheBatchSim::s_lanes presets, traversing the
+ * trace once per batch. Additionally, the optimal hit rate of each preset is determined through OptimalReplacement,
+ * sharing the precomputed next-use indices between presets of equal block size. The simulations are distributed across
+ * the global thread pool, and the call blocks until all simulations have finished. The simulations do not access the
+ * processor handler nor the settings; @p wordBytes is the number of bytes in a word of the processor which recorded
+ * the trace.
+ * @returns the access statistics of each preset, in the order of @p presets.
+ */
+std::vector<CacheReplayResult> replayMemoryTrace(const MemoryTrace& trace, const QList<CachePreset>& presets,
+                                                 unsigned wordBytes);
+
+/**
+ * @brief analyzeStackDistances
+ * Performs stack-distance analysis of @p trace for all line counts and associativities up to the given maximums. The
+ * analysis of each line count is distributed across the global thread pool, and the call blocks until the analysis has
+ * finished.
+ */
+StackDistanceAnalyzer analyzeStackDistances(const MemoryTrace& trace, unsigned offsetBits, unsigned maxLineBits,
+                                            unsigned maxWaysBits);
+
+}  // namespace Ripes
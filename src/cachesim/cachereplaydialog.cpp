@@ -0,0 +1,109 @@
+#include "cachereplaydialog.h"
+
+#include <QApplication>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+#include <cmath>
+
+#include "cachereplay.h"
+#include "processorhandler.h"
+#include "ripessettings.h"
+
+namespace Ripes {
+
+CacheReplayDialog::CacheReplayDialog(const MemoryTrace& trace, QWidget* parent) : QDialog(parent), m_trace(trace) {
+    setWindowTitle("Compare cache presets");
+
+    m_traceInfo = new QLabel(this);
+    m_table = new QTableWidget(this);
+    m_table->setColumnCount(7);
+    m_table->setHorizontalHeaderLabels(
+        {"Preset", "Size (bits)", "Hits", "Misses", "Writebacks", "Hit rate", "Optimal hit rate"});
+    m_table->horizontalHeaderItem(6)->setToolTip(
+        "Hit rate of the cache geometry of the preset under optimal (Belady MIN) replacement. This is an upper bound "
+        "on the hit rate which any replacement policy may achieve.");
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSortingEnabled(true);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    auto* loadButton = buttons->addButton("Load trace...", QDialogButtonBox::ActionRole);
+    auto* saveButton = buttons->addButton("Save trace...", QDialogButtonBox::ActionRole);
+    connect(loadButton, &QPushButton::clicked, this, &CacheReplayDialog::loadTrace);
+    connect(saveButton, &QPushButton::clicked, this, &CacheReplayDialog::saveTrace);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(m_traceInfo);
+    layout->addWidget(m_table);
+    layout->addWidget(buttons);
+    resize(700, 400);
+
+    replay();
+}
+
+void CacheReplayDialog::replay() {
+    m_traceInfo->setText(QString("Memory trace: %1 accesses (%2 bytes)").arg(m_trace.size()).arg(m_trace.byteSize()));
+
+    const auto presets = RipesSettings::value(RIPES_SETTING_CACHE_PRESETS).value<QList<CachePreset>>();
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const auto results = replayMemoryTrace(m_trace, presets, ProcessorHandler::currentISA()->bytes());
+    QApplication::restoreOverrideCursor();
+
+    // Numeric items are stored as display role values such that the table sorts them numerically.
+    const auto numberItem = [](const QVariant& value) {
+        auto* item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+
+    m_table->setSortingEnabled(false);
+    m_table->setRowCount(results.size());
+    for (unsigned row = 0; row < results.size(); ++row) {
+        const auto& result = results.at(row);
+        m_table->setItem(row, 0, new QTableWidgetItem(result.preset.name));
+        m_table->setItem(row, 1, numberItem(result.sizeBits));
+        m_table->setItem(row, 2, numberItem(result.hits));
+        m_table->setItem(row, 3, numberItem(result.misses));
+        m_table->setItem(row, 4, numberItem(result.writebacks));
+        m_table->setItem(row, 5, numberItem(std::round(result.hitRate * 10000) / 10000));
+        m_table->setItem(row, 6, numberItem(std::round(result.optimalHitRate * 10000) / 10000));
+    }
+    m_table->setSortingEnabled(true);
+}
+
+void CacheReplayDialog::saveTrace() {
+    const QString filename = QFileDialog::getSaveFileName(this, "Save memory trace", "", "Memory traces (*.rtrace)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly) || !m_trace.save(file)) {
+        QMessageBox::warning(this, "Error", "Could not write memory trace to '" + filename + "'");
+    }
+}
+
+void CacheReplayDialog::loadTrace() {
+    const QString filename = QFileDialog::getOpenFileName(this, "Load memory trace", "", "Memory traces (*.rtrace)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly) || !m_trace.load(file)) {
+        QMessageBox::warning(this, "Error", "'" + filename + "' is not a valid memory trace");
+        return;
+    }
+    replay();
+}
+
+}  // namespace Ripes
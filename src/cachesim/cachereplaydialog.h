@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QDialog>
+
+#include "memorytrace.h"
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QTableWidget)
+
+namespace Ripes {
+
+/**
+ * @brief The CacheReplayDialog class
+ * Replays a memory trace through each of the stored cache presets and tabulates the resulting access statistics.
+ */
+class CacheReplayDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    CacheReplayDialog(const MemoryTrace& trace, QWidget* parent = nullptr);
+
+private:
+    void replay();
+    void saveTrace();
+    void loadTrace();
+
+    MemoryTrace m_trace;
+    QLabel* m_traceInfo = nullptr;
+    QTableWidget* m_table = nullptr;
+};
+
+}  // namespace Ripes
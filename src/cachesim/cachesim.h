@@ -1,58 +1,18 @@
 #pragma once
 
 #include <math.h>
-#include <map>
-#include <vector>
+#include <memory>
 
-#include <QDataStream>
 #include <QObject>
 
 #include "../external/VSRTL/core/vsrtl_register.h"
+#include "cachecore.h"
 #include "processors/RISC-V/rv_memory.h"
 #include "processors/interface/ripesprocessor.h"
 
 namespace Ripes {
 class CacheSim;
 
-enum WriteAllocPolicy { WriteAllocate, NoWriteAllocate };
-enum WritePolicy { WriteThrough, WriteBack };
-enum ReplPolicy { Random, LRU };
-
-struct CachePreset {
-    QString name;
-    int blocks;
-    int lines;
-    int ways;
-
-    WritePolicy wrPolicy;
-    WriteAllocPolicy wrAllocPolicy;
-    ReplPolicy replPolicy;
-
-    friend QDataStream& operator<<(QDataStream& arch, const CachePreset& object) {
-        arch << object.name;
-        arch << object.blocks;
-        arch << object.lines;
-        arch << object.ways;
-        arch << object.wrPolicy;
-        arch << object.wrAllocPolicy;
-        arch << object.replPolicy;
-        return arch;
-    }
-
-    friend QDataStream& operator>>(QDataStream& arch, CachePreset& object) {
-        arch >> object.name;
-        arch >> object.blocks;
-        arch >> object.lines;
-        arch >> object.ways;
-        arch >> object.wrPolicy;
-        arch >> object.wrAllocPolicy;
-        arch >> object.replPolicy;
-        return arch;
-    }
-
-    bool operator==(const CachePreset& other) const { return this->name == other.name; }
-};
-
 class CacheInterface : public QObject {
     Q_OBJECT
 public:
@@ -64,7 +24,7 @@ public:
      * A function called by the logical "child" of this cache, indicating that it desires to access this cache
      */
     virtual void access(AInt address, MemoryAccess::Type type) = 0;
-    void setNextLevelCache(const std::shared_ptr<CacheSim>& cache) { m_nextLevelCache = cache; }
+    virtual void setNextLevelCache(const std::shared_ptr<CacheSim>& cache) { m_nextLevelCache = cache; }
 
     /**
      * @brief reset
@@ -81,118 +41,36 @@ protected:
     std::shared_ptr<CacheSim> m_nextLevelCache;
 };
 
-class CacheSim : public CacheInterface {
+
+/**
+ * @brief The CacheSim class
+ * A cache of the cache hierarchy of the current processor. The state machine of the cache is provided by CacheCore;
+ * CacheSim binds the environment of the core to the current processor and program, and notifies the views of the cache
+ * of its modifications through signals.
+ */
+class CacheSim : public CacheInterface, public CacheCore {
     Q_OBJECT
 public:
-    static constexpr unsigned s_invalidIndex = static_cast<unsigned>(-1);
-
-    struct CacheSize {
-        unsigned bits = 0;
-        std::vector<QString> components;
-    };
-
-    struct CacheWay {
-        VInt tag = -1;
-        std::set<unsigned> dirtyBlocks;
-        bool dirty = false;
-        bool valid = false;
-
-        // LRU algorithm relies on invalid cache ways to have an initial high value. -1 ensures maximum value for all
-        // way sizes.
-        unsigned lru = -1;
-    };
-
-    struct CacheIndex {
-        unsigned line = s_invalidIndex;
-        unsigned way = s_invalidIndex;
-        unsigned block = s_invalidIndex;
-        void assertValid() const {
-            Q_ASSERT(line != s_invalidIndex && "Cache line index is invalid");
-            Q_ASSERT(way != s_invalidIndex && "Cache way index is invalid");
-            Q_ASSERT(block != s_invalidIndex && "Cache block index is invalid");
-        }
-
-        bool operator==(const CacheIndex& other) const {
-            return this->line == other.line && this->way == other.way && this->block == other.block;
-        }
-    };
-
-    struct CacheTransaction {
-        AInt address;
-        CacheIndex index;
-
-        bool isHit = false;
-        bool isWriteback = false;  // True if the transaction resulted in an eviction of a dirty cacheline
-        MemoryAccess::Type type = MemoryAccess::None;
-        bool transToValid = false;  // True if the cacheline just transitioned from invalid to valid
-        bool tagChanged = false;    // True if transToValid or the previous entry was evicted
-    };
-
-    struct CacheAccessTrace {
-        int hits = 0;
-        int misses = 0;
-        int reads = 0;
-        int writes = 0;
-        int writebacks = 0;
-        CacheAccessTrace() {}
-        CacheAccessTrace(const CacheTransaction& transaction) : CacheAccessTrace(CacheAccessTrace(), transaction) {}
-        CacheAccessTrace(const CacheAccessTrace& pre, const CacheTransaction& transaction) {
-            reads = pre.reads + (transaction.type == MemoryAccess::Read ? 1 : 0);
-            writes = pre.writes + (transaction.type == MemoryAccess::Write ? 1 : 0);
-            writebacks = pre.writebacks + (transaction.isWriteback ? 1 : 0);
-            hits = pre.hits + (transaction.isHit ? 1 : 0);
-            misses = pre.misses + (transaction.isHit ? 0 : 1);
-        }
-    };
-
-    using CacheLine = std::map<unsigned, CacheWay>;
-
     CacheSim(QObject* parent);
-    void setWritePolicy(WritePolicy policy);
-    void setWriteAllocatePolicy(WriteAllocPolicy policy);
-    void setReplacementPolicy(ReplPolicy policy);
+    ~CacheSim() override;
+
+    /**
+     * @brief setNextLevelCache
+     * Sets @p cache as the next level of this cache, see CacheCore::setNextLevel().
+     */
+    void setNextLevelCache(const std::shared_ptr<CacheSim>& cache) override;
 
+    using CacheCore::access;
     void access(AInt address, MemoryAccess::Type type) override;
-    void undo();
     void reset() override;
 
-    WriteAllocPolicy getWriteAllocPolicy() const { return m_wrAllocPolicy; }
-    ReplPolicy getReplacementPolicy() const { return m_replPolicy; }
-    WritePolicy getWritePolicy() const { return m_wrPolicy; }
-
-    const std::map<unsigned, CacheAccessTrace>& getAccessTrace() const { return m_accessTrace; }
-
-    double getHitRate() const;
-    unsigned getHits() const;
-    unsigned getMisses() const;
-    unsigned getWritebacks() const;
-    CacheSize getCacheSize() const;
-
-    AInt buildAddress(unsigned tag, unsigned lineIdx, unsigned blockIdx) const;
-
-    int getBlockBits() const { return m_blocks; }
-    int getWaysBits() const { return m_ways; }
-    int getLineBits() const { return m_lines; }
-    int getTagBits() const { return 32 - 2 /*byte offset*/ - getBlockBits() - getLineBits(); }
-
-    int getBlocks() const { return static_cast<int>(std::pow(2, m_blocks)); }
-    int getWays() const { return static_cast<int>(std::pow(2, m_ways)); }
-    int getLines() const { return static_cast<int>(std::pow(2, m_lines)); }
-    unsigned getBlockMask() const { return m_blockMask; }
-    unsigned getTagMask() const { return m_tagMask; }
-    unsigned getLineMask() const { return m_lineMask; }
-
-    unsigned getLineIdx(const AInt address) const;
-    unsigned getBlockIdx(const AInt address) const;
-    unsigned getTag(const AInt address) const;
-
-    const CacheLine* getLine(unsigned idx) const;
+    void setWriteBufferSize(unsigned entries) { CacheCore::setWriteBufferSize(entries); }
 
 public slots:
-    void setBlocks(unsigned blocks);
-    void setLines(unsigned lines);
-    void setWays(unsigned ways);
-    void setPreset(const Ripes::CachePreset& preset);
+    void setBlocks(unsigned blocks) { CacheCore::setBlocks(blocks); }
+    void setLines(unsigned lines) { CacheCore::setLines(lines); }
+    void setWays(unsigned ways) { CacheCore::setWays(ways); }
+    void setPreset(const Ripes::CachePreset& preset) { CacheCore::setPreset(preset); }
 
     /**
      * @brief reverse
@@ -219,73 +97,18 @@ signals:
      */
     void cacheInvalidated();
 
-private:
-    struct CacheTrace {
-        CacheTransaction transaction;
-        CacheWay oldWay;
-    };
-
-    std::pair<unsigned, CacheSim::CacheWay*> locateEvictionWay(const CacheTransaction& transaction);
-    CacheWay evictAndUpdate(CacheTransaction& transaction);
-    void analyzeCacheAccess(CacheTransaction& transaction) const;
-    void pushAccessTrace(const CacheTransaction& transaction);
-    void popAccessTrace();
-
-    /**
-     * @brief updateConfiguration
-     * Called whenever one of the cache parameters changes. Emits signal configurationChanged after updating.
-     */
-    void updateConfiguration();
-    void recalculateMasks();
-
-    /**
-     * @brief reassociateMemory
-     * Binds to a memory component exposed by the processor handler, based on the current cache type.
-     */
-    void reassociateMemory();
-
-    ReplPolicy m_replPolicy = ReplPolicy::LRU;
-    WritePolicy m_wrPolicy = WritePolicy::WriteBack;
-    WriteAllocPolicy m_wrAllocPolicy = WriteAllocPolicy::WriteAllocate;
-
-    unsigned m_blockMask = -1;
-    unsigned m_lineMask = -1;
-    unsigned m_tagMask = -1;
-
-    int m_blocks = 2;            // Some power of 2
-    int m_lines = 5;             // Some power of 2
-    int m_ways = 0;              // Some power of 2
-    unsigned m_byteOffset = -1;  // # of bits to represent the # of bytes in a word
-    unsigned m_wordBits = -1;
-
-    /**
-     * @brief m_cacheLines
-     * The datastructure for storing our cache hierachy, as per the current cache configuration.
-     */
-    std::map<unsigned, CacheLine> m_cacheLines;
-
-    void updateCacheLineReplFields(CacheLine& line, unsigned wayIdx);
-    /**
-     * @brief revertCacheLineReplFields
-     * Called whenever undoing a transaction to the cache. Reverts a cacheline's replacement fields according to the
-     * configured replacement policy.
-     */
-    void revertCacheLineReplFields(CacheLine& line, const CacheWay& oldWay, unsigned wayIdx);
-
-    /**
-     * @brief m_accessTrace
-     * The access trace stack contains cache access statistics for each simulation cycle. Contrary to the TraceStack
-     * (m_traceStack).
-     */
-    std::map<unsigned, CacheAccessTrace> m_accessTrace;
+protected:
+    void notifyConfigurationChanged() override { emit configurationChanged(); }
+    void notifyTransaction(const CacheTransaction& transaction) override;
+    void notifyWayChanged(unsigned lineIdx, unsigned wayIdx) override;
+    void notifyStatisticsChanged() override;
 
+private:
     /**
-     * @brief m_traceStack
-     * The following information is used to track all most-recent modifications made to the stack. The stack is of a
-     * fixed sized which is equal to the undo stack of VSRTL memory elements. Storing all modifications allows us to
-     * rollback any changes performed to the cache, when clock cycles are undone.
+     * @brief updateEnvironment
+     * Sets the environment of the cache core from the current processor and program.
      */
-    std::deque<CacheTrace> m_traceStack;
+    void updateEnvironment();
 
     /**
      * @brief m_isResetting
@@ -295,20 +118,8 @@ private:
      * so, we do not emit a processor request signal, avoiding a signalling loop.
      */
     bool m_isResetting = false;
-
-    CacheTrace popTrace();
-    void pushTrace(const CacheTrace& trace);
 };
 
-const static std::map<ReplPolicy, QString> s_cacheReplPolicyStrings{{ReplPolicy::Random, "Random"},
-                                                                    {ReplPolicy::LRU, "LRU"}};
-const static std::map<WriteAllocPolicy, QString> s_cacheWriteAllocateStrings{
-    {WriteAllocPolicy::WriteAllocate, "Write allocate"},
-    {WriteAllocPolicy::NoWriteAllocate, "No write allocate"}};
-
-const static std::map<WritePolicy, QString> s_cacheWritePolicyStrings{{WritePolicy::WriteThrough, "Write-through"},
-                                                                      {WritePolicy::WriteBack, "Write-back"}};
-
 }  // namespace Ripes
 
 Q_DECLARE_METATYPE(Ripes::CacheSim::CacheTransaction);
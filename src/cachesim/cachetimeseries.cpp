@@ -0,0 +1,201 @@
+#include "cachetimeseries.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Ripes {
+
+namespace {
+
+void encodeVarint(std::vector<uint8_t>& data, unsigned value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+unsigned decodeVarint(const uint8_t*& it) {
+    unsigned value = 0;
+    unsigned shift = 0;
+    while (*it & 0x80) {
+        value |= static_cast<unsigned>(*it & 0x7F) << shift;
+        shift += 7;
+        it++;
+    }
+    value |= static_cast<unsigned>(*it) << shift;
+    it++;
+    return value;
+}
+
+// Column 0 is the cycle column; columns [1; NColumns] are the value columns.
+unsigned& column(CacheTimeSeries::Sample& sample, unsigned col) {
+    return col == 0 ? sample.cycle : sample.values[col - 1];
+}
+
+}  // namespace
+
+void CacheTimeSeries::append(const Sample& sample) {
+    if (m_active.size() == s_chunkSize) {
+        seal();
+    }
+    m_active.push_back(sample);
+}
+
+void CacheTimeSeries::popBack() {
+    if (m_active.empty()) {
+        unseal();
+    }
+    m_active.pop_back();
+}
+
+void CacheTimeSeries::clear() {
+    m_chunks.clear();
+    m_active.clear();
+}
+
+void CacheTimeSeries::seal() {
+    Chunk chunk;
+    chunk.first = m_active.front();
+    chunk.last = m_active.back();
+
+    for (unsigned col = 0; col <= NColumns; ++col) {
+        // Run-length encode the deltas between consecutive samples of the column.
+        unsigned runValue = 0;
+        unsigned runLength = 0;
+        for (unsigned i = 1; i < m_active.size(); ++i) {
+            const unsigned delta = column(m_active[i], col) - column(m_active[i - 1], col);
+            if (runLength != 0 && delta != runValue) {
+                encodeVarint(chunk.data, runValue);
+                encodeVarint(chunk.data, runLength);
+                runLength = 0;
+            }
+            runValue = delta;
+            runLength++;
+        }
+        if (runLength != 0) {
+            encodeVarint(chunk.data, runValue);
+            encodeVarint(chunk.data, runLength);
+        }
+        chunk.columnEnd[col] = chunk.data.size();
+    }
+    chunk.data.shrink_to_fit();
+
+    m_chunks.push_back(std::move(chunk));
+    m_active.clear();
+}
+
+void CacheTimeSeries::unseal() {
+    decode(m_chunks.back(), m_active);
+    m_chunks.pop_back();
+}
+
+void CacheTimeSeries::decode(const Chunk& chunk, std::vector<Sample>& out) const {
+    out.resize(s_chunkSize);
+    out[0] = chunk.first;
+
+    const uint8_t* it = chunk.data.data();
+    for (unsigned col = 0; col <= NColumns; ++col) {
+        const uint8_t* end = chunk.data.data() + chunk.columnEnd[col];
+        unsigned i = 1;
+        while (it != end) {
+            const unsigned delta = decodeVarint(it);
+            const unsigned runLength = decodeVarint(it);
+            for (unsigned r = 0; r < runLength; ++r, ++i) {
+                column(out[i], col) = column(out[i - 1], col) + delta;
+            }
+        }
+    }
+}
+
+size_t CacheTimeSeries::upperIndex(unsigned cycle) const {
+    // Locate the first sealed chunk which contains a sample with a cycle larger than @p cycle.
+    const auto chunkIt = std::upper_bound(m_chunks.begin(), m_chunks.end(), cycle,
+                                          [](unsigned c, const Chunk& chunk) { return c < chunk.last.cycle; });
+    const auto cycleCmp = [](unsigned c, const Sample& sample) { return c < sample.cycle; };
+
+    if (chunkIt == m_chunks.end()) {
+        return m_chunks.size() * s_chunkSize +
+               (std::upper_bound(m_active.begin(), m_active.end(), cycle, cycleCmp) - m_active.begin());
+    }
+
+    const size_t chunkStart = (chunkIt - m_chunks.begin()) * s_chunkSize;
+    if (cycle < chunkIt->first.cycle) {
+        return chunkStart;
+    }
+
+    std::vector<Sample> decoded;
+    decode(*chunkIt, decoded);
+    return chunkStart + (std::upper_bound(decoded.begin(), decoded.end(), cycle, cycleCmp) - decoded.begin());
+}
+
+std::vector<CacheTimeSeries::Sample> CacheTimeSeries::samples(unsigned fromCycle, unsigned toCycle,
+                                                              unsigned maxPoints) const {
+    std::vector<Sample> result;
+
+    const size_t begin = upperIndex(fromCycle);
+    const size_t end = toCycle == 0 ? 0 : upperIndex(toCycle - 1);
+    if (begin >= end) {
+        return result;
+    }
+
+    const size_t n = end - begin;
+    size_t stride = 1;
+    if (maxPoints != 0 && n > maxPoints) {
+        stride = (n + maxPoints - 1) / maxPoints;
+    }
+
+    // Sampled values are retrieved through the first and last samples of sealed chunks whenever possible. Other
+    // samples within a sealed chunk require decoding the chunk, of which the most recently decoded is cached.
+    std::vector<Sample> decoded;
+    size_t decodedChunk = std::numeric_limits<size_t>::max();
+    const auto at = [&](size_t idx) -> const Sample& {
+        const size_t chunkIdx = idx / s_chunkSize;
+        if (chunkIdx >= m_chunks.size()) {
+            return m_active[idx - m_chunks.size() * s_chunkSize];
+        }
+        const Chunk& chunk = m_chunks[chunkIdx];
+        const size_t offset = idx % s_chunkSize;
+        if (offset == 0) {
+            return chunk.first;
+        } else if (offset == s_chunkSize - 1) {
+            return chunk.last;
+        }
+        if (decodedChunk != chunkIdx) {
+            decode(chunk, decoded);
+            decodedChunk = chunkIdx;
+        }
+        return decoded[offset];
+    };
+
+    size_t idx = begin;
+    if (stride >= s_chunkSize) {
+        // Coarse resolution; align the stride and all but the first and last samples to chunk boundaries, such that no
+        // chunks need to be decoded for the samples in between.
+        stride -= stride % s_chunkSize;
+        result.reserve(n / stride + 3);
+        result.push_back(at(begin));
+        idx = (begin / s_chunkSize + 1) * s_chunkSize;
+    } else {
+        result.reserve(n / stride + 2);
+    }
+
+    for (; idx < end; idx += stride) {
+        result.push_back(at(idx));
+    }
+    if (result.back().cycle != at(end - 1).cycle) {
+        result.push_back(at(end - 1));
+    }
+
+    return result;
+}
+
+size_t CacheTimeSeries::memoryUsage() const {
+    size_t bytes = sizeof(*this) + m_chunks.capacity() * sizeof(Chunk) + m_active.capacity() * sizeof(Sample);
+    for (const auto& chunk : m_chunks) {
+        bytes += chunk.data.capacity();
+    }
+    return bytes;
+}
+
+}  // namespace Ripes
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The CacheTimeSeries class
+ * An append-only time series of cumulative cache access statistics, with one sample per cycle in which the cache was
+ * accessed.
+ *
+ * Samples are stored in chunks of s_chunkSize samples. The most recent chunk is kept uncompressed, allowing for cheap
+ * appends and removals (when undoing cycles). Once full, a chunk is sealed: each column is delta encoded wrt. the
+ * previous sample, and the deltas are run-length encoded as variable-length integers. Given that the statistics are
+ * cumulative and grow by at most a few units per sample, a sealed chunk typically requires a few bytes per column.
+ *
+ * Each sealed chunk retains its first and last samples in decoded form. These form a coarse resolution level of the
+ * series, which is used for locating samples by cycle and for sampling large cycle ranges without decoding any chunks.
+ */
+class CacheTimeSeries {
+public:
+    enum Column {
+        Hits,
+        Misses,
+        Reads,
+        Writes,
+        Writebacks,
+        CompulsoryMisses,
+        CapacityMisses,
+        ConflictMisses,
+        CoalescedWrites,
+        NColumns
+    };
+    static constexpr unsigned s_chunkSize = 4096;
+
+    struct Sample {
+        unsigned cycle = 0;
+        std::array<unsigned, NColumns> values{};
+    };
+
+    /**
+     * @brief append
+     * Appends @p sample to the series. The cycle of @p sample must be larger than the cycle of the current last sample.
+     */
+    void append(const Sample& sample);
+    void popBack();
+    void clear();
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return m_chunks.size() * s_chunkSize + m_active.size(); }
+    const Sample& back() const { return m_active.empty() ? m_chunks.back().last : m_active.back(); }
+
+    /**
+     * @brief samples
+     * @returns the samples with a cycle in the range ]@p fromCycle; @p toCycle[. If the range contains more than
+     * @p maxPoints samples, the range is sampled at a fixed stride such that roughly @p maxPoints samples are returned.
+     * The first and last samples of the range are always included. If @p maxPoints is 0, all samples in the range are
+     * returned.
+     */
+    std::vector<Sample> samples(unsigned fromCycle, unsigned toCycle, unsigned maxPoints = 0) const;
+
+    /**
+     * @brief memoryUsage
+     * @returns the approximate number of bytes used by the series.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Chunk {
+        Sample first;
+        Sample last;
+        // Run-length encoded deltas for the cycle column followed by each value column. columnEnd[i] is the offset
+        // into data wherein column i ends.
+        std::array<uint32_t, NColumns + 1> columnEnd{};
+        std::vector<uint8_t> data;
+    };
+
+    void seal();
+    void unseal();
+    void decode(const Chunk& chunk, std::vector<Sample>& out) const;
+
+    /**
+     * @brief upperIndex
+     * @returns the index of the first sample with a cycle larger than @p cycle.
+     */
+    size_t upperIndex(unsigned cycle) const;
+
+    std::vector<Chunk> m_chunks;
+    std::vector<Sample> m_active;
+};
+
+}  // namespace Ripes
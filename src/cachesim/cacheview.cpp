@@ -1,9 +1,10 @@
 #include "cacheview.h"
 
 #include <qmath.h>
-#include <QGraphicsSimpleTextItem>
 #include <QWheelEvent>
 
+#include "cachegraphic.h"
+
 namespace Ripes {
 
 CacheView::CacheView(QWidget* parent) : QGraphicsView(parent) {
@@ -17,14 +18,14 @@ CacheView::CacheView(QWidget* parent) : QGraphicsView(parent) {
 }
 
 void CacheView::mousePressEvent(QMouseEvent* event) {
-    // If we press on a cache data block, get the address stored for that block and emit a signal indicating that the
-    // address was selected through the cache
+    // If we press on a cache data block, get the address of that block from the cache graphic and emit a signal
+    // indicating that the address was selected through the cache
     const auto viewItems = items(event->pos());
     for (const auto& item : qAsConst(viewItems)) {
-        if (auto* textItem = dynamic_cast<QGraphicsSimpleTextItem*>(item)) {
-            const QVariant userData = textItem->data(Qt::UserRole);
-            if (userData.isValid()) {
-                emit cacheAddressSelected(userData.toULongLong());
+        if (auto* cacheGraphic = dynamic_cast<CacheGraphic*>(item)) {
+            const auto address = cacheGraphic->blockAddressAt(cacheGraphic->mapFromScene(mapToScene(event->pos())));
+            if (address) {
+                emit cacheAddressSelected(address.value());
                 break;
             }
         }
@@ -17,6 +17,7 @@ CacheWidget::CacheWidget(QWidget* parent) : QWidget(parent), m_ui(new Ui::CacheW
     m_cacheSim = std::make_shared<CacheSim>(this);
     m_ui->cacheConfig->setCache(m_cacheSim);
     m_ui->cachePlot->setCache(m_cacheSim);
+    m_ui->stackDistancePlot->setCache(m_cacheSim);
 
     auto* cacheGraphic = new CacheGraphic(*m_cacheSim);
     m_scene->addItem(cacheGraphic);
@@ -34,6 +35,11 @@ void CacheWidget::setNextLevelCache(const std::shared_ptr<CacheSim>& cache) {
     m_cacheSim.get()->setNextLevelCache(cache);
 }
 
+void CacheWidget::setMemoryTrace(const MemoryTrace* trace) {
+    m_ui->cacheConfig->setMemoryTrace(trace);
+    m_ui->stackDistancePlot->setMemoryTrace(trace);
+}
+
 CacheWidget::~CacheWidget() {
     delete m_ui;
 }
@@ -2,6 +2,7 @@
 
 #include <QWidget>
 #include "cachesim.h"
+#include "memorytrace.h"
 #include "processors/RISC-V/rv_memory.h"
 
 QT_FORWARD_DECLARE_CLASS(QGraphicsScene)
@@ -24,6 +25,7 @@ public:
     ~CacheWidget();
 
     void setNextLevelCache(const std::shared_ptr<CacheSim>& cache);
+    void setMemoryTrace(const MemoryTrace* trace);
 
     std::shared_ptr<CacheSim>& getCacheSim() { return m_cacheSim; }
     QGraphicsScene* getScene() { return m_scene.get(); }
@@ -0,0 +1,96 @@
+#include "dramsim.h"
+
+#include "../external/VSRTL/core/vsrtl_register.h"
+
+#include <algorithm>
+
+namespace Ripes {
+
+void DRAMSim::setConfig(const DRAMConfig& config) {
+    m_config = config;
+    m_config.banks = std::max(1u, m_config.banks);
+    m_config.rowBytes = std::max(1u, m_config.rowBytes);
+    reset();
+}
+
+void DRAMSim::reset() {
+    m_openRows.assign(m_config.banks, s_noRow);
+    m_records.clear();
+    m_stats = DRAMStats();
+}
+
+unsigned DRAMSim::access(AInt address, unsigned bytes, bool isWrite, unsigned cycle) {
+    // Discard the records of the cycles which can no longer be reversed.
+    const unsigned reverseCycles = vsrtl::core::ClockedComponent::reverseStackSize();
+    while (!m_records.empty() && m_records.front().cycle + reverseCycles < cycle) {
+        m_records.pop_front();
+    }
+
+    // Consecutive rows are interleaved across the banks.
+    const AInt rowIdx = address / m_config.rowBytes;
+    const unsigned bank = rowIdx % m_config.banks;
+    const AInt row = rowIdx / m_config.banks;
+
+    Record record;
+    record.prevRow = m_openRows[bank];
+    record.cycle = cycle;
+    record.bank = bank;
+    record.bytes = bytes;
+    record.isWrite = isWrite;
+    if (record.prevRow == row) {
+        record.outcome = Record::RowHit;
+        record.latency = m_config.tCAS;
+        m_stats.rowHits++;
+    } else if (record.prevRow == s_noRow) {
+        record.outcome = Record::RowMiss;
+        record.latency = m_config.tRCD + m_config.tCAS;
+        m_stats.rowMisses++;
+    } else {
+        record.outcome = Record::RowConflict;
+        record.latency = m_config.tRP + m_config.tRCD + m_config.tCAS;
+        m_stats.rowConflicts++;
+    }
+
+    // A closed page policy precharges the bank following each access, off the critical path of the access.
+    m_openRows[bank] = m_config.pagePolicy == PagePolicy::Open ? row : s_noRow;
+
+    if (isWrite) {
+        m_stats.writes++;
+        m_stats.bytesWritten += bytes;
+    } else {
+        m_stats.reads++;
+        m_stats.bytesRead += bytes;
+        m_stats.readLatency += record.latency;
+    }
+    m_records.push_back(record);
+    return record.latency;
+}
+
+void DRAMSim::reverse(unsigned cycle) {
+    while (!m_records.empty() && m_records.back().cycle >= cycle) {
+        const Record& record = m_records.back();
+        m_openRows[record.bank] = record.prevRow;
+        switch (record.outcome) {
+            case Record::RowHit:
+                m_stats.rowHits--;
+                break;
+            case Record::RowMiss:
+                m_stats.rowMisses--;
+                break;
+            case Record::RowConflict:
+                m_stats.rowConflicts--;
+                break;
+        }
+        if (record.isWrite) {
+            m_stats.writes--;
+            m_stats.bytesWritten -= record.bytes;
+        } else {
+            m_stats.reads--;
+            m_stats.bytesRead -= record.bytes;
+            m_stats.readLatency -= record.latency;
+        }
+        m_records.pop_back();
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+enum class PagePolicy { Open, Closed };
+
+/**
+ * @brief The DRAMConfig struct
+ * Organization and timing of the DRAM main memory. Timings are given in processor cycles.
+ * - tRCD: activation of a row, i.e., loading the row into the row buffer of its bank.
+ * - tRP: precharge of a bank, i.e., closing the row held in its row buffer.
+ * - tCAS: column access of the row held in the row buffer.
+ */
+struct DRAMConfig {
+    unsigned banks = 8;
+    unsigned rowBytes = 2048;
+    unsigned tRCD = 14;
+    unsigned tRP = 14;
+    unsigned tCAS = 14;
+    PagePolicy pagePolicy = PagePolicy::Open;
+};
+
+/**
+ * @brief The DRAMStats struct
+ * Counters of the accesses of the DRAM main memory. Each access is either a row hit (the row was held in the row buffer
+ * of its bank), a row miss (the bank was precharged) or a row conflict (another row was held in the row buffer, which
+ * had to be precharged first).
+ */
+struct DRAMStats {
+    unsigned reads = 0;
+    unsigned writes = 0;
+    unsigned rowHits = 0;
+    unsigned rowMisses = 0;
+    unsigned rowConflicts = 0;
+    uint64_t bytesRead = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t readLatency = 0;  // Sum of the latencies of all reads
+
+    unsigned accesses() const { return reads + writes; }
+    uint64_t bytes() const { return bytesRead + bytesWritten; }
+    double rowHitRate() const { return accesses() == 0 ? 0 : static_cast<double>(rowHits) / accesses(); }
+    double averageReadLatency() const { return reads == 0 ? 0 : static_cast<double>(readLatency) / reads; }
+};
+
+/**
+ * @brief The DRAMSim class
+ * A row buffer and bank timing model of the DRAM main memory behind the last-level caches. The last-level caches
+ * issue their fills, writebacks and write-throughs to the model, which tracks the row held in the row buffer of each
+ * bank. Consecutive rows are interleaved across the banks.
+ *
+ * With an open page policy, a row is held in the row buffer until an access to another row of the bank; with a closed
+ * page policy, the bank is precharged after each access. The latency of an access is determined by the state of the
+ * row buffer alone; the model does not account for queueing in the memory controller nor for the occupancy of the
+ * banks and the data bus.
+ *
+ * Accesses may be undone by cycle, alongside the accesses of the caches which issued them.
+ */
+class DRAMSim {
+public:
+    DRAMSim() { reset(); }
+
+    /**
+     * @brief setConfig
+     * Sets the organization and timing of the memory, and resets the state of the memory.
+     */
+    void setConfig(const DRAMConfig& config);
+    const DRAMConfig& getConfig() const { return m_config; }
+
+    /**
+     * @brief access
+     * Accesses the @p bytes bytes at @p address in @p cycle.
+     * @returns the latency of the access in cycles.
+     */
+    unsigned access(AInt address, unsigned bytes, bool isWrite, unsigned cycle);
+
+    /**
+     * @brief reverse
+     * Undoes all accesses performed in or after @p cycle.
+     */
+    void reverse(unsigned cycle);
+    void reset();
+
+    const DRAMStats& getStats() const { return m_stats; }
+
+private:
+    static constexpr AInt s_noRow = static_cast<AInt>(-1);
+
+    /**
+     * @brief The Record struct
+     * An undo record of a single access.
+     */
+    struct Record {
+        enum Outcome : uint8_t { RowHit, RowMiss, RowConflict };
+
+        AInt prevRow;
+        unsigned cycle;
+        unsigned bank;
+        unsigned bytes;
+        unsigned latency;
+        Outcome outcome;
+        bool isWrite;
+    };
+
+    DRAMConfig m_config;
+    DRAMStats m_stats;
+
+    /**
+     * @brief m_openRows
+     * The row held in the row buffer of each bank, or s_noRow for precharged banks.
+     */
+    std::vector<AInt> m_openRows;
+
+    /**
+     * @brief m_records
+     * Undo records of the accesses of the most recent cycles, in the order of the accesses. Records of cycles which
+     * can no longer be reversed (see the undo stack size of VSRTL memory elements) are discarded.
+     */
+    std::deque<Record> m_records;
+};
+
+const static std::map<PagePolicy, QString> s_dramPagePolicyStrings{{PagePolicy::Open, "Open page"},
+                                                                   {PagePolicy::Closed, "Closed page"}};
+
+}  // namespace Ripes
@@ -1,6 +1,7 @@
 #include "l1cacheshim.h"
 
 #include "processorhandler.h"
+#include "ripessettings.h"
 
 namespace Ripes {
 
@@ -14,6 +15,10 @@ L1CacheShim::L1CacheShim(CacheType type, QObject* parent) : CacheInterface(paren
             Qt::DirectConnection);
     connect(ProcessorHandler::get(), &ProcessorHandler::processorReversed, this, &L1CacheShim::processorReversed);
 
+    m_timingEnabled = RipesSettings::value(RIPES_SETTING_CACHE_TIMING).toBool();
+    connect(RipesSettings::getObserver(RIPES_SETTING_CACHE_TIMING), &SettingObserver::modified, this,
+            [=](const QVariant& value) { m_timingEnabled = value.toBool(); });
+
     processorReset();
 }
 
@@ -25,6 +30,7 @@ void L1CacheShim::access(AInt, MemoryAccess::Type) {
 void L1CacheShim::processorReset() {
     // Propagate a reset through the cache hierarchy
     CacheInterface::reset();
+    m_trace.clear();
 
     if (m_nextLevelCache) {
         // Reload the initial (cycle 0) state of the processor. This is necessary to reflect ie. the instruction which
@@ -36,6 +42,19 @@ void L1CacheShim::processorReset() {
 void L1CacheShim::processorReversed() {
     // Start propagating a reverse call through the cache hierarchy
     CacheInterface::reverse();
+    m_trace.truncate(ProcessorHandler::getProcessor()->getCycleCount());
+}
+
+void L1CacheShim::forwardAccess(const MemoryAccess& access) {
+    const unsigned cycle = ProcessorHandler::getProcessor()->getCycleCount();
+    m_trace.append(cycle, access.address, access.type);
+    const unsigned latency = m_nextLevelCache->access(access.address, access.type, cycle, access.pc);
+
+    // The access itself is performed in the cycle which the processor was clocked in; any additional cycles are
+    // spent stalling the processor.
+    if (m_timingEnabled && latency > 1) {
+        ProcessorHandler::getProcessorNonConst()->stallMemory(latency - 1);
+    }
 }
 
 void L1CacheShim::processorWasClocked() {
@@ -45,10 +64,8 @@ void L1CacheShim::processorWasClocked() {
         // Determine whether the memory is being accessed in the current cycle, and if so, the access type.
         switch (dataAccess.type) {
             case MemoryAccess::Write:
-                m_nextLevelCache->access(dataAccess.address, MemoryAccess::Write);
-                break;
             case MemoryAccess::Read:
-                m_nextLevelCache->access(dataAccess.address, MemoryAccess::Read);
+                forwardAccess(dataAccess);
                 break;
             case MemoryAccess::None:
             default:
@@ -57,7 +74,7 @@ void L1CacheShim::processorWasClocked() {
     } else {
         const auto instrAccess = ProcessorHandler::getProcessor()->instrMemAccess();
         if (instrAccess.type == MemoryAccess::Read) {
-            m_nextLevelCache->access(instrAccess.address, MemoryAccess::Read);
+            forwardAccess(instrAccess);
         }
     }
 }
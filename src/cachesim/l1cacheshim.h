@@ -3,6 +3,7 @@
 #include <QObject>
 
 #include "cachesim.h"
+#include "memorytrace.h"
 
 #include "VSRTL/core/vsrtl_memory.h"
 #include "ripes_types.h"
@@ -23,10 +24,18 @@ public:
 
     void setType(CacheType type);
 
+    /**
+     * @brief getTrace
+     * Returns the trace of all memory accesses which the shim has forwarded to the cache since the last processor
+     * reset.
+     */
+    const MemoryTrace& getTrace() const { return m_trace; }
+
 private:
     void processorReset();
     void processorWasClocked();
     void processorReversed();
+    void forwardAccess(const MemoryAccess& access);
 
     /**
      * @brief m_memory
@@ -34,6 +43,14 @@ private:
      * VSRTL component signals are dependent on the given type of the memory.
      */
     CacheType m_type;
+
+    MemoryTrace m_trace;
+
+    /**
+     * @brief m_timingEnabled
+     * Cached value of RIPES_SETTING_CACHE_TIMING. If set, the processor is stalled for the latency of each access.
+     */
+    bool m_timingEnabled = false;
 };
 
 }  // namespace Ripes
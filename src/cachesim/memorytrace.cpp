@@ -0,0 +1,162 @@
+#include "memorytrace.h"
+
+#include <QDataStream>
+
+#include <algorithm>
+
+namespace Ripes {
+
+namespace {
+
+constexpr quint32 s_traceMagic = 0x52545243;  // "RTRC"
+constexpr quint32 s_traceVersion = 1;
+constexpr unsigned s_typeBits = 2;
+
+void encodeVarint(std::vector<uint8_t>& data, uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t decodeVarint(const uint8_t*& it) {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    while (*it & 0x80) {
+        value |= static_cast<uint64_t>(*it & 0x7F) << shift;
+        shift += 7;
+        it++;
+    }
+    value |= static_cast<uint64_t>(*it) << shift;
+    it++;
+    return value;
+}
+
+}  // namespace
+
+const MemoryTrace::Entry& MemoryTrace::Decoder::next(const uint8_t*& it) {
+    const uint64_t cycleAndType = decodeVarint(it);
+    const uint64_t zigzag = decodeVarint(it);
+    const int64_t addressDelta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+
+    state.cycle += static_cast<unsigned>(cycleAndType >> s_typeBits);
+    state.type = static_cast<MemoryAccess::Type>(cycleAndType & ((1 << s_typeBits) - 1));
+    state.address += static_cast<AInt>(addressDelta);
+    return state;
+}
+
+void MemoryTrace::append(unsigned cycle, AInt address, MemoryAccess::Type type) {
+    Q_ASSERT(m_size == 0 || cycle >= m_last.cycle);
+
+    if (m_size % s_checkpointInterval == 0 && m_checkpoints.size() == m_size / s_checkpointInterval) {
+        m_checkpoints.push_back({m_data.size(), Decoder{m_last}});
+    }
+
+    const int64_t addressDelta = static_cast<int64_t>(address - m_last.address);
+    const uint64_t zigzag = (static_cast<uint64_t>(addressDelta) << 1) ^ static_cast<uint64_t>(addressDelta >> 63);
+    encodeVarint(m_data, (static_cast<uint64_t>(cycle - m_last.cycle) << s_typeBits) | type);
+    encodeVarint(m_data, zigzag);
+
+    m_last = {cycle, address, type};
+    m_size++;
+}
+
+void MemoryTrace::truncate(unsigned cycle) {
+    if (m_size == 0 || m_last.cycle <= cycle) {
+        return;
+    }
+
+    // Locate the last checkpoint wherein all preceding accesses are to be kept, and decode from there until the first
+    // access which occurred after @p cycle.
+    auto cpIt = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), cycle,
+                                 [](unsigned c, const Checkpoint& cp) { return c < cp.decoder.state.cycle; });
+    Q_ASSERT(cpIt != m_checkpoints.begin());
+    cpIt--;
+
+    Decoder decoder = cpIt->decoder;
+    size_t index = (cpIt - m_checkpoints.begin()) * s_checkpointInterval;
+    const uint8_t* it = m_data.data() + cpIt->offset;
+    while (index < m_size) {
+        Decoder probe = decoder;
+        const uint8_t* probeIt = it;
+        if (probe.next(probeIt).cycle > cycle) {
+            break;
+        }
+        decoder = probe;
+        it = probeIt;
+        index++;
+    }
+
+    m_data.resize(it - m_data.data());
+    m_size = index;
+    m_last = decoder.state;
+    m_checkpoints.resize((m_size + s_checkpointInterval - 1) / s_checkpointInterval);
+}
+
+void MemoryTrace::clear() {
+    m_data.clear();
+    m_checkpoints.clear();
+    m_size = 0;
+    m_last = Entry();
+}
+
+void MemoryTrace::rebuildCheckpoints() {
+    m_checkpoints.clear();
+    Decoder decoder;
+    const uint8_t* it = m_data.data();
+    for (size_t i = 0; i < m_size; ++i) {
+        if (i % s_checkpointInterval == 0) {
+            m_checkpoints.push_back({static_cast<size_t>(it - m_data.data()), decoder});
+        }
+        decoder.next(it);
+    }
+    m_last = decoder.state;
+}
+
+bool MemoryTrace::save(QIODevice& device) const {
+    QDataStream out(&device);
+    out << s_traceMagic << s_traceVersion << static_cast<quint64>(m_size) << static_cast<quint64>(m_data.size());
+    out.writeRawData(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+    return out.status() == QDataStream::Ok;
+}
+
+bool MemoryTrace::load(QIODevice& device) {
+    QDataStream in(&device);
+    quint32 magic, version;
+    quint64 size, bytes;
+    in >> magic >> version >> size >> bytes;
+    if (in.status() != QDataStream::Ok || magic != s_traceMagic || version != s_traceVersion) {
+        return false;
+    }
+
+    std::vector<uint8_t> data(bytes);
+    if (in.readRawData(reinterpret_cast<char*>(data.data()), bytes) != static_cast<int>(bytes)) {
+        return false;
+    }
+
+    // Validate that the data contains exactly the number of accesses specified in the header.
+    const uint8_t* it = data.data();
+    const uint8_t* end = data.data() + data.size();
+    for (quint64 i = 0; i < size; ++i) {
+        for (int field = 0; field < 2; ++field) {
+            while (it != end && (*it & 0x80)) {
+                it++;
+            }
+            if (it == end) {
+                return false;
+            }
+            it++;
+        }
+    }
+    if (it != end) {
+        return false;
+    }
+
+    m_data = std::move(data);
+    m_size = size;
+    rebuildCheckpoints();
+    return true;
+}
+
+}  // namespace Ripes
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QIODevice>
+
+#include "processors/interface/ripesprocessor.h"
+#include "ripes_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The MemoryTrace class
+ * A compact, append-only record of the memory accesses seen by a cache, suitable for replaying the accesses through
+ * other cache configurations without re-simulating the processor.
+ *
+ * Each access is encoded relative to the previous access as two variable-length integers: the cycle delta packed
+ * together with the access type, and the zigzag encoded address delta. For sequential instruction fetches, this
+ * amounts to 2 bytes per access.
+ * Every s_checkpointInterval accesses, the decoder state is checkpointed, allowing for truncating the trace when the
+ * processor is reversed without decoding the entire trace.
+ */
+class MemoryTrace {
+public:
+    struct Entry {
+        unsigned cycle = 0;
+        AInt address = 0;
+        MemoryAccess::Type type = MemoryAccess::None;
+    };
+
+    static constexpr unsigned s_checkpointInterval = 1024;
+
+    /**
+     * @brief append
+     * Appends an access to the trace. @p cycle must be larger than or equal to the cycle of the last access in the
+     * trace.
+     */
+    void append(unsigned cycle, AInt address, MemoryAccess::Type type);
+
+    /**
+     * @brief truncate
+     * Removes all accesses which occurred after @p cycle.
+     */
+    void truncate(unsigned cycle);
+    void clear();
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t byteSize() const { return m_data.size(); }
+
+    /**
+     * @brief forEach
+     * Decodes the trace, calling @p f for each access in the order of which they were recorded.
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        Decoder decoder;
+        const uint8_t* it = m_data.data();
+        for (size_t i = 0; i < m_size; ++i) {
+            f(decoder.next(it));
+        }
+    }
+
+    /**
+     * @brief save/load
+     * Serializes/deserializes the trace to/from @p device. Returns false if the device could not be written or did
+     * not contain a valid trace.
+     */
+    bool save(QIODevice& device) const;
+    bool load(QIODevice& device);
+
+private:
+    struct Decoder {
+        Entry state;
+        const Entry& next(const uint8_t*& it);
+    };
+
+    struct Checkpoint {
+        size_t offset;
+        Decoder decoder;
+    };
+
+    void rebuildCheckpoints();
+
+    std::vector<uint8_t> m_data;
+    std::vector<Checkpoint> m_checkpoints;
+    size_t m_size = 0;
+    Entry m_last;
+};
+
+}  // namespace Ripes
@@ -0,0 +1,100 @@
+#include "missclassifier.h"
+
+#include <QtGlobal>
+
+namespace Ripes {
+
+void MissClassifier::reset(unsigned blocks) {
+    m_capacity = blocks;
+    m_nodes.clear();
+    m_nodes.reserve(blocks);
+    m_resident.clear();
+    m_resident.reserve(blocks);
+    m_head = s_noBlock;
+    m_tail = s_noBlock;
+    m_referenced.clear();
+}
+
+void MissClassifier::unlink(uint32_t nodeIdx) {
+    const Node& node = m_nodes[nodeIdx];
+    (node.prev == s_noBlock ? m_head : m_nodes[node.prev].next) = node.next;
+    (node.next == s_noBlock ? m_tail : m_nodes[node.next].prev) = node.prev;
+}
+
+void MissClassifier::link(uint32_t nodeIdx, uint32_t nextIdx) {
+    Node& node = m_nodes[nodeIdx];
+    node.next = nextIdx;
+    node.prev = nextIdx == s_noBlock ? m_tail : m_nodes[nextIdx].prev;
+    (node.prev == s_noBlock ? m_head : m_nodes[node.prev].next) = nodeIdx;
+    (nextIdx == s_noBlock ? m_tail : m_nodes[nextIdx].prev) = nodeIdx;
+}
+
+MissClassifier::Record MissClassifier::access(AInt blockAddress, bool isHit, bool allocate, bool prefetched) {
+    Record record;
+    auto it = m_resident.find(blockAddress);
+
+    // Blocks which are resident in the shadow cache have been referenced before; the set of referenced blocks need only
+    // be consulted for the remaining accesses. Blocks which hit in the cache have been referenced before, unless they
+    // were prefetched.
+    if ((!isHit || prefetched) && it == m_resident.end() && m_referenced.insert(blockAddress).second) {
+        record.flags |= Record::FirstReference;
+    }
+
+    if (it != m_resident.end()) {
+        record.flags |= Record::ShadowHit;
+        record.next = m_nodes[it->second].next;
+        unlink(it->second);
+        link(it->second, m_head);
+    } else if (allocate && m_capacity > 0) {
+        record.flags |= Record::Inserted;
+        uint32_t nodeIdx;
+        if (m_nodes.size() < m_capacity) {
+            nodeIdx = m_nodes.size();
+            m_nodes.push_back({blockAddress, s_noBlock, s_noBlock});
+        } else {
+            // Replace the least recently used block. The map entry of the evicted block is reused for the inserted
+            // block, avoiding an allocation per replacement.
+            nodeIdx = m_tail;
+            record.flags |= Record::Evicted;
+            record.evictedBlock = m_nodes[nodeIdx].block;
+            unlink(nodeIdx);
+            auto entry = m_resident.extract(record.evictedBlock);
+            entry.key() = blockAddress;
+            m_resident.insert(std::move(entry));
+            m_nodes[nodeIdx].block = blockAddress;
+        }
+        if (!(record.flags & Record::Evicted)) {
+            m_resident[blockAddress] = nodeIdx;
+        }
+        link(nodeIdx, m_head);
+    }
+    return record;
+}
+
+void MissClassifier::undo(AInt blockAddress, const Record& record) {
+    if (record.flags & Record::Inserted) {
+        auto entry = m_resident.extract(blockAddress);
+        const uint32_t nodeIdx = entry.mapped();
+        unlink(nodeIdx);
+        if (record.flags & Record::Evicted) {
+            // Restore the evicted block as the least recently used block
+            m_nodes[nodeIdx].block = record.evictedBlock;
+            entry.key() = record.evictedBlock;
+            m_resident.insert(std::move(entry));
+            link(nodeIdx, s_noBlock);
+        } else {
+            Q_ASSERT(nodeIdx == m_nodes.size() - 1);
+            m_nodes.pop_back();
+        }
+    } else if (record.flags & Record::ShadowHit) {
+        const uint32_t nodeIdx = m_resident.at(blockAddress);
+        unlink(nodeIdx);
+        link(nodeIdx, record.next);
+    }
+
+    if (record.flags & Record::FirstReference) {
+        m_referenced.erase(blockAddress);
+    }
+}
+
+}  // namespace Ripes
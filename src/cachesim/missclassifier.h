@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+enum MissClass { Compulsory, Capacity, Conflict, NMissClasses };
+
+/**
+ * @brief The MissClassifier class
+ * Classifies the misses of a cache by their cause (the "3C" model):
+ * - Compulsory: the first reference to a block. Tracked through the (unbounded) set of all blocks referenced so far.
+ * - Capacity: the block would also have missed in a fully associative LRU cache of the same capacity. Tracked through
+ *   a shadow cache of that capacity, which is accessed alongside the cache.
+ * - Conflict: all other misses, i.e., misses caused by the limited associativity of the cache.
+ *
+ * Accesses to the classifier may be undone, in reverse order, through the undo record returned by access().
+ */
+class MissClassifier {
+public:
+    struct Record {
+        enum Flags : uint8_t {
+            FirstReference = 0b1,  // The block had not been referenced before
+            ShadowHit = 0b10,      // The block was resident in the shadow cache
+            Inserted = 0b100,      // The block was inserted in the shadow cache
+            Evicted = 0b1000       // The insertion evicted evictedBlock from the shadow cache
+        };
+        AInt evictedBlock = 0;
+        uint32_t next = 0;  // For shadow hits, the block which was next in the recency order of the shadow cache
+        uint8_t flags = 0;
+    };
+
+    /**
+     * @brief reset
+     * Clears all state of the classifier, and sets the capacity of the shadow cache to @p blocks blocks.
+     */
+    void reset(unsigned blocks);
+
+    /**
+     * @brief access
+     * Registers an access to the block at @p blockAddress, which hit in the cache if @p isHit. On a miss in the shadow
+     * cache, the block is only inserted if @p allocate is set, mirroring the allocation policy of the cache.
+     * @p prefetched indicates that the access hit on a block which was prefetched into the cache, and has thus not
+     * necessarily been referenced before.
+     */
+    Record access(AInt blockAddress, bool isHit, bool allocate, bool prefetched = false);
+    void undo(AInt blockAddress, const Record& record);
+
+    /**
+     * @brief classify
+     * @returns the class of a miss in the cache, given the record of the classifier access for the missing access.
+     */
+    static MissClass classify(const Record& record) {
+        return (record.flags & Record::FirstReference) ? MissClass::Compulsory
+               : (record.flags & Record::ShadowHit)    ? MissClass::Conflict
+                                                       : MissClass::Capacity;
+    }
+
+private:
+    static constexpr uint32_t s_noBlock = UINT32_MAX;
+
+    /**
+     * @brief The Node struct
+     * A block resident in the shadow cache. Resident blocks form a doubly linked list ordered from the most to the
+     * least recently used block, such that the shadow cache is updated in constant time regardless of its capacity.
+     */
+    struct Node {
+        AInt block;
+        uint32_t prev;  // Towards the most recently used block
+        uint32_t next;  // Towards the least recently used block
+    };
+
+    void unlink(uint32_t nodeIdx);
+    /**
+     * @brief link
+     * Inserts @p nodeIdx in the recency list before @p nextIdx, or as the least recently used block if @p nextIdx is
+     * s_noBlock.
+     */
+    void link(uint32_t nodeIdx, uint32_t nextIdx);
+
+    unsigned m_capacity = 0;
+    std::vector<Node> m_nodes;
+    std::unordered_map<AInt, uint32_t> m_resident;
+    uint32_t m_head = s_noBlock;
+    uint32_t m_tail = s_noBlock;
+
+    std::unordered_set<AInt> m_referenced;
+};
+
+const static std::map<MissClass, QString> s_cacheMissClassStrings{{MissClass::Compulsory, "Compulsory"},
+                                                                  {MissClass::Capacity, "Capacity"},
+                                                                  {MissClass::Conflict, "Conflict"}};
+
+}  // namespace Ripes
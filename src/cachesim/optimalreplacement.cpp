@@ -0,0 +1,183 @@
+#include "optimalreplacement.h"
+#include "binutils.h"
+
+#include <utility>
+
+namespace Ripes {
+
+namespace {
+
+/**
+ * @brief The BlockIdMap class
+ * An open addressing hash map from block addresses to dense block IDs. Blocks are never removed, such that the map is
+ * a linear probing table without tombstones. Mapping a long trace performs tens of millions of lookups, for which this
+ * is several times faster than std::unordered_map.
+ */
+class BlockIdMap {
+public:
+    BlockIdMap() { rehash(1 << 12); }
+
+    /**
+     * @brief insert
+     * @returns the ID of @p block, and whether @p block was inserted with the ID @p id.
+     */
+    std::pair<uint32_t, bool> insert(AInt block, uint32_t id) {
+        if (2 * (m_size + 1) > m_ids.size()) {
+            rehash(2 * m_ids.size());
+        }
+        for (size_t slot = hash(block);; slot = (slot + 1) & (m_ids.size() - 1)) {
+            if (m_ids[slot] == s_empty) {
+                m_ids[slot] = id;
+                m_blocks[slot] = block;
+                m_size++;
+                return {id, true};
+            }
+            if (m_blocks[slot] == block) {
+                return {m_ids[slot], false};
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t s_empty = UINT32_MAX;
+
+    size_t hash(AInt block) const { return (block * 0x9E3779B97F4A7C15) >> m_shift; }
+
+    void rehash(size_t capacity) {
+        std::vector<AInt> blocks(capacity);
+        std::vector<uint32_t> ids(capacity, s_empty);
+        std::swap(blocks, m_blocks);
+        std::swap(ids, m_ids);
+        m_shift = 64 - log2Ceil(capacity);
+        m_size = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] != s_empty) {
+                insert(blocks[i], ids[i]);
+            }
+        }
+    }
+
+    std::vector<AInt> m_blocks;
+    std::vector<uint32_t> m_ids;
+    size_t m_size = 0;
+    unsigned m_shift = 0;
+};
+
+}  // namespace
+
+OptimalReplacement::OptimalReplacement(const MemoryTrace& trace, unsigned blockBytes) : m_blockBytes(blockBytes) {
+    Q_ASSERT(trace.size() < s_never);
+    m_blocks.reserve(trace.size());
+    m_isWrite.reserve(trace.size());
+
+    BlockIdMap blockIds;
+    trace.forEach([&](const MemoryTrace::Entry& entry) {
+        // Disregard unaligned accesses, as CacheCore
+        const AInt blockAddress = entry.address & ~0b11 & ~static_cast<AInt>(blockBytes - 1);
+        const auto blockId = blockIds.insert(blockAddress, m_blockAddresses.size());
+        if (blockId.second) {
+            m_blockAddresses.push_back(blockAddress);
+        }
+        m_blocks.push_back(blockId.first);
+        m_isWrite.push_back(entry.type == MemoryAccess::Write);
+    });
+
+    // Reverse pass: the next use of an access is the most recently seen access to the same block.
+    m_nextUse.resize(m_blocks.size());
+    std::vector<uint32_t> nextAccess(m_blockAddresses.size(), s_never);
+    for (size_t i = m_blocks.size(); i-- > 0;) {
+        m_nextUse[i] = nextAccess[m_blocks[i]];
+        nextAccess[m_blocks[i]] = i;
+    }
+}
+
+OptimalReplacement::Result OptimalReplacement::simulate(const CachePreset& preset) const {
+    // The words of the blocks of the preset make up the block size of the trace.
+    CacheCore geometry;
+    geometry.setWordSize(m_blockBytes >> preset.blocks);
+    geometry.setPreset(preset);
+    Q_ASSERT(geometry.getBlockBytes() == m_blockBytes);
+    const unsigned ways = geometry.getWays();
+    const bool writeBack = preset.wrPolicy == WritePolicy::WriteBack;
+    const bool writeAllocate = preset.wrAllocPolicy == WriteAllocPolicy::WriteAllocate;
+
+    std::vector<uint32_t> lineIdx(m_blockAddresses.size());
+    for (unsigned id = 0; id < m_blockAddresses.size(); ++id) {
+        lineIdx[id] = geometry.getLineIdx(m_blockAddresses[id]);
+    }
+
+    // The resident blocks of cache line l are stored as a max-heap, keyed on next use, in the heap slots
+    // [l * ways; l * ways + heapSize[l][. slot[id] is the position of a resident block within the heap of its line.
+    std::vector<uint32_t> heap(geometry.getLines() * ways);
+    std::vector<uint32_t> heapSize(geometry.getLines(), 0);
+    std::vector<uint32_t> nextUse(m_blockAddresses.size());
+    std::vector<uint32_t> slot(m_blockAddresses.size(), s_never);
+    std::vector<uint8_t> dirty(m_blockAddresses.size(), false);
+
+    const auto place = [&](uint32_t* lineHeap, uint32_t pos, uint32_t id) {
+        lineHeap[pos] = id;
+        slot[id] = pos;
+    };
+    const auto siftUp = [&](uint32_t* lineHeap, uint32_t pos) {
+        const uint32_t id = lineHeap[pos];
+        while (pos > 0 && nextUse[lineHeap[(pos - 1) / 2]] < nextUse[id]) {
+            place(lineHeap, pos, lineHeap[(pos - 1) / 2]);
+            pos = (pos - 1) / 2;
+        }
+        place(lineHeap, pos, id);
+    };
+    const auto siftDown = [&](uint32_t* lineHeap, uint32_t size, uint32_t pos) {
+        const uint32_t id = lineHeap[pos];
+        for (uint32_t child = 2 * pos + 1; child < size; pos = child, child = 2 * pos + 1) {
+            if (child + 1 < size && nextUse[lineHeap[child + 1]] > nextUse[lineHeap[child]]) {
+                child++;
+            }
+            if (nextUse[lineHeap[child]] <= nextUse[id]) {
+                break;
+            }
+            place(lineHeap, pos, lineHeap[child]);
+        }
+        place(lineHeap, pos, id);
+    };
+
+    Result result;
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        const uint32_t id = m_blocks[i];
+        const bool isWrite = m_isWrite[i];
+        const uint32_t line = lineIdx[id];
+        uint32_t* lineHeap = &heap[line * ways];
+
+        const bool hit = slot[id] != s_never;
+        const bool allocate = !isWrite || writeAllocate;
+        bool writeback = isWrite && (!writeBack || (!hit && !allocate));
+        if (hit) {
+            // The block was keyed on this access; its next use can only move further into the future.
+            nextUse[id] = m_nextUse[i];
+            siftUp(lineHeap, slot[id]);
+        } else if (allocate) {
+            nextUse[id] = m_nextUse[i];
+            if (heapSize[line] < ways) {
+                place(lineHeap, heapSize[line]++, id);
+                siftUp(lineHeap, heapSize[line] - 1);
+            } else {
+                // Evict the block which is used furthest in the future
+                const uint32_t victim = lineHeap[0];
+                writeback |= dirty[victim];
+                dirty[victim] = false;
+                slot[victim] = s_never;
+                place(lineHeap, 0, id);
+                siftDown(lineHeap, ways, 0);
+            }
+        }
+        if (hit || allocate) {
+            dirty[id] |= isWrite && writeBack;
+        }
+
+        result.hits += hit ? 1 : 0;
+        result.misses += hit ? 0 : 1;
+        result.writebacks += writeback ? 1 : 0;
+    }
+    return result;
+}
+
+}  // namespace Ripes
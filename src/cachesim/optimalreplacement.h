@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cachecore.h"
+#include "memorytrace.h"
+
+namespace Ripes {
+
+/**
+ * @brief The OptimalReplacement class
+ * Offline Belady-optimal (MIN) replacement for a recorded memory trace, providing an upper bound on the hit rate which
+ * is achievable by any replacement policy for a given cache geometry.
+ *
+ * On construction, the trace is decoded once and each access is mapped to a dense block ID. The index of the next
+ * access to the same block (the next use) is then computed for each access in a single reverse pass. Simulating a
+ * cache geometry thereby only requires a forward pass over the precomputed accesses: each cache line keeps a max-heap
+ * of its resident blocks keyed on their next use, such that the block to evict (the block used furthest in the future)
+ * is located in constant time and updated in logarithmic time of the associativity.
+ */
+class OptimalReplacement {
+public:
+    struct Result {
+        unsigned hits = 0;
+        unsigned misses = 0;
+        unsigned writebacks = 0;
+    };
+
+    /**
+     * @param blockBytes: the number of bytes in a cache block; all presets simulated through this object must have
+     * blocks of this size.
+     */
+    OptimalReplacement(const MemoryTrace& trace, unsigned blockBytes);
+
+    /**
+     * @brief simulate
+     * Simulates the trace through a cache with the geometry and write policies of @p preset, using optimal
+     * replacement. Accesses which do not allocate in the cache (write misses without write allocation) do not affect
+     * the cache state.
+     */
+    Result simulate(const CachePreset& preset) const;
+
+private:
+    static constexpr uint32_t s_never = UINT32_MAX;
+
+    unsigned m_blockBytes;
+    std::vector<uint32_t> m_blocks;   // Block ID of each access
+    std::vector<uint32_t> m_nextUse;  // Index of the next access to the same block, or s_never
+    std::vector<uint8_t> m_isWrite;
+    std::vector<AInt> m_blockAddresses;  // Address of each block ID
+};
+
+}  // namespace Ripes
@@ -0,0 +1,146 @@
+#include "plotdownsampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ripes {
+
+void PlotDownsampler::Bucket::add(const QPointF& point) {
+    if (n == 0 || point.y() < min.y()) {
+        min = point;
+    }
+    if (n == 0 || point.y() > max.y()) {
+        max = point;
+    }
+    sumX += point.x();
+    sumY += point.y();
+    n++;
+}
+
+void PlotDownsampler::Bucket::merge(const Bucket& other) {
+    if (other.min.y() < min.y()) {
+        min = other.min;
+    }
+    if (other.max.y() > max.y()) {
+        max = other.max;
+    }
+    sumX += other.sumX;
+    sumY += other.sumY;
+    n += other.n;
+}
+
+void PlotDownsampler::reset(unsigned budget) {
+    m_budget = std::max(1u, budget);
+    m_width = 1;
+    m_empty = true;
+    m_buckets.clear();
+    m_selected.clear();
+    m_open = Bucket();
+}
+
+int64_t PlotDownsampler::bucketIndex(double x) const {
+    return static_cast<int64_t>(std::floor(x / m_width));
+}
+
+void PlotDownsampler::append(const QPointF& point) {
+    m_last = point;
+    if (m_empty) {
+        m_empty = false;
+        m_first = point;
+        m_open.index = bucketIndex(point.x());
+        m_open.add(point);
+        return;
+    }
+
+    int64_t index = bucketIndex(point.x());
+    if (index != m_open.index) {
+        // Coarsen the buckets before completing the incomplete bucket, if this would exceed the budget. The point may
+        // then fall within the incomplete bucket. Buckets of sparse series may not all be merged by a single doubling
+        // of the bucket width.
+        while (index != m_open.index && m_buckets.size() + 1 >= 2 * m_budget) {
+            coarsen();
+            index = bucketIndex(point.x());
+        }
+        if (index != m_open.index) {
+            completeBucket();
+            m_open.index = index;
+        }
+    }
+    m_open.add(point);
+}
+
+QPointF PlotDownsampler::select(const QPointF& prev, const Bucket& bucket, const QPointF& next) const {
+    // Twice the area of the triangle formed by prev, the candidate and next
+    const auto area = [&](const QPointF& p) {
+        return std::abs((prev.x() - next.x()) * (p.y() - prev.y()) - (prev.x() - p.x()) * (next.y() - prev.y()));
+    };
+    return area(bucket.max) > area(bucket.min) ? bucket.max : bucket.min;
+}
+
+void PlotDownsampler::completeBucket() {
+    m_buckets.push_back(m_open);
+    m_open = Bucket();
+    if (m_buckets.size() >= 2) {
+        const size_t i = m_buckets.size() - 2;
+        const QPointF& prev = m_selected.empty() ? m_first : m_selected.back();
+        m_selected.push_back(select(prev, m_buckets.at(i), m_buckets.at(i + 1).average()));
+    }
+}
+
+void PlotDownsampler::coarsen() {
+    m_width *= 2;
+    std::vector<Bucket> merged;
+    merged.reserve(m_buckets.size() / 2 + 1);
+    for (Bucket bucket : m_buckets) {
+        bucket.index = bucket.index >> 1;
+        if (!merged.empty() && merged.back().index == bucket.index) {
+            merged.back().merge(bucket);
+        } else {
+            merged.push_back(bucket);
+        }
+    }
+
+    // The last completed bucket may merge with the incomplete bucket
+    m_open.index = m_open.index >> 1;
+    if (!merged.empty() && merged.back().index == m_open.index) {
+        merged.back().merge(m_open);
+        m_open = merged.back();
+        merged.pop_back();
+    }
+    m_buckets = std::move(merged);
+
+    m_selected.clear();
+    for (size_t i = 0; i + 1 < m_buckets.size(); i++) {
+        const QPointF& prev = m_selected.empty() ? m_first : m_selected.back();
+        m_selected.push_back(select(prev, m_buckets.at(i), m_buckets.at(i + 1).average()));
+    }
+}
+
+std::vector<QPointF> PlotDownsampler::points() const {
+    std::vector<QPointF> points;
+    if (m_empty) {
+        return points;
+    }
+    points.reserve(m_selected.size() + 3);
+
+    // Points are only added in order of strictly increasing x; the first and last points of the series may also be the
+    // selected points of their buckets.
+    const auto add = [&](const QPointF& point) {
+        if (points.empty() || point.x() > points.back().x()) {
+            points.push_back(point);
+        }
+    };
+
+    add(m_first);
+    for (const auto& point : m_selected) {
+        add(point);
+    }
+    if (!m_buckets.empty()) {
+        const QPointF& prev = m_selected.empty() ? m_first : m_selected.back();
+        add(select(prev, m_buckets.back(), m_open.average()));
+    }
+    add(m_last);
+    return points;
+}
+
+}  // namespace Ripes
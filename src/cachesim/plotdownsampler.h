@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QPointF>
+
+#include <cstdint>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The PlotDownsampler class
+ * Incremental largest-triangle-three-buckets (LTTB) downsampling of a plotted series, retaining a bounded number of
+ * points regardless of the length of the series.
+ *
+ * Points are appended in order of increasing x. The x-axis is divided into buckets of a fixed width, and a single point
+ * is selected from each bucket: the point which forms the largest triangle with the point selected from the preceding
+ * bucket and the average of the points of the following bucket. A bucket is thereby selected from once the following
+ * bucket is complete. Once the number of buckets reaches twice the point budget, the bucket width is doubled by merging
+ * adjacent buckets, and the points of all buckets are reselected.
+ *
+ * Only the points of minimum and maximum y of each bucket are retained as candidates for the selection. This bounds
+ * both the memory and the cost of appending a point, while the extremes of each bucket, i.e. spikes in the series, are
+ * always candidates.
+ */
+class PlotDownsampler {
+public:
+    /**
+     * @brief reset
+     * Clears the series. Between @p budget and 2x @p budget points are retained for the series.
+     */
+    void reset(unsigned budget);
+    void append(const QPointF& point);
+    bool empty() const { return m_empty; }
+
+    /**
+     * @brief points
+     * @returns the downsampled series: the first point of the series, the selected point of each bucket and the last
+     * point of the series. The point of the most recently completed bucket is selected provisionally, using the
+     * average of the incomplete bucket.
+     */
+    std::vector<QPointF> points() const;
+
+private:
+    struct Bucket {
+        int64_t index = 0;  // x / bucket width
+        QPointF min;
+        QPointF max;
+        double sumX = 0;
+        double sumY = 0;
+        unsigned n = 0;
+
+        void add(const QPointF& point);
+        void merge(const Bucket& other);
+        QPointF average() const { return QPointF(sumX / n, sumY / n); }
+    };
+
+    int64_t bucketIndex(double x) const;
+    QPointF select(const QPointF& prev, const Bucket& bucket, const QPointF& next) const;
+    void completeBucket();
+    void coarsen();
+
+    unsigned m_budget = 1;
+    double m_width = 1;
+    bool m_empty = true;
+    QPointF m_first;
+    QPointF m_last;
+
+    // Completed buckets, and the points selected from all but the last of these
+    std::vector<Bucket> m_buckets;
+    std::vector<QPointF> m_selected;
+
+    // The bucket which points are currently appended to
+    Bucket m_open;
+};
+
+}  // namespace Ripes
@@ -0,0 +1,148 @@
+#include "prefetcher.h"
+
+#include <QtGlobal>
+
+#include <cstdlib>
+
+namespace Ripes {
+
+namespace {
+
+/**
+ * @brief nominate
+ * Appends the block at @p blockAddress plus @p offset bytes to @p prefetches, unless the offset wraps the address
+ * space.
+ */
+void nominate(std::vector<AInt>& prefetches, AInt blockAddress, AIntS offset) {
+    const AInt address = blockAddress + offset;
+    if ((offset < 0) == (address < blockAddress)) {
+        prefetches.push_back(address);
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<Prefetcher> Prefetcher::create(PrefetcherType type) {
+    switch (type) {
+        case PrefetcherType::None:
+            return nullptr;
+        case PrefetcherType::NextLine:
+            return std::make_unique<NextLinePrefetcher>();
+        case PrefetcherType::Stride:
+            return std::make_unique<StridePrefetcher>();
+        case PrefetcherType::Stream:
+            return std::make_unique<StreamPrefetcher>();
+    }
+    Q_UNREACHABLE();
+}
+
+void Prefetcher::reset(unsigned blockBytes, unsigned) {
+    m_blockBytes = blockBytes;
+    m_stats = PrefetchStats();
+}
+
+void NextLinePrefetcher::train(const Access& access, std::vector<AInt>& prefetches) {
+    if (!access.isHit || access.isPrefetchHit) {
+        nominate(prefetches, blockAddress(access.address), m_blockBytes);
+    }
+}
+
+void StridePrefetcher::reset(unsigned blockBytes, unsigned undoCapacity) {
+    Prefetcher::reset(blockBytes, undoCapacity);
+    m_table.reset(s_entries, undoCapacity);
+}
+
+void StridePrefetcher::train(const Access& access, std::vector<AInt>& prefetches) {
+    // Instructions are at least 2-byte aligned; the lowest bit of the PC carries no information.
+    Entry& entry = m_table.update((access.pc >> 1) % s_entries);
+    if (!entry.valid || entry.pc != access.pc) {
+        entry = Entry();
+        entry.pc = access.pc;
+        entry.lastAddress = access.address;
+        entry.valid = true;
+        return;
+    }
+
+    const AIntS stride = static_cast<AIntS>(access.address - entry.lastAddress);
+    if (stride == entry.stride) {
+        entry.confidence = std::min(entry.confidence + 1, s_maxConfidence);
+    } else if (entry.confidence > 0) {
+        entry.confidence--;
+    } else {
+        entry.stride = stride;
+    }
+    entry.lastAddress = access.address;
+
+    if (entry.confidence >= s_prefetchConfidence && entry.stride != 0) {
+        // Strides shorter than a block advance by a block
+        const AIntS blockBytes = m_blockBytes;
+        const AIntS step = std::abs(entry.stride) >= blockBytes ? entry.stride
+                           : entry.stride > 0                 ? blockBytes
+                                                              : -blockBytes;
+        const AInt block = blockAddress(access.address);
+        for (unsigned i = 1; i <= s_degree; ++i) {
+            nominate(prefetches, block, static_cast<AIntS>(blockAddress(access.address + i * step) - block));
+        }
+    }
+}
+
+void StreamPrefetcher::reset(unsigned blockBytes, unsigned undoCapacity) {
+    Prefetcher::reset(blockBytes, undoCapacity);
+    m_table.reset(s_streams, undoCapacity);
+    m_stamp = 0;
+}
+
+void StreamPrefetcher::train(const Access& access, std::vector<AInt>& prefetches) {
+    m_stamp++;
+    const AInt block = blockAddress(access.address);
+    const AIntS blockBytes = m_blockBytes;
+
+    // Locate the stream which the access belongs to: a stream whose head is the accessed block, a confirmed stream
+    // whose prefetched window contains the block, or an allocated stream whose head is adjacent to the block.
+    unsigned streamIdx = s_streams;
+    AIntS distance = 0;  // Distance from the head of the stream to the block, in blocks
+    for (unsigned i = 0; i < s_streams && streamIdx == s_streams; ++i) {
+        const Stream& stream = m_table.at(i);
+        distance = static_cast<AIntS>(block - stream.head) / blockBytes;
+        const bool inStream = stream.direction != 0
+                                  ? distance * stream.direction >= 0 && distance * stream.direction <= s_depth
+                                  : distance >= -1 && distance <= 1;
+        if (stream.stamp != 0 && inStream) {
+            streamIdx = i;
+        }
+    }
+
+    if (streamIdx == s_streams) {
+        if (access.isHit) {
+            m_table.unchanged();
+            return;
+        }
+        // Replace the least recently referenced stream
+        for (unsigned i = 0; i < s_streams; ++i) {
+            if (streamIdx == s_streams || m_table.at(i).stamp < m_table.at(streamIdx).stamp) {
+                streamIdx = i;
+            }
+        }
+        Stream& stream = m_table.update(streamIdx);
+        stream = {block, 0, m_stamp};
+        return;
+    }
+
+    Stream& stream = m_table.update(streamIdx);
+    stream.stamp = m_stamp;
+    if (distance == 0) {
+        return;
+    }
+
+    // The blocks up until s_depth blocks ahead of the previous head have already been prefetched, unless the stream is
+    // being confirmed.
+    const bool confirmed = stream.direction != 0;
+    stream.direction = distance > 0 ? 1 : -1;
+    const AIntS first = confirmed ? s_depth + 1 - distance * stream.direction : 1;
+    stream.head = block;
+    for (AIntS i = first; i <= s_depth; ++i) {
+        nominate(prefetches, block, i * stream.direction * blockBytes);
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <QString>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+enum class PrefetcherType { None, NextLine, Stride, Stream };
+
+/**
+ * @brief The PrefetchStats struct
+ * Counters of the effectiveness of a prefetcher.
+ * - Accuracy: the fraction of the issued prefetches which were referenced by a demand access before being evicted.
+ * - Coverage: the fraction of the demand misses, had the cache not prefetched, which were eliminated by prefetching.
+ * - Timeliness: the fraction of the useful prefetches which had completed by the time they were referenced.
+ */
+struct PrefetchStats {
+    unsigned issued = 0;  // Prefetches which filled a block into the cache
+    unsigned useful = 0;  // Prefetched blocks which were referenced by a demand access
+    unsigned late = 0;    // Useful prefetches which were referenced before their fill completed
+    unsigned misses = 0;  // Demand misses of the cache
+
+    double accuracy() const { return issued == 0 ? 0 : static_cast<double>(useful) / issued; }
+    double coverage() const { return useful + misses == 0 ? 0 : static_cast<double>(useful) / (useful + misses); }
+    double timeliness() const { return useful == 0 ? 0 : static_cast<double>(useful - late) / useful; }
+};
+
+/**
+ * @brief The Prefetcher class
+ * Interface of the hardware prefetchers which may be attached to a CacheSim. A prefetcher is trained on the demand
+ * accesses of its cache, and in turn nominates blocks to be prefetched into the cache. The cache issues the
+ * nominated blocks which are not already resident, and maintains the statistics of the prefetcher.
+ *
+ * The training of a prefetcher may be undone, in reverse order, alongside the accesses of the cache.
+ */
+class Prefetcher {
+public:
+    struct Access {
+        AInt address = 0;
+        AInt pc = 0;  // Program counter of the instruction which performed the access, or 0 if unknown
+        bool isHit = false;
+        bool isPrefetchHit = false;  // The access was the first demand reference to a prefetched block
+    };
+
+    virtual ~Prefetcher() {}
+    static std::unique_ptr<Prefetcher> create(PrefetcherType type);
+    virtual PrefetcherType type() const = 0;
+
+    /**
+     * @brief degree
+     * @returns the maximum number of blocks nominated by a single training of the prefetcher.
+     */
+    virtual unsigned degree() const = 0;
+
+    /**
+     * @brief reset
+     * Clears all state and statistics of the prefetcher. @p undoCapacity is the number of most recent trainings which
+     * must be undoable.
+     */
+    virtual void reset(unsigned blockBytes, unsigned undoCapacity);
+
+    /**
+     * @brief train
+     * Trains the prefetcher on a demand access to its cache, appending the addresses of the blocks to prefetch to
+     * @p prefetches.
+     */
+    virtual void train(const Access& access, std::vector<AInt>& prefetches) = 0;
+
+    /**
+     * @brief undo
+     * Reverts the most recent training of the prefetcher.
+     */
+    virtual void undo() = 0;
+
+    const PrefetchStats& getStats() const { return m_stats; }
+    PrefetchStats& stats() { return m_stats; }
+
+protected:
+    AInt blockAddress(AInt address) const { return address & ~static_cast<AInt>(m_blockBytes - 1); }
+
+    unsigned m_blockBytes = 1;
+    PrefetchStats m_stats;
+};
+
+/**
+ * @brief The PrefetchTable class
+ * A table of prefetcher entries, wherein each training of the prefetcher modifies a single entry through update().
+ * The previous value of the entry is recorded in a ring buffer of undo records, such that trainings may be undone.
+ */
+template <typename Entry>
+class PrefetchTable {
+public:
+    void reset(unsigned entries, unsigned undoCapacity) {
+        m_entries.assign(entries, Entry());
+        m_undo.resize(std::max(1u, undoCapacity));
+        m_undoHead = 0;
+    }
+
+    unsigned size() const { return m_entries.size(); }
+    const Entry& at(unsigned idx) const { return m_entries[idx]; }
+
+    /**
+     * @brief update/unchanged
+     * Records the value of entry @p idx, and returns the entry for modification. Trainings which do not modify the
+     * table record this through unchanged(). Either must be called exactly once per training of the prefetcher.
+     */
+    Entry& update(unsigned idx) {
+        m_undo[m_undoHead] = {idx, m_entries[idx]};
+        m_undoHead = (m_undoHead + 1) % m_undo.size();
+        return m_entries[idx];
+    }
+    void unchanged() {
+        m_undo[m_undoHead].first = s_noEntry;
+        m_undoHead = (m_undoHead + 1) % m_undo.size();
+    }
+
+    void undo() {
+        m_undoHead = (m_undoHead + m_undo.size() - 1) % m_undo.size();
+        if (m_undo[m_undoHead].first != s_noEntry) {
+            m_entries[m_undo[m_undoHead].first] = m_undo[m_undoHead].second;
+        }
+    }
+
+private:
+    static constexpr unsigned s_noEntry = UINT_MAX;
+
+    std::vector<Entry> m_entries;
+    std::vector<std::pair<unsigned, Entry>> m_undo;
+    unsigned m_undoHead = 0;
+};
+
+/**
+ * @brief The NextLinePrefetcher class
+ * Tagged next-line prefetching: the block following the accessed block is prefetched on each miss and on each first
+ * reference to a prefetched block, such that a sequential access stream stays one block ahead. Stateless.
+ */
+class NextLinePrefetcher : public Prefetcher {
+public:
+    PrefetcherType type() const override { return PrefetcherType::NextLine; }
+    unsigned degree() const override { return 1; }
+    void train(const Access& access, std::vector<AInt>& prefetches) override;
+    void undo() override {}
+};
+
+/**
+ * @brief The StridePrefetcher class
+ * PC-indexed stride prefetching through a reference prediction table. Each entry tracks the last address and stride
+ * of the accesses of a single instruction, alongside a saturating confidence counter. Once the stride of an
+ * instruction has repeated, the s_degree blocks which are next along the stride of its access are prefetched; strides
+ * shorter than a block thereby prefetch consecutive blocks.
+ */
+class StridePrefetcher : public Prefetcher {
+public:
+    PrefetcherType type() const override { return PrefetcherType::Stride; }
+    unsigned degree() const override { return s_degree; }
+    void reset(unsigned blockBytes, unsigned undoCapacity) override;
+    void train(const Access& access, std::vector<AInt>& prefetches) override;
+    void undo() override { m_table.undo(); }
+
+private:
+    static constexpr unsigned s_entries = 64;
+    static constexpr unsigned s_degree = 2;
+    static constexpr unsigned s_maxConfidence = 3;
+    static constexpr unsigned s_prefetchConfidence = 1;
+
+    struct Entry {
+        AInt pc = 0;
+        AInt lastAddress = 0;
+        AIntS stride = 0;
+        unsigned confidence = 0;
+        bool valid = false;
+    };
+    PrefetchTable<Entry> m_table;
+};
+
+/**
+ * @brief The StreamPrefetcher class
+ * Stream prefetching modelled after stream buffers. Up to s_streams sequential streams, ascending or descending, are
+ * tracked. A stream is allocated on a miss which does not belong to any stream, and is confirmed by a miss to an
+ * adjacent block, after which the s_depth blocks ahead of the stream are prefetched. Each reference within the
+ * prefetched window advances the stream, prefetching the blocks which enter the window.
+ * Contrary to stream buffers, prefetched blocks are placed in the cache itself.
+ */
+class StreamPrefetcher : public Prefetcher {
+public:
+    PrefetcherType type() const override { return PrefetcherType::Stream; }
+    unsigned degree() const override { return s_depth; }
+    void reset(unsigned blockBytes, unsigned undoCapacity) override;
+    void train(const Access& access, std::vector<AInt>& prefetches) override;
+    void undo() override {
+        m_table.undo();
+        m_stamp--;
+    }
+
+private:
+    static constexpr unsigned s_streams = 4;
+    static constexpr unsigned s_depth = 4;
+
+    struct Stream {
+        AInt head = 0;       // The most recently referenced block of the stream
+        int direction = 0;   // +1 or -1 for confirmed streams, 0 for allocated streams
+        unsigned stamp = 0;  // Training at which the stream was last referenced; 0 for unused streams
+    };
+    PrefetchTable<Stream> m_table;
+    unsigned m_stamp = 0;
+};
+
+const static std::map<PrefetcherType, QString> s_cachePrefetcherStrings{{PrefetcherType::None, "None"},
+                                                                        {PrefetcherType::NextLine, "Next-line"},
+                                                                        {PrefetcherType::Stride, "Stride (PC)"},
+                                                                        {PrefetcherType::Stream, "Stream"}};
+
+}  // namespace Ripes
@@ -0,0 +1,136 @@
+#include "stackdistance.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <limits>
+
+namespace Ripes {
+
+static constexpr unsigned s_dead = std::numeric_limits<unsigned>::max();
+
+static unsigned lowbit(unsigned i) {
+    return i & (~i + 1);
+}
+
+unsigned StackDistanceAnalyzer::LineStack::prefix(unsigned position) const {
+    unsigned sum = 0;
+    for (; position > 0; position -= lowbit(position)) {
+        sum += m_tree[position - 1];
+    }
+    return sum;
+}
+
+unsigned StackDistanceAnalyzer::LineStack::push(unsigned blockId) {
+    // Appending a marked position to a Fenwick tree: the new node covers the range ]n - lowbit(n); n].
+    const unsigned n = m_blocks.size() + 1;
+    m_tree.push_back(1 + prefix(n - 1) - prefix(n - lowbit(n)));
+    m_blocks.push_back(blockId);
+    m_live++;
+    return n;
+}
+
+unsigned StackDistanceAnalyzer::LineStack::distanceAndRemove(unsigned position) {
+    const unsigned distance = prefix(m_blocks.size()) - prefix(position);
+    for (unsigned i = position; i <= m_tree.size(); i += lowbit(i)) {
+        m_tree[i - 1]--;
+    }
+    m_blocks[position - 1] = s_dead;
+    m_live--;
+    return distance;
+}
+
+template <typename F>
+void StackDistanceAnalyzer::LineStack::compact(F&& relocate) {
+    m_blocks.erase(std::remove(m_blocks.begin(), m_blocks.end(), s_dead), m_blocks.end());
+    Q_ASSERT(m_blocks.size() == m_live);
+    // All remaining positions are marked, such that each node of the tree covers lowbit(i) marks.
+    m_tree.resize(m_blocks.size());
+    for (unsigned i = 1; i <= m_blocks.size(); ++i) {
+        m_tree[i - 1] = lowbit(i);
+        relocate(m_blocks[i - 1], i);
+    }
+}
+
+StackDistanceAnalyzer::StackDistanceAnalyzer(unsigned offsetBits, unsigned maxLineBits, unsigned maxWaysBits)
+    : m_offsetBits(offsetBits), m_maxLineBits(maxLineBits), m_maxWaysBits(maxWaysBits) {
+    m_levels.resize(maxLineBits + 1);
+    for (unsigned lineBits = 0; lineBits <= maxLineBits; ++lineBits) {
+        auto& level = m_levels.at(lineBits);
+        level.lines.resize(1 << lineBits);
+        level.histogram.resize((1 << maxWaysBits) + 1);
+    }
+}
+
+void StackDistanceAnalyzer::analyzeLineBits(unsigned lineBits) {
+    for (unsigned i = 0; i < m_levels.size(); ++i) {
+        auto& level = m_levels.at(i);
+        level.enabled = i == lineBits;
+        if (!level.enabled) {
+            level.lines = {};
+            level.positions = {};
+        }
+    }
+}
+
+void StackDistanceAnalyzer::access(AInt address) {
+    const AInt block = address >> m_offsetBits;
+    const unsigned maxDistance = 1 << m_maxWaysBits;
+    m_accesses++;
+
+    const auto idIt = m_blockIds.emplace(block, m_blockIds.size()).first;
+    const unsigned blockId = idIt->second;
+
+    for (unsigned lineBits = 0; lineBits < m_levels.size(); ++lineBits) {
+        auto& level = m_levels[lineBits];
+        if (!level.enabled) {
+            continue;
+        }
+
+        if (blockId >= level.positions.size()) {
+            level.positions.resize(std::max<size_t>(blockId + 1, level.positions.size() * 2), 0);
+        }
+
+        auto& line = level.lines[block & ((AInt(1) << lineBits) - 1)];
+        unsigned& position = level.positions[blockId];
+        if (position == 0) {
+            // Cold access
+            level.histogram[maxDistance]++;
+        } else {
+            const unsigned distance = line.distanceAndRemove(position);
+            level.histogram[std::min(distance, maxDistance)]++;
+        }
+        position = line.push(blockId);
+
+        if (line.needsCompaction()) {
+            line.compact([&](unsigned id, unsigned newPosition) { level.positions[id] = newPosition; });
+        }
+    }
+}
+
+uint64_t StackDistanceAnalyzer::hits(unsigned lineBits, unsigned waysBits) const {
+    Q_ASSERT(lineBits <= m_maxLineBits && waysBits <= m_maxWaysBits);
+    const auto& histogram = m_levels.at(lineBits).histogram;
+    uint64_t hits = 0;
+    for (unsigned distance = 0; distance < (1u << waysBits); ++distance) {
+        hits += histogram[distance];
+    }
+    return hits;
+}
+
+double StackDistanceAnalyzer::hitRate(unsigned lineBits, unsigned waysBits) const {
+    return m_accesses == 0 ? 0 : static_cast<double>(hits(lineBits, waysBits)) / m_accesses;
+}
+
+void StackDistanceAnalyzer::merge(const StackDistanceAnalyzer& other) {
+    Q_ASSERT(other.m_levels.size() == m_levels.size());
+    for (unsigned lineBits = 0; lineBits < m_levels.size(); ++lineBits) {
+        if (other.m_levels.at(lineBits).enabled && !m_levels.at(lineBits).enabled) {
+            m_levels.at(lineBits).histogram = other.m_levels.at(lineBits).histogram;
+            m_levels.at(lineBits).enabled = true;
+        }
+    }
+    m_accesses = std::max(m_accesses, other.m_accesses);
+}
+
+}  // namespace Ripes
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The StackDistanceAnalyzer class
+ * Single-pass Mattson stack-distance analysis of a memory access stream. For a fixed block size, the analyzer
+ * determines the number of hits which an LRU replaced, write-allocating cache would have seen, for every combination of
+ * line (set) count and associativity up to the given maximums.
+ *
+ * An access hits in a cache with 2^L lines and 2^W ways if and only if fewer than 2^W distinct blocks mapping to the
+ * same line have been accessed since the previous access to the block. This per-line stack distance is recorded in a
+ * histogram for each line count. Stack distances are computed by indexing each line's accesses by a local timestamp
+ * and marking the timestamps which are the most recent access to some block in a Fenwick tree; the stack distance
+ * of an access is then the number of marks after the previous access to the block.
+ */
+class StackDistanceAnalyzer {
+public:
+    /**
+     * @param offsetBits: number of address bits below the line index (byte offset + block bits)
+     */
+    StackDistanceAnalyzer(unsigned offsetBits, unsigned maxLineBits, unsigned maxWaysBits);
+    StackDistanceAnalyzer() : StackDistanceAnalyzer(0, 0, 0) {}
+
+    void access(AInt address);
+
+    /**
+     * @brief analyzeLineBits
+     * Restricts the analysis to caches with 2^@p lineBits lines. Allows for distributing the analysis of each line
+     * count across multiple analyzers.
+     */
+    void analyzeLineBits(unsigned lineBits);
+
+    uint64_t accesses() const { return m_accesses; }
+    uint64_t hits(unsigned lineBits, unsigned waysBits) const;
+    double hitRate(unsigned lineBits, unsigned waysBits) const;
+
+    unsigned maxLineBits() const { return m_maxLineBits; }
+    unsigned maxWaysBits() const { return m_maxWaysBits; }
+
+    /**
+     * @brief merge
+     * Merges the histograms of @p other, which analyzed the same access stream for a disjoint set of line counts.
+     */
+    void merge(const StackDistanceAnalyzer& other);
+
+private:
+    class LineStack {
+    public:
+        /**
+         * @brief push
+         * Pushes the block identified by @p blockId onto the stack, returning the new position of the block.
+         */
+        unsigned push(unsigned blockId);
+        /**
+         * @brief distanceAndRemove
+         * Returns the number of distinct blocks pushed after @p position, and removes the block at @p position.
+         */
+        unsigned distanceAndRemove(unsigned position);
+        bool needsCompaction() const { return m_blocks.size() > 2 * m_live + 64; }
+        /**
+         * @brief compact
+         * Renumbers all live positions contiguously; @p relocate is called with each live block ID and its new position.
+         */
+        template <typename F>
+        void compact(F&& relocate);
+
+    private:
+        unsigned prefix(unsigned position) const;
+        std::vector<unsigned> m_tree;    // 1-indexed Fenwick tree of live marks
+        std::vector<unsigned> m_blocks;  // Block ID at each position; s_dead if no longer the most recent access
+        unsigned m_live = 0;
+    };
+
+    struct Level {
+        bool enabled = true;
+        std::vector<LineStack> lines;
+        // Position of each block ID within its line stack; 0 if the block has not yet been accessed.
+        std::vector<unsigned> positions;
+        // histogram[d] is the number of accesses with a stack distance of d. The last bucket counts both cold accesses
+        // and accesses with a stack distance exceeding the maximum associativity.
+        std::vector<uint64_t> histogram;
+    };
+
+    unsigned m_offsetBits;
+    unsigned m_maxLineBits;
+    unsigned m_maxWaysBits;
+    uint64_t m_accesses = 0;
+    std::vector<Level> m_levels;
+
+    // Dense IDs of all accessed blocks, shared by all levels.
+    std::unordered_map<AInt, unsigned> m_blockIds;
+};
+
+}  // namespace Ripes
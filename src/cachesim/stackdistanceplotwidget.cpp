@@ -0,0 +1,148 @@
+#include "stackdistanceplotwidget.h"
+
+#include <QApplication>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QLogValueAxis>
+#include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
+
+#include "binutils.h"
+#include "cachereplay.h"
+#include "colors.h"
+#include "processorhandler.h"
+
+namespace Ripes {
+
+// Maximum line and way bits which are selectable in the cache configuration widget.
+static constexpr unsigned s_maxLineBits = 10;
+static constexpr unsigned s_maxWaysBits = 10;
+
+StackDistancePlotWidget::StackDistancePlotWidget(QWidget* parent) : QWidget(parent) {
+    setWindowTitle("Cache Capacity Sweep");
+
+    m_info = new QLabel(this);
+    m_info->setWordWrap(true);
+
+    auto* analyzeButton = new QToolButton(this);
+    analyzeButton->setIcon(QIcon(":/icons/analytics.svg"));
+    analyzeButton->setToolTip("Analyze the current memory trace");
+    connect(analyzeButton, &QToolButton::clicked, this, &StackDistancePlotWidget::analyze);
+
+    m_chart = new QChart();
+    m_chart->legend()->setAlignment(Qt::AlignRight);
+    m_chartView = new QChartView(m_chart, this);
+    m_chartView->setRenderHint(QPainter::Antialiasing);
+
+    auto* headerLayout = new QHBoxLayout();
+    headerLayout->addWidget(m_info, 1);
+    headerLayout->addWidget(analyzeButton);
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(headerLayout);
+    layout->addWidget(m_chartView);
+
+    // The memory trace is not analyzed on each processor clock, given the cost of a full analysis. Instead, the
+    // analysis is refreshed once a run finishes, or when the widget is shown after the trace has changed.
+    connect(ProcessorHandler::get(), &ProcessorHandler::runFinished, this, [=] {
+        m_stale = true;
+        if (isVisible()) {
+            analyze();
+        }
+    });
+}
+
+void StackDistancePlotWidget::setCache(const std::shared_ptr<CacheSim>& cache) {
+    m_cache = cache;
+    connect(m_cache.get(), &CacheSim::configurationChanged, this, [=] {
+        // The block size determines the analysis, and the current configuration is marked in the plot.
+        m_stale = true;
+        if (isVisible()) {
+            analyze();
+        }
+    });
+}
+
+void StackDistancePlotWidget::setMemoryTrace(const MemoryTrace* trace) {
+    m_memoryTrace = trace;
+    m_stale = true;
+}
+
+void StackDistancePlotWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (m_stale || (m_memoryTrace && m_memoryTrace->size() != m_analyzedAccesses)) {
+        analyze();
+    }
+}
+
+void StackDistancePlotWidget::analyze() {
+    if (!m_cache || !m_memoryTrace) {
+        m_info->setText("No memory trace is available for this cache.");
+        return;
+    }
+    m_stale = false;
+    m_analyzedAccesses = m_memoryTrace->size();
+
+    const unsigned wordBytes = ProcessorHandler::currentISA()->bytes();
+    const unsigned offsetBits = log2Ceil(wordBytes) + m_cache->getBlockBits();
+    const double blockBytes = static_cast<double>(wordBytes) * m_cache->getBlocks();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const auto analyzer = analyzeStackDistances(*m_memoryTrace, offsetBits, s_maxLineBits, s_maxWaysBits);
+    QApplication::restoreOverrideCursor();
+
+    m_chart->removeAllSeries();
+    for (auto* axis : m_chart->axes()) {
+        m_chart->removeAxis(axis);
+        delete axis;
+    }
+
+    auto* xAxis = new QLogValueAxis();
+    xAxis->setBase(2);
+    xAxis->setLabelFormat("%g");
+    xAxis->setTitleText("Capacity (bytes)");
+    auto* yAxis = new QValueAxis();
+    yAxis->setRange(0, 1);
+    yAxis->setTitleText("Hit rate");
+    m_chart->addAxis(xAxis, Qt::AlignBottom);
+    m_chart->addAxis(yAxis, Qt::AlignLeft);
+
+    // One curve per line count, with a point for each associativity.
+    auto colorGenerator = Colors::incrementalColorGenerator(Colors::BerkeleyBlue, s_maxLineBits + 1);
+    for (unsigned lineBits = 0; lineBits <= s_maxLineBits; ++lineBits) {
+        auto* series = new QLineSeries();
+        series->setName(QString("%1 lines").arg(1 << lineBits));
+        QPen pen = series->pen();
+        pen.setColor(colorGenerator());
+        series->setPen(pen);
+        for (unsigned waysBits = 0; waysBits <= s_maxWaysBits; ++waysBits) {
+            series->append(blockBytes * (1 << (lineBits + waysBits)), analyzer.hitRate(lineBits, waysBits));
+        }
+        m_chart->addSeries(series);
+        series->attachAxis(xAxis);
+        series->attachAxis(yAxis);
+    }
+
+    const unsigned lineBits = m_cache->getLineBits();
+    const unsigned waysBits = m_cache->getWaysBits();
+    const double currentHitRate = analyzer.hitRate(lineBits, waysBits);
+    auto* current = new QScatterSeries();
+    current->setName("Current");
+    current->setColor(Colors::CaliforniaGold);
+    current->append(blockBytes * (1 << (lineBits + waysBits)), currentHitRate);
+    m_chart->addSeries(current);
+    current->attachAxis(xAxis);
+    current->attachAxis(yAxis);
+
+    m_info->setText(QString("LRU hit rates of %1 accesses with %2-byte blocks, assuming write allocation. Current "
+                            "configuration: %3")
+                        .arg(analyzer.accesses())
+                        .arg(blockBytes)
+                        .arg(currentHitRate, 0, 'f', 4));
+}
+
+}  // namespace Ripes
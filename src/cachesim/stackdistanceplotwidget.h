@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QWidget>
+#include <QtCharts/QChartGlobal>
+
+#include <memory>
+
+#include "cachesim.h"
+#include "memorytrace.h"
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+
+QT_CHARTS_BEGIN_NAMESPACE
+class QChart;
+class QChartView;
+QT_CHARTS_END_NAMESPACE
+
+QT_CHARTS_USE_NAMESPACE
+
+namespace Ripes {
+
+/**
+ * @brief The StackDistancePlotWidget class
+ * Plots the LRU hit rate versus cache capacity for all line counts and associativities, as determined by a single
+ * stack-distance analysis pass over the memory trace of the cache. The block size is fixed to that of the current
+ * cache configuration.
+ */
+class StackDistancePlotWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit StackDistancePlotWidget(QWidget* parent = nullptr);
+
+    void setCache(const std::shared_ptr<CacheSim>& cache);
+    void setMemoryTrace(const MemoryTrace* trace);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+private:
+    void analyze();
+
+    std::shared_ptr<CacheSim> m_cache;
+    const MemoryTrace* m_memoryTrace = nullptr;
+
+    /**
+     * @brief m_stale
+     * Set when the trace or cache configuration may have changed since the last analysis. The analysis is deferred
+     * until the widget is visible.
+     */
+    bool m_stale = true;
+    size_t m_analyzedAccesses = 0;
+
+    QLabel* m_info = nullptr;
+    QChart* m_chart = nullptr;
+    QChartView* m_chartView = nullptr;
+};
+
+}  // namespace Ripes
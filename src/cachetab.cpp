@@ -5,6 +5,7 @@
 #include "cachesim/cachewidget.h"
 
 #include "processorhandler.h"
+#include "ripessettings.h"
 
 namespace Ripes {
 
@@ -26,6 +27,14 @@ CacheTab::CacheTab(QToolBar* toolbar, QWidget* parent) : RipesTab(toolbar, paren
     m_ui->splitter->setStretchFactor(0, 0);
     m_ui->splitter->setStretchFactor(1, 10);
     m_ui->splitter->setSizes({1, 10000});
+
+    m_missHeatmapAction = new QAction("Show conflict miss heatmap", this);
+    m_missHeatmapAction->setCheckable(true);
+    m_missHeatmapAction->setChecked(RipesSettings::value(RIPES_SETTING_CACHE_MISSHEATMAP).toBool());
+    connect(m_missHeatmapAction, &QAction::toggled, this, [=](bool checked) {
+        RipesSettings::setValue(RIPES_SETTING_CACHE_MISSHEATMAP, QVariant::fromValue(checked));
+    });
+    m_toolbar->addAction(m_missHeatmapAction);
 }
 
 void CacheTab::tabVisibilityChanged(bool visible) {
@@ -39,6 +48,10 @@ void CacheTab::tabVisibilityChanged(bool visible) {
     }
 }
 
+std::shared_ptr<const CacheSim> CacheTab::getDataCache() const {
+    return m_ui->cacheTabWidget->getDataCache();
+}
+
 CacheTab::~CacheTab() {
     delete m_ui;
 }
@@ -1,16 +1,21 @@
 #pragma once
 
+#include <QAction>
 #include <QWidget>
 #include "ripestab.h"
 
 #include "ripes_types.h"
 
+#include <memory>
+
 namespace Ripes {
 
 namespace Ui {
 class CacheTab;
 }
 
+class CacheSim;
+
 class CacheTab : public RipesTab {
     Q_OBJECT
 
@@ -20,11 +25,18 @@ public:
 
     void tabVisibilityChanged(bool visible) override;
 
+    /**
+     * @brief getDataCache
+     * @returns the L1 data cache of the cache hierarchy.
+     */
+    std::shared_ptr<const CacheSim> getDataCache() const;
+
 signals:
     void focusAddressChanged(Ripes::AInt address);
 
 private:
     Ui::CacheTab* m_ui;
+    QAction* m_missHeatmapAction = nullptr;
     bool m_initialized = false;
 };
 
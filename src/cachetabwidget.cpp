@@ -1,10 +1,15 @@
 #include "cachetabwidget.h"
 #include "ui_cachetabwidget.h"
 
+#include "cachesim/cacheconfigwidget.h"
+#include "cachesim/cachewidget.h"
+#include "enumcombobox.h"
 #include "memorytab.h"
 #include "memoryviewerwidget.h"
+#include "processorhandler.h"
 #include "ripessettings.h"
 
+#include <QHeaderView>
 #include <QTabBar>
 #include <QWheelEvent>
 
@@ -31,15 +36,31 @@ void CacheTabWidget::flipTabs() {
 CacheTabWidget::CacheTabWidget(QWidget* parent) : QWidget(parent), m_ui(new Ui::CacheTabWidget) {
     m_ui->setupUi(this);
 
+    // The main memory must be reset before the shims reload the initial state of the processor into the caches.
+    setupMainMemory();
+
     m_l1dShim = std::make_unique<L1CacheShim>(L1CacheShim::CacheType::DataCache, this);
     m_l1iShim = std::make_unique<L1CacheShim>(L1CacheShim::CacheType::InstrCache, this);
 
     m_l1dShim->setNextLevelCache(m_ui->dataCacheWidget->getCacheSim());
     m_l1iShim->setNextLevelCache(m_ui->instructionCacheWidget->getCacheSim());
+    m_ui->dataCacheWidget->setMemoryTrace(&m_l1dShim->getTrace());
+    m_ui->instructionCacheWidget->setMemoryTrace(&m_l1iShim->getTrace());
 
-#ifdef N_CACHES_ENABLED
     m_addTabIdx = m_ui->tabWidget->addTab(new QLabel("Placeholder"), QIcon((":/icons/plus.svg")), QString());
-#endif
+
+    setupEnumCombobox(m_ui->inclusionPolicy, s_cacheInclusionPolicyStrings);
+    connect(m_ui->inclusionPolicy, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [=] { setInclusionPolicy(getEnumValue<InclusionPolicy>(m_ui->inclusionPolicy)); });
+
+    m_ui->levelStats->setColumnCount(5);
+    m_ui->levelStats->setHorizontalHeaderLabels({"Accesses", "Hits", "Misses", "Hit rate", "Writebacks"});
+    m_ui->levelStats->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_ui->levelStats->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    for (const auto& cache : allCaches()) {
+        connect(cache.get(), &CacheSim::hitrateChanged, this, &CacheTabWidget::updateLevelStats);
+    }
+    updateLevelStats();
 
     connect(m_ui->tabWidget, &QTabWidget::currentChanged, this, &CacheTabWidget::handleTabIndexChanged);
     connect(m_ui->tabWidget, &QTabWidget::tabCloseRequested, this, &CacheTabWidget::handleTabCloseRequest);
@@ -57,34 +78,173 @@ CacheTabWidget::CacheTabWidget(QWidget* parent) : QWidget(parent), m_ui(new Ui::
         }
     }
 
-#ifdef N_CACHES_ENABLED
     if (auto* addTabButton = m_ui->tabWidget->tabBar()->tabButton(m_addTabIdx, QTabBar::RightSide)) {
         addTabButton->resize(0, 0);
     }
-#endif
 
     // Filter out scroll events to avoid mouse scrolling creating a bazillion new caches
     m_ui->tabWidget->tabBar()->installEventFilter(new ScrollEventFilter(this));
 }
 
+void CacheTabWidget::setupMainMemory() {
+    m_mainMemory = std::make_shared<DRAMSim>();
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this, [=] { m_mainMemory->reset(); });
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReversed, this,
+            [=] { m_mainMemory->reverse(ProcessorHandler::getProcessor()->getCycleCount() + 1); });
+    connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun, this,
+            &CacheTabWidget::updateMemoryStats);
+    connect(ProcessorHandler::get(), &ProcessorHandler::runFinished, this, &CacheTabWidget::updateMemoryStats);
+
+    const DRAMConfig config;
+    setupEnumCombobox(m_ui->pagePolicy, s_dramPagePolicyStrings);
+    setEnumIndex(m_ui->pagePolicy, config.pagePolicy);
+    m_ui->dramBanks->setValue(config.banks);
+    m_ui->dramRowBytes->setValue(config.rowBytes);
+    m_ui->dramTRCD->setValue(config.tRCD);
+    m_ui->dramTRP->setValue(config.tRP);
+    m_ui->dramTCAS->setValue(config.tCAS);
+
+    connect(m_ui->dramEnabled, &QCheckBox::toggled, this, &CacheTabWidget::updateMainMemory);
+    connect(m_ui->pagePolicy, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &CacheTabWidget::updateMainMemory);
+    for (auto* spinBox : {m_ui->dramBanks, m_ui->dramRowBytes, m_ui->dramTRCD, m_ui->dramTRP, m_ui->dramTCAS}) {
+        connect(spinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &CacheTabWidget::updateMainMemory);
+    }
+    updateMainMemory();
+}
+
+void CacheTabWidget::updateMainMemory() {
+    DRAMConfig config;
+    config.banks = m_ui->dramBanks->value();
+    config.rowBytes = m_ui->dramRowBytes->value();
+    config.tRCD = m_ui->dramTRCD->value();
+    config.tRP = m_ui->dramTRP->value();
+    config.tCAS = m_ui->dramTCAS->value();
+    config.pagePolicy = getEnumValue<PagePolicy>(m_ui->pagePolicy);
+    m_mainMemory->setConfig(config);
+
+    const bool enabled = m_ui->dramEnabled->isChecked();
+    for (auto* widget : std::vector<QWidget*>{m_ui->pagePolicy, m_ui->dramBanks, m_ui->dramRowBytes, m_ui->dramTRCD,
+                                             m_ui->dramTRP, m_ui->dramTCAS, m_ui->memoryStats}) {
+        widget->setEnabled(enabled);
+    }
+
+    // The constructor sets up the main memory before the L1 caches are attached to the shims.
+    if (m_l1dShim) {
+        for (const auto& cache : allCaches()) {
+            cache->setMainMemory(enabled ? m_mainMemory : nullptr);
+        }
+        RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    }
+    updateMemoryStats();
+}
+
+void CacheTabWidget::updateMemoryStats() {
+    if (!m_ui->dramEnabled->isChecked()) {
+        m_ui->memoryStats->setText("Fixed main memory latency");
+        return;
+    }
+    const DRAMStats& stats = m_mainMemory->getStats();
+    m_ui->memoryStats->setText(
+        QString("Row hit rate: %1 | Row conflicts: %2 | Bytes: %3 read, %4 written | Avg. miss latency: %5 cycles")
+            .arg(QString::number(stats.rowHitRate(), 'g', 3))
+            .arg(stats.rowConflicts)
+            .arg(stats.bytesRead)
+            .arg(stats.bytesWritten)
+            .arg(QString::number(stats.averageReadLatency(), 'g', 3)));
+}
+
+std::shared_ptr<const CacheSim> CacheTabWidget::getDataCache() const {
+    return m_ui->dataCacheWidget->getCacheSim();
+}
+
+std::vector<std::shared_ptr<CacheSim>> CacheTabWidget::upperLevelCaches(int level) {
+    if (level == 2) {
+        return {m_ui->dataCacheWidget->getCacheSim(), m_ui->instructionCacheWidget->getCacheSim()};
+    }
+    return {m_lowerLevels.at(level - 3)->getCacheSim()};
+}
+
+std::vector<std::shared_ptr<CacheSim>> CacheTabWidget::allCaches() {
+    auto caches = upperLevelCaches(2);
+    for (auto* cw : m_lowerLevels) {
+        caches.push_back(cw->getCacheSim());
+    }
+    return caches;
+}
+
+void CacheTabWidget::setInclusionPolicy(InclusionPolicy policy) {
+    m_inclusionPolicy = policy;
+    for (auto* cw : m_lowerLevels) {
+        cw->getCacheSim()->setInclusionPolicy(policy);
+    }
+}
+
+void CacheTabWidget::updateLevelStats() {
+    const auto caches = allCaches();
+    QStringList levelNames = {"L1D", "L1I"};
+    for (unsigned i = 0; i < m_lowerLevels.size(); ++i) {
+        levelNames << QString("L%1").arg(i + 2);
+    }
+
+    m_ui->levelStats->setRowCount(caches.size());
+    m_ui->levelStats->setVerticalHeaderLabels(levelNames);
+    for (unsigned row = 0; row < caches.size(); ++row) {
+        const auto& cache = caches.at(row);
+        const unsigned hits = cache->getHits();
+        const unsigned misses = cache->getMisses();
+        const QStringList values = {QString::number(hits + misses), QString::number(hits), QString::number(misses),
+                                    QString::number(cache->getHitRate(), 'g', 3),
+                                    QString::number(cache->getWritebacks())};
+        for (int col = 0; col < values.size(); ++col) {
+            auto* item = m_ui->levelStats->item(row, col);
+            if (!item) {
+                item = new QTableWidgetItem();
+                m_ui->levelStats->setItem(row, col, item);
+            }
+            item->setText(values.at(col));
+        }
+    }
+    m_ui->hierarchyGroup->setVisible(!m_lowerLevels.empty());
+}
+
 void CacheTabWidget::handleTabCloseRequest(int index) {
     // Only the last-level cache should be closeable
     Q_ASSERT(index == m_addTabIdx - 1 && index > InstrCache);
     const int newIndex = index - 1;
+
+    // Detach the cache from the hierarchy before disposing of it
+    m_nextCacheLevel--;
+    for (const auto& cache : upperLevelCaches(m_nextCacheLevel)) {
+        cache->setNextLevelCache(nullptr);
+    }
+    auto* cw = m_lowerLevels.back();
+    m_lowerLevels.pop_back();
+
     m_ui->tabWidget->setCurrentIndex(newIndex);
     m_ui->tabWidget->removeTab(index);
+    cw->deleteLater();
     m_addTabIdx = m_ui->tabWidget->count() - 1;
     if (newIndex > InstrCache) {
         m_ui->tabWidget->tabBar()->tabButton(newIndex, QTabBar::RightSide)->resize(m_defaultTabButtonSize);
     }
-    m_nextCacheLevel--;
     m_ui->tabWidget->setTabText(m_addTabIdx, QString());
+    updateLevelStats();
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
 }
 
 void CacheTabWidget::handleTabIndexChanged(int index) {
     if (index == m_addTabIdx) {
-        // Add new level of cache
+        // Add new level of cache, and connect the level above to it
         auto* cw = new CacheWidget(this);
+        cw->getCacheSim()->setInclusionPolicy(m_inclusionPolicy);
+        cw->getCacheSim()->setMainMemory(m_ui->dramEnabled->isChecked() ? m_mainMemory : nullptr);
+        for (const auto& cache : upperLevelCaches(m_nextCacheLevel)) {
+            cache->setNextLevelCache(cw->getCacheSim());
+        }
+        m_lowerLevels.push_back(cw);
+        connect(cw->getCacheSim().get(), &CacheSim::hitrateChanged, this, &CacheTabWidget::updateLevelStats);
+
         m_ui->tabWidget->insertTab(m_addTabIdx, cw, QString("L%1 Cache").arg(m_nextCacheLevel));
         m_nextCacheLevel++;
 
@@ -93,10 +253,18 @@ void CacheTabWidget::handleTabIndexChanged(int index) {
         m_ui->tabWidget->tabBar()->tabButton(m_addTabIdx - 1, QTabBar::RightSide)->resize(0, 0);
         m_addTabIdx = m_ui->tabWidget->count() - 1;
         m_ui->tabWidget->setCurrentIndex(index);
+        updateLevelStats();
+        RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
     }
 
-    // Locate cacheWidget for the current index
-    for (const auto& ch : m_ui->tabWidget->widget(index)->children()) {
+    // Locate cacheWidget for the current index. L1 cache widgets are nested within their tab page, whereas lower
+    // level cache widgets are the tab page.
+    auto* page = m_ui->tabWidget->widget(index);
+    if (auto* cw = dynamic_cast<CacheWidget*>(page)) {
+        emit cacheFocusChanged(cw);
+        return;
+    }
+    for (const auto& ch : page->children()) {
         auto* cw = dynamic_cast<CacheWidget*>(ch);
         if (cw) {
             emit cacheFocusChanged(cw);
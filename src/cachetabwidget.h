@@ -1,10 +1,10 @@
 #pragma once
 #include <QWidget>
 
+#include "cachesim/cachesim.h"
+#include "cachesim/dramsim.h"
 #include "cachesim/l1cacheshim.h"
 
-// #define N_CACHES_ENABLED
-
 namespace Ripes {
 class CacheWidget;
 
@@ -26,6 +26,8 @@ public:
      */
     void flipTabs();
 
+    std::shared_ptr<const CacheSim> getDataCache() const;
+
 signals:
     void focusAddressChanged(unsigned address);
     void cacheFocusChanged(Ripes::CacheWidget* cacheInFocus);
@@ -36,14 +38,41 @@ private:
     void handleTabIndexChanged(int index);
     void handleTabCloseRequest(int index);
 
+    /**
+     * @brief upperLevelCaches
+     * @returns the caches which forward their misses and writebacks to cache level @p level.
+     */
+    std::vector<std::shared_ptr<CacheSim>> upperLevelCaches(int level);
+    std::vector<std::shared_ptr<CacheSim>> allCaches();
+
+    void setInclusionPolicy(InclusionPolicy policy);
+    void updateLevelStats();
+
+    /**
+     * @brief setupMainMemory
+     * Sets up the configuration widgets of the DRAM model. The DRAM model is reset and reversed alongside the
+     * processor, and is accessed by the last-level caches while enabled.
+     */
+    void setupMainMemory();
+    void updateMainMemory();
+    void updateMemoryStats();
+
     Ui::CacheTabWidget* m_ui;
 
     int m_addTabIdx = -1;
     int m_nextCacheLevel = 2;
     QSize m_defaultTabButtonSize;
+    InclusionPolicy m_inclusionPolicy = InclusionPolicy::NonInclusive;
+
+    /// Cache widgets of the L2 cache and below, in order of the cache hierarchy.
+    std::vector<CacheWidget*> m_lowerLevels;
+
+    std::shared_ptr<DRAMSim> m_mainMemory;
 
     std::unique_ptr<L1CacheShim> m_l1dShim;
     std::unique_ptr<L1CacheShim> m_l1iShim;
 };
 
 }  // namespace Ripes
+
+Q_DECLARE_METATYPE(Ripes::PagePolicy);
@@ -0,0 +1,97 @@
+#include "callgraphdialog.h"
+
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QVBoxLayout>
+
+#include <cmath>
+
+#include "callgraphprofiler.h"
+
+namespace Ripes {
+
+CallGraphDialog::CallGraphDialog(const CallGraphProfiler& profile, QWidget* parent)
+    : QDialog(parent), m_profile(profile) {
+    setWindowTitle("Call graph profile");
+
+    const auto& totals = m_profile.getTotals();
+    m_info = new QLabel(this);
+    m_info->setText(QString("%1 cycles, %2 instructions retired, %3 data cache misses")
+                        .arg(totals.cycles)
+                        .arg(totals.instructions)
+                        .arg(totals.misses));
+
+    m_table = new QTableWidget(this);
+    m_table->setColumnCount(9);
+    m_table->setHorizontalHeaderLabels({"Function", "Calls", "Cycles (incl.)", "Cycles (excl.)", "Cycles (% incl.)",
+                                        "Instructions (incl.)", "Instructions (excl.)", "D$ misses (incl.)",
+                                        "D$ misses (excl.)"});
+    m_table->horizontalHeaderItem(0)->setToolTip(
+        "Functions are delimited by the symbols of the program. Inclusive counts include the functions called by the "
+        "function, exclusive counts do not.");
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    // Numeric items are stored as display role values such that the table sorts them numerically.
+    const auto numberItem = [](const QVariant& value) {
+        auto* item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+
+    const auto stats = m_profile.functionStats();
+    m_table->setRowCount(stats.size());
+    for (unsigned row = 0; row < stats.size(); ++row) {
+        const auto& fstats = stats.at(row);
+        const double share = totals.cycles == 0 ? 0 : 100.0 * fstats.inclusive.cycles / totals.cycles;
+        m_table->setItem(row, 0, new QTableWidgetItem(fstats.name));
+        m_table->setItem(row, 1, numberItem(static_cast<qulonglong>(fstats.calls)));
+        m_table->setItem(row, 2, numberItem(static_cast<qulonglong>(fstats.inclusive.cycles)));
+        m_table->setItem(row, 3, numberItem(static_cast<qulonglong>(fstats.exclusive.cycles)));
+        m_table->setItem(row, 4, numberItem(std::round(share * 100) / 100));
+        m_table->setItem(row, 5, numberItem(static_cast<qulonglong>(fstats.inclusive.instructions)));
+        m_table->setItem(row, 6, numberItem(static_cast<qulonglong>(fstats.exclusive.instructions)));
+        m_table->setItem(row, 7, numberItem(static_cast<qulonglong>(fstats.inclusive.misses)));
+        m_table->setItem(row, 8, numberItem(static_cast<qulonglong>(fstats.exclusive.misses)));
+    }
+    m_table->setSortingEnabled(true);
+    m_table->sortByColumn(2, Qt::DescendingOrder);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    auto* exportButton = buttons->addButton("Export folded stacks...", QDialogButtonBox::ActionRole);
+    exportButton->setToolTip("Export the cycles of each call stack in the folded stack format of flame graph tools.");
+    connect(exportButton, &QPushButton::clicked, this, &CallGraphDialog::exportFoldedStacks);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(m_info);
+    layout->addWidget(m_table);
+    layout->addWidget(buttons);
+    resize(900, 500);
+}
+
+void CallGraphDialog::exportFoldedStacks() {
+    const QString filename =
+        QFileDialog::getSaveFileName(this, "Export folded stacks", "", "Folded stacks (*.folded);;All files (*)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Error", "Could not write folded stacks to '" + filename + "'");
+        return;
+    }
+    QTextStream out(&file);
+    m_profile.writeFoldedStacks(out);
+}
+
+}  // namespace Ripes
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QDialog>
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QTableWidget)
+
+namespace Ripes {
+
+class CallGraphProfiler;
+
+/**
+ * @brief The CallGraphDialog class
+ * Tabulates the inclusive and exclusive counts of each function of a call graph profile, and exports the profile as
+ * folded stacks for flame graph tools.
+ */
+class CallGraphDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    CallGraphDialog(const CallGraphProfiler& profile, QWidget* parent = nullptr);
+
+private:
+    void exportFoldedStacks();
+
+    const CallGraphProfiler& m_profile;
+    QLabel* m_info = nullptr;
+    QTableWidget* m_table = nullptr;
+};
+
+}  // namespace Ripes
@@ -0,0 +1,243 @@
+#include "callgraphprofiler.h"
+
+#include <algorithm>
+
+#include "assembler/program.h"
+#include "processorhandler.h"
+
+namespace Ripes {
+
+void CallGraphProfiler::reset(const Program* program, AInt pcBase, unsigned pcShift, unsigned slots,
+                              unsigned undoCycles, unsigned retiresPerCycle) {
+    m_functions = {"[unknown]"};
+    m_slotFunctions.assign(slots, s_unknownFunction);
+    m_slotTransfers.assign(slots, None);
+
+    m_nodes.clear();
+    m_nodes.push_back({s_unknownFunction, s_root});
+    m_top = s_root;
+    m_pendingTransfer = None;
+    m_totals = Counts();
+
+    m_events.assign(std::max(1u, undoCycles * (1 + retiresPerCycle)), Event());
+    m_eventHead = 0;
+    m_eventCount = 0;
+
+    const ProgramSection* text = program ? program->getSection(TEXT_SECTION_NAME) : nullptr;
+    if (!text) {
+        return;
+    }
+
+    // Each symbol within the text section starts a function, which extends until the next symbol.
+    const AInt textEnd = pcBase + (static_cast<AInt>(slots) << pcShift);
+    unsigned slot = 0;
+    for (auto it = program->symbols.lower_bound(pcBase); it != program->symbols.end() && it->first < textEnd; ++it) {
+        if (it->second.is(Symbol::Constant)) {
+            continue;
+        }
+        const unsigned firstSlot = (it->first - pcBase) >> pcShift;
+        std::fill(m_slotFunctions.begin() + slot, m_slotFunctions.begin() + firstSlot, m_functions.size() - 1);
+        m_functions.push_back(it->second.v);
+        slot = firstSlot;
+    }
+    std::fill(m_slotFunctions.begin() + slot, m_slotFunctions.end(), m_functions.size() - 1);
+
+    const bool rv32 = ProcessorHandler::currentISA()->bits() == 32;
+    for (slot = 0; slot < slots; ++slot) {
+        m_slotTransfers[slot] = decodeTransfer(text->data, slot << pcShift, rv32);
+    }
+}
+
+CallGraphProfiler::Transfer CallGraphProfiler::decodeTransfer(const QByteArray& text, unsigned offset, bool rv32) {
+    const auto byte = [&](unsigned i) { return static_cast<uint32_t>(static_cast<uint8_t>(text[offset + i])); };
+    const auto isLink = [](unsigned reg) { return reg == 1 || reg == 5; };
+    if (offset + 2 > static_cast<unsigned>(text.size())) {
+        return None;
+    }
+
+    const uint32_t parcel = byte(0) | byte(1) << 8;
+    if ((parcel & 0b11) != 0b11) {
+        // Compressed instructions; c.jal (RV32 only), c.jalr and c.jr.
+        const unsigned op = parcel & 0b11;
+        const unsigned funct3 = parcel >> 13;
+        if (op == 0b01 && funct3 == 0b001) {
+            return rv32 ? Call : None;
+        }
+        const unsigned rs1 = (parcel >> 7) & 0x1F;
+        const unsigned rs2 = (parcel >> 2) & 0x1F;
+        if (op == 0b10 && funct3 == 0b100 && rs1 != 0 && rs2 == 0) {
+            if (parcel & (1 << 12)) {
+                return Call;
+            }
+            return isLink(rs1) ? Return : None;
+        }
+        return None;
+    }
+
+    if (offset + 4 > static_cast<unsigned>(text.size())) {
+        return None;
+    }
+    const uint32_t instr = parcel | byte(2) << 16 | byte(3) << 24;
+    const unsigned opcode = instr & 0x7F;
+    const unsigned rd = (instr >> 7) & 0x1F;
+    const unsigned rs1 = (instr >> 15) & 0x1F;
+    if (opcode == 0b1101111) {
+        // JAL
+        return isLink(rd) ? Call : None;
+    }
+    if (opcode == 0b1100111) {
+        // JALR
+        return isLink(rd) ? Call : isLink(rs1) ? Return : None;
+    }
+    return None;
+}
+
+uint32_t CallGraphProfiler::child(uint32_t node, uint32_t function) {
+    auto it = m_nodes[node].children.find(function);
+    if (it != m_nodes[node].children.end()) {
+        return it->second;
+    }
+    const uint32_t childNode = m_nodes.size();
+    m_nodes[node].children[function] = childNode;
+    m_nodes.push_back({function, node});
+    return childNode;
+}
+
+void CallGraphProfiler::pushEvent(const Event& event) {
+    m_events[m_eventHead] = event;
+    m_eventHead = (m_eventHead + 1) % m_events.size();
+    m_eventCount = std::min<unsigned>(m_eventCount + 1, m_events.size());
+}
+
+void CallGraphProfiler::cycle(unsigned misses) {
+    Counts& counts = m_nodes[m_top].counts;
+    counts.cycles++;
+    counts.misses += misses;
+    m_totals.cycles++;
+    m_totals.misses += misses;
+
+    Event event;
+    event.node = m_top;
+    event.prevTop = m_top;
+    event.misses = misses;
+    event.isCycle = true;
+    event.called = false;
+    event.prevTransfer = m_pendingTransfer;
+    pushEvent(event);
+}
+
+void CallGraphProfiler::retire(uint32_t slot) {
+    const uint32_t function = slot == s_noSlot ? s_unknownFunction : m_slotFunctions[slot];
+
+    Event event;
+    event.prevTop = m_top;
+    event.misses = 0;
+    event.isCycle = false;
+    event.called = false;
+    event.prevTransfer = m_pendingTransfer;
+
+    if (m_top == s_root || m_pendingTransfer == Call) {
+        m_top = child(m_top, function);
+        event.called = true;
+    } else if (m_pendingTransfer == Return) {
+        // Unwind to the nearest frame of the function returned into. If there is none, the function is entered as if
+        // jumped to.
+        uint32_t frame = parentOf(m_top);
+        while (frame != s_root && m_nodes[frame].function != function) {
+            frame = parentOf(frame);
+        }
+        if (frame != s_root) {
+            m_top = frame;
+        } else {
+            m_top = child(parentOf(m_top), function);
+            event.called = true;
+        }
+    } else if (m_nodes[m_top].function != function) {
+        // Control was transferred into another function without a call, e.g., through a tail call. The function
+        // replaces the function of the current frame.
+        m_top = child(parentOf(m_top), function);
+        event.called = true;
+    }
+
+    Node& node = m_nodes[m_top];
+    node.calls += event.called ? 1 : 0;
+    node.counts.instructions++;
+    m_totals.instructions++;
+    m_pendingTransfer = slot == s_noSlot ? None : m_slotTransfers[slot];
+
+    event.node = m_top;
+    pushEvent(event);
+}
+
+void CallGraphProfiler::undoCycle() {
+    while (m_eventCount > 0) {
+        m_eventHead = (m_eventHead + m_events.size() - 1) % m_events.size();
+        m_eventCount--;
+        const Event& event = m_events[m_eventHead];
+        Node& node = m_nodes[event.node];
+        if (event.isCycle) {
+            node.counts.cycles--;
+            node.counts.misses -= event.misses;
+            m_totals.cycles--;
+            m_totals.misses -= event.misses;
+            return;
+        }
+        node.calls -= event.called ? 1 : 0;
+        node.counts.instructions--;
+        m_totals.instructions--;
+        m_top = event.prevTop;
+        m_pendingTransfer = event.prevTransfer;
+    }
+}
+
+std::vector<CallGraphProfiler::FunctionStats> CallGraphProfiler::functionStats() const {
+    // Children are always created after their parents, such that the counts of each subtree may be accumulated in a
+    // single reverse pass.
+    std::vector<Counts> subtree(m_nodes.size());
+    for (uint32_t node = m_nodes.size() - 1; node > s_root; --node) {
+        subtree[node] += m_nodes[node].counts;
+        subtree[m_nodes[node].parent] += subtree[node];
+    }
+
+    std::vector<FunctionStats> stats(m_functions.size());
+    for (uint32_t function = 0; function < m_functions.size(); ++function) {
+        stats[function].name = m_functions[function];
+    }
+    for (uint32_t node = s_root + 1; node < m_nodes.size(); ++node) {
+        FunctionStats& fstats = stats[m_nodes[node].function];
+        fstats.calls += m_nodes[node].calls;
+        fstats.exclusive += m_nodes[node].counts;
+
+        // Recursive invocations are included once, through their outermost frame.
+        bool outermost = true;
+        for (uint32_t frame = m_nodes[node].parent; frame != s_root && outermost; frame = m_nodes[frame].parent) {
+            outermost = m_nodes[frame].function != m_nodes[node].function;
+        }
+        if (outermost) {
+            fstats.inclusive += subtree[node];
+        }
+    }
+
+    stats.erase(std::remove_if(stats.begin(), stats.end(),
+                               [](const FunctionStats& fstats) {
+                                   return fstats.inclusive.cycles == 0 && fstats.inclusive.instructions == 0;
+                               }),
+                stats.end());
+    return stats;
+}
+
+void CallGraphProfiler::writeFoldedStacks(QTextStream& out) const {
+    QStringList stack;
+    for (uint32_t node = s_root + 1; node < m_nodes.size(); ++node) {
+        if (m_nodes[node].counts.cycles == 0) {
+            continue;
+        }
+        stack.clear();
+        for (uint32_t frame = node; frame != s_root; frame = m_nodes[frame].parent) {
+            stack.prepend(m_functions[m_nodes[frame].function]);
+        }
+        out << stack.join(';') << " " << m_nodes[node].counts.cycles << "\n";
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QTextStream>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+class Program;
+
+/**
+ * @brief The CallGraphProfiler class
+ * Profiles the execution of the current program per function, through a shadow call stack which follows the retired
+ * instructions of the program. Functions are delimited by the symbols of the program within its text section; for ELF
+ * programs, these are the function symbols.
+ *
+ * Calls and returns are identified through the link register conventions of RISC-V: a JAL/JALR which links to ra or
+ * t0 is a call, and a JALR through ra or t0 which does not link is a return. Control transfers into another function
+ * by any other means, e.g., tail calls, replace the function of the current frame. A return unwinds the stack to the
+ * nearest frame of the function returned into, if any.
+ *
+ * The shadow stack is maintained as a calling context tree, wherein each node is a unique stack of functions. The
+ * cycles, retired instructions and data cache misses of the program are attributed to the node of the stack in which
+ * they occurred, i.e., exclusively to the function at the top of the stack. Inclusive counts are derived from the
+ * tree on demand.
+ *
+ * Cycles may be undone in reverse order, alongside the cycles of the processor.
+ */
+class CallGraphProfiler {
+public:
+    /**
+     * @brief The Counts struct
+     * Counts attributed to a node of the calling context tree, or to a function.
+     */
+    struct Counts {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t misses = 0;
+
+        Counts& operator+=(const Counts& rhs) {
+            cycles += rhs.cycles;
+            instructions += rhs.instructions;
+            misses += rhs.misses;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief The FunctionStats struct
+     * The counts of a single function; exclusive counts occurred within the function itself, inclusive counts also
+     * within the functions which it called.
+     */
+    struct FunctionStats {
+        QString name;
+        uint64_t calls = 0;
+        Counts exclusive;
+        Counts inclusive;
+    };
+
+    /**
+     * @brief reset
+     * Clears the profile and resolves the functions of the instruction slots of the text section of @p program.
+     * Instruction slots start at @p pcBase and are 1 << @p pcShift bytes apart. The most recent @p undoCycles cycles
+     * may be undone, wherein up to @p retiresPerCycle instructions retire.
+     */
+    void reset(const Program* program, AInt pcBase, unsigned pcShift, unsigned slots, unsigned undoCycles,
+               unsigned retiresPerCycle);
+
+    /**
+     * @brief cycle
+     * Attributes a cycle, and the @p misses data cache misses which occurred in it, to the current stack. Marks the
+     * start of a cycle; must be called before the instructions retiring in the cycle are recorded through retire().
+     */
+    void cycle(unsigned misses);
+
+    /**
+     * @brief retire
+     * Attributes the retirement of the instruction in slot @p slot to the current stack, following any call or return
+     * of the previously retired instruction. Instructions outside the text section are given as s_noSlot.
+     */
+    void retire(uint32_t slot);
+
+    /**
+     * @brief undoCycle
+     * Undoes the most recent cycle and the instructions which retired in it.
+     */
+    void undoCycle();
+
+    /**
+     * @brief functionStats
+     * @returns the counts of each function which has been executed.
+     */
+    std::vector<FunctionStats> functionStats() const;
+
+    /**
+     * @brief writeFoldedStacks
+     * Writes the cycles of each unique stack to @p out, in the folded stack format of flame graph tools: a line per
+     * stack, listing the functions of the stack outermost first, separated by ';', followed by the cycle count.
+     */
+    void writeFoldedStacks(QTextStream& out) const;
+
+    const Counts& getTotals() const { return m_totals; }
+
+    static constexpr uint32_t s_noSlot = UINT32_MAX;
+
+private:
+    static constexpr uint32_t s_root = 0;
+    static constexpr uint32_t s_unknownFunction = 0;
+
+    enum Transfer : uint8_t { None, Call, Return };
+
+    struct Node {
+        uint32_t function;
+        uint32_t parent;
+        uint64_t calls = 0;  // Number of times the node was entered through a call
+        Counts counts;
+        std::map<uint32_t, uint32_t> children;  // Function : node
+    };
+
+    /**
+     * @brief The Event struct
+     * Undo record of a cycle, or of a retired instruction.
+     */
+    struct Event {
+        uint32_t node;     // The node which the cycle or instruction was attributed to
+        uint32_t prevTop;  // The top of the stack prior to the retirement of the instruction
+        uint32_t misses;
+        bool isCycle;
+        bool called;            // The instruction entered the node through a call
+        Transfer prevTransfer;  // The pending transfer prior to the retirement of the instruction
+    };
+
+    uint32_t child(uint32_t node, uint32_t function);
+    uint32_t parentOf(uint32_t node) const { return node == s_root ? s_root : m_nodes[node].parent; }
+    void pushEvent(const Event& event);
+    static Transfer decodeTransfer(const QByteArray& text, unsigned offset, bool rv32);
+
+    /**
+     * @brief m_functions/m_slotFunctions/m_slotTransfers
+     * The names of the functions of the program, the function of each instruction slot, and the control transfer
+     * performed by the instruction of each slot. Function 0 holds the instructions preceding any symbol.
+     */
+    std::vector<QString> m_functions;
+    std::vector<uint32_t> m_slotFunctions;
+    std::vector<Transfer> m_slotTransfers;
+
+    std::vector<Node> m_nodes;
+    uint32_t m_top = s_root;
+    Transfer m_pendingTransfer = None;
+    Counts m_totals;
+
+    std::vector<Event> m_events;
+    unsigned m_eventHead = 0;
+    unsigned m_eventCount = 0;
+};
+
+}  // namespace Ripes
@@ -34,6 +34,10 @@ CodeEditor::CodeEditor(QWidget* parent) : HighlightableTextEdit(parent) {
     updateSidebarWidth(0);
 
     connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun, this, &CodeEditor::updateHighlighting);
+    connect(RipesSettings::getObserver(RIPES_SETTING_EDITORMISSANNOTATIONS), &SettingObserver::modified, this,
+            &CodeEditor::updateHighlighting);
+    connect(RipesSettings::getObserver(RIPES_SETTING_EDITORPROFILEANNOTATIONS), &SettingObserver::modified, this,
+            &CodeEditor::updateHighlighting);
 
     // Set font for the entire widget. calls to fontMetrics() will get the
     // dimensions of the currently set font
@@ -393,7 +397,10 @@ void CodeEditor::lineNumberAreaPaintEvent(QPaintEvent* event) {
 void CodeEditor::updateHighlighting() {
     clearBlockHighlights();
 
-    if (!RipesSettings::value(RIPES_SETTING_EDITORSTAGEHIGHLIGHTING).toBool())
+    const bool stageHighlighting = RipesSettings::value(RIPES_SETTING_EDITORSTAGEHIGHLIGHTING).toBool();
+    const bool missAnnotations = m_profiledCache && RipesSettings::value(RIPES_SETTING_EDITORMISSANNOTATIONS).toBool();
+    const bool profileAnnotations = m_profiler && RipesSettings::value(RIPES_SETTING_EDITORPROFILEANNOTATIONS).toBool();
+    if (!stageHighlighting && !missAnnotations && !profileAnnotations)
         return;
 
     auto* proc = ProcessorHandler::getProcessor();
@@ -409,6 +416,47 @@ void CodeEditor::updateHighlighting() {
     if (sourceMapping.empty())
         return;
 
+    // Annotate the source lines with the cache misses of the instructions which they originated.
+    if (missAnnotations) {
+        std::map<int, CacheSim::PCStats> lineStats;
+        for (const auto& [pc, stats] : m_profiledCache->getPCProfile()) {
+            auto mappingIt = sourceMapping.find(pc);
+            if (mappingIt == sourceMapping.end())
+                continue;
+            for (auto sourceLine : mappingIt->second) {
+                QTextBlock block = document()->findBlockByLineNumber(sourceLine);
+                if (!block.isValid())
+                    continue;
+                auto& blockStats = lineStats[block.blockNumber()];
+                blockStats.misses += stats.misses;
+                blockStats.writebacks += stats.writebacks;
+            }
+        }
+        highlightMisses(lineStats);
+    }
+
+    // Annotate the source lines with the execution profile of the instructions which they originated.
+    if (profileAnnotations) {
+        std::map<int, ExecutionProfiler::PCStats> lineStats;
+        for (const auto& [pc, stats] : m_profiler->getPCProfile()) {
+            auto mappingIt = sourceMapping.find(pc);
+            if (mappingIt == sourceMapping.end())
+                continue;
+            for (auto sourceLine : mappingIt->second) {
+                QTextBlock block = document()->findBlockByLineNumber(sourceLine);
+                if (!block.isValid())
+                    continue;
+                auto& blockStats = lineStats[block.blockNumber()];
+                blockStats.cycles += stats.cycles;
+                blockStats.retired += stats.retired;
+            }
+        }
+        highlightProfile(lineStats);
+    }
+
+    if (!stageHighlighting)
+        return;
+
     // Iterate over the processor stages and use the source mappings to determine the source line which originated the
     // instruction.
     const unsigned stages = proc->stageCount();
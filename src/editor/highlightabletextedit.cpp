@@ -87,6 +87,42 @@ void HighlightableTextEdit::highlightBlock(const QTextBlock& block, const QColor
     applyHighlighting();
 }
 
+void HighlightableTextEdit::highlightMisses(const std::map<int, CacheSim::PCStats>& blockStats) {
+    unsigned maxMisses = 0;
+    for (const auto& it : blockStats) {
+        maxMisses = std::max(maxMisses, it.second.misses);
+    }
+
+    for (const auto& [blockNumber, stats] : blockStats) {
+        QString text = QString("%1 miss%2").arg(stats.misses).arg(stats.misses == 1 ? "" : "es");
+        if (stats.writebacks != 0) {
+            text += QString(", %1 wb").arg(stats.writebacks);
+        }
+        QColor color = Colors::CaliforniaGold;
+        color.setAlphaF(maxMisses == 0 ? 0.2 : 0.2 + 0.8 * stats.misses / maxMisses);
+        highlightBlock(document()->findBlockByNumber(blockNumber), color, text);
+    }
+}
+
+void HighlightableTextEdit::highlightProfile(const std::map<int, ExecutionProfiler::PCStats>& blockStats) {
+    uint64_t maxCycles = 0;
+    for (const auto& it : blockStats) {
+        maxCycles = std::max(maxCycles, it.second.cycles);
+    }
+
+    const uint64_t totalCycles = m_profiler->getTotals().cycles;
+    for (const auto& [blockNumber, stats] : blockStats) {
+        QString text = QString("%1 cycle%2").arg(stats.cycles).arg(stats.cycles == 1 ? "" : "s");
+        if (totalCycles != 0) {
+            text += QString(" (%1%)").arg(100.0 * stats.cycles / totalCycles, 0, 'f', 1);
+        }
+        text += QString(", %1x").arg(stats.retired);
+        QColor color = Colors::FoundersRock;
+        color.setAlphaF(maxCycles == 0 ? 0.2 : 0.2 + 0.8 * stats.cycles / maxCycles);
+        highlightBlock(document()->findBlockByNumber(blockNumber), color, text);
+    }
+}
+
 std::optional<QTextEdit::ExtraSelection>
 HighlightableTextEdit::getExtraSelection(const HighlightableTextEdit::BlockHighlight& highlighting) {
     auto block = document()->findBlockByNumber(highlighting.blockNumber);
@@ -6,9 +6,14 @@
 #include <QScrollBar>
 #include <QTimer>
 
+#include <map>
+#include <memory>
 #include <optional>
 #include <set>
 
+#include "cachesim/cachesim.h"
+#include "executionprofiler.h"
+
 namespace Ripes {
 
 // This implements a QPlainTextEdit with support for highlighting certain text blocks within the document.
@@ -33,9 +38,24 @@ public:
     void highlightBlock(const QTextBlock& block, const QColor& color, const QString& text = QString());
     /// Clears any currently active block highlightings.
     void clearBlockHighlights();
+    /// Sets the cache whose misses are annotated on the blocks of this text edit, see highlightMisses().
+    void setProfiledCache(const std::shared_ptr<const CacheSim>& cache) { m_profiledCache = cache; }
+    /// Sets the profiler whose execution profile is annotated on the blocks of this text edit, see highlightProfile().
+    void setExecutionProfiler(const ExecutionProfiler* profiler) { m_profiler = profiler; }
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
+    /// Highlights and annotates each block of @p blockStats, keyed by block number, with the misses and writebacks of
+    /// the profiled cache attributed to the instructions of the block. The intensity of the highlight is relative to
+    /// the block with the most misses, such that the hot spots of the program stand out.
+    void highlightMisses(const std::map<int, CacheSim::PCStats>& blockStats);
+    /// Highlights and annotates each block of @p blockStats, keyed by block number, with the cycles spent by the
+    /// instructions of the block and their number of executions. As with highlightMisses(), the intensity of the
+    /// highlight is relative to the block with the most cycles.
+    void highlightProfile(const std::map<int, ExecutionProfiler::PCStats>& blockStats);
+
+    std::shared_ptr<const CacheSim> m_profiledCache;
+    const ExecutionProfiler* m_profiler = nullptr;
 
 private:
     /// Creates a new ExtraSelection formatting from the information stored in BlockHighlighting.
@@ -200,6 +200,16 @@ void EditTab::clearAssemblyEditor() {
     m_ui->codeEditor->clear();
 }
 
+void EditTab::setProfiledCache(const std::shared_ptr<const CacheSim>& cache) {
+    m_ui->codeEditor->setProfiledCache(cache);
+    m_ui->programViewer->setProfiledCache(cache);
+}
+
+void EditTab::setExecutionProfiler(const ExecutionProfiler* profiler) {
+    m_ui->codeEditor->setExecutionProfiler(profiler);
+    m_ui->programViewer->setExecutionProfiler(profiler);
+}
+
 void EditTab::updateProgramViewerHighlighting() {
     if (isVisible()) {
         m_ui->programViewer->updateHighlightedAddresses();
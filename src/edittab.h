@@ -17,6 +17,8 @@ class EditTab;
 }
 
 struct LoadFileParams;
+class CacheSim;
+class ExecutionProfiler;
 
 class EditTab : public RipesTab {
     Q_OBJECT
@@ -43,6 +45,12 @@ public:
     /// if the file loaded successfully.
     bool loadExternalFile(const LoadFileParams& params);
 
+    /// Sets the cache whose misses are annotated on the source code and the program viewer.
+    void setProfiledCache(const std::shared_ptr<const CacheSim>& cache);
+
+    /// Sets the profiler whose execution profile is annotated on the source code and the program viewer.
+    void setExecutionProfiler(const ExecutionProfiler* profiler);
+
 signals:
     void programChanged(const std::shared_ptr<Program>& program);
     void editorStateChanged(bool enabled);
@@ -0,0 +1,251 @@
+#include "executionprofiler.h"
+#include "binutils.h"
+
+#include "cachesim/cachesim.h"
+#include "processorhandler.h"
+#include "radix.h"
+
+#include "../external/VSRTL/core/vsrtl_register.h"
+
+#include <algorithm>
+
+namespace Ripes {
+
+ExecutionProfiler::ExecutionProfiler(QObject* parent) : QObject(parent) {
+    // The processor is clocked in the simulator thread while running, wherein the profile is gathered directly.
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+            &ExecutionProfiler::processorWasClocked, Qt::DirectConnection);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReversed, this,
+            &ExecutionProfiler::processorWasReversed);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this, &ExecutionProfiler::reset);
+    reset();
+}
+
+void ExecutionProfiler::setProfiledCache(const std::shared_ptr<const CacheSim>& cache) {
+    m_profiledCache = cache;
+    m_lastMisses = m_profiledCache ? m_profiledCache->getMisses() : 0;
+}
+
+void ExecutionProfiler::reset() {
+    const auto* proc = ProcessorHandler::getProcessor();
+    m_stages = proc->stageCount();
+    m_stride = m_stages + 1;
+
+    // The final stages share the name of the last stage.
+    m_finalStages.assign(m_stages, false);
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        m_finalStages[stage] = proc->stageName(stage) == proc->stageName(m_stages - 1);
+    }
+
+    // Instructions are counted per instruction slot of the text section of the current program.
+    const auto program = ProcessorHandler::getProgram();
+    const ProgramSection* text = program ? program->getSection(TEXT_SECTION_NAME) : nullptr;
+    m_pcShift = log2Ceil(std::max(1u, ProcessorHandler::currentISA()->instrByteAlignment()));
+    m_pcBase = text ? text->address : 0;
+    m_slots = text ? text->data.size() >> m_pcShift : 0;
+    m_counters.assign(static_cast<size_t>(m_slots) * m_stride, 0);
+    m_totals = PCStats();
+    m_cycles = 0;
+
+    const unsigned undoCapacity = std::max(1u, vsrtl::core::ClockedComponent::reverseStackSize());
+    m_undoOccupants.assign(static_cast<size_t>(undoCapacity) * m_stages, s_noPC);
+    m_undoRetired.assign(undoCapacity, 0);
+    m_undoHead = 0;
+    m_undoSize = 0;
+
+    const unsigned finalStages = std::count(m_finalStages.begin(), m_finalStages.end(), true);
+    m_callGraph.reset(program.get(), m_pcBase, m_pcShift, m_slots, undoCapacity, finalStages);
+    m_lastMisses = m_profiledCache ? m_profiledCache->getMisses() : 0;
+
+    m_retired = proc->getInstructionsRetired();
+    m_occupants.assign(m_stages, s_noPC);
+    observeStages();
+}
+
+void ExecutionProfiler::observeStages() {
+    const auto* proc = ProcessorHandler::getProcessor();
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        const StageInfo info = proc->stageInfo(stage);
+        const bool occupied = info.stage_valid && info.state == StageInfo::State::None;
+        m_occupants[stage] = occupied ? pcIndex(info.pc) : s_noPC;
+    }
+}
+
+void ExecutionProfiler::processorWasClocked() {
+    // The cycle which just passed is attributed to the instructions observed in the stages during the cycle.
+    uint32_t* undoOccupants = &m_undoOccupants[static_cast<size_t>(m_undoHead) * m_stages];
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        const uint32_t pcIdx = m_occupants[stage];
+        undoOccupants[stage] = pcIdx;
+        if (pcIdx != s_noPC) {
+            m_counters[pcIdx * m_stride + stage]++;
+            m_totals.cycles++;
+        }
+    }
+
+    // The misses of the cycle are those which the cache simulated since the previous cycle.
+    unsigned misses = 0;
+    if (m_profiledCache) {
+        const unsigned totalMisses = m_profiledCache->getMisses();
+        misses = totalMisses > m_lastMisses ? totalMisses - m_lastMisses : 0;
+        m_lastMisses = totalMisses;
+    }
+    m_callGraph.cycle(misses);
+
+    // Instructions retire from the final stages. A processor retires the instructions in its final stages at the
+    // end of a cycle, unless they were stalled. The retired mask is indexed by the position of a stage among the final
+    // stages, as processors may have more stages than the bits of the mask.
+    const long long retired = ProcessorHandler::getProcessor()->getInstructionsRetired();
+    long long toRetire = retired - m_retired;
+    uint32_t retiredMask = 0;
+    unsigned finalStage = 0;
+    for (unsigned stage = 0; stage < m_stages && toRetire > 0; ++stage) {
+        if (!m_finalStages[stage]) {
+            continue;
+        }
+        const uint32_t pcIdx = m_occupants[stage];
+        if (pcIdx != s_noPC) {
+            m_counters[pcIdx * m_stride + m_stages]++;
+            m_totals.retired++;
+            retiredMask |= 1u << finalStage;
+            toRetire--;
+            m_callGraph.retire(pcIdx);
+        }
+        finalStage++;
+    }
+    m_retired = retired;
+    m_undoRetired[m_undoHead] = retiredMask;
+    m_undoHead = (m_undoHead + 1) % m_undoRetired.size();
+    m_undoSize = std::min<unsigned>(m_undoSize + 1, m_undoRetired.size());
+    m_cycles++;
+
+    observeStages();
+}
+
+void ExecutionProfiler::processorWasReversed() {
+    if (m_undoSize == 0) {
+        // The cycle precedes the recorded cycles; its counts cannot be undone.
+        m_retired = ProcessorHandler::getProcessor()->getInstructionsRetired();
+        observeStages();
+        return;
+    }
+    m_undoHead = (m_undoHead + m_undoRetired.size() - 1) % m_undoRetired.size();
+    m_undoSize--;
+    m_cycles--;
+    m_callGraph.undoCycle();
+
+    const uint32_t* undoOccupants = &m_undoOccupants[static_cast<size_t>(m_undoHead) * m_stages];
+    const uint32_t retiredMask = m_undoRetired[m_undoHead];
+    unsigned finalStage = 0;
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        const uint32_t pcIdx = undoOccupants[stage];
+        m_occupants[stage] = pcIdx;
+        bool retiredFromStage = false;
+        if (m_finalStages[stage]) {
+            retiredFromStage = retiredMask & (1u << finalStage);
+            finalStage++;
+        }
+        if (pcIdx == s_noPC) {
+            continue;
+        }
+        m_counters[pcIdx * m_stride + stage]--;
+        m_totals.cycles--;
+        if (retiredFromStage) {
+            m_counters[pcIdx * m_stride + m_stages]--;
+            m_totals.retired--;
+        }
+    }
+    m_retired = ProcessorHandler::getProcessor()->getInstructionsRetired();
+    m_lastMisses = m_profiledCache ? m_profiledCache->getMisses() : 0;
+}
+
+ExecutionProfiler::PCStats ExecutionProfiler::getPCStats(AInt pc) const {
+    PCStats stats;
+    const uint32_t pcIdx = pcIndex(pc);
+    if (pcIdx == s_noPC) {
+        return stats;
+    }
+    const uint64_t* counters = &m_counters[static_cast<size_t>(pcIdx) * m_stride];
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        stats.cycles += counters[stage];
+    }
+    stats.retired = counters[m_stages];
+    return stats;
+}
+
+std::vector<std::pair<AInt, ExecutionProfiler::PCStats>> ExecutionProfiler::getPCProfile() const {
+    std::vector<std::pair<AInt, PCStats>> profile;
+    for (uint32_t pcIdx = 0; pcIdx < m_slots; ++pcIdx) {
+        const AInt pc = m_pcBase + (static_cast<AInt>(pcIdx) << m_pcShift);
+        const PCStats stats = getPCStats(pc);
+        if (stats.cycles != 0 || stats.retired != 0) {
+            profile.push_back({pc, stats});
+        }
+    }
+    return profile;
+}
+
+void ExecutionProfiler::writeReport(QTextStream& out) const {
+    const auto* proc = ProcessorHandler::getProcessor();
+    const unsigned addrWidth = ProcessorHandler::currentISA()->bytes();
+    const auto program = ProcessorHandler::getProgram();
+    const auto percent = [&](uint64_t cycles) {
+        return QString("%1%").arg(m_totals.cycles == 0 ? 0.0 : 100.0 * cycles / m_totals.cycles, 7, 'f', 2);
+    };
+    const auto cpi = [](const PCStats& stats) {
+        return stats.retired == 0 ? QString("-").rightJustified(6)
+                                  : QString::number(static_cast<double>(stats.cycles) / stats.retired, 'f', 2)
+                                        .rightJustified(6);
+    };
+    const auto source = [&](AInt pc) {
+        QStringList lines;
+        if (program) {
+            auto it = program->sourceMapping.find(pc);
+            if (it != program->sourceMapping.end()) {
+                for (const auto line : it->second) {
+                    lines << QString::number(line + 1);
+                }
+            }
+        }
+        return lines.isEmpty() ? QString() : "  ; line " + lines.join(",");
+    };
+
+    auto profile = getPCProfile();
+    out << "# Processor: " << ProcessorRegistry::getDescription(ProcessorHandler::getID()).name << "\n";
+    out << "# Cycles: " << m_cycles << "\n";
+    out << "# Instructions retired: " << m_totals.retired << "\n";
+    out << "# Samples: " << m_totals.cycles << " of event 'stage-cycles'\n";
+    out << "#\n";
+    out << "# Overhead      Cycles     Retired     CPI  Address  Instruction\n";
+    out << "# ........  ..........  ..........  ......  .......  ...........\n";
+    out << "#\n";
+
+    // Instructions in order of their overhead.
+    std::stable_sort(profile.begin(), profile.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second.cycles > rhs.second.cycles; });
+    for (const auto& [pc, stats] : profile) {
+        out << "  " << percent(stats.cycles) << "  " << QString::number(stats.cycles).rightJustified(10) << "  "
+            << QString::number(stats.retired).rightJustified(10) << "  " << cpi(stats) << "  "
+            << encodeRadixValue(pc, Radix::Hex, addrWidth) << "  " << ProcessorHandler::disassembleInstr(pc)
+            << source(pc) << "\n";
+    }
+
+    // The annotated program, in order of address, with the cycles spent in each stage.
+    out << "\n# Annotated program\n#\n#  Percent";
+    for (unsigned stage = 0; stage < m_stages; ++stage) {
+        out << "  " << proc->stageName(stage).rightJustified(8);
+    }
+    out << "     Retired  Address  Instruction\n#\n";
+    std::sort(profile.begin(), profile.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (const auto& [pc, stats] : profile) {
+        out << "  " << percent(stats.cycles);
+        for (unsigned stage = 0; stage < m_stages; ++stage) {
+            out << "  " << QString::number(getStageCycles(pc, stage)).rightJustified(8);
+        }
+        out << "  " << QString::number(stats.retired).rightJustified(10) << "  "
+            << encodeRadixValue(pc, Radix::Hex, addrWidth) << "  " << ProcessorHandler::disassembleInstr(pc)
+            << source(pc) << "\n";
+    }
+}
+
+}  // namespace Ripes
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <QObject>
+#include <QTextStream>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "callgraphprofiler.h"
+#include "ripes_types.h"
+
+namespace Ripes {
+
+class CacheSim;
+
+/**
+ * @brief The ExecutionProfiler class
+ * Profiles the execution of the current program on the current processor, per instruction. For each instruction of
+ * the text section of the program, the number of times it retired and the number of cycles it spent in each stage of
+ * the processor are counted. The counters are gathered in each cycle, also while the processor is running, and the
+ * counts of reversed cycles are undone.
+ *
+ * The cycles of an instruction are the sum of the cycles it spent in each stage, i.e., its residency in the pipeline.
+ * The overhead of an instruction is its share of the residency of all instructions, akin to the share of samples of a
+ * sampling profiler which samples a random stage in each cycle.
+ *
+ * The retired instructions furthermore drive a call graph profile of the program, see CallGraphProfiler.
+ */
+class ExecutionProfiler : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief The PCStats struct
+     * The execution counts of a single instruction.
+     */
+    struct PCStats {
+        uint64_t retired = 0;
+        uint64_t cycles = 0;  // Cycles spent in all stages of the processor
+    };
+
+    ExecutionProfiler(QObject* parent = nullptr);
+
+    /**
+     * @brief setProfiledCache
+     * Sets the cache whose misses are attributed to the functions of the call graph profile.
+     */
+    void setProfiledCache(const std::shared_ptr<const CacheSim>& cache);
+
+    /**
+     * @brief getPCStats
+     * @returns the execution counts of the instruction at @p pc.
+     */
+    PCStats getPCStats(AInt pc) const;
+    /**
+     * @brief getStageCycles
+     * @returns the number of cycles which the instruction at @p pc spent in stage @p stage.
+     */
+    uint64_t getStageCycles(AInt pc, unsigned stage) const {
+        const uint32_t pcIdx = pcIndex(pc);
+        return pcIdx == s_noPC ? 0 : m_counters[pcIdx * m_stride + stage];
+    }
+    /**
+     * @brief getPCProfile
+     * @returns the instructions which have been executed, in order of their address.
+     */
+    std::vector<std::pair<AInt, PCStats>> getPCProfile() const;
+
+    /**
+     * @brief getTotals
+     * @returns the execution counts summed over all instructions.
+     */
+    const PCStats& getTotals() const { return m_totals; }
+    unsigned getCycles() const { return m_cycles; }
+
+    /**
+     * @brief writeReport
+     * Writes the profile to @p out as text, in the format of `perf report --stdio`: instructions sorted by their
+     * overhead, followed by the annotated program in order of address.
+     */
+    void writeReport(QTextStream& out) const;
+
+    const CallGraphProfiler& getCallGraph() const { return m_callGraph; }
+
+public slots:
+    void reset();
+
+private slots:
+    void processorWasClocked();
+    void processorWasReversed();
+
+private:
+    static constexpr uint32_t s_noPC = UINT32_MAX;
+
+    uint32_t pcIndex(AInt pc) const {
+        const AInt pcIdx = (pc - m_pcBase) >> m_pcShift;
+        return pc >= m_pcBase && pcIdx < m_slots ? static_cast<uint32_t>(pcIdx) : s_noPC;
+    }
+
+    /**
+     * @brief observeStages
+     * Records the instructions which occupy each stage of the processor in the current cycle into m_occupants.
+     */
+    void observeStages();
+
+    /**
+     * @brief m_counters
+     * Flat array of counters, with m_stride = stages + 1 counters per instruction slot of the text section of the
+     * current program, starting at m_pcBase; m_pcShift is log2 of the instruction alignment. The counters of a slot are
+     * the cycles spent in each stage followed by the number of retirements.
+     */
+    std::vector<uint64_t> m_counters;
+    AInt m_pcBase = 0;
+    unsigned m_pcShift = 0;
+    unsigned m_slots = 0;
+    unsigned m_stride = 1;
+    unsigned m_stages = 0;
+    PCStats m_totals;
+    unsigned m_cycles = 0;
+
+    /**
+     * @brief m_occupants
+     * The slot of the instruction in each stage of the processor in the current cycle, or s_noPC. The final stages are
+     * the stages wherein instructions retire, e.g., both write-back stages of a dual-issue processor.
+     */
+    std::vector<uint32_t> m_occupants;
+    std::vector<bool> m_finalStages;
+    long long m_retired = 0;
+
+    /**
+     * @brief m_undo*
+     * Ring buffer of the occupants of each profiled cycle and a mask of the stages whose instruction retired in the
+     * cycle, such that the most recent cycles may be undone when the processor is reversed.
+     */
+    std::vector<uint32_t> m_undoOccupants;
+    std::vector<uint32_t> m_undoRetired;
+    unsigned m_undoHead = 0;
+    unsigned m_undoSize = 0;
+
+    CallGraphProfiler m_callGraph;
+    std::shared_ptr<const CacheSim> m_profiledCache;
+    unsigned m_lastMisses = 0;
+};
+
+}  // namespace Ripes
@@ -1,6 +1,7 @@
 #include "instructionmodel.h"
 #include <QHeaderView>
 
+#include "colors.h"
 #include "processorhandler.h"
 
 namespace Ripes {
@@ -45,6 +46,29 @@ void InstructionModel::onProcessorReset() {
     updateStageInfo();
 }
 
+void InstructionModel::setProfiledCache(const std::shared_ptr<const CacheSim>& cache) {
+    m_profiledCache = cache;
+    if (m_rowCount > 0) {
+        emit dataChanged(index(0, Misses), index(m_rowCount - 1, Writebacks), {Qt::DisplayRole});
+    }
+}
+
+void InstructionModel::setExecutionProfiler(const ExecutionProfiler* profiler) {
+    m_profiler = profiler;
+    updateProfile();
+}
+
+void InstructionModel::updateProfile() {
+    if (!m_profiler || m_rowCount == 0) {
+        return;
+    }
+    m_maxCycles = 0;
+    for (const auto& it : m_profiler->getPCProfile()) {
+        m_maxCycles = std::max(m_maxCycles, it.second.cycles);
+    }
+    emit dataChanged(index(0, Executions), index(m_rowCount - 1, Cycles), {Qt::DisplayRole, Qt::BackgroundRole});
+}
+
 int InstructionModel::columnCount(const QModelIndex&) const {
     return NColumns;
 }
@@ -89,6 +113,14 @@ void InstructionModel::updateStageInfo() {
             }
         }
     }
+
+    // Any instruction may have executed since the last update.
+    updateProfile();
+
+    // Any instruction may have caused a miss since the last update. Only the visible rows are repainted.
+    if (m_profiledCache && m_rowCount > 0) {
+        emit dataChanged(index(0, Misses), index(m_rowCount - 1, Writebacks), {Qt::DisplayRole});
+    }
 }
 
 bool InstructionModel::setData(const QModelIndex& index, const QVariant& value, int role) {
@@ -113,6 +145,14 @@ QVariant InstructionModel::headerData(int section, Qt::Orientation orientation,
                 return role == Qt::DisplayRole ? "Stage" : "Stages currently executing instructon";
             case Column::Instruction:
                 return "Instruction";
+            case Column::Executions:
+                return role == Qt::DisplayRole ? "Exec" : "Number of times the instruction was executed (retired)";
+            case Column::Cycles:
+                return role == Qt::DisplayRole ? "Cycles" : "Cycles spent by the instruction in the processor stages";
+            case Column::Misses:
+                return role == Qt::DisplayRole ? "D$ miss" : "L1 data cache misses caused by the instruction";
+            case Column::Writebacks:
+                return role == Qt::DisplayRole ? "D$ wb" : "L1 data cache writebacks caused by the instruction";
             default:
                 return QVariant();
         }
@@ -151,6 +191,68 @@ QVariant InstructionModel::instructionData(AInt addr) const {
     return QVariant();
 }
 
+QVariant InstructionModel::cacheData(AInt addr, Column column, int role) const {
+    if (!m_profiledCache) {
+        return QVariant();
+    }
+    const auto stats = m_profiledCache->getPCStats(addr);
+    const unsigned value = column == Column::Misses ? stats.misses : stats.writebacks;
+    if (value == 0) {
+        return QVariant();
+    }
+    switch (role) {
+        case Qt::DisplayRole:
+            return value;
+        case Qt::ToolTipRole: {
+            const bool misses = column == Column::Misses;
+            const unsigned total = misses ? m_profiledCache->getMisses() : m_profiledCache->getWritebacks();
+            return QString("%1% of all %2").arg(100.0 * value / total, 0, 'f', 1).arg(misses ? "misses" : "writebacks");
+        }
+        case Qt::TextAlignmentRole:
+            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+        default:
+            return QVariant();
+    }
+}
+
+QVariant InstructionModel::profileData(AInt addr, Column column, int role) const {
+    if (!m_profiler) {
+        return QVariant();
+    }
+    const auto stats = m_profiler->getPCStats(addr);
+    const uint64_t value = column == Column::Executions ? stats.retired : stats.cycles;
+    if (value == 0) {
+        return QVariant();
+    }
+    switch (role) {
+        case Qt::DisplayRole:
+            return static_cast<qulonglong>(value);
+        case Qt::ToolTipRole: {
+            if (column == Column::Executions) {
+                return QString("%1 cycles per execution").arg(static_cast<double>(stats.cycles) / value, 0, 'f', 2);
+            }
+            QStringList stages;
+            for (unsigned i = 0; i < static_cast<unsigned>(m_stageNames.size()); ++i) {
+                stages << QString("%1: %2").arg(m_stageNames.at(i)).arg(m_profiler->getStageCycles(addr, i));
+            }
+            const uint64_t total = m_profiler->getTotals().cycles;
+            return QString("%1% of all cycles\n").arg(100.0 * value / total, 0, 'f', 1) + stages.join("\n");
+        }
+        case Qt::BackgroundRole: {
+            if (column != Column::Cycles || m_maxCycles == 0) {
+                return QVariant();
+            }
+            QColor color = Colors::FoundersRock;
+            color.setAlphaF(0.8 * value / m_maxCycles);
+            return color;
+        }
+        case Qt::TextAlignmentRole:
+            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+        default:
+            return QVariant();
+    }
+}
+
 QVariant InstructionModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid()) {
         return QVariant();
@@ -181,6 +283,12 @@ QVariant InstructionModel::data(const QModelIndex& index, int role) const {
             }
             break;
         }
+        case Column::Executions:
+        case Column::Cycles:
+            return profileData(addr, static_cast<Column>(index.column()), role);
+        case Column::Misses:
+        case Column::Writebacks:
+            return cacheData(addr, static_cast<Column>(index.column()), role);
     }
     return QVariant();
 }
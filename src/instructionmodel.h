@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <set>
 
 #include <QAbstractTableModel>
 #include <QColor>
 
 #include "assembler/program.h"
+#include "cachesim/cachesim.h"
+#include "executionprofiler.h"
 #include "processors/interface/ripesprocessor.h"
 
 namespace Ripes {
@@ -16,7 +19,17 @@ class Pipeline;
 class InstructionModel : public QAbstractTableModel {
     Q_OBJECT
 public:
-    enum Column { Breakpoint = 0, PC = 1, Stage = 2, Instruction = 3, NColumns };
+    enum Column {
+        Breakpoint = 0,
+        PC = 1,
+        Stage = 2,
+        Instruction = 3,
+        Executions = 4,
+        Cycles = 5,
+        Misses = 6,
+        Writebacks = 7,
+        NColumns
+    };
     InstructionModel(QObject* parent = nullptr);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -30,6 +43,20 @@ public:
     AInt indexToAddress(const QModelIndex& index) const;
     int addressToRow(AInt addr) const;
 
+    /**
+     * @brief setProfiledCache
+     * Sets the cache whose misses and writebacks are attributed to the instructions in the Misses and Writebacks
+     * columns.
+     */
+    void setProfiledCache(const std::shared_ptr<const CacheSim>& cache);
+
+    /**
+     * @brief setExecutionProfiler
+     * Sets the profiler whose execution counts are shown in the Executions and Cycles columns. The Cycles column is
+     * shaded as a heat map, relative to the instruction with the most cycles.
+     */
+    void setExecutionProfiler(const ExecutionProfiler* profiler);
+
 signals:
     /**
      * @brief firstStageInstrChanged
@@ -45,10 +72,16 @@ private:
     QVariant PCData(AInt addr) const;
     QVariant stageData(AInt addr) const;
     QVariant instructionData(AInt addr) const;
+    QVariant cacheData(AInt addr, Column column, int role) const;
+    QVariant profileData(AInt addr, Column column, int role) const;
+    void updateProfile();
     void updateRowCount();
     void onProcessorReset();
 
     std::shared_ptr<const Program> m_program;
+    std::shared_ptr<const CacheSim> m_profiledCache;
+    const ExecutionProfiler* m_profiler = nullptr;
+    uint64_t m_maxCycles = 0;
     QStringList m_stageNames;
     using StageID = unsigned;
     std::map<StageID, StageInfo> m_stageInfos;
@@ -66,7 +66,7 @@ void IOManager::peripheralSizeChanged(IOBase*) {
 }
 
 void IOManager::registerPeripheralWithProcessor(IOBase* peripheral) {
-    ProcessorHandler::getMemory().addIORegion(
+    ProcessorHandler::addIORegion(
         m_periphMMappings.at(peripheral).startAddr, peripheral->byteSize(),
         vsrtl::core::IOFunctors{
             [peripheral](AInt offset, VInt value, unsigned size) { peripheral->ioWrite(offset, value, size); },
@@ -83,7 +83,7 @@ void IOManager::registerPeripheralWithProcessor(IOBase* peripheral) {
 void IOManager::unregisterPeripheralWithProcessor(IOBase* peripheral) {
     const auto& mmEntry = m_periphMMappings.find(peripheral);
     if (mmEntry != m_periphMMappings.end()) {
-        ProcessorHandler::getMemory().removeIORegion(mmEntry->second.startAddr, mmEntry->second.size);
+        ProcessorHandler::removeIORegion(mmEntry->second.startAddr, mmEntry->second.size);
         m_periphMMappings.erase(mmEntry);
     }
 }
@@ -3,6 +3,7 @@
 
 #include "cachetab.h"
 #include "edittab.h"
+#include "executionprofiler.h"
 #include "iotab.h"
 #include "loaddialog.h"
 #include "memorytab.h"
@@ -118,6 +119,16 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), m_ui(new Ui::Main
 
     connect(cacheTab, &CacheTab::focusAddressChanged, memoryTab, &MemoryTab::setCentralAddress);
 
+    // Misses of the L1 data cache are attributed to the instructions shown in the editor and processor tabs
+    processorTab->setProfiledCache(cacheTab->getDataCache());
+    editTab->setProfiledCache(cacheTab->getDataCache());
+
+    // The execution profile is attributed to the instructions shown in the editor and processor tabs
+    auto* profiler = new ExecutionProfiler(this);
+    profiler->setProfiledCache(cacheTab->getDataCache());
+    processorTab->setExecutionProfiler(profiler);
+    editTab->setExecutionProfiler(profiler);
+
     connect(this, &MainWindow::prepareSave, editTab, &EditTab::onSave);
 
     m_currentTabID = ProcessorTabID;
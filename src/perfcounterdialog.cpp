@@ -0,0 +1,186 @@
+#include "perfcounterdialog.h"
+
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QVBoxLayout>
+#include <QtCharts/QBarCategoryAxis>
+#include <QtCharts/QBarSet>
+#include <QtCharts/QChartView>
+#include <QtCharts/QHorizontalStackedBarSeries>
+#include <QtCharts/QValueAxis>
+
+#include <algorithm>
+#include <cmath>
+
+#include "processorhandler.h"
+
+namespace Ripes {
+
+PerfCounterDialog::PerfCounterDialog(QWidget* parent) : QDialog(parent) {
+    setWindowTitle("Performance counters");
+    gatherRows();
+
+    m_info = new QLabel(this);
+    QString info = QString("%1 cycles, %2 instructions retired").arg(m_cycles).arg(m_instructions);
+    if (m_instructions != 0) {
+        info += QString(", CPI %1").arg(static_cast<double>(m_cycles) / m_instructions, 0, 'f', 3);
+    }
+    m_info->setText(info);
+
+    // CPI stack chart; a single horizontal bar stacking the CPI components of the processor.
+    auto* series = new QHorizontalStackedBarSeries();
+    for (const auto& row : m_rows) {
+        if (row.cycles > 0 && m_instructions != 0) {
+            auto* set = new QBarSet(row.name);
+            *set << row.cycles / m_instructions;
+            series->append(set);
+        }
+    }
+    auto* chart = new QChart();
+    chart->addSeries(series);
+    auto* categoryAxis = new QBarCategoryAxis();
+    categoryAxis->append("CPI");
+    chart->addAxis(categoryAxis, Qt::AlignLeft);
+    series->attachAxis(categoryAxis);
+    auto* valueAxis = new QValueAxis();
+    valueAxis->setLabelFormat("%.2f");
+    chart->addAxis(valueAxis, Qt::AlignBottom);
+    series->attachAxis(valueAxis);
+    chart->legend()->setAlignment(Qt::AlignBottom);
+    m_chartView = new QChartView(chart, this);
+    m_chartView->setRenderHint(QPainter::Antialiasing);
+    m_chartView->setMinimumHeight(200);
+
+    m_table = new QTableWidget(this);
+    m_table->setColumnCount(5);
+    m_table->setHorizontalHeaderLabels({"Event", "Count", "Cycles", "CPI", "% of cycles"});
+    m_table->horizontalHeaderItem(2)->setToolTip(
+        "Cycles attributed to the event in the CPI stack: the count of the event times its penalty in cycles.");
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    const auto numberItem = [](const QString& text) {
+        auto* item = new QTableWidgetItem(text);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+
+    m_table->setRowCount(m_rows.size());
+    for (unsigned i = 0; i < m_rows.size(); ++i) {
+        const auto& row = m_rows.at(i);
+        auto* nameItem = new QTableWidgetItem(row.name);
+        nameItem->setToolTip(row.description);
+        m_table->setItem(i, 0, nameItem);
+        if (row.events >= 0) {
+            m_table->setItem(i, 1, numberItem(QString::number(row.events)));
+        }
+        if (row.cycles >= 0) {
+            const int decimals = row.cycles == std::floor(row.cycles) ? 0 : 1;
+            m_table->setItem(i, 2, numberItem(QString::number(row.cycles, 'f', decimals)));
+            if (m_instructions != 0) {
+                m_table->setItem(i, 3, numberItem(QString::number(row.cycles / m_instructions, 'f', 3)));
+            }
+            if (m_cycles != 0) {
+                m_table->setItem(i, 4, numberItem(QString::number(100.0 * row.cycles / m_cycles, 'f', 1)));
+            }
+        }
+    }
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    auto* exportButton = buttons->addButton("Export...", QDialogButtonBox::ActionRole);
+    exportButton->setToolTip("Export the performance counters and CPI stack as comma-separated values.");
+    connect(exportButton, &QPushButton::clicked, this, &PerfCounterDialog::exportCSV);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(m_info);
+    layout->addWidget(m_chartView);
+    layout->addWidget(m_table);
+    layout->addWidget(buttons);
+    resize(700, 650);
+}
+
+void PerfCounterDialog::gatherRows() {
+    const auto* processor = ProcessorHandler::getProcessor();
+    const long long memStallCycles = processor->getMemoryStallCycles();
+    // Processors which do not stall for memory account for the memory stall cycles separately from the cycles in
+    // which the processor was clocked.
+    m_cycles = processor->getCycleCount() +
+               ((processor->features() & RipesProcessor::Features::hasMemoryStalls) ? 0 : memStallCycles);
+    m_instructions = processor->getInstructionsRetired();
+
+    const unsigned issueWidth = processor->issueWidth();
+    double attributed = static_cast<double>(m_instructions) / issueWidth;
+    m_rows.push_back({"Base",
+                      QString("Cycles required to retire the instructions at the ideal CPI of the processor (%1)")
+                          .arg(1.0 / issueWidth),
+                      m_instructions, attributed});
+
+    for (const auto& counter : processor->perfCounters()) {
+        Row row{counter.name, counter.description, counter.value};
+        if (counter.penalty != 0) {
+            row.cycles = static_cast<double>(counter.value) * counter.penalty;
+            row.description += QString(" (%1 cycle%2 each)").arg(counter.penalty).arg(counter.penalty == 1 ? "" : "s");
+            attributed += row.cycles;
+        }
+        m_rows.push_back(row);
+    }
+
+    m_rows.push_back({"Memory stalls", "Cycles spent waiting for memory", memStallCycles,
+                      static_cast<double>(memStallCycles)});
+    attributed += memStallCycles;
+
+    // The penalties of events are estimates which do not account for overlapping events; the remainder is clamped
+    // accordingly.
+    m_rows.push_back({"Other",
+                      "Cycles not attributed to any of the above, e.g., cycles spent filling and draining the pipeline",
+                      -1, std::max(0.0, m_cycles - attributed)});
+}
+
+void PerfCounterDialog::exportCSV() {
+    const QString filename =
+        QFileDialog::getSaveFileName(this, "Export performance counters", "", "CSV files (*.csv);;All files (*)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Error", "Could not write performance counters to '" + filename + "'");
+        return;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(12);
+    out << "event,count,cycles,cpi\n";
+    for (const auto& row : m_rows) {
+        out << row.name << ",";
+        if (row.events >= 0) {
+            out << row.events;
+        }
+        out << ",";
+        if (row.cycles >= 0) {
+            out << row.cycles << ",";
+            if (m_instructions != 0) {
+                out << row.cycles / m_instructions;
+            }
+        } else {
+            out << ",";
+        }
+        out << "\n";
+    }
+    out << "Total,," << m_cycles << ",";
+    if (m_instructions != 0) {
+        out << static_cast<double>(m_cycles) / m_instructions;
+    }
+    out << "\n";
+}
+
+}  // namespace Ripes
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QDialog>
+#include <QtCharts/QChartGlobal>
+
+#include <vector>
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QTableWidget)
+
+QT_CHARTS_BEGIN_NAMESPACE
+class QChartView;
+QT_CHARTS_END_NAMESPACE
+
+QT_CHARTS_USE_NAMESPACE
+
+namespace Ripes {
+
+/**
+ * @brief The PerfCounterDialog class
+ * Shows the performance counters of the current processor, and the CPI stack which is derived from these: the cycles
+ * of the processor broken down into the cycles required to retire the executed instructions at the ideal CPI of the
+ * processor, and the cycles lost to each cause of stalls and flushes. Cycles which are not attributed to any cause,
+ * e.g., cycles spent filling and draining the pipeline, are listed as "Other".
+ */
+class PerfCounterDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    PerfCounterDialog(QWidget* parent = nullptr);
+
+private:
+    /**
+     * @brief The Row struct
+     * A row of the table: a component of the CPI stack and/or a performance counter. Rows which are not components of
+     * the CPI stack have cycles < 0, and rows which do not count events have events < 0.
+     */
+    struct Row {
+        QString name;
+        QString description;
+        long long events = -1;
+        double cycles = -1;
+    };
+
+    void gatherRows();
+    void exportCSV();
+
+    std::vector<Row> m_rows;
+    long long m_cycles = 0;
+    long long m_instructions = 0;
+
+    QLabel* m_info = nullptr;
+    QChartView* m_chartView = nullptr;
+    QTableWidget* m_table = nullptr;
+};
+
+}  // namespace Ripes
@@ -1,9 +1,8 @@
 #include "pipelinediagrammodel.h"
 
 #include "processorhandler.h"
-#include "ripessettings.h"
 
-#include <vector>
+#include <limits>
 
 namespace Ripes {
 
@@ -18,6 +17,7 @@ PipelineDiagramModel::PipelineDiagramModel(QObject* parent) : QAbstractTableMode
     connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
             &PipelineDiagramModel::processorWasClocked, Qt::DirectConnection);
     connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this, &PipelineDiagramModel::reset);
+    reset();
 }
 
 QVariant PipelineDiagramModel::headerData(int section, Qt::Orientation orientation, int role) const {
@@ -37,24 +37,28 @@ int PipelineDiagramModel::rowCount(const QModelIndex&) const {
 }
 
 int PipelineDiagramModel::columnCount(const QModelIndex&) const {
-    return m_cycleStageInfos.size();
+    return m_cycles;
 }
 
 void PipelineDiagramModel::processorWasClocked() {
-    if (m_atMaxCycles) {
-        return;
-    }
     gatherStageInfo();
-
-    const auto cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
-    if (cycleCount >= RipesSettings::value(RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES).toInt()) {
-        m_atMaxCycles = true;
-    }
 }
 
 void PipelineDiagramModel::reset() {
-    m_atMaxCycles = false;
-    m_cycleStageInfos.clear();
+    m_chunks.clear();
+    m_cycles = 0;
+    m_namedStates = {QString()};
+    m_namedStateIds.clear();
+
+    auto* processor = ProcessorHandler::getProcessor();
+    m_stageCount = processor->stageCount();
+    m_stageNames.clear();
+    for (unsigned i = 0; i < m_stageCount; ++i) {
+        m_stageNames.push_back(processor->stageName(i));
+    }
+    m_instrBytes = ProcessorHandler::currentISA()->instrBytes();
+    m_textStart = indexToAddress(0);
+
     gatherStageInfo();
 }
 
@@ -63,17 +67,72 @@ void PipelineDiagramModel::prepareForView() {
     endResetModel();
 }
 
+uint16_t PipelineDiagramModel::internNamedState(const QString& namedState) {
+    if (namedState.isEmpty()) {
+        return 0;
+    }
+    auto it = m_namedStateIds.find(namedState);
+    if (it != m_namedStateIds.end()) {
+        return it->second;
+    }
+    if (m_namedStates.size() > std::numeric_limits<uint16_t>::max()) {
+        // Out of named state identifiers; the named state is not recorded
+        return 0;
+    }
+    const uint16_t id = static_cast<uint16_t>(m_namedStates.size());
+    m_namedStates.push_back(namedState);
+    m_namedStateIds[namedState] = id;
+    return id;
+}
+
 void PipelineDiagramModel::gatherStageInfo() {
-    long long cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
-    auto stageInfoForCycle = m_cycleStageInfos.find(cycleCount);
-    if (stageInfoForCycle == m_cycleStageInfos.end()) {
-        return;
+    auto* processor = ProcessorHandler::getProcessor();
+    const unsigned cycle = processor->getCycleCount();
+
+    // Records of cycles following the current cycle were recorded before the processor was reversed, and are
+    // rerecorded as the processor is clocked anew. Cycles which were not recorded (if any) are recorded as having
+    // all stages invalid.
+    if (cycle < m_cycles) {
+        m_cycles = cycle;
+        m_chunks.resize((cycle + s_chunkCycles - 1) / s_chunkCycles);
     }
-    for (unsigned i = 0; i < ProcessorHandler::getProcessor()->stageCount(); ++i) {
-        stageInfoForCycle->second[i] = ProcessorHandler::getProcessor()->stageInfo(i);
+    while (m_cycles <= cycle) {
+        if (m_cycles % s_chunkCycles == 0) {
+            m_chunks.emplace_back(s_chunkCycles * m_stageCount);
+        }
+        const unsigned recordCycle = m_cycles++;
+        for (unsigned i = 0; i < m_stageCount; ++i) {
+            record(recordCycle, i) = StageRecord();
+        }
+    }
+
+    for (unsigned i = 0; i < m_stageCount; ++i) {
+        const StageInfo stageInfo = processor->stageInfo(i);
+        StageRecord& stageRecord = record(cycle, i);
+        const AInt offset = stageInfo.pc - m_textStart;
+        if (stageInfo.stage_valid && stageInfo.pc >= m_textStart && offset % m_instrBytes == 0) {
+            stageRecord.row = offset / m_instrBytes + 1;
+        }
+        stageRecord.state = static_cast<uint8_t>(stageInfo.state);
+        stageRecord.namedState = internNamedState(stageInfo.namedState);
     }
 }
 
+QStringList PipelineDiagramModel::cellLabels() const {
+    QStringList labels;
+    for (const auto& stageName : m_stageNames) {
+        labels << stageName;
+    }
+    labels << "-";
+    const QStringList stageLabels = labels;
+    for (unsigned i = 1; i < m_namedStates.size(); ++i) {
+        for (const auto& label : stageLabels) {
+            labels << label + " (" + m_namedStates.at(i) + ")";
+        }
+    }
+    return labels;
+}
+
 QVariant PipelineDiagramModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid())
         return QVariant();
@@ -85,39 +144,35 @@ QVariant PipelineDiagramModel::data(const QModelIndex& index, int role) const {
     if (role != Qt::DisplayRole)
         return QVariant();
 
-    if (!m_cycleStageInfos.count(index.column()))
+    const unsigned cycle = index.column();
+    if (cycle >= m_cycles)
         return QVariant();
 
-    const AInt addr = indexToAddress(index.row());
-    const auto& stageInfo = m_cycleStageInfos.at(index.column());
-
-    QStringList stagesForAddr;
-    QString stageStr;
-    for (const auto& si : stageInfo) {
-        if (si.second.pc == addr && si.second.stage_valid && si.second.state == StageInfo::State::None) {
-            if (m_cycleStageInfos.count(index.column() - 1)) {
-                const auto& prevCycleStageInfo = m_cycleStageInfos.at(index.column() - 1);
-                if (prevCycleStageInfo.at(si.first).stage_valid && prevCycleStageInfo.at(si.first).pc == si.second.pc) {
-                    stageStr = "-";
-                    if (!si.second.namedState.isEmpty()) {
-                        stageStr += " (" + si.second.namedState + ")";
-                    }
-                    stagesForAddr << stageStr;
-                    continue;
-                }
-            }
-            stageStr = ProcessorHandler::getProcessor()->stageName(si.first);
-            if (!si.second.namedState.isEmpty()) {
-                stageStr += " (" + si.second.namedState + ")";
-            }
-            stagesForAddr << stageStr;
+    const uint32_t row = index.row() + 1;
+    QString stagesForAddr;
+    for (unsigned i = 0; i < m_stageCount; ++i) {
+        const StageRecord& stageRecord = record(cycle, i);
+        if (stageRecord.row != row || stageRecord.state != static_cast<uint8_t>(StageInfo::State::None)) {
+            continue;
+        }
+        if (!stagesForAddr.isEmpty()) {
+            stagesForAddr += '/';
+        }
+        // An instruction which remains in a stage is marked by "-"
+        if (cycle > 0 && record(cycle - 1, i).row == row) {
+            stagesForAddr += '-';
+        } else {
+            stagesForAddr += m_stageNames.at(i);
+        }
+        if (stageRecord.namedState != 0) {
+            stagesForAddr += " (" + m_namedStates.at(stageRecord.namedState) + ")";
         }
     }
 
-    if (stagesForAddr.size() == 0) {
+    if (stagesForAddr.isEmpty()) {
         return QVariant();
     }
 
-    return stagesForAddr.join('/');
+    return stagesForAddr;
 }
 }  // namespace Ripes
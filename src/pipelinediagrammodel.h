@@ -1,6 +1,11 @@
 #pragma once
 
 #include <QAbstractTableModel>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
 #include "processors/interface/ripesprocessor.h"
 
 namespace Ripes {
@@ -18,25 +23,61 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
     void prepareForView();
 
+    /**
+     * @brief cellLabels
+     * @returns the labels which a single stage may be displayed with in the cells of the diagram.
+     */
+    QStringList cellLabels() const;
+
 public slots:
     void processorWasClocked();
     void reset();
 
 private:
+    /**
+     * @brief The StageRecord struct
+     * Packed state of a single pipeline stage in a single cycle.
+     */
+    struct StageRecord {
+        uint32_t row = 0;         // Index of the instruction in the stage + 1, or 0 if the stage is invalid
+        uint8_t state = 0;        // StageInfo::State
+        uint16_t namedState = 0;  // Index into m_namedStates
+    };
+
+    /**
+     * @brief s_chunkCycles
+     * Stage records are allocated in chunks of s_chunkCycles cycles, such that the recorded cycles are never
+     * reallocated.
+     */
+    static constexpr unsigned s_chunkCycles = 4096;
+
     void gatherStageInfo();
+    const StageRecord& record(unsigned cycle, unsigned stage) const {
+        return m_chunks[cycle / s_chunkCycles][(cycle % s_chunkCycles) * m_stageCount + stage];
+    }
+    StageRecord& record(unsigned cycle, unsigned stage) {
+        return m_chunks[cycle / s_chunkCycles][(cycle % s_chunkCycles) * m_stageCount + stage];
+    }
+    uint16_t internNamedState(const QString& namedState);
 
     /**
-     * @brief m_cycleStageInfos
-     * map<cycle, map<stageId, stageInfo>>
+     * @brief m_chunks
+     * Stage records of each recorded cycle, stored as m_stageCount consecutive records per cycle.
      */
-    std::map<long long, std::map<unsigned, StageInfo>> m_cycleStageInfos;
+    std::vector<std::vector<StageRecord>> m_chunks;
+    unsigned m_cycles = 0;
+
+    // Properties of the processor and program which the stage records were recorded for
+    unsigned m_stageCount = 0;
+    std::vector<QString> m_stageNames;
+    AInt m_textStart = 0;
+    unsigned m_instrBytes = 1;
 
     /**
-     * @brief m_atMaxCycles
-     * Records the state that we've crossed the threshold set for RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES.
-     * This is to speed up execution by not having to check the settings value during each cycle of simulation,
-     * after the value has been reached.
+     * @brief m_namedStates
+     * Interned named states of the stages. Index 0 is the empty named state.
      */
-    bool m_atMaxCycles = false;
+    std::vector<QString> m_namedStates;
+    std::map<QString, uint16_t> m_namedStateIds;
 };
 }  // namespace Ripes
@@ -3,6 +3,9 @@
 
 #include <QClipboard>
 #include <QHeaderView>
+#include <QStyle>
+
+#include <algorithm>
 
 #include "pipelinediagrammodel.h"
 #include "ripessettings.h"
@@ -15,11 +18,22 @@ PipelineDiagramWidget::PipelineDiagramWidget(PipelineDiagramModel* model, QWidge
 
     m_stageModel = model;
     m_ui->pipelineDiagramView->setModel(m_stageModel);
-
-    m_ui->pipelineDiagramView->resizeColumnsToContents();
     m_ui->copy->setIcon(QIcon(":/icons/documents.svg"));
 
     m_stageModel->prepareForView();
+
+    // The diagram may span millions of cycles. Rather than resizing each cycle column to its contents, all columns are
+    // given a fixed width which fits any cell, such that only the visible cells are ever queried from the model.
+    auto* view = m_ui->pipelineDiagramView;
+    int columnWidth = view->horizontalHeader()->fontMetrics().horizontalAdvance(
+        QString::number(m_stageModel->columnCount()));
+    for (const auto& label : m_stageModel->cellLabels()) {
+        columnWidth = std::max(columnWidth, view->fontMetrics().horizontalAdvance(label));
+    }
+    const int margin = view->style()->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, view) + 1;
+    view->horizontalHeader()->setMinimumSectionSize(0);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->horizontalHeader()->setDefaultSectionSize(columnWidth + 4 * margin);
 }
 
 PipelineDiagramWidget::~PipelineDiagramWidget() {
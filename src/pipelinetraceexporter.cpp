@@ -0,0 +1,222 @@
+#include "pipelinetraceexporter.h"
+
+#include <array>
+
+#include "processorhandler.h"
+#include "radix.h"
+
+namespace Ripes {
+
+namespace {
+
+uint32_t crc32(const QByteArray& data) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (const char c : data) {
+        crc = table[(crc ^ static_cast<uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void appendLE32(QByteArray& data, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        data.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+}  // namespace
+
+PipelineTraceExporter::PipelineTraceExporter(QObject* parent) : QObject(parent) {
+    // The processor is clocked in the simulator thread while running, wherein the trace is gathered directly.
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+            &PipelineTraceExporter::processorWasClocked, Qt::DirectConnection);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this, &PipelineTraceExporter::stop);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReversed, this, &PipelineTraceExporter::stop);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorChanged, this, &PipelineTraceExporter::stop);
+}
+
+PipelineTraceExporter::~PipelineTraceExporter() {
+    blockSignals(true);
+    stop();
+}
+
+bool PipelineTraceExporter::start(const QString& filename) {
+    stop();
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    m_compress = filename.endsWith(".gz", Qt::CaseInsensitive);
+
+    // Stages which share a name form a single pipeline stage.
+    const auto* proc = ProcessorHandler::getProcessor();
+    m_stageGroups.clear();
+    m_groupNames.clear();
+    for (unsigned i = 0; i < proc->stageCount(); ++i) {
+        const QByteArray name = proc->stageName(i).toUtf8();
+        if (m_groupNames.empty() || m_groupNames.back() != name) {
+            m_groupNames.push_back(name);
+        }
+        m_stageGroups.push_back(m_groupNames.size() - 1);
+    }
+    m_occupants.assign(proc->stageCount(), Occupant());
+    m_instrLabels.clear();
+    m_nextId = 0;
+    m_nextRetireId = 0;
+    m_cycle = proc->getCycleCount();
+
+    write("Kanata\t0004\n");
+    write("C=\t" + QByteArray::number(m_cycle) + "\n");
+    gatherStages();
+    return true;
+}
+
+void PipelineTraceExporter::stop() {
+    if (!isExporting()) {
+        return;
+    }
+    for (const auto& occupant : m_occupants) {
+        if (occupant.id != s_noInstr) {
+            retire(occupant, true);
+        }
+    }
+    m_occupants.clear();
+    flushBuffer();
+    m_file.close();
+    emit stopped();
+}
+
+void PipelineTraceExporter::processorWasClocked() {
+    if (!isExporting()) {
+        return;
+    }
+    const long long cycle = ProcessorHandler::getProcessor()->getCycleCount();
+    if (cycle > m_cycle) {
+        write("C\t" + QByteArray::number(cycle - m_cycle) + "\n");
+        m_cycle = cycle;
+    }
+    gatherStages();
+}
+
+void PipelineTraceExporter::gatherStages() {
+    const auto* proc = ProcessorHandler::getProcessor();
+    const int stages = m_occupants.size();
+    std::vector<Occupant> occupants(stages);
+    std::vector<bool> claimed(stages, false);
+    const auto isPrevious = [&](int stage, AInt pc) {
+        return !claimed[stage] && m_occupants[stage].id != s_noInstr && m_occupants[stage].pc == pc;
+    };
+
+    // Stages are visited from last to first, such that each instruction is claimed by the furthest stage which it may
+    // have advanced into.
+    for (int stage = stages - 1; stage >= 0; --stage) {
+        const StageInfo info = proc->stageInfo(stage);
+        if (!info.stage_valid || info.state != StageInfo::State::None) {
+            continue;
+        }
+        const unsigned group = m_stageGroups[stage];
+
+        // An instruction either advanced from the nearest preceding pipeline stage, or remained in the stage.
+        int from = -1;
+        for (int prev = stage - 1; prev >= 0 && from < 0; --prev) {
+            if (m_stageGroups[prev] < group && isPrevious(prev, info.pc)) {
+                from = prev;
+            }
+        }
+        if (from < 0 && isPrevious(stage, info.pc)) {
+            from = stage;
+        }
+
+        Occupant& occupant = occupants[stage];
+        if (from < 0) {
+            occupant.id = m_nextId++;
+            occupant.pc = info.pc;
+            const QByteArray id = QByteArray::number(static_cast<qulonglong>(occupant.id));
+            write("I\t" + id + "\t" + id + "\t0\n");
+            write("L\t" + id + "\t0\t" + instrLabel(info.pc) + "\n");
+            write("S\t" + id + "\t0\t" + m_groupNames[group] + "\n");
+            continue;
+        }
+
+        claimed[from] = true;
+        occupant = m_occupants[from];
+        const QByteArray id = QByteArray::number(static_cast<qulonglong>(occupant.id));
+        if (from == stage) {
+            if (!occupant.stalled) {
+                write("L\t" + id + "\t1\tStalled in " + m_groupNames[group] + " at cycle " +
+                      QByteArray::number(m_cycle) + "\n");
+            }
+            occupant.stalled = true;
+        } else {
+            occupant.stalled = false;
+            if (m_stageGroups[from] != group) {
+                write("S\t" + id + "\t0\t" + m_groupNames[group] + "\n");
+            }
+        }
+    }
+
+    // Instructions which were not claimed by any stage left the pipeline; retired from the final pipeline stage, or
+    // else flushed.
+    for (int stage = 0; stage < stages; ++stage) {
+        if (m_occupants[stage].id != s_noInstr && !claimed[stage]) {
+            retire(m_occupants[stage], m_stageGroups[stage] + 1 != m_groupNames.size());
+        }
+    }
+    m_occupants = std::move(occupants);
+}
+
+void PipelineTraceExporter::retire(const Occupant& occupant, bool flushed) {
+    const QByteArray id = QByteArray::number(static_cast<qulonglong>(occupant.id));
+    const QByteArray retireId = QByteArray::number(static_cast<qulonglong>(flushed ? 0 : m_nextRetireId++));
+    write("R\t" + id + "\t" + retireId + (flushed ? "\t1\n" : "\t0\n"));
+}
+
+const QByteArray& PipelineTraceExporter::instrLabel(AInt pc) {
+    auto it = m_instrLabels.find(pc);
+    if (it == m_instrLabels.end()) {
+        const QString label = encodeRadixValue(pc, Radix::Hex, ProcessorHandler::currentISA()->bytes()) + ": " +
+                              ProcessorHandler::disassembleInstr(pc);
+        it = m_instrLabels.emplace(pc, label.toUtf8()).first;
+    }
+    return it->second;
+}
+
+void PipelineTraceExporter::write(const QByteArray& line) {
+    m_buffer.append(line);
+    if (m_buffer.size() >= s_bufferBytes) {
+        flushBuffer();
+    }
+}
+
+void PipelineTraceExporter::flushBuffer() {
+    if (m_buffer.isEmpty()) {
+        return;
+    }
+    m_file.write(m_compress ? gzipMember(m_buffer) : m_buffer);
+    m_buffer.clear();
+}
+
+QByteArray PipelineTraceExporter::gzipMember(const QByteArray& data) const {
+    // qCompress yields a 4-byte length prefix followed by a zlib stream; a 2-byte header, the deflate stream and a
+    // 4-byte Adler-32 trailer. The deflate stream is rewrapped as a gzip member, and a gzip file may consist of any
+    // number of concatenated members.
+    const QByteArray zlib = qCompress(data);
+    QByteArray member("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+    member.append(zlib.constData() + 6, zlib.size() - 10);
+    appendLE32(member, crc32(data));
+    appendLE32(member, static_cast<uint32_t>(data.size()));
+    return member;
+}
+
+}  // namespace Ripes
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "ripes_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The PipelineTraceExporter class
+ * Streams the execution of the current processor to a file in the Kanata log format of the Konata pipeline viewer.
+ * The trace is gathered from the stage information of the processor in each cycle, and hence applies to any processor.
+ * Each instruction is logged from the cycle in which it enters the first pipeline stage until it leaves the final
+ * pipeline stage (retired) or is squashed (flushed). Cycles wherein an instruction is stalled extend its current stage.
+ *
+ * Instructions are identified across cycles by their program counter. Stages which share a name (e.g. the two ways of
+ * a dual-issue processor) form a single pipeline stage, of which each stage is a separate lane.
+ *
+ * The trace is written as it is gathered, through a buffer of bounded size; no state is retained beyond the
+ * instructions currently in the pipeline. If the file name ends in ".gz", the trace is gzip compressed.
+ * Exporting stops when the processor is reset, reversed or changed, given that a streamed trace cannot be rewound.
+ */
+class PipelineTraceExporter : public QObject {
+    Q_OBJECT
+public:
+    PipelineTraceExporter(QObject* parent = nullptr);
+    ~PipelineTraceExporter() override;
+
+    /**
+     * @brief start
+     * Starts exporting the trace to @p filename, beginning at the current cycle of the processor.
+     * @returns false if the file could not be opened.
+     */
+    bool start(const QString& filename);
+
+    /**
+     * @brief stop
+     * Logs the instructions remaining in the pipeline as flushed, and closes the file.
+     */
+    void stop();
+
+    bool isExporting() const { return m_file.isOpen(); }
+
+signals:
+    void stopped();
+
+private slots:
+    void processorWasClocked();
+
+private:
+    static constexpr int s_bufferBytes = 1 << 20;
+    static constexpr uint64_t s_noInstr = ~static_cast<uint64_t>(0);
+
+    /**
+     * @brief The Occupant struct
+     * The instruction held in a stage of the pipeline.
+     */
+    struct Occupant {
+        uint64_t id = s_noInstr;
+        AInt pc = 0;
+        bool stalled = false;  // The instruction remained in the stage during the last cycle
+    };
+
+    void gatherStages();
+    void retire(const Occupant& occupant, bool flushed);
+    void write(const QByteArray& line);
+    void flushBuffer();
+    QByteArray gzipMember(const QByteArray& data) const;
+    const QByteArray& instrLabel(AInt pc);
+
+    QFile m_file;
+    QByteArray m_buffer;
+    bool m_compress = false;
+
+    /**
+     * @brief m_stageGroups/m_groupNames
+     * The pipeline stage which each stage of the processor belongs to, and the name of each pipeline stage.
+     */
+    std::vector<unsigned> m_stageGroups;
+    std::vector<QByteArray> m_groupNames;
+
+    std::vector<Occupant> m_occupants;
+    std::map<AInt, QByteArray> m_instrLabels;
+    uint64_t m_nextId = 0;
+    uint64_t m_nextRetireId = 0;
+    long long m_cycle = 0;
+};
+
+}  // namespace Ripes
@@ -1,6 +1,7 @@
 #include "processorhandler.h"
 
 #include "processorregistry.h"
+#include "processors/RISC-V/rvooo/rvooo_config.h"
 #include "processors/ripesvsrtlprocessor.h"
 #include "ripessettings.h"
 #include "statusmanager.h"
@@ -16,6 +17,20 @@
 
 namespace Ripes {
 
+static OoOConfig oooConfigFromSettings() {
+    OoOConfig config;
+    config.issueWidth = RipesSettings::value(RIPES_SETTING_OOO_ISSUEWIDTH).toUInt();
+    config.robEntries = RipesSettings::value(RIPES_SETTING_OOO_ROBENTRIES).toUInt();
+    config.rsEntries = RipesSettings::value(RIPES_SETTING_OOO_RSENTRIES).toUInt();
+    config.lsqEntries = RipesSettings::value(RIPES_SETTING_OOO_LSQENTRIES).toUInt();
+    config.aluLatency = RipesSettings::value(RIPES_SETTING_OOO_ALULATENCY).toUInt();
+    config.mulLatency = RipesSettings::value(RIPES_SETTING_OOO_MULLATENCY).toUInt();
+    config.divLatency = RipesSettings::value(RIPES_SETTING_OOO_DIVLATENCY).toUInt();
+    config.loadLatency = RipesSettings::value(RIPES_SETTING_OOO_LOADLATENCY).toUInt();
+    config.fusion = RipesSettings::value(RIPES_SETTING_OOO_FUSION).toBool();
+    return config.sanitized();
+}
+
 ProcessorHandler::ProcessorHandler() {
     m_constructing = true;
 
@@ -120,13 +135,35 @@ void ProcessorHandler::_loadProgram(const std::shared_ptr<Program>& p) {
 }
 
 void ProcessorHandler::_writeMem(AInt address, VInt value, int size) {
-    m_currentProcessor->getMemory().writeMem(address, value, size);
+    m_currentProcessor->writeMemory(address, value, size);
 }
 
 vsrtl::core::AddressSpaceMM& ProcessorHandler::_getMemory() {
     return m_currentProcessor->getMemory();
 }
 
+void ProcessorHandler::_addIORegion(AInt start, unsigned size, const vsrtl::core::IOFunctors& io) {
+    m_currentProcessor->getMemory().addIORegion(start, size, io);
+    std::lock_guard<std::mutex> lock(m_ioRegionsLock);
+    m_ioRegions[start] = size;
+}
+
+void ProcessorHandler::_removeIORegion(AInt start, unsigned size) {
+    m_currentProcessor->getMemory().removeIORegion(start, size);
+    std::lock_guard<std::mutex> lock(m_ioRegionsLock);
+    m_ioRegions.erase(start);
+}
+
+bool ProcessorHandler::_isIOAddress(AInt address) const {
+    std::lock_guard<std::mutex> lock(m_ioRegionsLock);
+    auto it = m_ioRegions.upper_bound(address);
+    if (it == m_ioRegions.begin()) {
+        return false;
+    }
+    --it;
+    return address - it->first < it->second;
+}
+
 void ProcessorHandler::_triggerProcStateChangeTimer() {
     m_enqueueStateChangeLock.lock();
     if (!m_procStateChangeTimer.isActive()) {
@@ -264,9 +301,16 @@ void ProcessorHandler::_selectProcessor(const ProcessorID& id, const QStringList
         m_currentProcessor && (m_currentProcessor->implementsISA()->eq(
                                   ProcessorRegistry::getDescription(id).isaInfo().isa.get(), extensions));
 
-    // Processor initializations
+    // Processor initializations. Configurable processors are constructed with the configuration stored in the settings.
+    OoOConfig::current() = oooConfigFromSettings();
     m_currentProcessor = ProcessorRegistry::constructProcessor(m_currentID, extensions);
     m_currentProcessor->isExecutableAddress = [=](AInt address) { return _isExecutableAddress(address); };
+    m_currentProcessor->isIOAddress = [=](AInt address) { return _isIOAddress(address); };
+    {
+        // I/O regions are mapped into the memory of the new processor as it is announced
+        std::lock_guard<std::mutex> lock(m_ioRegionsLock);
+        m_ioRegions.clear();
+    }
 
     // Syscall handling initialization
     m_currentProcessor->trapHandler = [=] { syscallTrap(); };
@@ -3,7 +3,9 @@
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QObject>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "VSRTL/graphics/gallantsignalwrapper.h"
 #include "assembler/assembler.h"
@@ -108,6 +110,27 @@ public:
      */
     static vsrtl::core::AddressSpaceMM& getMemory() { return get()->_getMemory(); }
 
+    /**
+     * @brief addIORegion
+     * Maps the memory-mapped I/O region of @p size bytes from @p start onto @p io in the memory of the current
+     * processor.
+     */
+    static void addIORegion(AInt start, unsigned size, const vsrtl::core::IOFunctors& io) {
+        get()->_addIORegion(start, size, io);
+    }
+
+    /**
+     * @brief removeIORegion
+     * Removes the memory-mapped I/O region of @p size bytes from @p start from the memory of the current processor.
+     */
+    static void removeIORegion(AInt start, unsigned size) { get()->_removeIORegion(start, size); }
+
+    /**
+     * @brief isIOAddress
+     * @returns whether @param address is within a memory-mapped I/O region. May be called from the simulator thread.
+     */
+    static bool isIOAddress(AInt address) { return get()->_isIOAddress(address); }
+
     /**
      * @brief setRegisterValue
      * Set the value of register @param idx to @param value.
@@ -239,6 +262,9 @@ private:
     AInt _getTextStart() const;
     QString _disassembleInstr(const AInt address) const;
     vsrtl::core::AddressSpaceMM& _getMemory();
+    void _addIORegion(AInt start, unsigned size, const vsrtl::core::IOFunctors& io);
+    void _removeIORegion(AInt start, unsigned size);
+    bool _isIOAddress(AInt address) const;
     const vsrtl::core::AddressSpace& _getRegisters() const;
     void _setRegisterValue(RegisterFileType rfid, const unsigned idx, VInt value);
     void _writeMem(AInt address, VInt value, int size = sizeof(VInt));
@@ -276,6 +302,14 @@ private:
     vsrtl::VSRTLWidget* m_vsrtlWidget = nullptr;
 
     std::set<AInt> m_breakpoints;
+
+    /**
+     * @brief m_ioRegions
+     * Sizes of the memory-mapped I/O regions of the current processor, keyed by their start addresses. Guarded by
+     * m_ioRegionsLock, given that the regions are queried by the processor in the simulator thread.
+     */
+    std::map<AInt, unsigned> m_ioRegions;
+    mutable std::mutex m_ioRegionsLock;
     std::shared_ptr<Program> m_program;
 
     QFutureWatcher<void> m_runWatcher;
@@ -7,6 +7,7 @@
 #include "processors/RISC-V/rv5s_no_fw_hz/rv5s_no_fw_hz.h"
 #include "processors/RISC-V/rv5s_no_hz/rv5s_no_hz.h"
 #include "processors/RISC-V/rv6s_dual/rv6s_dual.h"
+#include "processors/RISC-V/rvooo/rvooo.h"
 #include "processors/RISC-V/rvss/rvss.h"
 
 namespace Ripes {
@@ -102,5 +103,18 @@ ProcessorRegistry::ProcessorRegistry() {
         "A 6-stage dual-issue in-order processor. Each way may execute arithmetic instructions, whereas way 1 "
         "is reserved for controlflow and ecall instructions, and way 2 for memory accessing instructions.",
         layouts, defRegVals));
+
+    // RISC-V out-of-order. The processor is modelled at the level of instructions, and has no datapath layout.
+    layouts = {};
+    defRegVals = {{2, 0x7ffffff0}, {3, 0x10000000}};
+    const QString oooDescription =
+        "An out-of-order processor with a reorder buffer, a unified reservation station and a load/store queue. "
+        "Instructions are fetched, dispatched, issued and committed in groups of up to the issue width, and execute "
+        "on pipelined ALUs, a pipelined multiplier, an unpipelined divider and a load/store unit. The processor has "
+        "no datapath view; its stages are shown in the pipeline diagram.";
+    addProcessor(ProcInfo<vsrtl::core::RVOOO<uint32_t>>(ProcessorID::RV32_OOO, "Out-of-order processor",
+                                                        oooDescription, layouts, defRegVals));
+    addProcessor(ProcInfo<vsrtl::core::RVOOO<uint64_t>>(ProcessorID::RV64_OOO, "Out-of-order processor",
+                                                        oooDescription, layouts, defRegVals));
 }
 }  // namespace Ripes
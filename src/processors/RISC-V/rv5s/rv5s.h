@@ -44,6 +44,7 @@ public:
     enum Stage { IF = 0, ID = 1, EX = 2, MEM = 3, WB = 4, STAGECOUNT };
     RV5S(const QStringList& extensions) : RipesVSRTLProcessor("5-Stage RISC-V Processor") {
         m_enabledISA = std::make_shared<ISAInfo<XLenToRVISA<XLEN>()>>(extensions);
+        m_features |= Features::hasMemoryStalls;
         decode->setISA(m_enabledISA);
         uncompress->setISA(m_enabledISA);
 
@@ -272,6 +273,17 @@ public:
         memwb_reg->reg_do_write_out >> hzunit->wb_do_reg_write;
 
         idex_reg->opcode_out >> hzunit->opcode;
+
+        // -----------------------------------------------------------------------
+        // Performance counters
+        m_loadUseStalls = registerPerfCounter(
+            "Load-use stalls", "Cycles stalled for an instruction in ID which uses the result of a load in EX", 1);
+        m_ecallStalls = registerPerfCounter(
+            "Ecall stalls", "Cycles stalled for outstanding register writes to drain before executing an ecall", 1);
+        m_controlflowFlushes = registerPerfCounter(
+            "Control flow flushes", "Taken branches and jumps, flushing the instructions in IF and ID", 2);
+        m_memForwards = registerPerfCounter("Operands forwarded from MEM", "Operands forwarded from MEM to EX");
+        m_wbForwards = registerPerfCounter("Operands forwarded from WB", "Operands forwarded from WB to EX");
     }
 
     // Design subcomponents
@@ -423,6 +435,16 @@ public:
             }
         }
 
+        if (isMemoryStalled()) {
+            // The pipeline is frozen whilst waiting for memory. The instruction in the WB stage has already been
+            // written back, leaving a bubble in the WB stage.
+            if (stage == WB) {
+                stageValid = false;
+            } else {
+                state = StageInfo::State::Stalled;
+            }
+        }
+
         return StageInfo({getPcForStage(stage), stageValid, state});
     }
 
@@ -443,13 +465,41 @@ public:
     }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {IF}; }
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        if (isMemoryStalled()) {
+            return MemoryAccess();
+        }
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(MEM);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
+        if (isMemoryStalled()) {
+            return MemoryAccess();
+        }
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(IF);
         return instrAccess;
     }
 
+    ControlFlow controlFlow() const override {
+        // Control flow is resolved in the EX stage
+        ControlFlow cf;
+        if (isMemoryStalled() || !idex_reg->valid_out.uValue() || !isExecutableAddress(idex_reg->pc_out.uValue())) {
+            return cf;
+        }
+        cf.kind = Control::do_controlflow_kind(idex_reg->opcode_out.uValue(), idex_reg->wr_reg_idx_out.uValue(),
+                                               idex_reg->rd_reg1_idx_out.uValue());
+        cf.pc = idex_reg->pc_out.uValue();
+        cf.fallthrough = idex_reg->pc4_out.uValue();
+        cf.target = alu->res.uValue();
+        cf.taken = controlflow_or->out.uValue();
+        return cf;
+    }
+    // Taken control flow flushes the instructions in IF and ID
+    unsigned controlFlowPenalty() const override { return 2; }
+
     bool finished() const override {
         // The processor is finished when there are no more valid instructions in the pipeline
         bool allStagesInvalid = true;
@@ -466,11 +516,16 @@ public:
     }
 
     void clockProcessor() override {
+        if (clockMemoryStall()) {
+            return;
+        }
+
         // An instruction has been retired if the instruction in the WB stage is valid and the PC is within the
         // executable range of the program
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired++;
         }
+        countPerfEvents(1);
 
         Design::clock();
     }
@@ -486,6 +541,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired--;
         }
+        countPerfEvents(-1);
     }
 
     void reset() override {
@@ -510,6 +566,33 @@ public:
     }
 
 private:
+    /**
+     * @brief countPerfEvents
+     * Counts the events of the current cycle, prior to clocking the design. @p sign is -1 when the cycle is reversed.
+     */
+    void countPerfEvents(int sign) {
+        const auto count = [=](unsigned counter, bool event) {
+            if (event) {
+                countPerfEvent(counter, sign);
+            }
+        };
+        count(m_loadUseStalls, hzunit->hazardIDEXClear.uValue());
+        count(m_ecallStalls, hzunit->stallEcallHandling.uValue());
+        count(m_controlflowFlushes, controlflow_or->out.uValue());
+
+        if (idex_reg->valid_out.uValue()) {
+            const auto opcode = idex_reg->opcode_out.uValue();
+            const auto reg1Src = funit->alu_reg1_forwarding_ctrl.uValue();
+            const auto reg2Src = funit->alu_reg2_forwarding_ctrl.uValue();
+            const bool reads1 = Control::do_reads_reg1(opcode);
+            const bool reads2 = Control::do_reads_reg2(opcode);
+            count(m_memForwards, reads1 && reg1Src == ForwardingSrc::MemStage);
+            count(m_memForwards, reads2 && reg2Src == ForwardingSrc::MemStage);
+            count(m_wbForwards, reads1 && reg1Src == ForwardingSrc::WbStage);
+            count(m_wbForwards, reads2 && reg2Src == ForwardingSrc::WbStage);
+        }
+    }
+
     /**
      * @brief m_syscallExitCycle
      * The variable will contain the cycle of which an exit system call was executed. From this, we may determine
@@ -517,6 +600,9 @@ private:
      */
     long long m_syscallExitCycle = -1;
     std::shared_ptr<ISAInfoBase> m_enabledISA;
+
+    // Performance counter indices
+    unsigned m_loadUseStalls, m_ecallStalls, m_controlflowFlushes, m_memForwards, m_wbForwards;
 };
 
 }  // namespace core
@@ -251,6 +251,15 @@ public:
         exmem_reg->wr_reg_idx_out >> hzunit->mem_reg_wr_idx;
 
         memwb_reg->reg_do_write_out >> hzunit->wb_do_reg_write;
+
+        // -----------------------------------------------------------------------
+        // Performance counters
+        m_dataHazardStalls = registerPerfCounter(
+            "Data hazard stalls", "Cycles stalled for an instruction in ID which depends on one in EX or MEM", 1);
+        m_ecallStalls = registerPerfCounter(
+            "Ecall stalls", "Cycles stalled for outstanding register writes to drain before executing an ecall", 1);
+        m_controlflowFlushes = registerPerfCounter(
+            "Control flow flushes", "Taken branches and jumps, flushing the instructions in IF and ID", 2);
     }
 
     // Design subcomponents
@@ -419,10 +428,15 @@ public:
     }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {IF}; }
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(MEM);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(IF);
         return instrAccess;
     }
 
@@ -447,6 +461,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired++;
         }
+        countPerfEvents(1);
 
         Design::clock();
     }
@@ -462,6 +477,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired--;
         }
+        countPerfEvents(-1);
     }
 
     void reset() override {
@@ -486,6 +502,21 @@ public:
     }
 
 private:
+    /**
+     * @brief countPerfEvents
+     * Counts the events of the current cycle, prior to clocking the design. @p sign is -1 when the cycle is reversed.
+     */
+    void countPerfEvents(int sign) {
+        const auto count = [=](unsigned counter, bool event) {
+            if (event) {
+                countPerfEvent(counter, sign);
+            }
+        };
+        count(m_dataHazardStalls, hzunit->hazardIDEXClear.uValue());
+        count(m_ecallStalls, hzunit->stallEcallHandling.uValue());
+        count(m_controlflowFlushes, controlflow_or->out.uValue());
+    }
+
     /**
      * @brief m_syscallExitCycle
      * The variable will contain the cycle of which an exit system call was executed. From this, we may determine
@@ -493,6 +524,9 @@ private:
      */
     long long m_syscallExitCycle = -1;
     std::shared_ptr<ISAInfoBase> m_enabledISA;
+
+    // Performance counter indices
+    unsigned m_dataHazardStalls, m_ecallStalls, m_controlflowFlushes;
 };
 
 }  // namespace core
@@ -215,6 +215,11 @@ public:
         exmem_reg->reg_do_write_out >> memwb_reg->reg_do_write_in;
 
         exmem_reg->valid_out >> memwb_reg->valid_in;
+
+        // -----------------------------------------------------------------------
+        // Performance counters
+        m_controlflowFlushes = registerPerfCounter(
+            "Control flow flushes", "Taken branches and jumps, flushing the instructions in IF and ID", 2);
     }
 
     // Design subcomponents
@@ -370,10 +375,15 @@ public:
     }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {IF}; };
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(MEM);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(IF);
         return instrAccess;
     }
 
@@ -397,6 +407,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired++;
         }
+        countPerfEvents(1);
 
         Design::clock();
     }
@@ -412,6 +423,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired--;
         }
+        countPerfEvents(-1);
     }
 
     void reset() override {
@@ -436,6 +448,16 @@ public:
     }
 
 private:
+    /**
+     * @brief countPerfEvents
+     * Counts the events of the current cycle, prior to clocking the design. @p sign is -1 when the cycle is reversed.
+     */
+    void countPerfEvents(int sign) {
+        if (controlflow_or->out.uValue()) {
+            countPerfEvent(m_controlflowFlushes, sign);
+        }
+    }
+
     /**
      * @brief m_syscallExitCycle
      * The variable will contain the cycle of which an exit system call was executed. From this, we may determine when
@@ -443,6 +465,9 @@ private:
      */
     long long m_syscallExitCycle = -1;
     std::shared_ptr<ISAInfoBase> m_enabledISA;
+
+    // Performance counter indices
+    unsigned m_controlflowFlushes;
 };
 
 }  // namespace core
@@ -243,6 +243,13 @@ public:
 
         memwb_reg->wr_reg_idx_out >> funit->wb_reg_wr_idx;
         memwb_reg->reg_do_write_out >> funit->wb_reg_wr_en;
+
+        // -----------------------------------------------------------------------
+        // Performance counters
+        m_controlflowFlushes = registerPerfCounter(
+            "Control flow flushes", "Taken branches and jumps, flushing the instructions in IF and ID", 2);
+        m_memForwards = registerPerfCounter("Operands forwarded from MEM", "Operands forwarded from MEM to EX");
+        m_wbForwards = registerPerfCounter("Operands forwarded from WB", "Operands forwarded from WB to EX");
     }
 
     // Design subcomponents
@@ -403,10 +410,15 @@ public:
     }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {IF}; };
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(MEM);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(IF);
         return instrAccess;
     }
 
@@ -430,6 +442,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired++;
         }
+        countPerfEvents(1);
 
         Design::clock();
     }
@@ -445,6 +458,7 @@ public:
         if (memwb_reg->valid_out.uValue() != 0 && isExecutableAddress(memwb_reg->pc_out.uValue())) {
             m_instructionsRetired--;
         }
+        countPerfEvents(-1);
     }
 
     void reset() override {
@@ -469,6 +483,31 @@ public:
     }
 
 private:
+    /**
+     * @brief countPerfEvents
+     * Counts the events of the current cycle, prior to clocking the design. @p sign is -1 when the cycle is reversed.
+     */
+    void countPerfEvents(int sign) {
+        const auto count = [=](unsigned counter, bool event) {
+            if (event) {
+                countPerfEvent(counter, sign);
+            }
+        };
+        count(m_controlflowFlushes, controlflow_or->out.uValue());
+
+        if (idex_reg->valid_out.uValue()) {
+            const auto opcode = idex_reg->opcode_out.uValue();
+            const auto reg1Src = funit->alu_reg1_forwarding_ctrl.uValue();
+            const auto reg2Src = funit->alu_reg2_forwarding_ctrl.uValue();
+            const bool reads1 = Control::do_reads_reg1(opcode);
+            const bool reads2 = Control::do_reads_reg2(opcode);
+            count(m_memForwards, reads1 && reg1Src == ForwardingSrc::MemStage);
+            count(m_memForwards, reads2 && reg2Src == ForwardingSrc::MemStage);
+            count(m_wbForwards, reads1 && reg1Src == ForwardingSrc::WbStage);
+            count(m_wbForwards, reads2 && reg2Src == ForwardingSrc::WbStage);
+        }
+    }
+
     /**
      * @brief m_syscallExitCycle
      * The variable will contain the cycle of which an exit system call was executed. From this, we may determine when
@@ -476,6 +515,9 @@ private:
      */
     long long m_syscallExitCycle = -1;
     std::shared_ptr<ISAInfoBase> m_enabledISA;
+
+    // Performance counter indices
+    unsigned m_controlflowFlushes, m_memForwards, m_wbForwards;
 };
 
 }  // namespace core
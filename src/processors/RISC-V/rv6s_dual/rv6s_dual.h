@@ -63,6 +63,7 @@ public:
     };
     RV6S_DUAL(const QStringList& extensions) : RipesVSRTLProcessor("6-Stage dual-issue RISC-V Processor") {
         m_enabledISA = std::make_shared<ISAInfo<XLenToRVISA<XLEN>()>>(extensions);
+        m_features |= Features::hasMemoryStalls;
         decode_way2->setISA(m_enabledISA);
         decode_way1->setISA(m_enabledISA);
         uncompress_dual->setISA(m_enabledISA);
@@ -511,6 +512,39 @@ public:
         memwb_reg->reg_do_write_data_out >> hzunit->wb_do_reg_write_data;
 
         iiex_reg->opcode_out >> hzunit->opcode;
+
+        // -----------------------------------------------------------------------
+        // Performance counters
+        m_loadUseStalls = registerPerfCounter(
+            "Load-use stalls", "Cycles stalled for an instruction in II which uses the result of a load in EX", 1);
+        m_ecallStalls = registerPerfCounter(
+            "Ecall stalls", "Cycles stalled for outstanding register writes to drain before executing an ecall", 1);
+        m_controlflowFlushes = registerPerfCounter(
+            "Control flow flushes", "Taken branches and jumps, flushing the instructions in IF, ID and II", 3);
+        m_pairingFailures[WayControl::PairingFailure::Controlflow] = registerPerfCounter(
+            "Pairing failures: control flow", "Fetched pairs split as the first instruction is a branch or jump", 1);
+        m_pairingFailures[WayControl::PairingFailure::Structural] = registerPerfCounter(
+            "Pairing failures: structural",
+            "Fetched pairs split as both instructions require the data way, or both are branches or jumps", 1);
+        m_pairingFailures[WayControl::PairingFailure::Ecall] =
+            registerPerfCounter("Pairing failures: ecall", "Fetched pairs split as either instruction is an ecall", 1);
+        m_pairingFailures[WayControl::PairingFailure::DataDependency] = registerPerfCounter(
+            "Pairing failures: data dependency",
+            "Fetched pairs split as one instruction uses the result of the other, other than the idioms below", 1);
+        // Dependent pairs forming a common idiom are split as any other dependent pair, but are counted separately
+        for (const auto idiom : {RVIdiom::LuiAddi, RVIdiom::AuipcJalr, RVIdiom::SlliAdd, RVIdiom::CompareBranch}) {
+            m_splitIdioms[idiom] = registerPerfCounter(
+                "Pairing failures: " + idiomName(idiom),
+                "Fetched " + idiomName(idiom) + " pairs split as the 2nd instruction uses the result of the 1st", 1);
+        }
+        m_forwards[ForwardingSrcDual::MemStageExec] =
+            registerPerfCounter("Operands forwarded from MEM (exec)", "Operands forwarded from the MEM exec way to EX");
+        m_forwards[ForwardingSrcDual::MemStageMem] =
+            registerPerfCounter("Operands forwarded from MEM (data)", "Operands forwarded from the MEM data way to EX");
+        m_forwards[ForwardingSrcDual::WbStageExec] =
+            registerPerfCounter("Operands forwarded from WB (exec)", "Operands forwarded from the WB exec way to EX");
+        m_forwards[ForwardingSrcDual::WbStageMem] =
+            registerPerfCounter("Operands forwarded from WB (data)", "Operands forwarded from the WB data way to EX");
     }
 
     // Design subcomponents
@@ -606,6 +640,7 @@ public:
 
     // Ripes interface compliance
     unsigned int stageCount() const override { return STAGECOUNT; }
+    unsigned issueWidth() const override { return 2; }
     unsigned int getPcForStage(unsigned int idx) const override {
         // clang-format off
         switch (idx) {
@@ -752,6 +787,16 @@ public:
             }
         }
 
+        if (isMemoryStalled()) {
+            // The pipeline is frozen whilst waiting for memory. The instructions in the WB stages have already been
+            // written back, leaving bubbles in the WB stages.
+            if (stage == WB_EXEC || stage == WB_DATA) {
+                stageValid = false;
+            } else {
+                state = StageInfo::State::Stalled;
+            }
+        }
+
         return StageInfo({getPcForStage(stage), stageValid, state});
     }
 
@@ -772,13 +817,42 @@ public:
     }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {IF_1, IF_2}; };
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        if (isMemoryStalled()) {
+            return MemoryAccess();
+        }
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(MEM_DATA);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
+        if (isMemoryStalled()) {
+            return MemoryAccess();
+        }
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(IF_1);
         return instrAccess;
     }
 
+    ControlFlow controlFlow() const override {
+        // Control flow is resolved by the exec way of the EX stage
+        ControlFlow cf;
+        if (isMemoryStalled() || !iiex_reg->valid_out.uValue() || !iiex_reg->exec_valid_out.uValue() ||
+            !isExecutableAddress(iiex_reg->pc_out.uValue())) {
+            return cf;
+        }
+        cf.kind = Control::do_controlflow_kind(iiex_reg->opcode_out.uValue(), iiex_reg->wr_reg_idx_out.uValue(),
+                                               iiex_reg->rd_reg1_idx_out.uValue());
+        cf.pc = iiex_reg->pc_out.uValue();
+        cf.fallthrough = pc_4_link->out.uValue();
+        cf.target = alu->res.uValue();
+        cf.taken = branch->did_controlflow.uValue();
+        return cf;
+    }
+    // Taken control flow flushes the instructions in IF, ID and II
+    unsigned controlFlowPenalty() const override { return 3; }
+
     bool finished() const override {
         // The processor is finished when there are no more valid instructions in the pipeline
         bool allStagesInvalid = true;
@@ -810,9 +884,14 @@ public:
     }
 
     void clockProcessor() override {
+        if (clockMemoryStall()) {
+            return;
+        }
+
         // An instruction has been retired if the instruction in the WB stage is valid and the PC is within the
         // executable range of the program
         m_instructionsRetired += instructionsRetired();
+        countPerfEvents(1);
 
         Design::clock();
     }
@@ -826,6 +905,7 @@ public:
         }
         Design::reverse();
         m_instructionsRetired -= instructionsRetired();
+        countPerfEvents(-1);
     }
 
     void reset() override {
@@ -850,6 +930,51 @@ public:
     }
 
 private:
+    /**
+     * @brief countPerfEvents
+     * Counts the events of the current cycle, prior to clocking the design. @p sign is -1 when the cycle is reversed.
+     */
+    void countPerfEvents(int sign) {
+        const auto count = [=](unsigned counter, bool event) {
+            if (event) {
+                countPerfEvent(counter, sign);
+            }
+        };
+        const bool controlflow = branch->did_controlflow.uValue();
+        // A load-use hazard on an instruction which is flushed does not stall the pipeline
+        count(m_loadUseStalls, hzunit->hazardIDEXClear.uValue() && !controlflow);
+        count(m_ecallStalls, hzunit->stallEcallHandling.uValue());
+        count(m_controlflowFlushes, controlflow);
+
+        // Pairs which are flushed, or held in ID by a stall, are not issued in this cycle
+        const auto pairingFailure = waycontrol->pairingFailure();
+        if (pairingFailure != WayControl::PairingFailure::None && hzunit->hazardFEEnable.uValue() && !controlflow) {
+            const auto splitIdiom = waycontrol->splitIdiom();
+            countPerfEvent(splitIdiom != RVIdiom::None ? m_splitIdioms.at(splitIdiom)
+                                                       : m_pairingFailures.at(pairingFailure),
+                           sign);
+        }
+
+        if (iiex_reg->valid_out.uValue()) {
+            const auto countForward = [&](VSRTL_VT_U src, bool reads) {
+                if (reads && src != ForwardingSrcDual::IdStage) {
+                    countPerfEvent(m_forwards.at(src), sign);
+                }
+            };
+            if (iiex_reg->exec_valid_out.uValue()) {
+                const auto opcode = iiex_reg->opcode_out.uValue();
+                countForward(funit->alu_reg1_fw_ctrl_exec.uValue(), Control::do_reads_reg1(opcode));
+                countForward(funit->alu_reg2_fw_ctrl_exec.uValue(), Control::do_reads_reg2(opcode));
+            }
+            if (iiex_reg->data_valid_out.uValue()) {
+                const bool reads2 =
+                    iiex_reg->alu_op2_ctrl_data_out.uValue() == AluSrc2::REG2 || iiex_reg->mem_do_write_out.uValue();
+                countForward(funit->alu_reg1_fw_ctrl_data.uValue(), true);
+                countForward(funit->alu_reg2_fw_ctrl_data.uValue(), reads2);
+            }
+        }
+    }
+
     /**
      * @brief m_syscallExitCycle
      * The variable will contain the cycle of which an exit system call was executed. From this, we may determine
@@ -857,6 +982,12 @@ private:
      */
     long long m_syscallExitCycle = -1;
     std::shared_ptr<ISAInfoBase> m_enabledISA;
+
+    // Performance counter indices
+    unsigned m_loadUseStalls, m_ecallStalls, m_controlflowFlushes;
+    std::map<WayControl::PairingFailure, unsigned> m_pairingFailures;
+    std::map<RVIdiom, unsigned> m_splitIdioms;
+    std::map<VSRTL_VT_U, unsigned> m_forwards;  // Forwarding source : counter
 };
 
 }  // namespace core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../rv_control.h"
+#include "../rv_idioms.h"
 #include "VSRTL/core/vsrtl_component.h"
 #include "rv6s_dual_common.h"
 
@@ -9,6 +10,13 @@ namespace core {
 using namespace Ripes;
 
 class WayControl : public Component {
+public:
+    /**
+     * @brief The PairingFailure enum
+     * The reason for which the two fetched instructions could not be issued together.
+     */
+    enum class PairingFailure { None, Controlflow, Structural, Ecall, DataDependency };
+
 private:
     enum class WayClass { Data, Controlflow, Arithmetic, Ecall };
 
@@ -80,6 +88,16 @@ private:
         return hazard_1 || hazard_2;
     }
 
+    /**
+     * @brief pairIdiom
+     * @returns the idiom which the two fetched instructions form, if the 2nd fetched instruction consumes the result of
+     * the 1st.
+     */
+    RVIdiom pairIdiom() const {
+        return dependentIdiom(opcode_way1.uValue(), wr_reg_idx_way1.uValue(), opcode_way2.uValue(),
+                              wr_reg_idx_way2.uValue(), r1_reg_idx_way2.uValue(), r2_reg_idx_way2.uValue());
+    }
+
     WayClass instrType(const VSRTL_VT_U opcode) const {
         if (isLoadStore(opcode)) {
             return WayClass ::Data;
@@ -103,6 +121,7 @@ private:
             return;
 
         // Default assignments
+        m_splitIdiom = RVIdiom::None;
         const WayClass way1Type = instrType(opcode_way1.uValue());
         const WayClass way2Type = instrType(opcode_way2.uValue());
 
@@ -114,12 +133,14 @@ private:
             m_execWayValid = way2Type != WayClass::Data;
             m_execWaySrc = WaySrc::WAY2;
             m_stall = false;
+            m_pairingFailure = PairingFailure::None;
         } else if (way1Type == WayClass::Controlflow) {
             // Control flow hazard; only issue 1st fetched instruction
             m_dataWayValid = false;
             m_execWayValid = true;
             m_execWaySrc = WaySrc::WAY1;
             m_stall = true && ifid_valid.uValue();
+            m_pairingFailure = PairingFailure::Controlflow;
         } else if (structuralHazard(way1Type, way2Type) || way2Type == WayClass::Ecall || way1Type == WayClass::Ecall) {
             // Structural hazard or ecall; always issue way 1 instruction (execute in-order)
             m_dataWayValid = way1Type == WayClass::Data;
@@ -127,6 +148,8 @@ private:
             m_execWayValid = way1Type != WayClass::Data;
             m_execWaySrc = WaySrc::WAY1;
             m_stall = true && ifid_valid.uValue();
+            m_pairingFailure =
+                structuralHazard(way1Type, way2Type) ? PairingFailure::Structural : PairingFailure::Ecall;
         } else if (rawHazard()) {
             // WAR hazard; only issue 1st fetched instruction
             m_dataWayValid = way1Type == WayClass::Data;
@@ -134,6 +157,8 @@ private:
             m_dataWaySrc = WaySrc::WAY1;
             m_execWaySrc = WaySrc::WAY1;
             m_stall = true && ifid_valid.uValue();
+            m_pairingFailure = PairingFailure::DataDependency;
+            m_splitIdiom = pairIdiom();
         } else {
             // Can issue both
             m_dataWayValid = true;
@@ -154,6 +179,7 @@ private:
             }
 
             m_stall = false;
+            m_pairingFailure = PairingFailure::None;
             Q_ASSERT(m_dataWaySrc != m_execWaySrc);
         }
 
@@ -188,6 +214,25 @@ public:
         Q_ASSERT(m_design != nullptr);
     }
 
+    /**
+     * @brief pairingFailure
+     * @returns the reason for which only one of the fetched instructions is issued in the current cycle, if any.
+     */
+    PairingFailure pairingFailure() {
+        computeCycle();
+        return m_stall ? m_pairingFailure : PairingFailure::None;
+    }
+
+    /**
+     * @brief splitIdiom
+     * @returns the idiom formed by the fetched pair if it is split by a data dependency in the current cycle. The
+     * datapath does not fuse idioms; these are split as any other dependent pair.
+     */
+    RVIdiom splitIdiom() {
+        computeCycle();
+        return pairingFailure() == PairingFailure::DataDependency ? m_splitIdiom : RVIdiom::None;
+    }
+
     INPUTPORT(ifid_valid, 1);
 
     INPUTPORT_ENUM(opcode_way1, RVInstr);
@@ -222,6 +267,8 @@ private:
     WaySrc m_execWaySrc = WaySrc::WAY1;
     WaySrc m_dataWaySrc = WaySrc::WAY1;
     bool m_stall = false;
+    PairingFailure m_pairingFailure = PairingFailure::None;
+    RVIdiom m_splitIdiom = RVIdiom::None;
 };
 
 }  // namespace core
@@ -11,19 +11,27 @@ template <unsigned XLEN>
 class Branch : public Component {
 public:
     Branch(const std::string& name, SimComponent* parent) : Component(name, parent) {
+        res << [=] { return compare(comp_op.uValue(), op1.uValue(), op2.uValue()); };
+    }
+
+    /**
+     * @brief compare
+     * @returns the outcome of the comparison @p comp_op of the XLEN-bit operands @p op1 and @p op2.
+     */
+    static bool compare(const VSRTL_VT_U& comp_op, const VSRTL_VT_U& op1, const VSRTL_VT_U& op2) {
+        const VSRTL_VT_S sop1 = signextend<XLEN>(op1);
+        const VSRTL_VT_S sop2 = signextend<XLEN>(op2);
         // clang-format off
-        res << [=] {
-            switch(comp_op.uValue()){
-                case CompOp::NOP: return false;
-                case CompOp::EQ: return op1.uValue() == op2.uValue();
-                case CompOp::NE: return op1.uValue() != op2.uValue();
-                case CompOp::LT: return op1.sValue() < op2.sValue();
-                case CompOp::LTU: return op1.uValue() < op2.uValue();
-                case CompOp::GE: return op1.sValue() >= op2.sValue();
-                case CompOp::GEU: return op1.uValue() >= op2.uValue();
-                default: assert("Comparator: Unknown comparison operator"); return false;
-            }
-        };
+        switch(comp_op){
+            case CompOp::NOP: return false;
+            case CompOp::EQ: return op1 == op2;
+            case CompOp::NE: return op1 != op2;
+            case CompOp::LT: return sop1 < sop2;
+            case CompOp::LTU: return op1 < op2;
+            case CompOp::GE: return sop1 >= sop2;
+            case CompOp::GEU: return op1 >= op2;
+            default: assert("Comparator: Unknown comparison operator"); return false;
+        }
         // clang-format on
     }
 
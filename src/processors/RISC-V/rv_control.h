@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../interface/ripesprocessor.h"
 #include "VSRTL/core/vsrtl_component.h"
 #include "riscv.h"
 
@@ -236,6 +237,37 @@ public:
             default: return 0;
         }
     }
+
+    // Whether the first and second source register operands of an instruction are read by the instruction
+    static bool do_reads_reg1(const VSRTL_VT_U& opc) {
+        switch(opc) {
+            case RVInstr::NOP: case RVInstr::LUI: case RVInstr::AUIPC: case RVInstr::JAL: case RVInstr::ECALL:
+                return false;
+            default: return true;
+        }
+    }
+
+    static bool do_reads_reg2(const VSRTL_VT_U& opc) {
+        switch(opc) {
+            case RVInstr::NOP: case RVInstr::ECALL:
+                return false;
+            default:
+                return do_alu_op2_ctrl(opc) == +AluSrc2::REG2 || do_branch_ctrl(opc) || do_do_mem_write_ctrl(opc);
+        }
+    }
+
+    // Calls and returns are identified through the link registers of the calling convention, ra and t0
+    static ControlFlow::Kind do_controlflow_kind(const VSRTL_VT_U& opc, unsigned rd, unsigned rs1) {
+        const auto isLink = [](unsigned reg) { return reg == 1 || reg == 5; };
+        switch(opc) {
+            case RVInstr::JAL:
+                return isLink(rd) ? ControlFlow::Call : ControlFlow::Jump;
+            case RVInstr::JALR:
+                return isLink(rd) ? ControlFlow::Call : isLink(rs1) ? ControlFlow::Return : ControlFlow::IndirectJump;
+            default:
+                return do_branch_ctrl(opc) ? ControlFlow::Branch : ControlFlow::None;
+        }
+    }
     /* clang-format on */
 
 public:
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QString>
+
+#include "riscv.h"
+
+namespace Ripes {
+
+/**
+ * @brief The RVIdiom enum
+ * Dependent instruction pairs emitted by compilers for materializing constants (lui+addi), far jumps and calls
+ * (auipc+jalr), indexed address generation (slli+add) and conditional branches on a comparison (slt+beqz/bnez).
+ */
+enum class RVIdiom { None, LuiAddi, AuipcJalr, SlliAdd, CompareBranch };
+
+/**
+ * @brief dependentIdiom
+ * @returns the idiom formed by an instruction @p opcode1 writing register @p rd1, followed by an instruction
+ * @p opcode2 writing register @p rd2 and reading registers @p rs1_2 and @p rs2_2, if the 2nd instruction consumes the
+ * result of the 1st. Except for compare+branch, the 2nd instruction overwrites the result of the 1st, such that the
+ * pair writes a single register.
+ */
+inline RVIdiom dependentIdiom(const VSRTL_VT_U opcode1, unsigned rd1, const VSRTL_VT_U opcode2, unsigned rd2,
+                              unsigned rs1_2, unsigned rs2_2) {
+    if (rd1 == 0) {
+        return RVIdiom::None;
+    }
+    switch (opcode1) {
+        case RVInstr::LUI:
+            if ((opcode2 == RVInstr::ADDI || opcode2 == RVInstr::ADDIW) && rs1_2 == rd1 && rd2 == rd1) {
+                return RVIdiom::LuiAddi;
+            }
+            break;
+        case RVInstr::AUIPC:
+            if (opcode2 == RVInstr::JALR && rs1_2 == rd1) {
+                return RVIdiom::AuipcJalr;
+            }
+            break;
+        case RVInstr::SLLI:
+            if (opcode2 == RVInstr::ADD && (rs1_2 == rd1 || rs2_2 == rd1) && rd2 == rd1) {
+                return RVIdiom::SlliAdd;
+            }
+            break;
+        case RVInstr::SLT:
+        case RVInstr::SLTU:
+        case RVInstr::SLTI:
+        case RVInstr::SLTIU:
+            if ((opcode2 == RVInstr::BEQ || opcode2 == RVInstr::BNE) &&
+                ((rs1_2 == rd1 && rs2_2 == 0) || (rs1_2 == 0 && rs2_2 == rd1))) {
+                return RVIdiom::CompareBranch;
+            }
+            break;
+        default:
+            break;
+    }
+    return RVIdiom::None;
+}
+
+inline QString idiomName(RVIdiom idiom) {
+    switch (idiom) {
+        case RVIdiom::None:
+            return "";
+        case RVIdiom::LuiAddi:
+            return "lui+addi";
+        case RVIdiom::AuipcJalr:
+            return "auipc+jalr";
+        case RVIdiom::SlliAdd:
+            return "slli+add";
+        case RVIdiom::CompareBranch:
+            return "compare+branch";
+    }
+    Q_UNREACHABLE();
+}
+
+}  // namespace Ripes
@@ -34,27 +34,32 @@ public:
         };
         wr_width->out >> mem->wr_width;
 
-        data_out << [=] {
-            const auto& value = mem->data_out.uValue();
-            switch (op.uValue()) {
-                case MemOp::LB:
-                    return VT_U(signextend<8>(value & 0xFFUL));
-                case MemOp::LBU:
-                    return value & 0xFFUL;
-                case MemOp::LH:
-                    return VT_U(signextend<16>(value & 0xFFFFUL));
-                case MemOp::LHU:
-                    return value & 0xFFFFUL;
-                case MemOp::LWU:
-                    return value & 0xFFFFFFFFUL;
-                case MemOp::LW:
-                    return VT_U(signextend<32>(value));
-                case MemOp::LD:
-                    return value;
-                default:
-                    return value;
-            }
-        };
+        data_out << [=] { return extendLoad(op.uValue(), mem->data_out.uValue()); };
+    }
+
+    /**
+     * @brief extendLoad
+     * @returns the value loaded by the memory operation @p op, from the memory word @p value.
+     */
+    static VSRTL_VT_U extendLoad(const VSRTL_VT_U& op, const VSRTL_VT_U& value) {
+        switch (op) {
+            case MemOp::LB:
+                return VT_U(signextend<8>(value & 0xFFUL));
+            case MemOp::LBU:
+                return value & 0xFFUL;
+            case MemOp::LH:
+                return VT_U(signextend<16>(value & 0xFFFFUL));
+            case MemOp::LHU:
+                return value & 0xFFFFUL;
+            case MemOp::LWU:
+                return value & 0xFFFFFFFFUL;
+            case MemOp::LW:
+                return VT_U(signextend<32>(value));
+            case MemOp::LD:
+                return value;
+            default:
+                return value;
+        }
     }
 
     void setMemory(AddressSpace* addressSpace) {
@@ -0,0 +1,1257 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <limits>
+#include <vector>
+
+#include "VSRTL/core/vsrtl_register.h"
+
+#include "../../interface/ripesprocessor.h"
+
+#include "../riscv.h"
+#include "../rv_alu.h"
+#include "../rv_branch.h"
+#include "../rv_control.h"
+#include "../rv_decode.h"
+#include "../rv_idioms.h"
+#include "../rv_immediate.h"
+#include "../rv_memory.h"
+#include "rvooo_config.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The RVOOO class
+ * A behavioural model of an out-of-order RISC-V processor with a reorder buffer (ROB), a unified reservation station
+ * (RS) and a load/store queue (LSQ), parameterized by an OoOConfig. Unlike the VSRTL processors, the processor is
+ * modelled at the level of instructions, and has no datapath view.
+ *
+ * Each cycle, the processor
+ * - fetches a group of issueWidth sequential instructions (IF), if the previously fetched group is dispatched in the
+ *   cycle. Control flow is predicted not taken.
+ * - dispatches fetched instructions in order (ID): an instruction is renamed onto the ROB, and allocates an RS entry
+ *   and, if it accesses memory, an LSQ entry. Dispatching stalls when either of these is full. Operands are read from
+ *   the register file or from completed instructions in the ROB, or are awaited from the instructions producing them.
+ * - issues the oldest instructions in the RS whose operands are available (IS) to the functional units (EX): up to
+ *   issueWidth ALUs, of which a single one resolves branches and jumps, a multiplier, a divider and a load/store unit.
+ *   A load issues once the addresses of all older stores are known. The value of an older store to the same address is
+ *   forwarded to the load; loads which partially overlap older stores wait for these to commit.
+ * - completes the instructions finishing execution, whose results wake up the instructions awaiting them in the RS.
+ *   Taken branches and jumps flush all younger instructions, and redirect fetching to their target.
+ * - commits completed instructions in order from the head of the ROB (WB, CM). Stores write memory as they commit, a
+ *   single store per cycle; loads do not issue in cycles wherein a store commits.
+ *
+ * An ecall is executed as it commits, and serializes dispatching: the instructions following an ecall are dispatched
+ * once it has committed, such that system calls observe and modify the architectural state.
+ * Loads execute speculatively, except for loads of memory-mapped I/O, which issue once they are at the head of the
+ * ROB.
+ *
+ * With macro-op fusion enabled, a dependent idiom (see RVIdiom) whose instructions are dispatched in the same cycle is
+ * fused into a single op: the pair occupies a single RS entry, and issues to a single ALU in a single issue slot once
+ * the operands of both instructions, other than the result of the 1st, are available. The result of the 1st
+ * instruction is forwarded to the 2nd within the op, such that both complete after a single ALU latency. The
+ * instructions retain an ROB entry each, and commit as any other instructions.
+ */
+template <typename XLEN_T>
+class RVOOO : public RipesProcessor {
+    static_assert(std::is_same<uint32_t, XLEN_T>::value || std::is_same<uint64_t, XLEN_T>::value,
+                  "Only supports 32- and 64-bit variants");
+    static constexpr unsigned XLEN = sizeof(XLEN_T) * CHAR_BIT;
+    static constexpr VSRTL_VT_U s_xlenMask = std::numeric_limits<XLEN_T>::max();
+    static constexpr unsigned s_instrBytes = c_RVInstrWidth / CHAR_BIT;
+
+public:
+    enum class Unit { ALU, MUL, DIV, LSU };
+
+    RVOOO(const QStringList& extensions) : m_config(OoOConfig::current().sanitized()) {
+        m_enabledISA = std::make_shared<ISAInfo<XLenToRVISA<XLEN>()>>(extensions);
+        m_features = Features::isReversible | Features::hasICacheInterface | Features::hasDCacheInterface;
+        m_maxReverseCycles = vsrtl::core::ClockedComponent::reverseStackSize();
+
+        const unsigned W = m_config.issueWidth;
+        m_stageOffsets[IF] = 0;
+        m_stageOffsets[ID] = m_stageOffsets[IF] + W;
+        m_stageOffsets[IS] = m_stageOffsets[ID] + W;
+        // An RS entry, and an ALU, holding a fused op hold both of its instructions
+        const unsigned opInstrs = m_config.fusion ? 2 : 1;
+        m_stageOffsets[EX] = m_stageOffsets[IS] + m_config.rsEntries * opInstrs;
+        // A pipelined unit holds an instruction per cycle of its latency, whereas the divider holds a single one.
+        m_stageOffsets[WB] = m_stageOffsets[EX] + W * m_config.aluLatency * opInstrs + m_config.mulLatency + 1 +
+                             m_config.loadLatency;
+        m_stageOffsets[CM] = m_stageOffsets[WB] + m_config.robEntries;
+        m_stageOffsets[STAGECOUNT] = m_stageOffsets[CM] + W;
+        m_stages.assign(m_stageOffsets[STAGECOUNT], StageInfo({0, false, StageInfo::State::None}));
+
+        m_dispatchStalls[DispatchStall::ROBFull] = registerPerfCounter(
+            "Dispatch stalls: ROB full", "Cycles without dispatching as the reorder buffer is full", 1);
+        m_dispatchStalls[DispatchStall::RSFull] = registerPerfCounter(
+            "Dispatch stalls: RS full", "Cycles without dispatching as the reservation station is full", 1);
+        m_dispatchStalls[DispatchStall::LSQFull] = registerPerfCounter(
+            "Dispatch stalls: LSQ full", "Cycles without dispatching as the load/store queue is full", 1);
+        m_dispatchStalls[DispatchStall::Ecall] = registerPerfCounter(
+            "Dispatch stalls: ecall", "Cycles without dispatching while an ecall awaits being committed", 1);
+        m_controlflowFlushes =
+            registerPerfCounter("Control flow flushes", "Taken branches and jumps, flushing all younger instructions",
+                                controlFlowPenalty());
+        m_squashed = registerPerfCounter("Squashed instructions",
+                                         "Dispatched instructions flushed by an older taken branch or jump");
+        m_forwardedLoads = registerPerfCounter("Loads forwarded", "Loads whose value is forwarded from an older store");
+        m_storeWaits =
+            registerPerfCounter("Load ordering waits", "Cycles of loads with available operands awaiting older stores");
+        if (m_config.fusion) {
+            for (const auto idiom : {RVIdiom::LuiAddi, RVIdiom::AuipcJalr, RVIdiom::SlliAdd, RVIdiom::CompareBranch}) {
+                m_fusedIdioms[idiom] = registerPerfCounter("Fused pairs: " + idiomName(idiom),
+                                                           idiomName(idiom) + " pairs dispatched as a single op");
+            }
+        }
+    }
+
+    // Ripes interface compliance
+    unsigned int stageCount() const override { return m_stageOffsets[STAGECOUNT]; }
+    unsigned int getPcForStage(unsigned int idx) const override { return m_stages.at(idx).pc; }
+    AInt nextFetchedAddress() const override { return m_state.fetchPC; }
+    QString stageName(unsigned int idx) const override {
+        // clang-format off
+        switch (stageOf(idx)) {
+            case IF: return "IF";
+            case ID: return "ID";
+            case IS: return "IS";
+            case EX: return "EX";
+            case WB: return "WB";
+            case CM: return "CM";
+            default: return "N/A";
+        }
+        // clang-format on
+    }
+    StageInfo stageInfo(unsigned int idx) const override { return m_stages.at(idx); }
+    const std::vector<unsigned> breakpointTriggeringStages() const override {
+        std::vector<unsigned> stages;
+        for (unsigned i = m_stageOffsets[IF]; i < m_stageOffsets[ID]; ++i) {
+            stages.push_back(i);
+        }
+        return stages;
+    }
+
+    void setProgramCounter(AInt address) override {
+        m_state.fetchPC = address;
+        propagate();
+    }
+    void setPCInitialValue(AInt address) override { m_pcInitialValue = address; }
+    AddressSpaceMM& getMemory() override { return m_memory; }
+    void writeMemory(AInt address, VInt value, int size) override {
+        // Memory is written within a cycle by committing stores and by system calls
+        if (m_recording) {
+            record({UndoOp::Memory, static_cast<unsigned>(size), address, m_memory.readMemConst(address, size)});
+        }
+        m_memory.writeMem(address, value, size);
+    }
+    VInt getRegister(RegisterFileType, unsigned i) const override { return m_state.regs.at(i); }
+    void setRegister(RegisterFileType, unsigned i, VInt v) override {
+        // x0 is hardwired to zero. Registers are set within a cycle by system calls.
+        if (i != 0) {
+            record({UndoOp::Register, i, 0, m_state.regs.at(i)});
+            m_state.regs.at(i) = v & s_xlenMask;
+        }
+    }
+
+    void finalize(FinalizeReason fr) override {
+        if (fr == FinalizeReason::exitSyscall) {
+            // An exit system call is executed as the ecall commits; no younger instructions have been dispatched.
+            m_state.exiting = true;
+            clearFetchQueue();
+        }
+    }
+    bool finished() const override {
+        // The processor is finished when there are no more instructions in flight, nor any to be fetched
+        return m_state.rob.empty() && m_state.fetchQueue.empty() &&
+               (m_state.exiting || !isExecutableAddress(m_state.fetchPC));
+    }
+
+    MemoryAccess dataMemAccess() const override {
+        MemoryAccess access;
+        const Entry* entry = nullptr;
+        if (m_cycle.commitsStore) {
+            // Stores write memory as they commit
+            for (unsigned i = 0; i < m_cycle.commits; ++i) {
+                if (Control::do_do_mem_write_ctrl(m_state.rob.at(i).opcode)) {
+                    entry = &m_state.rob.at(i);
+                    access.type = MemoryAccess::Write;
+                    access.address = entry->address;
+                }
+            }
+        } else if (m_cycle.load != 0 && m_cycle.forwardFrom == 0) {
+            entry = &this->entry(m_cycle.load);
+            access.type = MemoryAccess::Read;
+            access.address = aluResult(*entry);
+        }
+        if (entry) {
+            access.bytes = memBytes(Control::do_mem_ctrl(entry->opcode));
+            access.pc = entry->pc;
+        }
+        return access;
+    }
+    MemoryAccess instrMemAccess() const override {
+        MemoryAccess access;
+        if (m_cycle.fetches > 0) {
+            access.type = MemoryAccess::Read;
+            access.address = m_state.fetchPC;
+            access.bytes = m_cycle.fetches * s_instrBytes;
+            access.pc = m_state.fetchPC;
+        }
+        return access;
+    }
+
+    ControlFlow controlFlow() const override {
+        // Control flow is resolved by the branch ALU, in the cycle wherein a branch or jump is issued
+        ControlFlow cf;
+        if (m_cycle.controlflow == 0) {
+            return cf;
+        }
+        const Entry e = planned(m_cycle.controlflow);
+        cf.kind = Control::do_controlflow_kind(e.opcode, e.rd, e.rs1);
+        cf.pc = e.pc;
+        cf.fallthrough = (e.pc + s_instrBytes) & s_xlenMask;
+        cf.target = aluResult(e);
+        cf.taken = isTaken(e);
+        return cf;
+    }
+    // A taken branch or jump is resolved no earlier than in the cycle following its dispatch; the instruction at its
+    // target is fetched in the following cycle, and dispatched in the cycle thereafter.
+    unsigned controlFlowPenalty() const override { return 3; }
+    unsigned issueWidth() const override { return m_config.issueWidth; }
+
+    long long getInstructionsRetired() const override { return m_state.retired; }
+    long long getCycleCount() const override { return m_state.cycle; }
+
+    // The processor does not stall for memory; the cycles of memory stalls are accounted for separately.
+    void stallMemory(unsigned cycles) override { m_state.memStallCycles += cycles; }
+    long long getMemoryStallCycles() const override { return m_state.memStallCycles; }
+
+    void postConstruct() override { resetState(); }
+
+    void resetProcessor() override {
+        m_memory.reset();
+        resetPerfCounters();
+        resetState();
+        if (m_emitsSignals) {
+            processorWasReset.Emit();
+        }
+    }
+
+    void reverseProcessor() override {
+        if (m_undoCycles.size() == m_undoFirst) {
+            return;
+        }
+        // The modifications of the cycle are undone in the reverse order of which they were made
+        const UndoCycle& undo = m_undoCycles.back();
+        auto& rob = m_state.rob;
+        while (m_undoOps.size() > undo.ops) {
+            const UndoOp& op = m_undoOps.back();
+            switch (op.kind) {
+                case UndoOp::Dispatch:
+                    rob.pop_back();
+                    break;
+                case UndoOp::Flush:
+                    rob.push_back(m_undoEntries.back());
+                    m_undoEntries.pop_back();
+                    break;
+                case UndoOp::Commit:
+                    rob.push_front(m_undoEntries.back());
+                    m_undoEntries.pop_back();
+                    break;
+                case UndoOp::Issue: {
+                    // An instruction issues once; the results of issuing are reset to those of its dispatch
+                    Entry& e = entry(op.key);
+                    e.status = Status::Waiting;
+                    e.doneCycle = 0;
+                    e.result = 0;
+                    e.address = 0;
+                    e.taken = false;
+                    e.target = 0;
+                    break;
+                }
+                case UndoOp::Complete:
+                    entry(op.key).status = Status::Executing;
+                    break;
+                case UndoOp::Wakeup: {
+                    // The value of an operand which is not yet available is 0
+                    Entry& e = entry(op.key);
+                    (op.index == 1 ? e.tag1 : e.tag2) = op.value;
+                    (op.index == 1 ? e.op1 : e.op2) = 0;
+                    break;
+                }
+                case UndoOp::Register:
+                    m_state.regs.at(op.index) = op.value;
+                    break;
+                case UndoOp::Memory:
+                    m_memory.writeMem(op.key, op.value, op.index);
+                    break;
+                case UndoOp::FetchPush:
+                    m_state.fetchQueue.pop_back();
+                    break;
+                case UndoOp::FetchPopFront:
+                    m_state.fetchQueue.insert(m_state.fetchQueue.begin(), {op.key, op.value});
+                    break;
+                case UndoOp::FetchPopBack:
+                    m_state.fetchQueue.push_back({op.key, op.value});
+                    break;
+                case UndoOp::PerfEvent:
+                    countPerfEvent(op.index, -static_cast<long long>(op.value));
+                    break;
+            }
+            m_undoOps.pop_back();
+        }
+        Q_ASSERT(m_undoEntries.size() == undo.entries);
+
+        m_state.cycle--;
+        m_state.retired = undo.retired;
+        m_state.memStallCycles = undo.memStallCycles;
+        m_state.fetchPC = undo.fetchPC;
+        m_state.nextSeq = undo.nextSeq;
+        m_state.divBusyUntil = undo.divBusyUntil;
+        m_state.exiting = undo.exiting;
+        renameRegisters();
+        m_undoCycles.pop_back();
+
+        propagate();
+        if (m_emitsSignals) {
+            processorWasReversed.Emit();
+        }
+    }
+    void setMaxReverseCycles(unsigned cycles) override {
+        m_maxReverseCycles = cycles;
+        if (m_undoCycles.size() - m_undoFirst > m_maxReverseCycles) {
+            m_undoFirst = m_undoCycles.size() - m_maxReverseCycles;
+        }
+        discardUndoCycles();
+    }
+
+    static ProcessorISAInfo supportsISA() {
+        return ProcessorISAInfo{std::make_shared<ISAInfo<XLenToRVISA<XLEN>()>>(QStringList()), {"M"}, {"M"}};
+    }
+    const ISAInfoBase* implementsISA() const override { return m_enabledISA.get(); }
+    const std::set<RegisterFileType> registerFiles() const override {
+        std::set<RegisterFileType> rfs;
+        rfs.insert(RegisterFileType::GPR);
+        return rfs;
+    }
+
+protected:
+    void clockProcessor() override {
+        m_recording = m_maxReverseCycles > 0;
+        if (m_recording) {
+            if (m_undoCycles.size() - m_undoFirst == m_maxReverseCycles) {
+                m_undoFirst++;
+            }
+            discardUndoCycles();
+            m_undoCycles.push_back({m_state.retired, m_state.memStallCycles, m_state.fetchPC, m_state.nextSeq,
+                                    m_state.divBusyUntil, m_state.exiting, m_undoOps.size(), m_undoEntries.size()});
+        }
+        countPerfEvents();
+
+        // Instructions issue prior to older instructions committing, such that a store forwarding its value to a load
+        // issued in the cycle remains in the ROB.
+        const long long cycle = m_state.cycle;
+        issue(cycle);
+        commit();
+        const uint64_t flushAfter = complete(cycle);
+        dispatch();
+        if (flushAfter != 0) {
+            flush(flushAfter);
+        } else {
+            fetch();
+        }
+
+        m_state.cycle++;
+        m_recording = false;
+        propagate();
+        if (m_emitsSignals) {
+            processorWasClocked.Emit();
+        }
+    }
+
+private:
+    enum Stage { IF, ID, IS, EX, WB, CM, STAGECOUNT };
+    enum class Status { Waiting, Executing, Done };
+    enum class DispatchStall { None, ROBFull, RSFull, LSQFull, Ecall };
+
+    /**
+     * @brief The Entry struct
+     * An instruction in flight, from being dispatched until being committed. Instructions in flight are identified by
+     * sequence numbers, assigned in program order as they are dispatched. An operand which is not yet available is
+     * tagged with the sequence number of the instruction producing it; a tag of 0 denotes an available operand.
+     */
+    struct Entry {
+        uint64_t seq = 0;
+        AInt pc = 0;
+        VSRTL_VT_U opcode = RVInstr::NOP;
+        unsigned rd = 0;
+        unsigned rs1 = 0;
+        VSRTL_VT_U imm = 0;
+        Unit unit = Unit::ALU;
+        Status status = Status::Waiting;
+        uint64_t tag1 = 0;
+        uint64_t tag2 = 0;
+        VSRTL_VT_U op1 = 0;  // Values of the source registers
+        VSRTL_VT_U op2 = 0;
+        long long doneCycle = 0;  // The final cycle of execution
+        VSRTL_VT_U result = 0;
+        AInt address = 0;  // Effective address of loads and stores
+        bool taken = false;
+        AInt target = 0;
+        bool fused = false;  // Fused with the preceding instruction into a single op
+    };
+
+    struct Fetched {
+        AInt pc;
+        VSRTL_VT_U instr;
+    };
+
+    /**
+     * @brief The State struct
+     * The state of the processor in between cycles. The register alias table (rat) is derived from the ROB.
+     */
+    struct State {
+        long long cycle = 0;
+        long long retired = 0;
+        long long memStallCycles = 0;
+        AInt fetchPC = 0;
+        std::vector<Fetched> fetchQueue;  // Instructions in ID
+        std::deque<Entry> rob;            // In program order
+        uint64_t nextSeq = 1;
+        std::vector<uint64_t> rat;  // Sequence number of the youngest instruction in flight writing a register, or 0
+        std::vector<VSRTL_VT_U> regs;  // Architectural registers
+        long long divBusyUntil = -1;   // Final cycle of the division occupying the divider
+        bool exiting = false;
+    };
+
+    /**
+     * @brief The Cycle struct
+     * The actions of the processor in the upcoming cycle, as determined by the current state of the processor.
+     */
+    struct Cycle {
+        unsigned commits = 0;  // Instructions committed from the head of the ROB
+        bool commitsStore = false;
+        std::vector<uint64_t> issues;  // Instructions issued from the RS
+        uint64_t controlflow = 0;      // The branch or jump issued
+        uint64_t load = 0;             // The load issued
+        uint64_t forwardFrom = 0;      // The store forwarding its value to the load, if any
+        unsigned storeWaits = 0;
+        unsigned dispatches = 0;  // Instructions dispatched from ID
+        DispatchStall dispatchStall = DispatchStall::None;
+        unsigned fetches = 0;  // Instructions fetched in IF
+    };
+
+    /**
+     * @brief The UndoOp struct
+     * A modification of the state of the processor made within a cycle, recorded such that the cycle can be reversed.
+     * Entries removed from the ROB are recorded separately, in m_undoEntries.
+     */
+    struct UndoOp {
+        enum Kind : uint8_t {
+            Dispatch,       // An entry was appended to the ROB
+            Flush,          // An entry was removed from the back of the ROB
+            Commit,         // An entry was removed from the front of the ROB
+            Issue,          // Entry key was issued
+            Complete,       // Entry key completed
+            Wakeup,         // Operand index of entry key, tagged with value, became available
+            Register,       // Register index, of value, was written
+            Memory,         // index bytes at address key, of value, were written
+            FetchPush,      // An instruction was appended to the fetch queue
+            FetchPopFront,  // The instruction value at key was removed from the front of the fetch queue
+            FetchPopBack,   // The instruction value at key was removed from the back of the fetch queue
+            PerfEvent       // value events were counted by perf counter index
+        };
+        Kind kind;
+        unsigned index;
+        uint64_t key;
+        VSRTL_VT_U value;
+    };
+
+    /**
+     * @brief The UndoCycle struct
+     * The state of the processor prior to a cycle which is not recorded through UndoOps, alongside the first of the
+     * undo records of the cycle.
+     */
+    struct UndoCycle {
+        long long retired;
+        long long memStallCycles;
+        AInt fetchPC;
+        uint64_t nextSeq;
+        long long divBusyUntil;
+        bool exiting;
+        size_t ops;
+        size_t entries;
+    };
+
+    // ======================== Instruction semantics ========================
+
+    static Unit unitOf(const VSRTL_VT_U& opcode) {
+        if (Control::do_mem_ctrl(opcode) != +MemOp::NOP) {
+            return Unit::LSU;
+        }
+        switch (Control::do_alu_ctrl(opcode)) {
+            case ALUOp::MUL:
+            case ALUOp::MULH:
+            case ALUOp::MULHU:
+            case ALUOp::MULHSU:
+            case ALUOp::MULW:
+                return Unit::MUL;
+            case ALUOp::DIV:
+            case ALUOp::DIVU:
+            case ALUOp::REM:
+            case ALUOp::REMU:
+            case ALUOp::DIVW:
+            case ALUOp::DIVUW:
+            case ALUOp::REMW:
+            case ALUOp::REMUW:
+                return Unit::DIV;
+            default:
+                return Unit::ALU;
+        }
+    }
+
+    static unsigned memBytes(const MemOp& op) {
+        switch (op) {
+            case MemOp::LB:
+            case MemOp::LBU:
+            case MemOp::SB:
+                return 1;
+            case MemOp::LH:
+            case MemOp::LHU:
+            case MemOp::SH:
+                return 2;
+            case MemOp::LW:
+            case MemOp::LWU:
+            case MemOp::SW:
+                return 4;
+            case MemOp::LD:
+            case MemOp::SD:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    static bool isControlflow(const Entry& e) {
+        return Control::do_branch_ctrl(e.opcode) || Control::do_jump_ctrl(e.opcode);
+    }
+    static bool isLoad(const Entry& e) { return Control::do_do_read_ctrl(e.opcode); }
+    static bool isStore(const Entry& e) { return Control::do_do_mem_write_ctrl(e.opcode); }
+    static bool writesRegister(const Entry& e) { return e.rd != 0 && Control::do_reg_do_write_ctrl(e.opcode); }
+
+    /**
+     * @brief aluResult
+     * @returns the result of the ALU for instruction @p e, whose operands must be available. This is the effective
+     * address of loads and stores, and the target of branches and jumps.
+     */
+    static VSRTL_VT_U aluResult(const Entry& e) {
+        const VSRTL_VT_U op1 = Control::do_alu_op1_ctrl(e.opcode) == +AluSrc1::REG1 ? e.op1 : e.pc;
+        const VSRTL_VT_U op2 = Control::do_alu_op2_ctrl(e.opcode) == +AluSrc2::REG2 ? e.op2 : e.imm;
+        return ALU<XLEN>::compute(Control::do_alu_ctrl(e.opcode), op1, op2) & s_xlenMask;
+    }
+
+    static bool isTaken(const Entry& e) {
+        if (Control::do_jump_ctrl(e.opcode)) {
+            return true;
+        }
+        return Control::do_branch_ctrl(e.opcode) &&
+               Branch<XLEN>::compare(Control::do_comp_ctrl(e.opcode), e.op1, e.op2);
+    }
+
+    static unsigned latency(const Entry& e, const OoOConfig& config) {
+        switch (e.unit) {
+            case Unit::ALU:
+                return config.aluLatency;
+            case Unit::MUL:
+                return config.mulLatency;
+            case Unit::DIV:
+                return config.divLatency;
+            case Unit::LSU:
+                return isLoad(e) ? config.loadLatency : 1;
+        }
+        Q_UNREACHABLE();
+    }
+
+    /**
+     * @brief fusedIdiom
+     * @returns the idiom formed by the fetched instructions @p head and @p tail, if they are fused when dispatched in
+     * the same cycle.
+     */
+    RVIdiom fusedIdiom(const Fetched& head, const Fetched& tail) const {
+        if (!m_config.fusion) {
+            return RVIdiom::None;
+        }
+        const auto field = [](VSRTL_VT_U instr, unsigned lsb) -> unsigned { return (instr >> lsb) & 0b11111; };
+        return dependentIdiom(Decode<XLEN>::decodeOpcode(head.instr, m_enabledISA.get()), field(head.instr, 7),
+                              Decode<XLEN>::decodeOpcode(tail.instr, m_enabledISA.get()), field(tail.instr, 7),
+                              field(tail.instr, 15), field(tail.instr, 20));
+    }
+
+    void record(const UndoOp& op) {
+        if (m_recording) {
+            m_undoOps.push_back(op);
+        }
+    }
+
+    void countEvent(unsigned counter, long long events) {
+        if (events != 0) {
+            countPerfEvent(counter, events);
+            record({UndoOp::PerfEvent, counter, 0, static_cast<VSRTL_VT_U>(events)});
+        }
+    }
+
+    /**
+     * @brief discardUndoCycles
+     * Discards the undo records of the cycles which may no longer be reversed. Records are discarded in bulk once as
+     * many cycles as may be reversed have been discarded, such that the undo records are reused without reallocation.
+     */
+    void discardUndoCycles() {
+        if (m_undoFirst == 0 || (m_maxReverseCycles != 0 && m_undoFirst < m_maxReverseCycles)) {
+            return;
+        }
+        const bool all = m_undoFirst == m_undoCycles.size();
+        const size_t ops = all ? m_undoOps.size() : m_undoCycles.at(m_undoFirst).ops;
+        const size_t entries = all ? m_undoEntries.size() : m_undoCycles.at(m_undoFirst).entries;
+        m_undoOps.erase(m_undoOps.begin(), m_undoOps.begin() + ops);
+        m_undoEntries.erase(m_undoEntries.begin(), m_undoEntries.begin() + entries);
+        m_undoCycles.erase(m_undoCycles.begin(), m_undoCycles.begin() + m_undoFirst);
+        for (auto& cycle : m_undoCycles) {
+            cycle.ops -= ops;
+            cycle.entries -= entries;
+        }
+        m_undoFirst = 0;
+    }
+
+    const Entry& entry(uint64_t seq) const { return m_state.rob.at(seq - m_state.rob.front().seq); }
+    Entry& entry(uint64_t seq) { return m_state.rob.at(seq - m_state.rob.front().seq); }
+
+    /**
+     * @brief planned
+     * @returns entry @p seq, which issues in the upcoming cycle, with the result of the instruction it is fused with
+     * forwarded to its operands. The 1st instruction of each idiom writes the result of the ALU.
+     */
+    Entry planned(uint64_t seq) const {
+        Entry e = entry(seq);
+        if (e.fused && entry(seq - 1).status == Status::Waiting) {
+            Entry head = entry(seq - 1);
+            head.result = aluResult(head);
+            if (e.tag1 == head.seq) {
+                e.op1 = head.result;
+                e.tag1 = 0;
+            }
+            if (e.tag2 == head.seq) {
+                e.op2 = head.result;
+                e.tag2 = 0;
+            }
+        }
+        return e;
+    }
+
+    // ============================ Cycle actions ============================
+
+    void commit() {
+        bool ecall = false;
+        for (unsigned i = 0; i < m_cycle.commits; ++i) {
+            const Entry& e = m_state.rob.front();
+            if (isStore(e)) {
+                writeMemory(e.address, e.op2, memBytes(Control::do_mem_ctrl(e.opcode)));
+            }
+            if (writesRegister(e)) {
+                record({UndoOp::Register, e.rd, 0, m_state.regs[e.rd]});
+                m_state.regs[e.rd] = e.result;
+                if (m_state.rat[e.rd] == e.seq) {
+                    m_state.rat[e.rd] = 0;
+                }
+            }
+            ecall |= e.opcode == RVInstr::ECALL;
+            m_state.retired++;
+            if (m_recording) {
+                m_undoEntries.push_back(e);
+                record({UndoOp::Commit, 0, e.seq, 0});
+            }
+            m_state.rob.pop_front();
+        }
+
+        if (ecall) {
+            // The ecall commits alone; the ROB is empty, and the architectural state is that following the ecall.
+            trapHandler();
+        }
+    }
+
+    void issue(long long cycle) {
+        for (const uint64_t seq : m_cycle.issues) {
+            Entry& e = entry(seq);
+            if (e.fused) {
+                // The result of the instruction fused with is forwarded within the op; it issues prior to this one.
+                wakeup(entry(seq - 1), e);
+            }
+            const VSRTL_VT_U aluRes = aluResult(e);
+            e.address = aluRes;
+            e.target = aluRes;
+            e.taken = isTaken(e);
+            switch (Control::do_reg_wr_src_ctrl(e.opcode)) {
+                case RegWrSrc::MEMREAD: {
+                    const MemOp op = Control::do_mem_ctrl(e.opcode);
+                    const VSRTL_VT_U value = m_cycle.forwardFrom != 0
+                                                 ? entry(m_cycle.forwardFrom).op2
+                                                 : m_memory.readMem(e.address, memBytes(op));
+                    e.result = RVMemory<XLEN, XLEN>::extendLoad(op, value) & s_xlenMask;
+                    break;
+                }
+                case RegWrSrc::ALURES:
+                    e.result = aluRes;
+                    break;
+                case RegWrSrc::PC4:
+                    e.result = (e.pc + s_instrBytes) & s_xlenMask;
+                    break;
+            }
+            record({UndoOp::Issue, 0, e.seq, 0});
+            e.status = Status::Executing;
+            e.doneCycle = cycle + latency(e, m_config) - 1;
+            if (e.unit == Unit::DIV) {
+                m_state.divBusyUntil = e.doneCycle;
+            }
+        }
+    }
+
+    /**
+     * @brief complete
+     * Completes the instructions finishing execution in @p cycle, and wakes up the instructions awaiting their
+     * results.
+     * @returns the sequence number of the taken branch or jump completed, or 0 if none.
+     */
+    uint64_t complete(long long cycle) {
+        uint64_t flushAfter = 0;
+        for (auto& e : m_state.rob) {
+            if (e.status != Status::Executing || e.doneCycle != cycle) {
+                continue;
+            }
+            record({UndoOp::Complete, 0, e.seq, 0});
+            e.status = Status::Done;
+            for (auto& waiting : m_state.rob) {
+                if (waiting.status == Status::Waiting) {
+                    wakeup(e, waiting);
+                }
+            }
+            if (isControlflow(e) && e.taken && flushAfter == 0) {
+                flushAfter = e.seq;
+            }
+        }
+        return flushAfter;
+    }
+
+    /**
+     * @brief wakeup
+     * Provides the result of @p producer to the operands of @p waiting which await it.
+     */
+    void wakeup(const Entry& producer, Entry& waiting) {
+        if (waiting.tag1 == producer.seq) {
+            record({UndoOp::Wakeup, 1, waiting.seq, waiting.tag1});
+            waiting.op1 = producer.result;
+            waiting.tag1 = 0;
+        }
+        if (waiting.tag2 == producer.seq) {
+            record({UndoOp::Wakeup, 2, waiting.seq, waiting.tag2});
+            waiting.op2 = producer.result;
+            waiting.tag2 = 0;
+        }
+    }
+
+    /**
+     * @brief readOperand
+     * Reads source register @p reg for an instruction being dispatched, into @p value if available, and otherwise tags
+     * it with the instruction producing it.
+     */
+    void readOperand(unsigned reg, VSRTL_VT_U& value, uint64_t& tag) const {
+        const uint64_t producer = m_state.rat.at(reg);
+        if (producer == 0) {
+            value = m_state.regs.at(reg);
+        } else if (entry(producer).status == Status::Done) {
+            value = entry(producer).result;
+        } else {
+            tag = producer;
+        }
+    }
+
+    void dispatch() {
+        for (unsigned i = 0; i < m_cycle.dispatches; ++i) {
+            const Fetched& fetched = m_state.fetchQueue.at(i);
+            Entry e;
+            e.seq = m_state.nextSeq++;
+            e.pc = fetched.pc;
+            e.opcode = Decode<XLEN>::decodeOpcode(fetched.instr, m_enabledISA.get());
+            e.rd = (fetched.instr >> 7) & 0b11111;
+            e.rs1 = (fetched.instr >> 15) & 0b11111;
+            const unsigned rs2 = (fetched.instr >> 20) & 0b11111;
+            e.imm = Immediate<XLEN>::decodeImmediate(e.opcode, fetched.instr) & s_xlenMask;
+            e.unit = unitOf(e.opcode);
+            // An instruction is fused with the preceding instruction dispatched in the cycle, unless that one is fused
+            const RVIdiom idiom = i > 0 && !m_state.rob.back().fused
+                                      ? fusedIdiom(m_state.fetchQueue.at(i - 1), fetched)
+                                      : RVIdiom::None;
+            if (idiom != RVIdiom::None) {
+                e.fused = true;
+                countEvent(m_fusedIdioms.at(idiom), 1);
+            }
+            if (Control::do_reads_reg1(e.opcode)) {
+                readOperand(e.rs1, e.op1, e.tag1);
+            }
+            if (Control::do_reads_reg2(e.opcode)) {
+                readOperand(rs2, e.op2, e.tag2);
+            }
+            // An ecall is executed as it commits
+            e.status = e.opcode == RVInstr::ECALL ? Status::Done : Status::Waiting;
+            if (writesRegister(e)) {
+                m_state.rat[e.rd] = e.seq;
+            }
+            m_state.rob.push_back(e);
+            record({UndoOp::Dispatch, 0, e.seq, 0});
+        }
+        // The pops are undone in reverse order, each reinserting its instruction at the front of the fetch queue
+        for (unsigned i = 0; i < m_cycle.dispatches; ++i) {
+            const Fetched& fetched = m_state.fetchQueue.at(i);
+            record({UndoOp::FetchPopFront, 0, fetched.pc, fetched.instr});
+        }
+        m_state.fetchQueue.erase(m_state.fetchQueue.begin(), m_state.fetchQueue.begin() + m_cycle.dispatches);
+    }
+
+    /**
+     * @brief flush
+     * Flushes the instructions younger than the taken branch or jump @p seq, and redirects fetching to its target.
+     */
+    void flush(uint64_t seq) {
+        const AInt target = entry(seq).target;
+        countEvent(m_squashed, m_state.rob.back().seq - seq);
+        while (m_state.rob.back().seq != seq) {
+            if (m_recording) {
+                m_undoEntries.push_back(m_state.rob.back());
+                record({UndoOp::Flush, 0, m_state.rob.back().seq, 0});
+            }
+            m_state.rob.pop_back();
+        }
+        m_state.nextSeq = seq + 1;
+        clearFetchQueue();
+        m_state.fetchPC = target;
+        renameRegisters();
+
+        m_state.divBusyUntil = -1;
+        for (const auto& remaining : m_state.rob) {
+            if (remaining.unit == Unit::DIV && remaining.status == Status::Executing) {
+                m_state.divBusyUntil = remaining.doneCycle;
+            }
+        }
+    }
+
+    /**
+     * @brief renameRegisters
+     * Renames each register onto the youngest instruction in flight writing it, if any.
+     */
+    void renameRegisters() {
+        std::fill(m_state.rat.begin(), m_state.rat.end(), 0);
+        for (const auto& e : m_state.rob) {
+            if (writesRegister(e)) {
+                m_state.rat[e.rd] = e.seq;
+            }
+        }
+    }
+
+    void clearFetchQueue() {
+        while (!m_state.fetchQueue.empty()) {
+            record({UndoOp::FetchPopBack, 0, m_state.fetchQueue.back().pc, m_state.fetchQueue.back().instr});
+            m_state.fetchQueue.pop_back();
+        }
+    }
+
+    void fetch() {
+        if (m_state.exiting) {
+            return;
+        }
+        for (unsigned i = 0; i < m_cycle.fetches; ++i) {
+            m_state.fetchQueue.push_back({m_state.fetchPC, m_memory.readMem(m_state.fetchPC, s_instrBytes)});
+            record({UndoOp::FetchPush, 0, m_state.fetchPC, 0});
+            m_state.fetchPC = (m_state.fetchPC + s_instrBytes) & s_xlenMask;
+        }
+    }
+
+    void countPerfEvents() {
+        if (m_cycle.dispatches == 0 && m_cycle.dispatchStall != DispatchStall::None) {
+            countEvent(m_dispatchStalls.at(m_cycle.dispatchStall), 1);
+        }
+        if (m_cycle.controlflow != 0 && isTaken(planned(m_cycle.controlflow))) {
+            countEvent(m_controlflowFlushes, 1);
+        }
+        if (m_cycle.forwardFrom != 0) {
+            countEvent(m_forwardedLoads, 1);
+        }
+        countEvent(m_storeWaits, m_cycle.storeWaits);
+    }
+
+    // ============================ Propagation ==============================
+
+    void resetState() {
+        m_state = State();
+        m_state.fetchPC = m_pcInitialValue;
+        m_state.rat.assign(c_RVRegs, 0);
+        m_state.regs.assign(c_RVRegs, 0);
+        m_undoOps.clear();
+        m_undoEntries.clear();
+        m_undoCycles.clear();
+        m_undoFirst = 0;
+        propagate();
+    }
+
+    /**
+     * @brief propagate
+     * Determines the actions of the processor in the upcoming cycle, and the contents of its stages during the cycle.
+     */
+    void propagate() {
+        m_cycle = Cycle();
+        planCommit();
+        const std::vector<QString> waitReasons = planIssue();
+        planDispatch();
+        planFetch();
+        updateStages(waitReasons);
+    }
+
+    void planCommit() {
+        // Instructions committed in a cycle write distinct registers, such that each register write is observable.
+        const auto& rob = m_state.rob;
+        uint32_t written = 0;
+        for (unsigned i = 0; i < rob.size() && i < m_config.issueWidth; ++i) {
+            const Entry& e = rob[i];
+            const bool ecall = e.opcode == RVInstr::ECALL;
+            const uint32_t writes = writesRegister(e) ? 1u << e.rd : 0;
+            if (e.status != Status::Done || (ecall && i > 0) || (isStore(e) && m_cycle.commitsStore) ||
+                (written & writes)) {
+                break;
+            }
+            m_cycle.commits++;
+            m_cycle.commitsStore |= isStore(e);
+            written |= writes;
+            if (ecall) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief planIssue
+     * Selects the instructions issued from the RS, oldest first. The 2nd instruction of a fused op issues alongside the
+     * 1st.
+     * @returns the reasons for which each of the instructions remaining in the RS is waiting, in program order.
+     */
+    std::vector<QString> planIssue() {
+        std::vector<QString> waitReasons;
+        const auto& rob = m_state.rob;
+        unsigned ops = 0, alus = 0;
+        bool branch = false, mul = false, div = m_state.divBusyUntil >= m_state.cycle, lsu = false;
+        for (unsigned i = 0; i < rob.size(); ++i) {
+            const Entry& e = rob[i];
+            if (e.status != Status::Waiting) {
+                continue;
+            }
+            if (e.fused) {
+                if (m_cycle.issues.empty() || m_cycle.issues.back() != e.seq) {
+                    waitReasons.push_back("fused");
+                }
+                continue;
+            }
+
+            // The operands of the instruction fused with this one, other than the result of this one, must be available
+            const Entry* fused = i + 1 < rob.size() && rob[i + 1].fused ? &rob[i + 1] : nullptr;
+            const auto awaits = [&](uint64_t tag) { return tag != 0 && tag != e.seq; };
+            const bool fusedControlflow = fused && isControlflow(*fused);
+
+            QString reason;
+            uint64_t forwardFrom = 0;
+            if (e.tag1 != 0 || e.tag2 != 0 || (fused && (awaits(fused->tag1) || awaits(fused->tag2)))) {
+                reason = "operands";
+            } else if (ops == m_config.issueWidth) {
+                reason = "issue width";
+            } else {
+                switch (e.unit) {
+                    case Unit::ALU:
+                        if (alus == m_config.issueWidth || ((isControlflow(e) || fusedControlflow) && branch)) {
+                            reason = "ALU";
+                        }
+                        break;
+                    case Unit::MUL:
+                        reason = mul ? "MUL" : "";
+                        break;
+                    case Unit::DIV:
+                        reason = div ? "DIV" : "";
+                        break;
+                    case Unit::LSU:
+                        if (lsu) {
+                            reason = "LSU";
+                        } else if (isLoad(e) && i != 0 && isIOAddress && isIOAddress(aluResult(e))) {
+                            // Loads of memory-mapped I/O have side effects, and are not executed speculatively
+                            reason = "I/O";
+                        } else if (isLoad(e)) {
+                            reason = loadDependence(i, forwardFrom);
+                            if (reason.isEmpty() && m_cycle.commitsStore && forwardFrom == 0) {
+                                reason = "memory port";
+                            }
+                        }
+                        break;
+                }
+            }
+
+            if (!reason.isEmpty()) {
+                waitReasons.push_back(reason);
+                continue;
+            }
+            ops++;
+            m_cycle.issues.push_back(e.seq);
+            if (fused) {
+                m_cycle.issues.push_back(fused->seq);
+            }
+            switch (e.unit) {
+                case Unit::ALU:
+                    alus++;
+                    if (isControlflow(e) || fusedControlflow) {
+                        branch = true;
+                        m_cycle.controlflow = fusedControlflow ? fused->seq : e.seq;
+                    }
+                    break;
+                case Unit::MUL:
+                    mul = true;
+                    break;
+                case Unit::DIV:
+                    div = true;
+                    break;
+                case Unit::LSU:
+                    lsu = true;
+                    if (isLoad(e)) {
+                        m_cycle.load = e.seq;
+                        m_cycle.forwardFrom = forwardFrom;
+                    }
+                    break;
+            }
+        }
+        return waitReasons;
+    }
+
+    /**
+     * @brief loadDependence
+     * Determines whether the load at ROB index @p idx, whose operands are available, depends on an older store.
+     * @p forwardFrom is set to the youngest older store overlapping the load, if it writes all of the bytes read by it.
+     * @returns the reason for which the load must wait, or an empty string if the load may issue.
+     */
+    QString loadDependence(unsigned idx, uint64_t& forwardFrom) {
+        const Entry& load = m_state.rob.at(idx);
+        const AInt address = aluResult(load);
+        const unsigned bytes = memBytes(Control::do_mem_ctrl(load.opcode));
+        for (unsigned i = idx; i-- > 0;) {
+            const Entry& store = m_state.rob.at(i);
+            if (!isStore(store)) {
+                continue;
+            }
+            if (store.status == Status::Waiting) {
+                m_cycle.storeWaits++;
+                return "store address";
+            }
+            const unsigned storeBytes = memBytes(Control::do_mem_ctrl(store.opcode));
+            if (store.address + storeBytes <= address || address + bytes <= store.address) {
+                continue;
+            }
+            if (store.address == address && storeBytes >= bytes) {
+                // The youngest overlapping store writes all of the bytes read by the load, shadowing any older stores
+                forwardFrom = store.seq;
+                return "";
+            }
+            m_cycle.storeWaits++;
+            return "store overlap";
+        }
+        return "";
+    }
+
+    void planDispatch() {
+        const auto& rob = m_state.rob;
+        unsigned robFree = m_config.robEntries - rob.size();
+        unsigned rsUsed = 0, lsqUsed = 0;
+        bool ecall = false;
+        for (const auto& e : rob) {
+            // A fused op occupies a single RS entry
+            rsUsed += e.status == Status::Waiting && !e.fused ? 1 : 0;
+            lsqUsed += e.unit == Unit::LSU ? 1 : 0;
+            ecall |= e.opcode == RVInstr::ECALL;
+        }
+
+        const auto& fetchQueue = m_state.fetchQueue;
+        bool fused = false;
+        for (unsigned i = 0; i < fetchQueue.size(); ++i) {
+            const Fetched& fetched = fetchQueue[i];
+            const VSRTL_VT_U opcode = Decode<XLEN>::decodeOpcode(fetched.instr, m_enabledISA.get());
+            const bool isEcall = opcode == RVInstr::ECALL;
+            const bool isMem = unitOf(opcode) == Unit::LSU;
+            fused = i > 0 && !fused && fusedIdiom(fetchQueue[i - 1], fetched) != RVIdiom::None;
+            if (ecall) {
+                m_cycle.dispatchStall = DispatchStall::Ecall;
+            } else if (robFree == 0) {
+                m_cycle.dispatchStall = DispatchStall::ROBFull;
+            } else if (!isEcall && !fused && rsUsed == m_config.rsEntries) {
+                m_cycle.dispatchStall = DispatchStall::RSFull;
+            } else if (isMem && lsqUsed == m_config.lsqEntries) {
+                m_cycle.dispatchStall = DispatchStall::LSQFull;
+            }
+            if (m_cycle.dispatchStall != DispatchStall::None) {
+                break;
+            }
+            m_cycle.dispatches++;
+            robFree--;
+            rsUsed += isEcall || fused ? 0 : 1;
+            lsqUsed += isMem ? 1 : 0;
+            ecall |= isEcall;
+        }
+    }
+
+    void planFetch() {
+        // A group is fetched once the previous group has been dispatched in its entirety
+        if (m_state.exiting || m_cycle.dispatches != m_state.fetchQueue.size()) {
+            return;
+        }
+        m_cycle.fetches = fetchGroupSize();
+    }
+
+    unsigned fetchGroupSize() const {
+        unsigned size = 0;
+        while (size < m_config.issueWidth && isExecutableAddress(m_state.fetchPC + size * s_instrBytes)) {
+            size++;
+        }
+        return size;
+    }
+
+    static QString dispatchStallName(DispatchStall stall) {
+        switch (stall) {
+            case DispatchStall::None:
+                return "";
+            case DispatchStall::ROBFull:
+                return "ROB full";
+            case DispatchStall::RSFull:
+                return "RS full";
+            case DispatchStall::LSQFull:
+                return "LSQ full";
+            case DispatchStall::Ecall:
+                return "ecall";
+        }
+        Q_UNREACHABLE();
+    }
+
+    static QString unitName(const Entry& e) {
+        switch (e.unit) {
+            case Unit::ALU:
+                return e.fused ? "fused" : "";
+            case Unit::MUL:
+                return "MUL";
+            case Unit::DIV:
+                return "DIV";
+            case Unit::LSU:
+                return isLoad(e) ? "load" : "store";
+        }
+        Q_UNREACHABLE();
+    }
+
+    void updateStages(const std::vector<QString>& waitReasons) {
+        std::fill(m_stages.begin(), m_stages.end(), StageInfo({0, false, StageInfo::State::None}));
+        std::vector<unsigned> occupancy(STAGECOUNT, 0);
+        const auto place = [&](Stage stage, AInt pc, StageInfo::State state = StageInfo::State::None,
+                               const QString& namedState = QString()) {
+            const unsigned idx = m_stageOffsets[stage] + occupancy[stage]++;
+            Q_ASSERT(idx < m_stageOffsets[stage + 1]);
+            if (idx < m_stageOffsets[stage + 1]) {
+                m_stages[idx] = StageInfo({pc, true, state});
+                m_stages[idx].namedState = namedState;
+            }
+        };
+
+        // IF holds the group being fetched, or the group which would be fetched if ID was not stalled
+        if (!m_state.exiting) {
+            const bool stalled = m_cycle.fetches == 0;
+            const unsigned size = stalled ? fetchGroupSize() : m_cycle.fetches;
+            for (unsigned i = 0; i < size; ++i) {
+                place(IF, m_state.fetchPC + i * s_instrBytes,
+                      stalled ? StageInfo::State::Stalled : StageInfo::State::None);
+            }
+        }
+
+        const QString stallName = dispatchStallName(m_cycle.dispatchStall);
+        for (unsigned i = 0; i < m_state.fetchQueue.size(); ++i) {
+            if (i < m_cycle.dispatches) {
+                place(ID, m_state.fetchQueue[i].pc);
+            } else {
+                place(ID, m_state.fetchQueue[i].pc, StageInfo::State::Stalled, stallName);
+            }
+        }
+
+        auto waitReason = waitReasons.begin();
+        auto issued = m_cycle.issues.begin();
+        for (unsigned i = 0; i < m_state.rob.size(); ++i) {
+            const Entry& e = m_state.rob[i];
+            if (i < m_cycle.commits) {
+                place(CM, e.pc);
+            } else if (e.status == Status::Done) {
+                place(WB, e.pc);
+            } else if (e.status == Status::Executing) {
+                place(EX, e.pc, StageInfo::State::None, unitName(e));
+            } else if (issued != m_cycle.issues.end() && *issued == e.seq) {
+                place(EX, e.pc, StageInfo::State::None, unitName(e));
+                issued++;
+            } else {
+                Q_ASSERT(waitReason != waitReasons.end());
+                place(IS, e.pc, StageInfo::State::None, *waitReason++);
+            }
+        }
+    }
+
+    Stage stageOf(unsigned idx) const {
+        for (int stage = IF; stage < STAGECOUNT; ++stage) {
+            if (idx < m_stageOffsets[stage + 1]) {
+                return static_cast<Stage>(stage);
+            }
+        }
+        return STAGECOUNT;
+    }
+
+    const OoOConfig m_config;
+    std::shared_ptr<ISAInfoBase> m_enabledISA;
+    AddressSpaceMM m_memory;
+    AInt m_pcInitialValue = 0;
+
+    State m_state;
+    Cycle m_cycle;
+    std::vector<StageInfo> m_stages;
+
+    /**
+     * @brief m_stageOffsets
+     * Index of the first stage of each stage group; the groups each hold as many stages as instructions they may hold.
+     */
+    unsigned m_stageOffsets[STAGECOUNT + 1];
+
+    /**
+     * @brief Undo records
+     * Each cycle records the modifications it makes to the state of the processor, rather than a copy of the state.
+     * The records of cycle i start at m_undoCycles[i].ops and m_undoCycles[i].entries. Cycles prior to m_undoFirst may
+     * no longer be reversed, and are awaiting being discarded.
+     */
+    std::vector<UndoOp> m_undoOps;
+    std::vector<Entry> m_undoEntries;
+    std::vector<UndoCycle> m_undoCycles;
+    size_t m_undoFirst = 0;
+    unsigned m_maxReverseCycles = 0;
+    bool m_recording = false;  // Whether modifications of the state are recorded; set during a clock cycle
+
+    std::map<DispatchStall, unsigned> m_dispatchStalls;
+    unsigned m_controlflowFlushes;
+    unsigned m_squashed;
+    unsigned m_forwardedLoads;
+    unsigned m_storeWaits;
+    std::map<RVIdiom, unsigned> m_fusedIdioms;
+};
+
+}  // namespace core
+}  // namespace vsrtl
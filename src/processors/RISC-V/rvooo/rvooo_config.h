@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+
+namespace Ripes {
+
+/**
+ * @brief The OoOConfig struct
+ * Parameters of the out-of-order processor. Processors are constructed with the configuration returned by
+ * OoOConfig::current(), which the processor handler loads from the settings as a processor is selected; changing it
+ * has no effect on a processor which has already been constructed.
+ */
+struct OoOConfig {
+    unsigned issueWidth = 2;   // Instructions fetched, dispatched, issued and committed per cycle
+    unsigned robEntries = 16;  // Reorder buffer entries
+    unsigned rsEntries = 8;    // Entries of the unified reservation station
+    unsigned lsqEntries = 8;   // Load/store queue entries
+    unsigned aluLatency = 1;   // Pipelined
+    unsigned mulLatency = 3;   // Pipelined
+    unsigned divLatency = 16;  // Not pipelined; a division occupies the divider until it completes
+    unsigned loadLatency = 2;  // Pipelined; stores compute their address in a single cycle
+    bool fusion = false;       // Dependent idioms dispatched together are fused into a single op
+
+    static constexpr unsigned s_maxIssueWidth = 8;
+    static constexpr unsigned s_maxEntries = 128;
+    static constexpr unsigned s_maxLatency = 64;
+
+    /**
+     * @brief sanitized
+     * @returns the configuration with each parameter clamped to its valid range. The reorder buffer holds at least
+     * issueWidth instructions.
+     */
+    OoOConfig sanitized() const {
+        OoOConfig config = *this;
+        config.issueWidth = std::clamp(issueWidth, 1u, s_maxIssueWidth);
+        config.robEntries = std::clamp(robEntries, config.issueWidth, s_maxEntries);
+        config.rsEntries = std::clamp(rsEntries, 1u, s_maxEntries);
+        config.lsqEntries = std::clamp(lsqEntries, 1u, s_maxEntries);
+        config.aluLatency = std::clamp(aluLatency, 1u, s_maxLatency);
+        config.mulLatency = std::clamp(mulLatency, 1u, s_maxLatency);
+        config.divLatency = std::clamp(divLatency, 1u, s_maxLatency);
+        config.loadLatency = std::clamp(loadLatency, 1u, s_maxLatency);
+        return config;
+    }
+
+    static OoOConfig& current() {
+        static OoOConfig config;
+        return config;
+    }
+};
+
+}  // namespace Ripes
@@ -181,10 +181,15 @@ public:
     bool finished() const override { return m_finished || !stageInfo(0).stage_valid; }
     const std::vector<unsigned> breakpointTriggeringStages() const override { return {0}; }
 
-    MemoryAccess dataMemAccess() const override { return memToAccessInfo(data_mem); }
+    MemoryAccess dataMemAccess() const override {
+        auto dataAccess = memToAccessInfo(data_mem);
+        dataAccess.pc = getPcForStage(0);
+        return dataAccess;
+    }
     MemoryAccess instrMemAccess() const override {
         auto instrAccess = memToAccessInfo(instr_mem);
         instrAccess.type = MemoryAccess::Read;
+        instrAccess.pc = getPcForStage(0);
         return instrAccess;
     }
 
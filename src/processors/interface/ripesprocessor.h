@@ -3,6 +3,7 @@
 #include <QString>
 
 #include <map>
+#include <vector>
 #include "Signals/Signal.h"
 #include "VSRTL/core/vsrtl_design.h"
 
@@ -31,12 +32,29 @@ struct StageInfo {
 /**
  * @brief The MemoryAccess struct
  * Address is byte-aligned, and the accessed bytes are [address : address + bytes[
+ * pc is the program counter of the instruction which performed the access.
  */
 struct MemoryAccess {
     enum Type { None, Read, Write };
     Type type = None;
     AInt address;
     unsigned bytes;
+    AInt pc = 0;
+};
+
+/**
+ * @brief The ControlFlow struct
+ * A control flow instruction resolved by the processor. Calls and returns are jumps which follow the calling convention
+ * of the ISA. fallthrough is the address of the instruction following the control flow instruction, and target is the
+ * address which control is transferred to if taken.
+ */
+struct ControlFlow {
+    enum Kind { None, Branch, Jump, IndirectJump, Call, Return };
+    Kind kind = None;
+    AInt pc = 0;
+    AInt fallthrough = 0;
+    AInt target = 0;
+    bool taken = false;
 };
 
 /**
@@ -66,7 +84,12 @@ public:
      * @brief The Features struct
      * The set of optional features implemented by this processor
      */
-    enum Features { isReversible = 0b1, hasICacheInterface = 0b10, hasDCacheInterface = 0b100 };
+    enum Features {
+        isReversible = 0b1,
+        hasICacheInterface = 0b10,
+        hasDCacheInterface = 0b100,
+        hasMemoryStalls = 0b1000
+    };
 
     unsigned features() const { return m_features; }
 
@@ -135,6 +158,13 @@ public:
      */
     virtual vsrtl::core::AddressSpaceMM& getMemory() = 0;
 
+    /**
+     * @brief writeMemory
+     * Writes up to @p size bytes of @p value to @p address on behalf of the environment of the processor, e.g., by a
+     * system call. Processors which record the modifications of each cycle for reversal record the write.
+     */
+    virtual void writeMemory(AInt address, VInt value, int size) { getMemory().writeMem(address, value, size); }
+
     /**
      * @brief dataMemAccess/instrMemAccess
      * @returns the state of a current access to the instruction or data memory. If the processor did not access the
@@ -233,6 +263,13 @@ public:
      */
     std::function<bool(AInt)> isExecutableAddress;
 
+    /**
+     * @brief isIOAddress
+     * Callback that the processor can use to query the Ripes environment. Returns whether the @p address is within a
+     * memory-mapped I/O region, for which accesses have side effects and must not be performed speculatively.
+     */
+    std::function<bool(AInt)> isIOAddress;
+
     /**
      * @brief trapHandler
      * Callback for the processor to pass control to the Ripes environment whenever a trap must be handled.
@@ -255,9 +292,96 @@ public:
      */
     virtual void setMaxReverseCycles(unsigned cycles) { Q_UNUSED(cycles); }
 
+    /** ===================== FEATURE: Memory stalls ====================== */
+    // Enabled by setting m_features.hasMemoryStalls = true
+
+    /**
+     * @brief stallMemory
+     * Called by the execution environment after the processor has been clocked, to indicate that the memory accesses
+     * of the current cycle require @p cycles cycles in addition to the current cycle to complete.
+     * Processors implementing the hasMemoryStalls feature stall their pipeline for the given number of cycles, which
+     * are included in getCycleCount(). Other processors only account for the cycles in getMemoryStallCycles().
+     */
+    virtual void stallMemory(unsigned cycles) { Q_UNUSED(cycles); }
+
+    /**
+     * @brief getMemoryStallCycles
+     * @returns the number of cycles which the processor has spent waiting for memory.
+     */
+    virtual long long getMemoryStallCycles() const { return 0; }
+
+    /** ====================== Performance counters ======================= */
+
+    /**
+     * @brief The PerfCounter struct
+     * A counter of a microarchitectural event of the processor, e.g., a stall or a flush. If penalty is non-zero, each
+     * event costs the processor penalty cycles, and the counter contributes a component to the CPI stack of the
+     * processor.
+     */
+    struct PerfCounter {
+        QString name;
+        QString description;
+        unsigned penalty = 0;
+        long long value = 0;
+    };
+
+    /**
+     * @brief perfCounters
+     * @returns the performance counters of the processor, in order of registration.
+     */
+    const std::vector<PerfCounter>& perfCounters() const { return m_perfCounters; }
+
+    /**
+     * @brief issueWidth
+     * @returns the number of instructions which the processor may retire in a cycle; the ideal CPI of the processor is
+     * the reciprocal hereof.
+     */
+    virtual unsigned issueWidth() const { return 1; }
+
+    /** ========================== Control flow ============================ */
+
+    /**
+     * @brief controlFlow
+     * @returns the control flow instruction which the processor resolves in the current cycle. If no control flow
+     * instruction is resolved, kind == ControlFlow::None. As for memory accesses, nothing is resolved in cycles spent
+     * stalling for memory.
+     */
+    virtual ControlFlow controlFlow() const { return ControlFlow(); }
+
+    /**
+     * @brief controlFlowPenalty
+     * @returns the number of cycles lost when the processor redirects fetching upon resolving a control flow
+     * instruction, i.e., the number of cycles of younger instructions which are flushed. Processors which fetch the
+     * target of control flow instructions without delay return 0.
+     */
+    virtual unsigned controlFlowPenalty() const { return 0; }
+
     /** ======================================================================*/
 
 protected:
+    /**
+     * @brief registerPerfCounter
+     * Registers a performance counter. To be called during processor construction.
+     * @returns the index of the counter, by which its events are counted.
+     */
+    unsigned registerPerfCounter(const QString& name, const QString& description, unsigned penalty = 0) {
+        m_perfCounters.push_back({name, description, penalty});
+        return m_perfCounters.size() - 1;
+    }
+
+    /**
+     * @brief countPerfEvent
+     * Counts @p events events of the performance counter @p counter. Processors count the events of a cycle when it is
+     * clocked, and uncount them when the cycle is reversed.
+     */
+    void countPerfEvent(unsigned counter, long long events) { m_perfCounters[counter].value += events; }
+
+    void resetPerfCounters() {
+        for (auto& counter : m_perfCounters) {
+            counter.value = 0;
+        }
+    }
+
     /**
      * @brief clock
      * Implementation of processor clocking.
@@ -267,6 +391,9 @@ protected:
     // m_features should be adjusted accordingly during processor construction
     unsigned m_features;
     bool m_emitsSignals = true;
+
+private:
+    std::vector<PerfCounter> m_perfCounters;
 };
 
 }  // namespace Ripes
@@ -4,6 +4,8 @@
  * Interface for all VSRTL-based Ripes processors
  */
 
+#include <deque>
+
 #include "RISC-V/riscv.h"
 #include "VSRTL/core/vsrtl_design.h"
 #include "interface/ripesprocessor.h"
@@ -24,15 +26,61 @@ public:
 
     virtual void resetProcessor() override {
         m_instructionsRetired = 0;
+        m_memStalls.clear();
+        m_memStallCycles = 0;
+        resetPerfCounters();
         reset();
     }
 
-    virtual void reverseProcessor() override { reverse(); }
+    virtual void reverseProcessor() override {
+        if (reverseMemoryStall()) {
+            return;
+        }
+
+        reverse();
+
+        // Discard the memory stalls which were initiated in the reversed cycle
+        while (!m_memStalls.empty() && m_memStalls.back().cycle > getCycleCount()) {
+            if (!(m_features & Features::hasMemoryStalls)) {
+                m_memStallCycles -= m_memStalls.back().cycles;
+            }
+            m_memStalls.pop_back();
+        }
+    }
 
     long long getInstructionsRetired() const override { return m_instructionsRetired; }
-    long long getCycleCount() const override { return m_cycleCount; }
+    long long getCycleCount() const override {
+        return m_cycleCount + ((m_features & Features::hasMemoryStalls) ? m_memStallCycles : 0);
+    }
     void setMaxReverseCycles(unsigned cycles) override { setReverseStackSize(cycles); }
 
+    void stallMemory(unsigned cycles) override {
+        if (cycles == 0) {
+            return;
+        }
+
+        const long long cycle = getCycleCount();
+        if (m_memStalls.empty() || m_memStalls.back().cycle != cycle) {
+            m_memStalls.push_back({cycle, 0});
+            if (m_memStalls.size() > std::max<unsigned>(vsrtl::core::ClockedComponent::reverseStackSize(), 1)) {
+                // Stalls which may no longer be reversed are discarded
+                m_memStalls.pop_front();
+            }
+        }
+
+        auto& stall = m_memStalls.back();
+        if (m_features & Features::hasMemoryStalls) {
+            // Instruction and data memory accesses of a cycle are performed in parallel; the pipeline is stalled until
+            // the slowest of these completes.
+            stall.cycles = std::max(stall.cycles, cycles);
+        } else {
+            stall.cycles += cycles;
+            m_memStallCycles += cycles;
+        }
+    }
+
+    long long getMemoryStallCycles() const override { return m_memStallCycles; }
+
     void postConstruct() override {
         /**
          * VSRTL designs must call verifyAndInitialize after being constructed.
@@ -41,6 +89,39 @@ public:
     }
 
 protected:
+    /**
+     * @brief clockMemoryStall
+     * To be called by processors implementing the hasMemoryStalls feature before clocking their design. If the
+     * processor is waiting for memory, the cycle is spent stalling, and true is returned. In this case, the design
+     * shall not be clocked; the state of the design is retained until the memory access has completed.
+     */
+    bool clockMemoryStall() {
+        if (!(m_features & Features::hasMemoryStalls) || m_memStalls.empty()) {
+            return false;
+        }
+        const auto& stall = m_memStalls.back();
+        if (getCycleCount() >= stall.cycle + stall.cycles) {
+            return false;
+        }
+        m_memStallCycles++;
+        processorWasClocked.Emit();
+        return true;
+    }
+
+    /**
+     * @brief isMemoryStalled
+     * @returns true if the current cycle is spent waiting for a memory access which was initiated in a previous cycle.
+     * The memories shall not be reported as being accessed in such cycles.
+     */
+    bool isMemoryStalled() const {
+        if (!(m_features & Features::hasMemoryStalls) || m_memStalls.empty()) {
+            return false;
+        }
+        const auto& stall = m_memStalls.back();
+        const long long cycle = getCycleCount();
+        return cycle > stall.cycle && cycle <= stall.cycle + stall.cycles;
+    }
+
     MemoryAccess memToAccessInfo(const vsrtl::core::BaseMemory<true>* memory) const {
         MemoryAccess access;
         switch (memory->opSig()) {
@@ -101,6 +182,37 @@ protected:
     // m_instructionsRetired should be modified by the processor when it retires (or "un-retires", while reversing)
     // an instruction
     long long m_instructionsRetired = 0;
+
+private:
+    /**
+     * @brief reverseMemoryStall
+     * Reverses a cycle which was spent stalling for memory. Returns false if the cycle to be reversed was not a stall
+     * cycle, in which case the design shall be reversed.
+     */
+    bool reverseMemoryStall() {
+        if (!isMemoryStalled()) {
+            return false;
+        }
+        m_memStallCycles--;
+        processorWasReversed.Emit();
+        return true;
+    }
+
+    /**
+     * @brief The MemoryStall struct
+     * A stall of @p cycles cycles for the memory accesses initiated in cycle @p cycle.
+     */
+    struct MemoryStall {
+        long long cycle;
+        unsigned cycles;
+    };
+
+    /**
+     * @brief m_memStalls
+     * Memory stalls in order of initiation, retained for as long as the initiating cycle may be reversed.
+     */
+    std::deque<MemoryStall> m_memStalls;
+    long long m_memStallCycles = 0;
 };
 
 }  // namespace Ripes
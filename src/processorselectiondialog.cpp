@@ -3,8 +3,12 @@
 
 #include <QCheckBox>
 #include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QSpinBox>
 
 #include "processorhandler.h"
+#include "processors/RISC-V/rvooo/rvooo_config.h"
 #include "radix.h"
 #include "ripessettings.h"
 
@@ -64,7 +68,9 @@ ProcessorSelectionDialog::ProcessorSelectionDialog(QWidget* parent)
         }
     });
 
-    connect(m_ui->buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    setupOoOConfig();
+
+    connect(m_ui->buttonBox, &QDialogButtonBox::accepted, this, &ProcessorSelectionDialog::accept);
     connect(m_ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
 
     // Initialize extensions for processors; default to all available extensions
@@ -88,6 +94,52 @@ RegisterInitialization ProcessorSelectionDialog::getRegisterInitialization() con
     return m_ui->regInitWidget->getInitialization();
 }
 
+void ProcessorSelectionDialog::setupOoOConfig() {
+    m_oooConfig = new QGroupBox("Out-of-order configuration", this);
+    auto* layout = new QFormLayout(m_oooConfig);
+    const auto addSpinBox = [&](const QString& key, const QString& label, unsigned min, unsigned max,
+                                const QString& tooltip) {
+        auto* spinBox = new QSpinBox(m_oooConfig);
+        spinBox->setRange(min, max);
+        spinBox->setValue(RipesSettings::value(key).toInt());
+        spinBox->setToolTip(tooltip);
+        layout->addRow(label, spinBox);
+        m_oooConfigSpinBoxes.push_back({key, spinBox});
+    };
+    addSpinBox(RIPES_SETTING_OOO_ISSUEWIDTH, "Issue width:", 1, OoOConfig::s_maxIssueWidth,
+               "Instructions fetched, dispatched, issued and committed per cycle");
+    addSpinBox(RIPES_SETTING_OOO_ROBENTRIES, "ROB entries:", 1, OoOConfig::s_maxEntries,
+               "Reorder buffer entries. The reorder buffer holds at least as many instructions as the issue width.");
+    addSpinBox(RIPES_SETTING_OOO_RSENTRIES, "RS entries:", 1, OoOConfig::s_maxEntries,
+               "Entries of the unified reservation station");
+    addSpinBox(RIPES_SETTING_OOO_LSQENTRIES, "LSQ entries:", 1, OoOConfig::s_maxEntries, "Load/store queue entries");
+    addSpinBox(RIPES_SETTING_OOO_ALULATENCY, "ALU latency:", 1, OoOConfig::s_maxLatency,
+               "Cycles of the pipelined ALUs");
+    addSpinBox(RIPES_SETTING_OOO_MULLATENCY, "MUL latency:", 1, OoOConfig::s_maxLatency,
+               "Cycles of the pipelined multiplier");
+    addSpinBox(RIPES_SETTING_OOO_DIVLATENCY, "DIV latency:", 1, OoOConfig::s_maxLatency,
+               "Cycles of the divider, which is not pipelined");
+    addSpinBox(RIPES_SETTING_OOO_LOADLATENCY, "Load latency:", 1, OoOConfig::s_maxLatency,
+               "Cycles of loads in the load/store unit");
+    m_oooFusion = new QCheckBox(m_oooConfig);
+    m_oooFusion->setChecked(RipesSettings::value(RIPES_SETTING_OOO_FUSION).toBool());
+    m_oooFusion->setToolTip("Fuse dependent lui+addi, auipc+jalr, slli+add and compare+branch pairs which are "
+                            "dispatched together into a single op, occupying a single RS entry, issue slot and ALU");
+    layout->addRow("Macro-op fusion:", m_oooFusion);
+    m_ui->infoLayout->addWidget(m_oooConfig);
+    m_oooConfig->setVisible(false);
+}
+
+void ProcessorSelectionDialog::accept() {
+    if (isOoOProcessor(m_selectedID)) {
+        for (const auto& [key, spinBox] : m_oooConfigSpinBoxes) {
+            RipesSettings::setValue(key, spinBox->value());
+        }
+        RipesSettings::setValue(RIPES_SETTING_OOO_FUSION, m_oooFusion->isChecked());
+    }
+    QDialog::accept();
+}
+
 ProcessorSelectionDialog::~ProcessorSelectionDialog() {
     delete m_ui;
 }
@@ -132,6 +184,7 @@ void ProcessorSelectionDialog::selectionChanged(QTreeWidgetItem* current, QTreeW
     for (const auto& layout : desc->layouts) {
         m_ui->layout->addItem(layout.name);
     }
+    m_oooConfig->setVisible(isOoOProcessor(id));
 
     // Setup extensions; Clear previously selected extensions and add whatever extensions are supported for the selected
     // processor
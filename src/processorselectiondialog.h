@@ -3,6 +3,10 @@
 #include <QDialog>
 #include <QTreeWidget>
 
+QT_FORWARD_DECLARE_CLASS(QCheckBox)
+QT_FORWARD_DECLARE_CLASS(QGroupBox)
+QT_FORWARD_DECLARE_CLASS(QSpinBox)
+
 #include "processorregistry.h"
 
 namespace Ripes {
@@ -23,15 +27,29 @@ public:
     const Layout* getSelectedLayout() const;
     QStringList getEnabledExtensions() const;
 
+public slots:
+    /**
+     * @brief accept
+     * Stores the configuration of the selected processor, if configurable, in the settings.
+     */
+    void accept() override;
+
 private slots:
     void selectionChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous);
 
 private:
     bool isCPUItem(const QTreeWidgetItem* item) const;
+    void setupOoOConfig();
+    static bool isOoOProcessor(ProcessorID id) { return id == ProcessorID::RV32_OOO || id == ProcessorID::RV64_OOO; }
 
     enum ProcessorTreeColums { ProcessorColumn, ColumnCount };
     ProcessorID m_selectedID;
     Ui::ProcessorSelectionDialog* m_ui;
     std::map<ProcessorID, QStringList> m_selectedExtensionsForID;
+
+    // Settings keys of the out-of-order processor configuration, alongside the spin boxes editing them
+    QGroupBox* m_oooConfig = nullptr;
+    std::vector<std::pair<QString, QSpinBox*>> m_oooConfigSpinBoxes;
+    QCheckBox* m_oooFusion = nullptr;
 };
 }  // namespace Ripes
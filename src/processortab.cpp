@@ -2,6 +2,7 @@
 #include "ui_processortab.h"
 
 #include <QDir>
+#include <QFileDialog>
 #include <QFontMetrics>
 #include <QMessageBox>
 #include <QPushButton>
@@ -9,10 +10,16 @@
 #include <QSpinBox>
 #include <QTemporaryFile>
 
+#include "branchpredictor.h"
+#include "branchpredictordialog.h"
+#include "callgraphdialog.h"
 #include "consolewidget.h"
+#include "executionprofiler.h"
 #include "instructionmodel.h"
+#include "perfcounterdialog.h"
 #include "pipelinediagrammodel.h"
 #include "pipelinediagramwidget.h"
+#include "pipelinetraceexporter.h"
 #include "processorhandler.h"
 #include "processorregistry.h"
 #include "processorselectiondialog.h"
@@ -89,6 +96,8 @@ ProcessorTab::ProcessorTab(QToolBar* controlToolbar, QToolBar* additionalToolbar
     }
 
     m_stageModel = new PipelineDiagramModel(this);
+    m_traceExporter = new PipelineTraceExporter(this);
+    m_branchPredictor = new BranchPredictor(this);
 
     updateInstructionModel();
     connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun, this, &ProcessorTab::updateStatistics);
@@ -241,6 +250,51 @@ void ProcessorTab::setupSimulatorActions(QToolBar* controlToolbar) {
     connect(m_pipelineDiagramAction, &QAction::triggered, this, &ProcessorTab::showPipelineDiagram);
     m_toolbar->addAction(m_pipelineDiagramAction);
 
+    const QIcon traceIcon = QIcon(":/icons/trace.svg");
+    m_pipelineTraceAction = new QAction(traceIcon, "Export pipeline trace", this);
+    m_pipelineTraceAction->setCheckable(true);
+    m_pipelineTraceAction->setToolTip(
+        "Export the execution of the processor, from the current cycle onwards, to a pipeline trace which may be "
+        "viewed in the Konata pipeline viewer.\nExporting stops when unchecked, or when the processor is reset or "
+        "reversed.");
+    connect(m_pipelineTraceAction, &QAction::toggled, this, &ProcessorTab::exportPipelineTrace);
+    connect(m_traceExporter, &PipelineTraceExporter::stopped, this, [=] { m_pipelineTraceAction->setChecked(false); });
+    m_toolbar->addAction(m_pipelineTraceAction);
+
+    const QIcon profileIcon = QIcon(":/icons/analytics.svg");
+    m_exportProfileAction = new QAction(profileIcon, "Export execution profile", this);
+    m_exportProfileAction->setToolTip(
+        "Export the cycles spent by, and the executions of, each instruction of the program since the processor was "
+        "reset.");
+    m_exportProfileAction->setEnabled(false);
+    connect(m_exportProfileAction, &QAction::triggered, this, &ProcessorTab::exportExecutionProfile);
+    m_toolbar->addAction(m_exportProfileAction);
+
+    const QIcon callGraphIcon = QIcon(":/icons/graph.svg");
+    m_callGraphAction = new QAction(callGraphIcon, "Show call graph profile", this);
+    m_callGraphAction->setToolTip(
+        "Show the cycles, instructions and data cache misses of each function of the program since the processor was "
+        "reset.");
+    m_callGraphAction->setEnabled(false);
+    connect(m_callGraphAction, &QAction::triggered, this, &ProcessorTab::showCallGraph);
+    m_toolbar->addAction(m_callGraphAction);
+
+    const QIcon perfCountersIcon = QIcon(":/icons/info.svg");
+    m_perfCountersAction = new QAction(perfCountersIcon, "Show performance counters", this);
+    m_perfCountersAction->setToolTip(
+        "Show the stalls, flushes and other microarchitectural events counted by the processor since it was reset, and "
+        "the breakdown of its CPI into the cycles lost to each of these.");
+    connect(m_perfCountersAction, &QAction::triggered, this, &ProcessorTab::showPerfCounters);
+    m_toolbar->addAction(m_perfCountersAction);
+
+    const QIcon branchPredictorIcon = QIcon(":/icons/compass.svg");
+    m_branchPredictorAction = new QAction(branchPredictorIcon, "Show branch predictor", this);
+    m_branchPredictorAction->setToolTip(
+        "Configure a branch predictor, and show how accurately it predicts the control flow which the processor has "
+        "resolved since it was reset, and the cycles which the processor would have saved through it.");
+    connect(m_branchPredictorAction, &QAction::triggered, this, &ProcessorTab::showBranchPredictor);
+    m_toolbar->addAction(m_branchPredictorAction);
+
     m_darkmodeAction = new QAction("Processor darkmode", this);
     m_darkmodeAction->setCheckable(true);
     connect(m_darkmodeAction, &QAction::toggled, m_vsrtlWidget, [=](bool checked) {
@@ -255,14 +309,20 @@ void ProcessorTab::updateStatistics() {
     static long long lastCycleCount = ProcessorHandler::getProcessor()->getCycleCount();
 
     const auto timeNow = std::chrono::system_clock::now();
-    const auto cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
-    const auto instrsRetired = ProcessorHandler::getProcessor()->getInstructionsRetired();
+    const auto* processor = ProcessorHandler::getProcessor();
+    const auto memStallCycles = processor->getMemoryStallCycles();
+    // Processors which do not stall for memory account for the memory stall cycles separately from the cycles in
+    // which the processor was clocked.
+    const auto cycleCount = processor->getCycleCount() +
+                            ((processor->features() & RipesProcessor::Features::hasMemoryStalls) ? 0 : memStallCycles);
+    const auto instrsRetired = processor->getInstructionsRetired();
     const auto timeDiff =
         std::chrono::duration_cast<std::chrono::milliseconds>(timeNow - lastUpdateTime).count() / 1000.0;  // in seconds
     const auto cycleDiff = cycleCount - lastCycleCount;
 
     // Cycle count
     m_ui->cycleCount->setText(QString::number(cycleCount));
+    m_ui->cycleCount->setToolTip(memStallCycles != 0 ? QString::number(memStallCycles) + " memory stall cycles" : "");
     // Instructions retired
     m_ui->instructionsRetired->setText(QString::number(instrsRetired));
     QString cpiText, ipcText;
@@ -347,9 +407,23 @@ void ProcessorTab::processorSelection() {
     }
 }
 
+void ProcessorTab::setProfiledCache(const std::shared_ptr<const CacheSim>& cache) {
+    m_profiledCache = cache;
+    m_instrModel->setProfiledCache(cache);
+}
+
+void ProcessorTab::setExecutionProfiler(const ExecutionProfiler* profiler) {
+    m_profiler = profiler;
+    m_instrModel->setExecutionProfiler(profiler);
+    m_exportProfileAction->setEnabled(profiler != nullptr);
+    m_callGraphAction->setEnabled(profiler != nullptr);
+}
+
 void ProcessorTab::updateInstructionModel() {
     auto* oldModel = m_instrModel;
     m_instrModel = new InstructionModel(this);
+    m_instrModel->setProfiledCache(m_profiledCache);
+    m_instrModel->setExecutionProfiler(m_profiler);
 
     // Update the instruction view according to the newly created model
     m_ui->instructionView->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -372,6 +446,15 @@ void ProcessorTab::updateInstructionModel() {
             1.25);
     m_ui->instructionView->horizontalHeader()->setSectionResizeMode(InstructionModel::Instruction,
                                                                     QHeaderView::Stretch);
+    // As with the "stage" section, the profile and cache sections change frequently and are sized wrt. their headers.
+    for (const auto column : {InstructionModel::Executions, InstructionModel::Cycles, InstructionModel::Misses,
+                              InstructionModel::Writebacks}) {
+        m_ui->instructionView->horizontalHeader()->setSectionResizeMode(column, QHeaderView::Interactive);
+        m_ui->instructionView->horizontalHeader()->resizeSection(
+            column,
+            ivfm.horizontalAdvance(m_instrModel->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString()) *
+                1.25);
+    }
     // Make the instruction view follow the instruction which is currently present in the first stage of the
     connect(m_instrModel, &InstructionModel::firstStageInstrChanged, this, &ProcessorTab::setInstructionViewCenterRow);
 
@@ -405,6 +488,7 @@ void ProcessorTab::enableSimulatorControls() {
     m_reverseAction->setEnabled(m_vsrtlWidget->isReversible());
     m_resetAction->setEnabled(true);
     m_pipelineDiagramAction->setEnabled(true);
+    m_pipelineTraceAction->setEnabled(true);
 }
 
 void ProcessorTab::updateInstructionLabels() {
@@ -481,6 +565,7 @@ void ProcessorTab::autoClock(bool state) {
     m_resetAction->setEnabled(!state);
     m_displayValuesAction->setEnabled(!state);
     m_pipelineDiagramAction->setEnabled(!state);
+    m_pipelineTraceAction->setEnabled(!state);
     m_runAction->setEnabled(!state);
 }
 
@@ -505,6 +590,11 @@ void ProcessorTab::run(bool state) {
     m_resetAction->setEnabled(!state);
     m_displayValuesAction->setEnabled(!state);
     m_pipelineDiagramAction->setEnabled(!state);
+    m_pipelineTraceAction->setEnabled(!state);
+    m_exportProfileAction->setEnabled(!state && m_profiler);
+    m_callGraphAction->setEnabled(!state && m_profiler);
+    m_perfCountersAction->setEnabled(!state);
+    m_branchPredictorAction->setEnabled(!state);
 
     // Disable widgets which are not updated when running the processor
     m_vsrtlWidget->setEnabled(!state);
@@ -521,4 +611,49 @@ void ProcessorTab::showPipelineDiagram() {
     auto w = PipelineDiagramWidget(m_stageModel);
     w.exec();
 }
+
+void ProcessorTab::exportExecutionProfile() {
+    const QString filename =
+        QFileDialog::getSaveFileName(this, "Export execution profile", "", "Execution profiles (*.txt);;All files (*)");
+    if (filename.isEmpty()) {
+        return;
+    }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, "Error", "Could not write execution profile to '" + filename + "'");
+        return;
+    }
+    QTextStream out(&file);
+    m_profiler->writeReport(out);
+}
+
+void ProcessorTab::showCallGraph() {
+    CallGraphDialog dialog(m_profiler->getCallGraph(), this);
+    dialog.exec();
+}
+
+void ProcessorTab::showPerfCounters() {
+    PerfCounterDialog dialog(this);
+    dialog.exec();
+}
+
+void ProcessorTab::showBranchPredictor() {
+    BranchPredictorDialog dialog(*m_branchPredictor, this);
+    dialog.exec();
+}
+
+void ProcessorTab::exportPipelineTrace(bool state) {
+    if (!state) {
+        m_traceExporter->stop();
+        return;
+    }
+    const QString filename = QFileDialog::getSaveFileName(this, "Export pipeline trace", "",
+                                                          "Konata pipeline traces (*.log *.log.gz);;All files (*)");
+    if (filename.isEmpty()) {
+        m_pipelineTraceAction->setChecked(false);
+    } else if (!m_traceExporter->start(filename)) {
+        QMessageBox::warning(this, "Error", "Could not write pipeline trace to '" + filename + "'");
+        m_pipelineTraceAction->setChecked(false);
+    }
+}
 }  // namespace Ripes
@@ -6,6 +6,8 @@
 #include <QToolBar>
 #include <QWidget>
 
+#include <memory>
+
 #include "ripes_types.h"
 #include "ripestab.h"
 
@@ -20,9 +22,13 @@ namespace Ui {
 class ProcessorTab;
 }
 
+class BranchPredictor;
+class CacheSim;
+class ExecutionProfiler;
 class InstructionModel;
 class RegisterModel;
 class PipelineDiagramModel;
+class PipelineTraceExporter;
 struct Layout;
 
 class ProcessorTab : public RipesTab {
@@ -36,6 +42,18 @@ public:
 
     void initRegWidget();
 
+    /**
+     * @brief setProfiledCache
+     * Sets the cache whose misses are attributed to the instructions of the instruction view.
+     */
+    void setProfiledCache(const std::shared_ptr<const CacheSim>& cache);
+
+    /**
+     * @brief setExecutionProfiler
+     * Sets the profiler whose execution profile is shown in the instruction view, and which may be exported.
+     */
+    void setExecutionProfiler(const ExecutionProfiler* profiler);
+
 public slots:
     void pause();
     void restart();
@@ -54,6 +72,11 @@ private slots:
     void autoClock(bool state);
     void setInstructionViewCenterRow(int row);
     void showPipelineDiagram();
+    void exportPipelineTrace(bool state);
+    void exportExecutionProfile();
+    void showCallGraph();
+    void showPerfCounters();
+    void showBranchPredictor();
 
 private:
     void setupSimulatorActions(QToolBar* controlToolbar);
@@ -65,7 +88,11 @@ private:
 
     Ui::ProcessorTab* m_ui = nullptr;
     InstructionModel* m_instrModel = nullptr;
+    std::shared_ptr<const CacheSim> m_profiledCache;
+    const ExecutionProfiler* m_profiler = nullptr;
     PipelineDiagramModel* m_stageModel = nullptr;
+    PipelineTraceExporter* m_traceExporter = nullptr;
+    BranchPredictor* m_branchPredictor = nullptr;
 
     vsrtl::VSRTLWidget* m_vsrtlWidget = nullptr;
 
@@ -80,6 +107,11 @@ private:
     QAction* m_runAction = nullptr;
     QAction* m_displayValuesAction = nullptr;
     QAction* m_pipelineDiagramAction = nullptr;
+    QAction* m_pipelineTraceAction = nullptr;
+    QAction* m_exportProfileAction = nullptr;
+    QAction* m_callGraphAction = nullptr;
+    QAction* m_perfCountersAction = nullptr;
+    QAction* m_branchPredictorAction = nullptr;
     QAction* m_reverseAction = nullptr;
     QAction* m_resetAction = nullptr;
     QAction* m_darkmodeAction = nullptr;
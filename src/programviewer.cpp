@@ -29,6 +29,11 @@ ProgramViewer::ProgramViewer(QWidget* parent) : HighlightableTextEdit(parent) {
     setTabStopDistance(QFontMetricsF(m_font).width(' ') * 4);
 
     setLineWrapMode(QPlainTextEdit::NoWrap);
+
+    connect(RipesSettings::getObserver(RIPES_SETTING_EDITORMISSANNOTATIONS), &SettingObserver::modified, this,
+            &ProgramViewer::updateHighlightedAddresses);
+    connect(RipesSettings::getObserver(RIPES_SETTING_EDITORPROFILEANNOTATIONS), &SettingObserver::modified, this,
+            &ProgramViewer::updateHighlightedAddresses);
 }
 
 void ProgramViewer::clearBreakpoints() {
@@ -114,6 +119,28 @@ void ProgramViewer::updateHighlightedAddresses() {
         }
     }
 
+    if (m_profiledCache && RipesSettings::value(RIPES_SETTING_EDITORMISSANNOTATIONS).toBool()) {
+        std::map<int, CacheSim::PCStats> blockStats;
+        for (const auto& [pc, stats] : m_profiledCache->getPCProfile()) {
+            auto block = blockForAddress(pc);
+            if (block.isValid()) {
+                blockStats[block.blockNumber()] = stats;
+            }
+        }
+        highlightMisses(blockStats);
+    }
+
+    if (m_profiler && RipesSettings::value(RIPES_SETTING_EDITORPROFILEANNOTATIONS).toBool()) {
+        std::map<int, ExecutionProfiler::PCStats> blockStats;
+        for (const auto& [pc, stats] : m_profiler->getPCProfile()) {
+            auto block = blockForAddress(pc);
+            if (block.isValid()) {
+                blockStats[block.blockNumber()] = stats;
+            }
+        }
+        highlightProfile(blockStats);
+    }
+
     if (m_following) {
         updateCenterAddressFromProcessor();
     }
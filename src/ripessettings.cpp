@@ -1,6 +1,7 @@
 #include "ripessettings.h"
 #include "assembler/program.h"
 #include "cachesim/cachesim.h"
+#include "processors/RISC-V/rvooo/rvooo_config.h"
 
 #include <QCoreApplication>
 #include <map>
@@ -32,10 +33,13 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_EDITORREGS, true},
     {RIPES_SETTING_EDITORCONSOLE, true},
     {RIPES_SETTING_EDITORSTAGEHIGHLIGHTING, true},
+    {RIPES_SETTING_EDITORMISSANNOTATIONS, false},
+    {RIPES_SETTING_EDITORPROFILEANNOTATIONS, false},
 
-    {RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES, 100},
     {RIPES_SETTING_CACHE_MAXCYCLES, 10000},
     {RIPES_SETTING_CACHE_MAXPOINTS, 1000},
+    {RIPES_SETTING_CACHE_TIMING, false},
+    {RIPES_SETTING_CACHE_MEMLATENCY, 20},
     {RIPES_SETTING_CACHE_PRESETS,
      QVariant::fromValue<QList<CachePreset>>(
          {CachePreset{"32-entry 4-word direct-mapped", 2, 5, 0, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate,
@@ -44,6 +48,15 @@ const std::map<QString, QVariant> s_defaultSettings = {
                       WriteAllocPolicy::WriteAllocate, ReplPolicy::LRU},
           CachePreset{"32-entry 4-word 2-way set associative", 2, 4, 1, WritePolicy::WriteBack,
                       WriteAllocPolicy::WriteAllocate, ReplPolicy::LRU}})},
+    {RIPES_SETTING_OOO_ISSUEWIDTH, OoOConfig().issueWidth},
+    {RIPES_SETTING_OOO_ROBENTRIES, OoOConfig().robEntries},
+    {RIPES_SETTING_OOO_RSENTRIES, OoOConfig().rsEntries},
+    {RIPES_SETTING_OOO_LSQENTRIES, OoOConfig().lsqEntries},
+    {RIPES_SETTING_OOO_ALULATENCY, OoOConfig().aluLatency},
+    {RIPES_SETTING_OOO_MULLATENCY, OoOConfig().mulLatency},
+    {RIPES_SETTING_OOO_DIVLATENCY, OoOConfig().divLatency},
+    {RIPES_SETTING_OOO_LOADLATENCY, OoOConfig().loadLatency},
+    {RIPES_SETTING_OOO_FUSION, OoOConfig().fusion},
 
     // Program state preserving settings
     {RIPES_GLOBALSIGNAL_QUIT, 0},
@@ -59,6 +72,7 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_SOURCECODE, ""},
     {RIPES_SETTING_DARKMODE, false},
     {RIPES_SETTING_SHOWSIGNALS, false},
+    {RIPES_SETTING_CACHE_MISSHEATMAP, false},
     {RIPES_SETTING_INPUT_TYPE, static_cast<unsigned>(SourceType::Assembly)},
     {RIPES_SETTING_AUTOCLOCK_INTERVAL, 100},
 
@@ -26,12 +26,22 @@ namespace Ripes {
 #define RIPES_SETTING_ASSEMBLER_DATASTART ("data_start")
 #define RIPES_SETTING_ASSEMBLER_BSSSTART ("bss_start")
 
-#define RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES ("pipelinediagram_maxcycles")
 #define RIPES_SETTING_PERIPHERALS_START ("peripheral_start")
 #define RIPES_SETTING_CACHE_MAXCYCLES ("cacheplot_maxcycles")
 #define RIPES_SETTING_CACHE_MAXPOINTS ("cacheplot_maxpoints")
 #define RIPES_SETTING_CACHE_PRESETS ("cache_presets")
+#define RIPES_SETTING_CACHE_TIMING ("cache_timing")
+#define RIPES_SETTING_CACHE_MEMLATENCY ("cache_memlatency")
 #define RIPES_SETTING_PERIPHERAL_SETTINGS ("peripheral_settings")
+#define RIPES_SETTING_OOO_ISSUEWIDTH ("ooo_issue_width")
+#define RIPES_SETTING_OOO_ROBENTRIES ("ooo_rob_entries")
+#define RIPES_SETTING_OOO_RSENTRIES ("ooo_rs_entries")
+#define RIPES_SETTING_OOO_LSQENTRIES ("ooo_lsq_entries")
+#define RIPES_SETTING_OOO_ALULATENCY ("ooo_alu_latency")
+#define RIPES_SETTING_OOO_MULLATENCY ("ooo_mul_latency")
+#define RIPES_SETTING_OOO_DIVLATENCY ("ooo_div_latency")
+#define RIPES_SETTING_OOO_LOADLATENCY ("ooo_load_latency")
+#define RIPES_SETTING_OOO_FUSION ("ooo_fusion")
 
 // This is not really a setting, but instead a method to leverage the static observer objects that are generated for a
 // setting. Used for other objects to hook into a signal emitted just before the application closes.
@@ -49,10 +59,13 @@ namespace Ripes {
 #define RIPES_SETTING_SOURCECODE ("sourcecode")
 #define RIPES_SETTING_DARKMODE ("darkmode")
 #define RIPES_SETTING_SHOWSIGNALS ("show_signals")
+#define RIPES_SETTING_CACHE_MISSHEATMAP ("cache_missheatmap")
 #define RIPES_SETTING_AUTOCLOCK_INTERVAL ("autoclock_interval")
 #define RIPES_SETTING_EDITORREGS ("editor_regs")
 #define RIPES_SETTING_EDITORCONSOLE ("editor_console")
 #define RIPES_SETTING_EDITORSTAGEHIGHLIGHTING ("editor_stage_highlighting")
+#define RIPES_SETTING_EDITORMISSANNOTATIONS ("editor_miss_annotations")
+#define RIPES_SETTING_EDITORPROFILEANNOTATIONS ("editor_profile_annotations")
 
 #define RIPES_SETTING_HAS_SAVEFILE ("has_savefile")
 #define RIPES_SETTING_SAVEPATH ("savepath")
@@ -310,6 +310,18 @@ QWidget* SettingsDialog::createEditorPage() {
     appendToLayout({editorStageHighlightingLabel, editorStageHighlightingCheckbox}, pageLayout,
                    "Show (or hide) highlighting of processor stages in the program source code.");
 
+    auto [editorMissAnnotationsLabel, editorMissAnnotationsCheckbox] =
+        createSettingsWidgets<QCheckBox>(RIPES_SETTING_EDITORMISSANNOTATIONS, "Annotate data cache misses");
+    appendToLayout({editorMissAnnotationsLabel, editorMissAnnotationsCheckbox}, pageLayout,
+                   "Annotate the instructions of the program, in both the source code and the program viewer, with the "
+                   "number of L1 data cache misses and writebacks which they caused.");
+
+    auto [editorProfileAnnotationsLabel, editorProfileAnnotationsCheckbox] =
+        createSettingsWidgets<QCheckBox>(RIPES_SETTING_EDITORPROFILEANNOTATIONS, "Annotate execution profile");
+    appendToLayout({editorProfileAnnotationsLabel, editorProfileAnnotationsCheckbox}, pageLayout,
+                   "Annotate the instructions of the program, in both the source code and the program viewer, with the "
+                   "number of cycles spent executing them and the number of times they were executed.");
+
     // ===== Source formatter
     auto* formatterGroupBox = new QGroupBox("Formatter");
     appendToLayout(formatterGroupBox, pageLayout);
@@ -371,16 +383,22 @@ QWidget* SettingsDialog::createEnvironmentPage() {
     appendToLayout(
         {maxPointsLabel, maxPointsSb}, pageLayout,
         "Minimum number of points to be kept in the cache plot. Once 2x this amount is reached, the cache "
-        "plot will be resampled to this minimum value, and new points will be added based on the sampling "
-        "rate after the resampling. This resampling allows for real-time plotting regardless of the number of "
-        "simulation cycles.");
-
-    auto [maxPipeDiagCycLabel, maxPipeDiagCycSb] =
-        createSettingsWidgets<QSpinBox>(RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES, "Max. pipeline diagram cycles:");
-    maxPipeDiagCycSb->setMinimum(0);
-    maxPipeDiagCycSb->setMaximum(INT_MAX);
-    appendToLayout({maxPipeDiagCycLabel, maxPipeDiagCycSb}, pageLayout,
-                   "Maximum number of cycles to be recorded in the pipeline diagram.");
+        "plot will be downsampled to this minimum value, and new points will be added based on the sampling "
+        "rate after the downsampling. Downsampling retains the extremes of the plot, such as spikes, and allows "
+        "for real-time plotting regardless of the number of simulation cycles.");
+
+    appendToLayout(createSettingsWidgets<QCheckBox>(RIPES_SETTING_CACHE_TIMING, "Cache timing model"), pageLayout,
+                   "Stall the processor for the latency of each cache access, as configured per cache level in the "
+                   "cache tab. The 5-stage and dual-issue processors freeze their entire pipeline for the stall "
+                   "cycles, whereas the stall cycles are only added to the cycle count of the other processors.");
+
+    auto [memLatencyLabel, memLatencySb] =
+        createSettingsWidgets<QSpinBox>(RIPES_SETTING_CACHE_MEMLATENCY, "Main memory latency (cycles):");
+    memLatencySb->setMinimum(1);
+    memLatencySb->setMaximum(10000);
+    appendToLayout({memLatencyLabel, memLatencySb}, pageLayout,
+                   "Number of cycles required to fetch a block from main memory on a miss in the last-level cache, "
+                   "unless the DRAM timing model of the cache tab is enabled.");
 
     // Console settings
     auto* consoleGroupBox = new QGroupBox("Console");
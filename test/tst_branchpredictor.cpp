@@ -0,0 +1,156 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QtTest/QTest>
+
+#include "branchpredictor.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "programloader.h"
+#include "ripessettings.h"
+
+/**
+ * Ripes branch predictor tests
+ * Executes a program of calls from two call sites and a loop on the 5-stage processor, and verifies the predictions of
+ * the BTB, the RAS and the direction predictors against the predictions expected of each, and that the predictor is
+ * restored exactly when the processor is reversed.
+ */
+
+using namespace Ripes;
+
+class tst_branchpredictor : public QObject {
+    Q_OBJECT
+
+private:
+    void run(bool reverse);
+
+private slots:
+    void initTestCase();
+    void testPredictions_data();
+    void testPredictions();
+    void testReverse();
+};
+
+// f is fetched on the wrong path of 'j loop', and the loop branch on the wrong path of the second call.
+static const QStringList s_program = QStringList() << ".text"
+                                                   << "li s0, 0"
+                                                   << "li s1, 8"
+                                                   << "j loop"
+                                                   << "f:"
+                                                   << "ret"
+                                                   << "loop:"
+                                                   << "jal ra, f"
+                                                   << "jal ra, f"
+                                                   << "addi s0, s0, 1"
+                                                   << "bne s0, s1, loop";
+static constexpr AInt s_retPC = 0xc;
+static constexpr AInt s_branchPC = 0x1c;
+static constexpr unsigned s_iterations = 8;
+
+void tst_branchpredictor::initTestCase() {
+    ProcessorHandler::get()->selectProcessor(ProcessorID::RV32_5S, {});
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    auto loader = new ProgramLoader();
+    loader->loadTest(s_program.join("\n"));
+}
+
+/**
+ * @brief tst_branchpredictor::run
+ * Resets the processor and clocks it until finished. If @p reverse, the processor is clocked 3 cycles forward and
+ * reversed 2 cycles at a time.
+ */
+void tst_branchpredictor::run(bool reverse) {
+    constexpr long long maxCycles = 1000;
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    QCoreApplication::processEvents();
+    auto* proc = ProcessorHandler::get()->getProcessorNonConst();
+    while (!proc->finished() && proc->getCycleCount() < maxCycles) {
+        for (unsigned s = 0; s < 3 && !proc->finished(); ++s) {
+            proc->clock();
+        }
+        for (unsigned s = 0; reverse && s < 2 && !proc->finished(); ++s) {
+            proc->reverseProcessor();
+            QCoreApplication::processEvents();
+        }
+    }
+    if (!proc->finished())
+        QFAIL("Execution never finished");
+}
+
+void tst_branchpredictor::testPredictions_data() {
+    QTest::addColumn<int>("type");
+    QTest::addColumn<unsigned>("rasEntries");
+    QTest::addColumn<uint64_t>("mispredicted");
+    QTest::addColumn<uint64_t>("targetMispredicted");
+    QTest::addColumn<uint64_t>("branchMispredicted");
+
+    // The jump, each call site and the return mispredict once, as they miss in the BTB. The loop branch is mispredicted
+    // on its first iteration and its exit by the bimodal predictor, and on each taken iteration if predicted not
+    // taken. Without a RAS, each return but the first is predicted to return to the other call site.
+    QTest::newRow("bimodal") << static_cast<int>(DirectionPredictorType::Bimodal) << 8u << uint64_t{6} << uint64_t{0}
+                             << uint64_t{2};
+    QTest::newRow("not taken") << static_cast<int>(DirectionPredictorType::NotTaken) << 8u << uint64_t{11}
+                               << uint64_t{0} << uint64_t{s_iterations - 1};
+    QTest::newRow("no RAS") << static_cast<int>(DirectionPredictorType::Bimodal) << 0u
+                            << uint64_t{3 + 2 * s_iterations} << uint64_t{2 * s_iterations - 1} << uint64_t{2};
+}
+
+void tst_branchpredictor::testPredictions() {
+    QFETCH(int, type);
+    QFETCH(unsigned, rasEntries);
+    QFETCH(uint64_t, mispredicted);
+    QFETCH(uint64_t, targetMispredicted);
+    QFETCH(uint64_t, branchMispredicted);
+
+    BranchPredictor predictor;
+    BranchPredictorConfig config;
+    config.type = static_cast<DirectionPredictorType>(type);
+    config.rasEntries = rasEntries;
+    predictor.setConfig(config);
+    run(false);
+
+    // A jump, two calls and two returns per iteration, and the loop branch
+    const BranchPredictor::Stats stats = predictor.getStats();
+    QCOMPARE(stats.resolved, uint64_t{1 + 5 * s_iterations});
+    QCOMPARE(stats.taken, uint64_t{5 * s_iterations});
+    QCOMPARE(stats.mispredicted, mispredicted);
+    QCOMPARE(stats.targetMispredicted, targetMispredicted);
+
+    const auto pcStats = predictor.getPCStats();
+    QCOMPARE(pcStats.at(s_retPC).kind, ControlFlow::Return);
+    QCOMPARE(pcStats.at(s_retPC).executed, uint64_t{2 * s_iterations});
+    QCOMPARE(pcStats.at(s_branchPC).kind, ControlFlow::Branch);
+    QCOMPARE(pcStats.at(s_branchPC).executed, uint64_t{s_iterations});
+    QCOMPARE(pcStats.at(s_branchPC).taken, uint64_t{s_iterations - 1});
+    QCOMPARE(pcStats.at(s_branchPC).mispredicted, branchMispredicted);
+}
+
+void tst_branchpredictor::testReverse() {
+    for (const auto type : {DirectionPredictorType::Bimodal, DirectionPredictorType::GShare}) {
+        BranchPredictor predictor;
+        BranchPredictorConfig config;
+        config.type = type;
+        config.rasEntries = 1;
+        predictor.setConfig(config);
+
+        run(false);
+        const BranchPredictor::Stats stats = predictor.getStats();
+        const auto pcStats = predictor.getPCStats();
+
+        run(true);
+        QCOMPARE(predictor.getStats().resolved, stats.resolved);
+        QCOMPARE(predictor.getStats().taken, stats.taken);
+        QCOMPARE(predictor.getStats().mispredicted, stats.mispredicted);
+        QCOMPARE(predictor.getStats().targetMispredicted, stats.targetMispredicted);
+        const auto reversedPCStats = predictor.getPCStats();
+        QCOMPARE(reversedPCStats.size(), pcStats.size());
+        for (const auto& [pc, expected] : pcStats) {
+            const BranchPredictor::PCStats& actual = reversedPCStats.at(pc);
+            QCOMPARE(actual.executed, expected.executed);
+            QCOMPARE(actual.taken, expected.taken);
+            QCOMPARE(actual.mispredicted, expected.mispredicted);
+        }
+    }
+}
+
+QTEST_MAIN(tst_branchpredictor)
+#include "tst_branchpredictor.moc"
@@ -0,0 +1,655 @@
+#include <QBuffer>
+#include <QStringList>
+#include <QtTest/QTest>
+
+#include <algorithm>
+#include <random>
+
+#include "binutils.h"
+#include "cachesim/cachebatchsim.h"
+#include "cachesim/cachecore.h"
+#include "cachesim/cachetimeseries.h"
+#include "cachesim/dramsim.h"
+#include "cachesim/memorytrace.h"
+#include "cachesim/optimalreplacement.h"
+#include "cachesim/plotdownsampler.h"
+#include "cachesim/stackdistance.h"
+
+/**
+ * Ripes cache simulator tests
+ * Replays memory traces generated from fixed seeds through the cache simulator, and verifies that the alternative
+ * implementations of the cache statistics (batch simulation, stack-distance analysis) agree with CacheCore, that no
+ * replacement policy of CacheCore outperforms optimal replacement, that the DRAM model charges the latency of the state
+ * of the accessed row buffer, that downsampling the cache plots retains the spikes of the plotted series, and that
+ * undoing the cycles of a trace returns the caches to their exact prior state. The compressed storage of the cache
+ * statistics and the memory traces is verified to return the samples and accesses which were stored.
+ */
+
+using namespace Ripes;
+
+struct Access {
+    AInt address;
+    MemoryAccess::Type type;
+    AInt pc;
+};
+using Trace = std::vector<Access>;
+
+static constexpr unsigned s_wordBytes = 4;
+static constexpr AInt s_textStart = 0x0;
+static constexpr unsigned s_textInstrs = 64;
+
+/**
+ * @brief generateTrace
+ * Generates a trace of @p accesses accesses from @p seed, mixing sequential accesses (which train the prefetchers),
+ * accesses to a small working set, which hit in most caches, and accesses to a larger working set, which evict. A
+ * third of the accesses are writes, if @p writes.
+ */
+static Trace generateTrace(unsigned seed, unsigned accesses, bool writes = true) {
+    std::mt19937 rng(seed);
+    Trace trace;
+    AInt stream = 0x10000;
+    for (unsigned i = 0; i < accesses; ++i) {
+        Access access;
+        switch (rng() % 4) {
+            case 0:
+                stream += s_wordBytes;
+                access.address = stream;
+                break;
+            case 1:
+                access.address = 0x20000 + s_wordBytes * (rng() % 256);
+                break;
+            default:
+                access.address = 0x40000 + s_wordBytes * (rng() % 4096);
+                break;
+        }
+        access.type = writes && rng() % 3 == 0 ? MemoryAccess::Write : MemoryAccess::Read;
+        access.pc = s_textStart + s_wordBytes * (rng() % s_textInstrs);
+        trace.push_back(access);
+    }
+    return trace;
+}
+
+static CachePreset makePreset(int blocks, int lines, int ways, WritePolicy wrPolicy, WriteAllocPolicy wrAllocPolicy,
+                              ReplPolicy replPolicy) {
+    return CachePreset{"", blocks, lines, ways, wrPolicy, wrAllocPolicy, replPolicy};
+}
+
+/**
+ * @brief dumpState
+ * @returns the observable state of @p cache: the state of each of its ways, its statistics and the statistics of its
+ * prefetcher, as text for readable comparison failures.
+ */
+static QStringList dumpState(const CacheCore& cache) {
+    QStringList state;
+    for (int lineIdx = 0; lineIdx < cache.getLines(); ++lineIdx) {
+        for (int wayIdx = 0; wayIdx < cache.getWays(); ++wayIdx) {
+            const CacheCore::CacheWay way = cache.getWay(lineIdx, wayIdx);
+            QStringList dirtyBlocks;
+            for (const unsigned block : way.dirtyBlocks) {
+                dirtyBlocks << QString::number(block);
+            }
+            state << QString("way %1/%2: valid %3 tag %4 dirty %5 (%6) lru %7 prefetched %8")
+                         .arg(lineIdx)
+                         .arg(wayIdx)
+                         .arg(way.valid)
+                         .arg(way.valid ? way.tag : 0)
+                         .arg(way.dirty)
+                         .arg(dirtyBlocks.join(","))
+                         .arg(static_cast<int>(way.lru))
+                         .arg(way.prefetched);
+        }
+        QStringList lineMisses;
+        for (unsigned missClass = 0; missClass < NMissClasses; ++missClass) {
+            lineMisses << QString::number(cache.getLineMisses(lineIdx, static_cast<MissClass>(missClass)));
+        }
+        state << QString("line %1: valid ways %2 misses %3")
+                     .arg(lineIdx)
+                     .arg(cache.getLineValidWays(lineIdx))
+                     .arg(lineMisses.join(","));
+    }
+    state << QString("hits %1 misses %2 writebacks %3 coalesced %4")
+                 .arg(cache.getHits())
+                 .arg(cache.getMisses())
+                 .arg(cache.getWritebacks())
+                 .arg(cache.getCoalescedWrites());
+    for (const auto& [pc, stats] : cache.getPCProfile()) {
+        state << QString("pc %1: misses %2 writebacks %3").arg(pc, 0, 16).arg(stats.misses).arg(stats.writebacks);
+    }
+    if (const Prefetcher* prefetcher = cache.getPrefetcher()) {
+        const PrefetchStats& stats = prefetcher->getStats();
+        state << QString("prefetches: issued %1 useful %2 late %3 misses %4")
+                     .arg(stats.issued)
+                     .arg(stats.useful)
+                     .arg(stats.late)
+                     .arg(stats.misses);
+    }
+    return state;
+}
+
+/**
+ * @brief The Hierarchy struct
+ * An instruction and a data L1 cache, optionally sharing an L2 cache. In each cycle, the instruction cache is accessed
+ * by the PC of an access of the trace, and the data cache by the access itself.
+ */
+struct Hierarchy {
+    CacheCore icache;
+    CacheCore dcache;
+    std::unique_ptr<CacheCore> l2;
+
+    std::vector<CacheCore*> caches() {
+        std::vector<CacheCore*> caches = {&icache, &dcache};
+        if (l2) {
+            caches.push_back(l2.get());
+        }
+        return caches;
+    }
+
+    QStringList dumpState() {
+        QStringList state;
+        for (auto* cache : caches()) {
+            state << ::dumpState(*cache);
+        }
+        return state;
+    }
+
+    std::vector<unsigned> clock(const Access& access, unsigned cycle) {
+        return {icache.access(access.pc, MemoryAccess::Read, cycle, access.pc),
+                dcache.access(access.address, access.type, cycle, access.pc)};
+    }
+};
+
+class tst_cachesim : public QObject {
+    Q_OBJECT
+
+private:
+    void compareBatch(const std::vector<CachePreset>& presets, const Trace& trace);
+    void clockAndReverse(Hierarchy& hierarchy, const Trace& trace);
+
+private slots:
+    void testBatchLanes();
+    void testStackDistance();
+    void testReverseReplacement();
+    void testReverseHierarchy();
+    void testTimeSeries();
+    void testMemoryTrace();
+    void testOptimalReplacement();
+    void testDRAM();
+    void testPlotDownsampler();
+};
+
+/**
+ * @brief tst_cachesim::compareBatch
+ * Simulates @p presets through the SSE2 and the scalar lanes of a batch simulator, and compares the statistics of each
+ * lane to those of a CacheCore simulating the preset of the lane.
+ */
+void tst_cachesim::compareBatch(const std::vector<CachePreset>& presets, const Trace& trace) {
+    CacheBatchSim vectorized(presets, s_wordBytes);
+    CacheBatchSim scalar(presets, s_wordBytes);
+    scalar.setVectorized(false);
+    for (const auto& access : trace) {
+        vectorized.access(access.address, access.type);
+        scalar.access(access.address, access.type);
+    }
+
+    for (unsigned lane = 0; lane < presets.size(); ++lane) {
+        CacheCore cache;
+        cache.setWordSize(s_wordBytes);
+        cache.setPreset(presets.at(lane));
+        for (unsigned cycle = 0; cycle < trace.size(); ++cycle) {
+            cache.access(trace.at(cycle).address, trace.at(cycle).type, cycle);
+        }
+
+        for (const auto* batch : {&vectorized, &scalar}) {
+            QCOMPARE(batch->getHits(lane), cache.getHits());
+            QCOMPARE(batch->getMisses(lane), cache.getMisses());
+            QCOMPARE(batch->getWritebacks(lane), cache.getWritebacks());
+        }
+    }
+}
+
+void tst_cachesim::testBatchLanes() {
+    const Trace trace = generateTrace(1, 20000);
+    const std::vector<std::pair<int, int>> geometries = {{0, 0}, {2, 3}, {1, 5}};
+    for (const auto& [blocks, lines] : geometries) {
+        // A full batch of every associativity up to 8 ways, each with both write policies
+        std::vector<CachePreset> presets;
+        for (int ways = 0; ways < 4; ++ways) {
+            presets.push_back(makePreset(blocks, lines, ways, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate,
+                                         ReplPolicy::LRU));
+            presets.push_back(makePreset(blocks, lines, ways, WritePolicy::WriteThrough,
+                                         WriteAllocPolicy::NoWriteAllocate, ReplPolicy::LRU));
+        }
+        QCOMPARE(presets.size(), static_cast<size_t>(CacheBatchSim::s_lanes));
+        compareBatch(presets, trace);
+
+        // A partial batch, whose unused lanes must not affect the used lanes
+        compareBatch({makePreset(blocks, lines, 4, WritePolicy::WriteBack, WriteAllocPolicy::NoWriteAllocate,
+                                 ReplPolicy::LRU),
+                      makePreset(blocks, lines, 1, WritePolicy::WriteThrough, WriteAllocPolicy::WriteAllocate,
+                                 ReplPolicy::LRU)},
+                     trace);
+    }
+}
+
+void tst_cachesim::testStackDistance() {
+    constexpr unsigned blocks = 1;
+    constexpr unsigned maxLineBits = 3;
+    constexpr unsigned maxWaysBits = 4;
+    const Trace trace = generateTrace(2, 20000, false);
+
+    StackDistanceAnalyzer analyzer(log2Ceil(s_wordBytes) + blocks, maxLineBits, maxWaysBits);
+    for (const auto& access : trace) {
+        analyzer.access(access.address);
+    }
+    QCOMPARE(analyzer.accesses(), static_cast<uint64_t>(trace.size()));
+
+    // Line count 0 is the fully associative cache of each size
+    for (unsigned lineBits = 0; lineBits <= maxLineBits; ++lineBits) {
+        for (unsigned waysBits = 0; waysBits <= maxWaysBits; ++waysBits) {
+            CacheCore cache;
+            cache.setWordSize(s_wordBytes);
+            cache.setPreset(makePreset(blocks, lineBits, waysBits, WritePolicy::WriteBack,
+                                       WriteAllocPolicy::WriteAllocate, ReplPolicy::LRU));
+            for (unsigned cycle = 0; cycle < trace.size(); ++cycle) {
+                cache.access(trace.at(cycle).address, trace.at(cycle).type, cycle);
+            }
+            QCOMPARE(analyzer.hits(lineBits, waysBits), static_cast<uint64_t>(cache.getHits()));
+        }
+    }
+}
+
+/**
+ * @brief tst_cachesim::clockAndReverse
+ * Clocks @p hierarchy through @p trace, one access per cycle, and then undoes each of the cycles, verifying that the
+ * caches return to their exact state prior to the cycle. Finally, the trace is replayed, verifying that the reversal
+ * also restored the state which is not observable through the state dumps, e.g., the replacement state.
+ */
+void tst_cachesim::clockAndReverse(Hierarchy& hierarchy, const Trace& trace) {
+    for (auto* cache : hierarchy.caches()) {
+        cache->setWordSize(s_wordBytes);
+        cache->setTextSection(s_textStart, s_textInstrs * s_wordBytes, s_wordBytes);
+        cache->setUndoCycles(trace.size());
+        cache->resetState();
+    }
+
+    std::vector<QStringList> states;
+    std::vector<std::vector<unsigned>> latencies;
+    for (unsigned cycle = 0; cycle < trace.size(); ++cycle) {
+        states.push_back(hierarchy.dumpState());
+        latencies.push_back(hierarchy.clock(trace.at(cycle), cycle));
+    }
+    const QStringList finalState = hierarchy.dumpState();
+
+    for (unsigned cycle = trace.size(); cycle-- > 0;) {
+        for (auto* cache : hierarchy.caches()) {
+            cache->undoCycle(cycle);
+        }
+        QCOMPARE(hierarchy.dumpState(), states.at(cycle));
+    }
+
+    for (unsigned cycle = 0; cycle < trace.size(); ++cycle) {
+        QCOMPARE(hierarchy.clock(trace.at(cycle), cycle), latencies.at(cycle));
+    }
+    QCOMPARE(hierarchy.dumpState(), finalState);
+}
+
+void tst_cachesim::testReverseReplacement() {
+    const Trace trace = generateTrace(3, 2000);
+    const std::vector<PrefetcherType> prefetchers = {PrefetcherType::None, PrefetcherType::NextLine,
+                                                     PrefetcherType::Stride, PrefetcherType::Stream};
+    unsigned config = 0;
+    for (const auto replPolicy :
+         {ReplPolicy::Random, ReplPolicy::LRU, ReplPolicy::FIFO, ReplPolicy::TreePLRU, ReplPolicy::BitPLRU,
+          ReplPolicy::SRRIP}) {
+        for (const bool writeBack : {true, false}) {
+            Hierarchy hierarchy;
+            hierarchy.icache.setPreset(
+                makePreset(1, 3, 1, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate, replPolicy));
+            const WritePolicy wrPolicy = writeBack ? WritePolicy::WriteBack : WritePolicy::WriteThrough;
+            const WriteAllocPolicy wrAllocPolicy =
+                writeBack ? WriteAllocPolicy::WriteAllocate : WriteAllocPolicy::NoWriteAllocate;
+            hierarchy.dcache.setPreset(makePreset(2, 2, 2, wrPolicy, wrAllocPolicy, replPolicy));
+            hierarchy.dcache.setPrefetcher(prefetchers.at(config++ % prefetchers.size()));
+            if (!writeBack) {
+                hierarchy.dcache.setWriteBufferSize(4);
+            }
+            clockAndReverse(hierarchy, trace);
+        }
+    }
+}
+
+void tst_cachesim::testReverseHierarchy() {
+    const Trace trace = generateTrace(4, 2000);
+    for (const auto inclusionPolicy :
+         {InclusionPolicy::NonInclusive, InclusionPolicy::Inclusive, InclusionPolicy::Exclusive}) {
+        Hierarchy hierarchy;
+        hierarchy.l2 = std::make_unique<CacheCore>();
+        hierarchy.icache.setPreset(
+            makePreset(1, 2, 1, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate, ReplPolicy::LRU));
+        hierarchy.dcache.setPreset(
+            makePreset(1, 2, 1, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate, ReplPolicy::TreePLRU));
+        hierarchy.dcache.setPrefetcher(PrefetcherType::NextLine);
+        // An L2 with larger blocks than the L1 caches, such that inclusive back-invalidations invalidate multiple ways
+        hierarchy.l2->setPreset(
+            makePreset(2, 3, 2, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate, ReplPolicy::SRRIP));
+        hierarchy.l2->setInclusionPolicy(inclusionPolicy);
+        hierarchy.l2->setPrefetcher(PrefetcherType::Stride);
+        hierarchy.icache.setNextLevel(hierarchy.l2.get());
+        hierarchy.dcache.setNextLevel(hierarchy.l2.get());
+        clockAndReverse(hierarchy, trace);
+    }
+}
+
+/**
+ * @brief generateSamples
+ * Generates @p count cumulative samples from @p seed, with cycles starting from 1. Most columns grow by a few units per
+ * sample, with occasional large increments which require multi-byte encodings.
+ */
+static std::vector<CacheTimeSeries::Sample> generateSamples(unsigned seed, unsigned count) {
+    std::mt19937 rng(seed);
+    std::vector<CacheTimeSeries::Sample> samples;
+    CacheTimeSeries::Sample sample;
+    for (unsigned i = 0; i < count; ++i) {
+        sample.cycle += 1 + rng() % 3;
+        for (auto& value : sample.values) {
+            value += rng() % 64 == 0 ? 1000 + rng() % 1000 : rng() % 3;
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+static void compareSamples(const std::vector<CacheTimeSeries::Sample>& actual,
+                           const std::vector<CacheTimeSeries::Sample>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (unsigned i = 0; i < actual.size(); ++i) {
+        QCOMPARE(actual.at(i).cycle, expected.at(i).cycle);
+        QVERIFY(actual.at(i).values == expected.at(i).values);
+    }
+}
+
+void tst_cachesim::testTimeSeries() {
+    constexpr unsigned chunk = CacheTimeSeries::s_chunkSize;
+    const auto expected = generateSamples(5, 2 * chunk + chunk / 2);
+    CacheTimeSeries series;
+    for (const auto& sample : expected) {
+        series.append(sample);
+    }
+    QCOMPARE(series.size(), expected.size());
+
+    // The full range, and ranges starting and ending within and on the boundaries of the sealed chunks. The range
+    // excludes the samples at its bounds.
+    compareSamples(series.samples(0, expected.back().cycle + 1), expected);
+    for (const auto& [from, to] : std::vector<std::pair<unsigned, unsigned>>{
+             {chunk / 2, chunk + chunk / 2}, {chunk - 1, chunk + 1}, {chunk - 2, 2 * chunk + 7}, {100, 101}}) {
+        const std::vector<CacheTimeSeries::Sample> range(expected.begin() + from + 1, expected.begin() + to);
+        compareSamples(series.samples(expected.at(from).cycle, expected.at(to).cycle), range);
+    }
+
+    // Sampling a range retains its first and last samples, and returns samples of the stored series
+    for (const unsigned maxPoints : {10u, 1000u}) {
+        const auto sampled = series.samples(0, expected.back().cycle + 1, maxPoints);
+        QVERIFY(sampled.size() >= 2 && sampled.size() <= maxPoints + 2);
+        QCOMPARE(sampled.front().cycle, expected.front().cycle);
+        QCOMPARE(sampled.back().cycle, expected.back().cycle);
+        for (const auto& sample : sampled) {
+            const auto it = std::find_if(expected.begin(), expected.end(),
+                                         [&](const auto& other) { return other.cycle == sample.cycle; });
+            QVERIFY(it != expected.end());
+            QVERIFY(it->values == sample.values);
+        }
+    }
+
+    // Removing samples past the boundary of a sealed chunk unseals the chunk, after which the series may grow again
+    const unsigned kept = chunk - 10;
+    while (series.size() > kept) {
+        series.popBack();
+    }
+    QCOMPARE(series.back().cycle, expected.at(kept - 1).cycle);
+    compareSamples(series.samples(0, expected.back().cycle + 1),
+                   std::vector<CacheTimeSeries::Sample>(expected.begin(), expected.begin() + kept));
+    for (unsigned i = kept; i < expected.size(); ++i) {
+        series.append(expected.at(i));
+    }
+    compareSamples(series.samples(0, expected.back().cycle + 1), expected);
+}
+
+static std::vector<MemoryTrace::Entry> traceEntries(const MemoryTrace& trace) {
+    std::vector<MemoryTrace::Entry> entries;
+    trace.forEach([&](const MemoryTrace::Entry& entry) { entries.push_back(entry); });
+    return entries;
+}
+
+static void compareEntries(const std::vector<MemoryTrace::Entry>& actual,
+                           const std::vector<MemoryTrace::Entry>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (unsigned i = 0; i < actual.size(); ++i) {
+        QCOMPARE(actual.at(i).cycle, expected.at(i).cycle);
+        QCOMPARE(actual.at(i).address, expected.at(i).address);
+        QCOMPARE(actual.at(i).type, expected.at(i).type);
+    }
+}
+
+void tst_cachesim::testMemoryTrace() {
+    // An instruction fetch and a data access in each cycle, spanning multiple checkpoints of the trace
+    const Trace accesses = generateTrace(6, 3 * MemoryTrace::s_checkpointInterval);
+    std::vector<MemoryTrace::Entry> expected;
+    MemoryTrace trace;
+    for (unsigned cycle = 0; cycle < accesses.size(); ++cycle) {
+        for (const auto& entry : {MemoryTrace::Entry{cycle, accesses.at(cycle).pc, MemoryAccess::Read},
+                                  MemoryTrace::Entry{cycle, accesses.at(cycle).address, accesses.at(cycle).type}}) {
+            trace.append(entry.cycle, entry.address, entry.type);
+            expected.push_back(entry);
+        }
+    }
+    QCOMPARE(trace.size(), expected.size());
+    compareEntries(traceEntries(trace), expected);
+
+    // Round-trip through a file
+    QByteArray file;
+    {
+        QBuffer buffer(&file);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(trace.save(buffer));
+    }
+    MemoryTrace loaded;
+    {
+        QBuffer buffer(&file);
+        buffer.open(QIODevice::ReadOnly);
+        QVERIFY(loaded.load(buffer));
+    }
+    compareEntries(traceEntries(loaded), expected);
+
+    // A truncated file is rejected, whether it ends within the header or within the accesses
+    for (const int bytes : {8, file.size() / 2, file.size() - 1}) {
+        QByteArray truncated = file.left(bytes);
+        QBuffer buffer(&truncated);
+        buffer.open(QIODevice::ReadOnly);
+        MemoryTrace rejected;
+        QVERIFY(!rejected.load(buffer));
+        QVERIFY(rejected.empty());
+    }
+
+    // Truncating the loaded trace by cycle, which locates the accesses through the rebuilt checkpoints, and appending
+    // the removed accesses again
+    const unsigned cycle = MemoryTrace::s_checkpointInterval + 100;
+    loaded.truncate(cycle);
+    const auto kept = std::find_if(expected.begin(), expected.end(), [&](const auto& e) { return e.cycle > cycle; });
+    compareEntries(traceEntries(loaded), std::vector<MemoryTrace::Entry>(expected.begin(), kept));
+    for (auto it = kept; it != expected.end(); ++it) {
+        loaded.append(it->cycle, it->address, it->type);
+    }
+    compareEntries(traceEntries(loaded), expected);
+}
+
+static MemoryTrace toMemoryTrace(const Trace& accesses) {
+    MemoryTrace trace;
+    for (unsigned cycle = 0; cycle < accesses.size(); ++cycle) {
+        trace.append(cycle, accesses.at(cycle).address, accesses.at(cycle).type);
+    }
+    return trace;
+}
+
+void tst_cachesim::testOptimalReplacement() {
+    const std::vector<ReplPolicy> replPolicies = {ReplPolicy::Random,   ReplPolicy::LRU,    ReplPolicy::FIFO,
+                                                  ReplPolicy::TreePLRU, ReplPolicy::BitPLRU, ReplPolicy::SRRIP};
+
+    // Cycling through five blocks, which in a fully associative cache of four blocks misses on each access under LRU
+    Trace cyclic;
+    for (unsigned i = 0; i < 300; ++i) {
+        cyclic.push_back({static_cast<AInt>(0x1000 + s_wordBytes * (i % 5)), MemoryAccess::Read, s_textStart});
+    }
+
+    for (const auto& [accesses, writes] :
+         std::vector<std::pair<Trace, bool>>{{cyclic, false}, {generateTrace(7, 20000, false), false},
+                                             {generateTrace(8, 20000), true}}) {
+        const MemoryTrace trace = toMemoryTrace(accesses);
+        for (const unsigned blocks : {0u, 2u}) {
+            const OptimalReplacement optimal(trace, s_wordBytes << blocks);
+            for (const auto& [lines, ways] : std::vector<std::pair<int, int>>{{0, 2}, {2, 1}, {3, 3}}) {
+                for (const bool writeBack : {true, false}) {
+                    if (!writes && !writeBack) {
+                        continue;
+                    }
+                    const WritePolicy wrPolicy = writeBack ? WritePolicy::WriteBack : WritePolicy::WriteThrough;
+                    const WriteAllocPolicy wrAllocPolicy =
+                        writeBack ? WriteAllocPolicy::WriteAllocate : WriteAllocPolicy::NoWriteAllocate;
+                    const auto result =
+                        optimal.simulate(makePreset(blocks, lines, ways, wrPolicy, wrAllocPolicy, ReplPolicy::LRU));
+                    QCOMPARE(static_cast<size_t>(result.hits + result.misses), trace.size());
+
+                    for (const auto replPolicy : replPolicies) {
+                        CacheCore cache;
+                        cache.setWordSize(s_wordBytes);
+                        cache.setPreset(makePreset(blocks, lines, ways, wrPolicy, wrAllocPolicy, replPolicy));
+                        trace.forEach([&](const MemoryTrace::Entry& entry) {
+                            cache.access(entry.address, entry.type, entry.cycle);
+                        });
+                        QVERIFY2(result.hits >= cache.getHits(),
+                                 qPrintable(QString("blocks %1 lines %2 ways %3 policy %4: optimal %5 < %6")
+                                                .arg(blocks)
+                                                .arg(lines)
+                                                .arg(ways)
+                                                .arg(static_cast<int>(replPolicy))
+                                                .arg(result.hits)
+                                                .arg(cache.getHits())));
+                    }
+                }
+            }
+        }
+    }
+
+    const MemoryTrace trace = toMemoryTrace(cyclic);
+    CacheCore lru;
+    lru.setWordSize(s_wordBytes);
+    lru.setPreset(makePreset(0, 0, 2, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate, ReplPolicy::LRU));
+    trace.forEach([&](const MemoryTrace::Entry& entry) { lru.access(entry.address, entry.type, entry.cycle); });
+    QCOMPARE(lru.getHits(), 0u);
+    const auto optimal = OptimalReplacement(trace, s_wordBytes)
+                             .simulate(makePreset(0, 0, 2, WritePolicy::WriteBack, WriteAllocPolicy::WriteAllocate,
+                                                  ReplPolicy::LRU));
+    // Optimal replacement evicts the block which is used last, such that after the 5 compulsory misses, only every
+    // 4th access misses
+    QCOMPARE(optimal.misses, 5u + (static_cast<unsigned>(cyclic.size()) - 5) / 4);
+}
+
+void tst_cachesim::testDRAM() {
+    // Distinct timings, such that each latency identifies the state of the row buffer
+    DRAMConfig config;
+    config.banks = 4;
+    config.rowBytes = 1024;
+    config.tRCD = 10;
+    config.tRP = 20;
+    config.tCAS = 5;
+    const unsigned rowHit = config.tCAS;
+    const unsigned rowMiss = config.tRCD + config.tCAS;
+    const unsigned rowConflict = config.tRP + config.tRCD + config.tCAS;
+
+    // Accesses of the first two rows of bank 0, interleaved with an access of bank 1
+    const AInt bank0Row0 = 0x0;
+    const AInt bank1Row0 = config.rowBytes;
+    const AInt bank0Row1 = config.rowBytes * config.banks;
+    const std::vector<std::pair<AInt, bool>> accesses = {{bank0Row0, false},      {bank0Row0 + 64, false},
+                                                         {bank1Row0, true},       {bank0Row0 + 128, false},
+                                                         {bank0Row1 + 64, false}, {bank0Row0, true}};
+
+    DRAMSim dram;
+    dram.setConfig(config);
+    const std::vector<unsigned> openLatencies = {rowMiss, rowHit, rowMiss, rowHit, rowConflict, rowConflict};
+    for (unsigned cycle = 0; cycle < accesses.size(); ++cycle) {
+        QCOMPARE(dram.access(accesses.at(cycle).first, 16, accesses.at(cycle).second, cycle),
+                 openLatencies.at(cycle));
+    }
+    QCOMPARE(dram.getStats().rowHits, 2u);
+    QCOMPARE(dram.getStats().rowMisses, 2u);
+    QCOMPARE(dram.getStats().rowConflicts, 2u);
+    QCOMPARE(dram.getStats().reads, 4u);
+    QCOMPARE(dram.getStats().writes, 2u);
+    QCOMPARE(dram.getStats().readLatency, static_cast<uint64_t>(rowMiss + rowHit + rowHit + rowConflict));
+
+    // Undoing the row conflicts reopens row 0 of bank 0
+    dram.reverse(4);
+    QCOMPARE(dram.getStats().rowConflicts, 0u);
+    QCOMPARE(dram.getStats().accesses(), 4u);
+    for (unsigned cycle = 4; cycle < accesses.size(); ++cycle) {
+        QCOMPARE(dram.access(accesses.at(cycle).first, 16, accesses.at(cycle).second, cycle),
+                 openLatencies.at(cycle));
+    }
+
+    // A closed page policy precharges the bank after each access
+    config.pagePolicy = PagePolicy::Closed;
+    dram.setConfig(config);
+    for (unsigned cycle = 0; cycle < accesses.size(); ++cycle) {
+        QCOMPARE(dram.access(accesses.at(cycle).first, 16, accesses.at(cycle).second, cycle), rowMiss);
+    }
+    QCOMPARE(dram.getStats().rowMisses, static_cast<unsigned>(accesses.size()));
+}
+
+void tst_cachesim::testPlotDownsampler() {
+    constexpr unsigned budget = 100;
+    PlotDownsampler downsampler;
+
+    // A series within the budget is retained in full
+    downsampler.reset(budget);
+    std::vector<QPointF> series;
+    for (unsigned x = 0; x < budget; ++x) {
+        series.push_back(QPointF(x, x % 7));
+        downsampler.append(series.back());
+    }
+    QCOMPARE(downsampler.points(), series);
+
+    // A noisy hit rate with a single spike, and a series sampled at irregular intervals
+    constexpr unsigned length = 100000;
+    constexpr unsigned spikeX = 54321;
+    const auto y = [](unsigned x) { return x == spikeX ? 10.0 : 0.5 + 0.01 * ((x * 7919) % 13); };
+    for (const unsigned step : {1u, 17u}) {
+        downsampler.reset(budget);
+        std::mt19937 rng(step);
+        std::vector<unsigned> xs;
+        for (unsigned x = 0; x < length; x += 1 + rng() % step) {
+            xs.push_back(x);
+        }
+        if (!std::binary_search(xs.begin(), xs.end(), spikeX)) {
+            xs.insert(std::upper_bound(xs.begin(), xs.end(), spikeX), spikeX);
+        }
+        for (const unsigned x : xs) {
+            downsampler.append(QPointF(x, y(x)));
+        }
+
+        const auto points = downsampler.points();
+        QVERIFY2(points.size() >= budget && points.size() <= 2 * budget + 2,
+                 qPrintable(QString::number(points.size())));
+        QCOMPARE(points.front(), QPointF(xs.front(), y(xs.front())));
+        QCOMPARE(points.back(), QPointF(xs.back(), y(xs.back())));
+        for (unsigned i = 0; i < points.size(); ++i) {
+            QVERIFY(i == 0 || points.at(i).x() > points.at(i - 1).x());
+            const unsigned x = static_cast<unsigned>(points.at(i).x());
+            QVERIFY(std::binary_search(xs.begin(), xs.end(), x));
+            QCOMPARE(points.at(i).y(), y(x));
+        }
+        QVERIFY(std::find(points.begin(), points.end(), QPointF(spikeX, y(spikeX))) != points.end());
+    }
+}
+
+QTEST_MAIN(tst_cachesim)
+#include "tst_cachesim.moc"
@@ -0,0 +1,142 @@
+#include <QStringList>
+#include <QTextStream>
+#include <QtTest/QTest>
+
+#include <map>
+#include <tuple>
+
+#include "callgraphprofiler.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "programloader.h"
+#include "ripessettings.h"
+
+/**
+ * Ripes call graph profiler tests
+ * Executes a program on the single-cycle processor, retiring the instruction of each cycle into the call graph
+ * profiler, and verifies the calling context tree which results from pairing the calls and returns of the program.
+ */
+
+using namespace Ripes;
+
+class tst_callgraph : public QObject {
+    Q_OBJECT
+
+private:
+    void run(CallGraphProfiler& profiler);
+
+private slots:
+    void testCallsAndUnwinds();
+};
+
+static QString foldedStacks(const CallGraphProfiler& profiler) {
+    QString folded;
+    QTextStream out(&folded);
+    profiler.writeFoldedStacks(out);
+    out.flush();
+    return folded;
+}
+
+/**
+ * @brief tst_callgraph::run
+ * Clocks the current processor until it finishes, attributing each cycle and the instruction which executes in it to
+ * @p profiler.
+ */
+void tst_callgraph::run(CallGraphProfiler& profiler) {
+    constexpr long long maxCycles = 1000;
+    auto* proc = ProcessorHandler::get()->getProcessorNonConst();
+    const AInt textStart = ProcessorHandler::getProgram()->getSection(TEXT_SECTION_NAME)->address;
+    while (!proc->finished() && proc->getCycleCount() < maxCycles) {
+        profiler.cycle(0);
+        profiler.retire((proc->getPcForStage(0) - textStart) >> 2);
+        proc->clock();
+    }
+    if (!proc->finished())
+        QFAIL("Execution never finished");
+}
+
+void tst_callgraph::testCallsAndUnwinds() {
+    // main calls f, calls outer and calls f again. outer records a landing address within itself before calling g,
+    // which calls h. h returns directly to the landing address, as a longjmp, unwinding the frames of g and h. The
+    // landing address is computed rather than labeled, as each label starts a function.
+    const QStringList program = QStringList() << ".text"
+                                              << "main:"
+                                              << "jal ra, f"
+                                              << "jal ra, outer"
+                                              << "jal ra, f"
+                                              << "li a7, 10"
+                                              << "ecall"
+                                              << "f:"
+                                              << "addi a0, a0, 1"
+                                              << "ret"
+                                              << "outer:"
+                                              << "mv s1, ra"
+                                              << "auipc s0, 0"
+                                              << "addi s0, s0, 16"
+                                              << "jal ra, g"
+                                              << "nop"
+                                              << "mv ra, s1"
+                                              << "ret"
+                                              << "g:"
+                                              << "mv s2, ra"
+                                              << "jal ra, h"
+                                              << "mv ra, s2"
+                                              << "ret"
+                                              << "h:"
+                                              << "mv ra, s0"
+                                              << "ret";
+
+    ProcessorHandler::get()->selectProcessor(ProcessorID::RV32_SS, {});
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    auto loader = new ProgramLoader();
+    loader->loadTest(program.join("\n"));
+
+    const auto prog = ProcessorHandler::getProgram();
+    const ProgramSection* text = prog->getSection(TEXT_SECTION_NAME);
+    constexpr unsigned undoCycles = 64;
+    CallGraphProfiler profiler;
+    profiler.reset(prog.get(), text->address, 2, text->data.size() >> 2, undoCycles, 1);
+    run(profiler);
+
+    // Each cycle is attributed to the stack left by the instruction of the previous cycle; the first cycle precedes
+    // any stack. The second call of f from main shares the stack of the first call, as the unwind returned to outer.
+    const QString expectedFolded = "main 4\n"
+                                   "main;f 4\n"
+                                   "main;outer 6\n"
+                                   "main;outer;g 2\n"
+                                   "main;outer;g;h 2\n";
+    constexpr uint64_t expectedCycles = 19;
+    QCOMPARE(foldedStacks(profiler), expectedFolded);
+    QCOMPARE(profiler.getTotals().cycles, expectedCycles);
+    QCOMPARE(profiler.getTotals().instructions, expectedCycles);
+
+    // Function : calls, exclusive instructions, inclusive instructions
+    const std::map<QString, std::tuple<uint64_t, uint64_t, uint64_t>> expectedStats = {
+        {"main", {1, 5, 19}}, {"f", {2, 4, 4}}, {"outer", {1, 6, 10}}, {"g", {1, 2, 4}}, {"h", {1, 2, 2}}};
+    const auto stats = profiler.functionStats();
+    QCOMPARE(stats.size(), expectedStats.size());
+    for (const auto& fstats : stats) {
+        QVERIFY2(expectedStats.count(fstats.name), qPrintable(fstats.name));
+        const auto& [calls, exclusive, inclusive] = expectedStats.at(fstats.name);
+        QCOMPARE(fstats.calls, calls);
+        QCOMPARE(fstats.exclusive.instructions, exclusive);
+        QCOMPARE(fstats.inclusive.instructions, inclusive);
+    }
+
+    // Undoing every cycle restores the empty profile, and the stack prior to the first instruction, such that the
+    // program profiles identically when executed again.
+    for (uint64_t cycle = 0; cycle < expectedCycles; ++cycle) {
+        profiler.undoCycle();
+    }
+    QCOMPARE(profiler.getTotals().cycles, uint64_t{0});
+    QCOMPARE(profiler.getTotals().instructions, uint64_t{0});
+    QVERIFY(profiler.functionStats().empty());
+    QCOMPARE(foldedStacks(profiler), QString());
+
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    run(profiler);
+    QCOMPARE(foldedStacks(profiler), expectedFolded);
+}
+
+QTEST_MAIN(tst_callgraph)
+#include "tst_callgraph.moc"
@@ -69,6 +69,7 @@ private:
     Registers dumpRegs();
     QString generateErrorReport(const RegisterChange& change, const TraceEntry& lhs, const TraceEntry& rhs) const;
     void loadCurrentTest();
+    void setOoOConfig(const std::map<QString, unsigned>& config);
 
     bool m_stop = false;
     QString m_err;
@@ -85,6 +86,37 @@ private slots:
     void testRV6SDual() { cosimulate(ProcessorID::RV32_6S_DUAL, {"M"}); }
     void testRV5S() { cosimulate(ProcessorID::RV32_5S, {"M"}); }
     void testRV5SNoFW() { cosimulate(ProcessorID::RV32_5S_NO_FW, {"M"}); }
+    void testRVOoO() { cosimulate(ProcessorID::RV32_OOO, {"M"}); }
+    void testRVOoONarrow() {
+        // A single-issue core with a small window, stalling dispatch, and a slow divider holding up commit
+        setOoOConfig({{RIPES_SETTING_OOO_ISSUEWIDTH, 1},
+                      {RIPES_SETTING_OOO_ROBENTRIES, 4},
+                      {RIPES_SETTING_OOO_RSENTRIES, 2},
+                      {RIPES_SETTING_OOO_LSQENTRIES, 1},
+                      {RIPES_SETTING_OOO_MULLATENCY, 5},
+                      {RIPES_SETTING_OOO_DIVLATENCY, 40},
+                      {RIPES_SETTING_OOO_LOADLATENCY, 3}});
+        cosimulate(ProcessorID::RV32_OOO, {"M"});
+        QCOMPARE(ProcessorHandler::getProcessor()->issueWidth(), 1u);
+    }
+    void testRVOoOWide() {
+        setOoOConfig({{RIPES_SETTING_OOO_ISSUEWIDTH, 4},
+                      {RIPES_SETTING_OOO_ROBENTRIES, 64},
+                      {RIPES_SETTING_OOO_RSENTRIES, 32},
+                      {RIPES_SETTING_OOO_LSQENTRIES, 16},
+                      {RIPES_SETTING_OOO_ALULATENCY, 2}});
+        cosimulate(ProcessorID::RV32_OOO, {"M"});
+        QCOMPARE(ProcessorHandler::getProcessor()->issueWidth(), 4u);
+    }
+
+    void testRVOoOFusion() {
+        // Fused ops share an RS entry; a small RS makes dispatch depend on it
+        setOoOConfig({{RIPES_SETTING_OOO_FUSION, 1}, {RIPES_SETTING_OOO_RSENTRIES, 2}});
+        cosimulate(ProcessorID::RV32_OOO, {"M"});
+    }
+
+    // Restores the default out-of-order configuration after each test
+    void cleanup() { setOoOConfig({}); }
 };
 
 void tst_Cosimulate::trapHandler() {
@@ -264,5 +296,18 @@ void tst_Cosimulate::cosimulate(const ProcessorID& id, const QStringList& extens
     }
 }
 
+/**
+ * @brief tst_Cosimulate::setOoOConfig
+ * Sets the configuration of the out-of-order processors to @p config, and the remaining parameters to their defaults.
+ */
+void tst_Cosimulate::setOoOConfig(const std::map<QString, unsigned>& config) {
+    for (const auto& key : {RIPES_SETTING_OOO_ISSUEWIDTH, RIPES_SETTING_OOO_ROBENTRIES, RIPES_SETTING_OOO_RSENTRIES,
+                            RIPES_SETTING_OOO_LSQENTRIES, RIPES_SETTING_OOO_ALULATENCY, RIPES_SETTING_OOO_MULLATENCY,
+                            RIPES_SETTING_OOO_DIVLATENCY, RIPES_SETTING_OOO_LOADLATENCY, RIPES_SETTING_OOO_FUSION}) {
+        const auto it = config.find(key);
+        RipesSettings::setValue(key, it != config.end() ? QVariant(it->second) : s_defaultSettings.at(key));
+    }
+}
+
 QTEST_MAIN(tst_Cosimulate)
 #include "tst_cosimulate.moc"
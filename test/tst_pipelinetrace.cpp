@@ -0,0 +1,177 @@
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <map>
+#include <set>
+
+#include "pipelinetraceexporter.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "programloader.h"
+#include "ripessettings.h"
+
+/**
+ * Ripes pipeline trace exporter tests
+ * Exports the execution of a program on the 5-stage processor, and verifies that each logged instruction leaves the
+ * pipeline exactly once, and that the gzip compressed trace decompresses to the uncompressed trace.
+ */
+
+using namespace Ripes;
+
+class tst_pipelinetrace : public QObject {
+    Q_OBJECT
+
+private:
+    QByteArray exportTrace(const QString& filename);
+
+private slots:
+    void testTrace();
+    void testGzip();
+};
+
+static const QStringList s_program = QStringList() << ".text"
+                                                   << "li a0, 0"
+                                                   << "li a1, 10"
+                                                   << "loop:"
+                                                   << "addi a0, a0, 1"
+                                                   << "lw t0, 0(sp)"
+                                                   << "add t1, t0, a0"
+                                                   << "bne a0, a1, loop";
+
+/**
+ * @brief tst_pipelinetrace::exportTrace
+ * Executes the program until finished, while exporting its trace to @p filename.
+ * @returns the contents of the file.
+ */
+QByteArray tst_pipelinetrace::exportTrace(const QString& filename) {
+    constexpr long long maxCycles = 1000;
+    ProcessorHandler::get()->selectProcessor(ProcessorID::RV32_5S, {});
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    auto loader = new ProgramLoader();
+    loader->loadTest(s_program.join("\n"));
+
+    PipelineTraceExporter exporter;
+    if (!exporter.start(filename)) {
+        QTest::qFail("Could not open the trace file", __FILE__, __LINE__);
+        return {};
+    }
+    auto* proc = ProcessorHandler::get()->getProcessorNonConst();
+    while (!proc->finished() && proc->getCycleCount() < maxCycles) {
+        proc->clock();
+    }
+    exporter.stop();
+
+    QFile file(filename);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+void tst_pipelinetrace::testTrace() {
+    QTemporaryDir dir;
+    const QList<QByteArray> lines = exportTrace(dir.filePath("trace.log")).split('\n');
+    QVERIFY(lines.size() > 2);
+    QCOMPARE(lines.at(0), QByteArray("Kanata\t0004"));
+    QCOMPARE(lines.at(1), QByteArray("C=\t0"));
+
+    std::set<QByteArray> stages;
+    const auto* proc = ProcessorHandler::getProcessor();
+    for (unsigned i = 0; i < proc->stageCount(); ++i) {
+        stages.insert(proc->stageName(i).toUtf8());
+    }
+
+    // Each instruction is introduced once and leaves the pipeline once, after which it is not referenced. Retired
+    // instructions are numbered consecutively; instructions on the wrong path of the taken branches are flushed.
+    std::map<QByteArray, bool> live;
+    unsigned introduced = 0;
+    unsigned retired = 0;
+    unsigned flushed = 0;
+    for (const auto& line : lines.mid(2)) {
+        const QList<QByteArray> fields = line.split('\t');
+        const QByteArray& command = fields.at(0);
+        if (command.isEmpty() || command == "C") {
+            continue;
+        }
+        QVERIFY2(fields.size() >= 4, line.constData());
+        const QByteArray& id = fields.at(1);
+        if (command == "I") {
+            QVERIFY2(live.count(id) == 0, line.constData());
+            live[id] = true;
+            introduced++;
+            continue;
+        }
+        QVERIFY2(live.count(id) != 0 && live.at(id), line.constData());
+        if (command == "S") {
+            QVERIFY2(stages.count(fields.at(3)) != 0, line.constData());
+        } else if (command == "R") {
+            live[id] = false;
+            if (fields.at(3) == "0") {
+                QCOMPARE(fields.at(2), QByteArray::number(retired++));
+            } else {
+                flushed++;
+            }
+        }
+    }
+    QCOMPARE(retired + flushed, introduced);
+    QVERIFY(retired > 0);
+    QVERIFY(flushed > 0);
+}
+
+static uint32_t crc32(const QByteArray& data) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (const char c : data) {
+        crc ^= static_cast<uint8_t>(c);
+        for (int k = 0; k < 8; ++k) {
+            crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static uint32_t adler32(const QByteArray& data) {
+    uint32_t a = 1, b = 0;
+    for (const char c : data) {
+        a = (a + static_cast<uint8_t>(c)) % 65521;
+        b = (b + a) % 65521;
+    }
+    return b << 16 | a;
+}
+
+static uint32_t readLE32(const QByteArray& data, int offset) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data.at(offset + i))) << (8 * i);
+    }
+    return value;
+}
+
+void tst_pipelinetrace::testGzip() {
+    QTemporaryDir dir;
+    const QByteArray plain = exportTrace(dir.filePath("trace.log"));
+    const QByteArray gzip = exportTrace(dir.filePath("trace.log.gz"));
+
+    // The trace fits within a single buffer, and is thereby written as a single gzip member: a 10-byte header, the
+    // deflate stream, and the CRC-32 and size of the uncompressed data.
+    QVERIFY(gzip.size() > 18);
+    QCOMPARE(gzip.left(4), QByteArray("\x1f\x8b\x08\x00", 4));
+    QCOMPARE(readLE32(gzip, gzip.size() - 8), crc32(plain));
+    QCOMPARE(readLE32(gzip, gzip.size() - 4), static_cast<uint32_t>(plain.size()));
+
+    // Rewrap the deflate stream as the input of qUncompress: the big-endian uncompressed size, a zlib header, the
+    // deflate stream and the Adler-32 checksum of the uncompressed data.
+    QByteArray zlib;
+    for (int i = 3; i >= 0; --i) {
+        zlib.append(static_cast<char>((plain.size() >> (8 * i)) & 0xFF));
+    }
+    zlib.append("\x78\x9c", 2);
+    zlib.append(gzip.mid(10, gzip.size() - 18));
+    const uint32_t adler = adler32(plain);
+    for (int i = 3; i >= 0; --i) {
+        zlib.append(static_cast<char>((adler >> (8 * i)) & 0xFF));
+    }
+    QCOMPARE(qUncompress(zlib), plain);
+}
+
+QTEST_MAIN(tst_pipelinetrace)
+#include "tst_pipelinetrace.moc"
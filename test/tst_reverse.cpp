@@ -27,6 +27,7 @@ private slots:
                   unsigned backStep, bool toFinish);
     void tst_reverse_regs();
     void tst_reverse_mem();
+    void tst_reverse_replay();
 };
 
 using Registers = std::map<int, VInt>;
@@ -72,7 +73,7 @@ void tst_reverse::run_test(const ProcessorID& id, const QStringList& program, un
 }
 
 void tst_reverse::tst_reverse_regs() {
-    for (auto processor : {ProcessorID::RV32_SS, ProcessorID::RV32_5S}) {
+    for (auto processor : {ProcessorID::RV32_SS, ProcessorID::RV32_5S, ProcessorID::RV32_OOO}) {
         QStringList program = QStringList() << ".text"
                                             << "li x10 0"
                                             << "addi x10 x10 1"
@@ -87,7 +88,7 @@ void tst_reverse::tst_reverse_regs() {
 }
 
 void tst_reverse::tst_reverse_mem() {
-    for (auto processor : {ProcessorID::RV32_SS, ProcessorID::RV32_5S}) {
+    for (auto processor : {ProcessorID::RV32_SS, ProcessorID::RV32_5S, ProcessorID::RV32_OOO}) {
         QStringList program = QStringList() << ".data"
                                             << "a: .word 42"
                                             << ".text"
@@ -102,5 +103,82 @@ void tst_reverse::tst_reverse_mem() {
     }
 }
 
+struct CycleState {
+    Registers regs;
+    AInt pc;
+    VInt mem;
+
+    bool operator==(const CycleState& other) const {
+        return regs == other.regs && pc == other.pc && mem == other.mem;
+    }
+};
+
+static CycleState dumpState(AInt address) {
+    return {dumpRegs(), ProcessorHandler::getProcessor()->getPcForStage(0),
+            ProcessorHandler::getMemory().readMemConst(address, 4)};
+}
+
+// Reversing must restore the state of the processor exactly, such that clocking the processor again follows the same
+// path as if it had never been reversed. The state after each cycle of a forward-only run is compared to the state
+// after each clock and reversal of a run which repeatedly reverses a few cycles.
+void tst_reverse::tst_reverse_replay() {
+    // Independent instructions are dispatched together, and the getcwd system call writes memory as the ecall commits
+    QStringList program = QStringList() << ".data"
+                                        << "buf: .word 0"
+                                        << ".text"
+                                        << "la s0 buf"
+                                        << "mv a0 s0"
+                                        << "li a1 4096"
+                                        << "li a7 17"
+                                        << "ecall"
+                                        << "lw t0 0 s0"
+                                        << "li t1 0"
+                                        << "li t2 10"
+                                        << "loop:"
+                                        << "addi t1 t1 1"
+                                        << "add t3 t1 t0"
+                                        << "xori t4 t3 5"
+                                        << "slli t5 t1 2"
+                                        << "sw t4 0 s0"
+                                        << "bne t1 t2 loop"
+                                        << "lw a2 0 s0";
+    constexpr long long maxCycles = 1000;
+    auto loader = new ProgramLoader();
+    const auto start = [&] {
+        ProcessorHandler::get()->selectProcessor(ProcessorID::RV32_OOO, {});
+        RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+        loader->loadTest(program.join("\n"));
+        return ProcessorHandler::get()->getProcessorNonConst();
+    };
+
+    // Forward-only run
+    auto proc = start();
+    const AInt buf = ProcessorHandler::getProgram()->getSection(".data")->address;
+    std::vector<CycleState> reference = {dumpState(buf)};
+    while (!proc->finished() && proc->getCycleCount() < maxCycles) {
+        proc->clock();
+        reference.push_back(dumpState(buf));
+    }
+    if (!proc->finished())
+        QFAIL("Execution never finished");
+
+    // Step 3 cycles forward and 2 back, until finished
+    proc = start();
+    while (true) {
+        for (unsigned s = 0; s < 3 && !proc->finished(); ++s) {
+            proc->clock();
+            QVERIFY(dumpState(buf) == reference.at(proc->getCycleCount()));
+        }
+        if (proc->finished()) {
+            break;
+        }
+        for (unsigned s = 0; s < 2; ++s) {
+            proc->reverseProcessor();
+            QVERIFY(dumpState(buf) == reference.at(proc->getCycleCount()));
+        }
+    }
+    QCOMPARE(static_cast<size_t>(proc->getCycleCount()), reference.size() - 1);
+}
+
 QTEST_MAIN(tst_reverse)
 #include "tst_reverse.moc"
@@ -68,6 +68,7 @@ private slots:
         runTests(ProcessorID::RV64_5S_NO_FW, {"M", "C"}, {RISCV64_TEST_DIR, RISCV64_C_TEST_DIR});
     }
     void testRV64_6SDual() { runTests(ProcessorID::RV64_6S_DUAL, {"M", "C"}, {RISCV64_TEST_DIR, RISCV64_C_TEST_DIR}); }
+    void testRV64_OoO() { runTests(ProcessorID::RV64_OOO, {"M"}, {RISCV64_TEST_DIR}); }
 
     void testRV32_SingleCycle() { runTests(ProcessorID::RV32_SS, {"M", "C"}, {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR}); }
     void testRV32_5StagePipeline() {
@@ -77,6 +78,7 @@ private slots:
         runTests(ProcessorID::RV32_5S_NO_FW, {"M", "C"}, {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
     }
     void testRV32_6SDual() { runTests(ProcessorID::RV32_6S_DUAL, {"M", "C"}, {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR}); }
+    void testRV32_OoO() { runTests(ProcessorID::RV32_OOO, {"M"}, {RISCV32_TEST_DIR}); }
 };
 
 bool tst_RISCV::skipTest(const QString& test) {